@@ -151,6 +151,7 @@ struct AssetLoadTaskInputs
     // specific to remote loading 
     uint64 clientPayload;
     uint32 clientAssetHash;
+    RemoteRequest clientRequest;     // Server: Response is sent to this request after the load batch is finished
     bool isRemoteLoad;
 };
 
@@ -208,7 +209,7 @@ enum class AssetServerBlobType : uint32
 struct AssetServer
 {
     SpinLockMutex pendingTasksMutex;
-    Array<AssetLoadTaskData*> pendingTasks;
+    RingQueue<AssetLoadTaskData*> pendingTasks;
     AssetLoadTaskData* loadTaskDatas[ASSET_SERVER_MAX_IN_FLIGHT];
     uint32 numLoadTasks;
 };
@@ -246,8 +247,8 @@ struct AssetMan
     MemProxyAllocator alloc;
     MemProxyAllocator assetHeaderAlloc;
     MemProxyAllocator assetDataAlloc;
-    ReadWriteMutex assetMutex;
-    ReadWriteMutex groupsMutex;
+    JobsReadWriteMutex assetMutex;      // Taken from loading jobs, so contention parks the job instead of blocking the worker thread
+    JobsReadWriteMutex groupsMutex;
     ReadWriteMutex hashLookupMutex;
     Mutex pendingJobsMutex;
     Mutex hotReloadMutex;
@@ -298,6 +299,7 @@ namespace Asset
     static Span<AssetMetaKeyValue> _LoadMetaData(const char* assetFilepath, AssetPlatform::Enum platform, MemAllocator* alloc);
     static AssetHandleResult _CreateOrFetchHandle(const AssetParams& params);
     static void _LoadAssetTask(uint32 groupIdx, void* userData);
+    static void _LoadAsset(AssetLoadTaskData& taskData, const Blob& fileBlob);
     static void _SaveBakedTask(uint32 groupIdx, void* userData);
     template <typename _T> _T* _TranslatePointer(_T* ptr, const void* origPtr, void* newPtr);
     static void _LoadGroupTask(uint32, void* userData);
@@ -305,8 +307,8 @@ namespace Asset
     static void _CreateGpuObjects(uint32 numImages, const AssetImageDescHandlePair* images, uint32 numBuffers, const AssetBufferDescHandlePair* buffers);
     static uint32 _MakeCacheFilepath(Path* outPath, const AssetDataHeader* header, uint32 overrideAssetHash = 0);
     static uint32 _MakeParamsHash(const AssetParams& params, uint32 typeSpecificParamsSize);
-    static bool _RemoteServerCallback(uint32 cmd, const Blob& incomingData, Blob*, void*, char outErrorDesc[REMOTE_ERROR_SIZE]);
-    static void _RemoteClientCallback(uint32 cmd, const Blob& incomingData, void*, bool error, const char* errorDesc);
+    static bool _RemoteServerCallback(uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob*, void*, char outErrorDesc[REMOTE_ERROR_SIZE]);
+    static void _RemoteClientCallback(uint32 cmd, uint32 requestId, const Blob& incomingData, void*, bool error, const char* errorDesc);
     static void _ServerLoadBatchTask(uint32, void*);
     constexpr AssetPlatform::Enum _GetCurrentPlatform();
     static void _SaveCacheLookup();
@@ -333,7 +335,7 @@ static void Asset::_GpuResourceFinishedCallback(void* userData)
     AssetHandle handle = AssetHandle(PtrToInt<uint32>(userData));
     ASSERT(handle.IsValid());
 
-    ReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
     if (gAssetMan.assetDb.IsValid(handle)) {
         AssetDataHeader* header = gAssetMan.assetDb.Data(handle);
 
@@ -366,7 +368,7 @@ static void Asset::_UnloadDatasManually(Span<AssetDataPair> datas)
             AssetGroup unloadGroup = Asset::CreateGroup();
 
             {
-                ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+                JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
                 AssetGroupInternal& groupData = gAssetMan.groups.Data(unloadGroup.mHandle);
 
                 depHandles.CopyTo(&groupData.handles);
@@ -412,7 +414,7 @@ static void Asset::_OnFileChanged(const char* filepath)
         path.CalcLength();
     }
 
-    ReadWriteMutexReadScope mtx(gAssetMan.assetMutex);
+    JobsReadWriteMutexReadScope mtx(gAssetMan.assetMutex);
     for (uint32 i = 0; i < gAssetMan.assetDb.Count(); i++) {
         AssetHandle handle = gAssetMan.assetDb.HandleAt(i);
         AssetDataHeader* header = gAssetMan.assetDb.Data(handle);
@@ -671,7 +673,7 @@ static AssetHandleResult Asset::_CreateOrFetchHandle(const AssetParams& params)
 
     // check with asset database and skip loading if it already exists
     {
-        ReadWriteMutexReadScope lock(gAssetMan.assetMutex);
+        JobsReadWriteMutexReadScope lock(gAssetMan.assetMutex);
         r.handle = gAssetMan.assetLookup.FindAndFetch(paramsHash, AssetHandle());
         if (r.handle.IsValid()) {
             r.header = gAssetMan.assetDb.Data(r.handle);
@@ -682,7 +684,7 @@ static AssetHandleResult Asset::_CreateOrFetchHandle(const AssetParams& params)
 
     // create new asset header and handle 
     if (!r.handle.IsValid()) {
-        ReadWriteMutexWriteScope lock(gAssetMan.assetMutex);
+        JobsReadWriteMutexWriteScope lock(gAssetMan.assetMutex);
             
         MemSingleShotMalloc<AssetParams> paramsMallocator;
         if (typeMan.extraParamTypeSize)
@@ -717,6 +719,24 @@ static void Asset::_LoadAssetTask(uint32 groupIdx, void* userData)
     PROFILE_ZONE_COLOR("Asset.Load", PROFILE_COLOR_ASSET2);
 
     AssetLoadTaskData& taskData = *(((AssetLoadTaskData**)userData)[groupIdx]);
+
+    // Local files are read first, because the job is suspended until the read is complete and may resume on another thread
+    // Thread-bound allocators (arena and temp) are only acquired after that. Remote files arrive through fileReadSignal instead
+    Blob fileBlob;
+    if (!taskData.inputs.isRemoteLoad) {
+        // Source files can be large and are only parsed once, so they are mapped instead of copied
+        // Vfs still copies them on watched mounts, because they may be edited while they are mapped
+        bool isSource = taskData.inputs.type == AssetLoadTaskInputType::Source;
+        const char* filepath = isSource ? taskData.inputs.header->params->path.CStr() : taskData.inputs.bakedFilepath.CStr();
+        fileBlob = Vfs::ReadFileAwait(filepath, isSource ? VfsFlags::Mapped : VfsFlags::None);
+    }
+
+    _LoadAsset(taskData, fileBlob);
+    fileBlob.Free();
+}
+
+static void Asset::_LoadAsset(AssetLoadTaskData& taskData, const Blob& fileBlob)
+{
     const AssetParams& params = *taskData.inputs.header->params;
     uint32 typeManIdx = gAssetMan.typeManagers.FindIf([typeId = params.typeId](const AssetTypeManager& typeMan) { return typeMan.fourcc == typeId; });
     ASSERT_MSG(typeManIdx != UINT32_MAX, "AssetType with FourCC %x is not registered", params.typeId);
@@ -740,8 +760,6 @@ static void Asset::_LoadAssetTask(uint32 groupIdx, void* userData)
         assetData.mData->metaData = metaData.Ptr();
         assetData.mData->numMetaData = metaData.Count();
 
-        MemTempAllocator tempAlloc;
-        Blob fileBlob = Vfs::ReadFile(taskData.inputs.header->params->path.CStr(), VfsFlags::None, &tempAlloc);
         const void* fileData = fileBlob.Data();
         ASSERT(fileBlob.Size() <= UINT32_MAX);
         uint32 fileSize = uint32(fileBlob.Size());
@@ -767,7 +785,6 @@ static void Asset::_LoadAssetTask(uint32 groupIdx, void* userData)
     else if (taskData.inputs.type == AssetLoadTaskInputType::Baked) {
         const void* fileData = nullptr;
         uint32 fileSize = 0;
-        MemTempAllocator tempAlloc;
 
         // REMOTE: wait for file to arrive 
         if (taskData.inputs.isRemoteLoad) {
@@ -776,8 +793,6 @@ static void Asset::_LoadAssetTask(uint32 groupIdx, void* userData)
             fileSize = taskData.inputs.fileSize;
         }
         else {
-            ASSERT(fileData == nullptr);
-            Blob fileBlob = Vfs::ReadFile(taskData.inputs.bakedFilepath.CStr(), VfsFlags::None, &tempAlloc);
             fileData = fileBlob.Data();
             ASSERT(fileBlob.Size() <= UINT32_MAX);
             fileSize = uint32(fileBlob.Size());
@@ -807,7 +822,9 @@ static void Asset::_LoadAssetTask(uint32 groupIdx, void* userData)
                 LOG_WARNING("%s '%s' has different binary version. Reverting to bake from source", 
                             typeMan.name.CStr(), taskData.inputs.header->params->path.CStr());
                 taskData.inputs.type = AssetLoadTaskInputType::Source;
-                _LoadAssetTask(groupIdx, userData);
+                Blob sourceBlob = Vfs::ReadFile(params.path.CStr(), VfsFlags::Mapped);
+                _LoadAsset(taskData, sourceBlob);
+                sourceBlob.Free();
             }
             else {
                 taskData.outputs.errorDesc = "Invalid binary version for the baked file";
@@ -969,12 +986,12 @@ static void Asset::_LoadGroupTask(uint32, void* userData)
     bool isHotReloadGroup;
 
     {
-        ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
         AssetGroupInternal& group = gAssetMan.groups.Data(groupHandle);
         Atomic::StoreExplicit(&group.state, uint32(AssetGroupState::Loading), AtomicMemoryOrder::Release);
         isHotReloadGroup = group.hotReloadGroup;
 
-        ReadWriteMutexReadScope rdlockAsset(gAssetMan.assetMutex);
+        JobsReadWriteMutexReadScope rdlockAsset(gAssetMan.assetMutex);
         loadList.Reserve(group.loadList.Count());
         loadListHandles.Reserve(group.loadList.Count());
 
@@ -1105,6 +1122,31 @@ static void Asset::_LoadGroupTask(uint32, void* userData)
             taskDataPtrs[k] = &taskDatas[k];
         }
 
+        // Files that the load tasks are going to read through Vfs. If any of them are on remote mounts, they are fetched
+        // with a single batch request and the tasks pick them up from the Vfs cache instead of a round-trip per file
+        {
+            const char** prefetchPaths = Mem::AllocTyped<const char*>(sliceCount*2, tempAlloc);
+            uint32 numPrefetchPaths = 0;
+            for (uint32 k = 0; k < sliceCount; k++) {
+                const AssetLoadTaskInputs& in = taskDatas[k].inputs;
+                if (in.isRemoteLoad)
+                    continue;
+
+                if (in.type == AssetLoadTaskInputType::Source) {
+                    Path* metaPath = NEW(tempAlloc, Path)(in.header->params->path);
+                    metaPath->Append(ASSET_METADATA_EXT);
+                    prefetchPaths[numPrefetchPaths++] = in.header->params->path.CStr();
+                    prefetchPaths[numPrefetchPaths++] = metaPath->CStr();
+                }
+                else {
+                    prefetchPaths[numPrefetchPaths++] = in.bakedFilepath.CStr();
+                }
+            }
+
+            if (numPrefetchPaths)
+                Vfs::PrefetchFiles(prefetchPaths, numPrefetchPaths);
+        }
+
         JobsHandle batchJob = Jobs::Dispatch(JobsType::LongTask, _LoadAssetTask, taskDataPtrs, sliceCount, JobsPriority::High, JobsStackSize::Large);
 
         // REMOTE: Make load requests
@@ -1426,13 +1468,13 @@ static void Asset::_LoadGroupTask(uint32, void* userData)
     gAssetMan.memArena->Reset();
 
     if (!isHotReloadGroup) {
-        ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
         AssetGroupInternal& group = gAssetMan.groups.Data(groupHandle);
         Atomic::StoreExplicit(&group.state, uint32(AssetGroupState::Loaded), AtomicMemoryOrder::Release);
     }
     else {
         {
-            ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+            JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
             AssetGroupInternal& group = gAssetMan.groups.Data(groupHandle);
             group.state = AssetGroupState::Idle;
         }
@@ -1456,7 +1498,7 @@ static void Asset::_UnloadGroupTask(uint32, void* userData)
 
     bool isHotReloadGroup;
     {
-        ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
         AssetGroupInternal& group = gAssetMan.groups.Data(groupHandle);
         Atomic::StoreExplicit(&group.state, uint32(AssetGroupState::Unloading), AtomicMemoryOrder::Release);
         group.handles.CopyTo(&unloadList);
@@ -1468,7 +1510,7 @@ static void Asset::_UnloadGroupTask(uint32, void* userData)
     // Unload assets and their dependencies
     // Omit assets that has refCount > 0
     {
-        ReadWriteMutexReadScope rlock(gAssetMan.assetMutex);
+        JobsReadWriteMutexReadScope rlock(gAssetMan.assetMutex);
         for (uint32 i = 0; i < unloadList.Count();) {
             AssetDataHeader* header = gAssetMan.assetDb.Data(unloadList[i]);
             if (--header->refCount > 0) {
@@ -1524,7 +1566,7 @@ static void Asset::_UnloadGroupTask(uint32, void* userData)
     // Remove the handles and free the header
     // TODO: this part seems to be crashing on some systems with Stack corruption. investigate
     {
-        ReadWriteMutexWriteScope wlock(gAssetMan.assetMutex);
+        JobsReadWriteMutexWriteScope wlock(gAssetMan.assetMutex);
         for (AssetHandle handle : unloadList) {
             AssetDataHeader* header = gAssetMan.assetDb.Data(handle);
 
@@ -1552,7 +1594,7 @@ static void Asset::_UnloadGroupTask(uint32, void* userData)
     }
 
     if (!isHotReloadGroup) {
-        ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
         AssetGroupInternal& group = gAssetMan.groups.Data(groupHandle);
         Atomic::StoreExplicit(&group.state, uint32(AssetGroupState::Idle), AtomicMemoryOrder::Release);
     }
@@ -1590,7 +1632,6 @@ static void Asset::_ServerLoadBatchTask(uint32, void*)
     tasksForLoad.Free();
 
     // Send successfully loaded asset blobs to the client
-    // TODO: compress the data
     {
         MemTempAllocator tempAlloc;
         for (uint32 i = 0; i < numTasks; i++) {
@@ -1605,14 +1646,14 @@ static void Asset::_ServerLoadBatchTask(uint32, void*)
 
             if (in.assetHash && in.clientAssetHash == in.assetHash) {
                 blobs[0].Write<uint32>(uint32(AssetServerBlobType::LocalCacheIsValid));
-                Remote::SendResponse(ASSET_LOAD_ASSET_REMOTE_CMD, blobs[0], false, nullptr);
+                Remote::SendResponse(in.clientRequest, ASSET_LOAD_ASSET_REMOTE_CMD, blobs[0], false, nullptr);
             }
             else if (!out.data) {
                 String<512> errorMsg;
                 errorMsg.FormatSelf("Loading %s '%s' failed: %s", in.header->typeName, in.header->params->path.CStr(), out.errorDesc.CStr());
                 LOG_ERROR(errorMsg.CStr());
 
-                Remote::SendResponse(ASSET_LOAD_ASSET_REMOTE_CMD, blobs[0], true, errorMsg.CStr());
+                Remote::SendResponse(in.clientRequest, ASSET_LOAD_ASSET_REMOTE_CMD, blobs[0], true, errorMsg.CStr());
             }
             else {
                 uint32 typeManIdx = gAssetMan.typeManagers.FindIf(
@@ -1633,7 +1674,7 @@ static void Asset::_ServerLoadBatchTask(uint32, void*)
                 blobs[1].Reserve(out.data, out.dataSize);
                 blobs[1].SetSize(out.dataSize);
 
-                Remote::SendResponseMerge(ASSET_LOAD_ASSET_REMOTE_CMD, blobs, CountOf(blobs), false, nullptr);
+                Remote::SendResponseMerge(in.clientRequest, ASSET_LOAD_ASSET_REMOTE_CMD, blobs, CountOf(blobs), false, nullptr);
             }
         }
     }
@@ -1646,7 +1687,7 @@ static void Asset::_ServerLoadBatchTask(uint32, void*)
     gAssetMan.memArena->Reset();
 }
 
-static bool Asset::_RemoteServerCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, Blob*, void*, char outErrorDesc[REMOTE_ERROR_SIZE])
+static bool Asset::_RemoteServerCallback([[maybe_unused]] uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob*, void*, char outErrorDesc[REMOTE_ERROR_SIZE])
 {
     ASSERT(cmd == ASSET_LOAD_ASSET_REMOTE_CMD);
     UNUSED(outErrorDesc);
@@ -1689,10 +1730,11 @@ static bool Asset::_RemoteServerCallback([[maybe_unused]] uint32 cmd, const Blob
 
     taskData->inputs.clientPayload = clientPayload;
     taskData->inputs.clientAssetHash = clientAssetHash;
+    taskData->inputs.clientRequest = req;
 
     {
         SpinLockMutexScope mtx(gAssetMan.server.pendingTasksMutex);
-        gAssetMan.server.pendingTasks.Push(taskData);
+        gAssetMan.server.pendingTasks.PushBack(taskData);
     }
 
     // Trigger server job, so we can dispatch server jobs in Update when we get idle
@@ -1708,7 +1750,7 @@ static bool Asset::_RemoteServerCallback([[maybe_unused]] uint32 cmd, const Blob
     return true;
 }
 
-static void Asset::_RemoteClientCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, void*, bool error, const char* errorDesc)
+static void Asset::_RemoteClientCallback([[maybe_unused]] uint32 cmd, uint32, const Blob& incomingData, void*, bool error, const char* errorDesc)
 {
     ASSERT(cmd == ASSET_LOAD_ASSET_REMOTE_CMD);
 
@@ -2004,7 +2046,7 @@ AssetGroup Asset::CreateGroup()
     groupInternal.loadList.SetAllocator(alloc);
     groupInternal.handles.SetAllocator(alloc);
 
-    ReadWriteMutexWriteScope lock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexWriteScope lock(gAssetMan.groupsMutex);
     AssetGroup group {
         .mHandle = gAssetMan.groups.Add(groupInternal)
     };
@@ -2028,7 +2070,7 @@ void Asset::DestroyGroup(AssetGroup& group)
     }
 
     {
-        ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
         AssetGroupInternal& gi = gAssetMan.groups.Data(group.mHandle);
         ASSERT_MSG(gi.state == AssetGroupState::Idle, "AssetGroup must be fully unloaded (Idle state) before getting destroyed");
 
@@ -2036,7 +2078,7 @@ void Asset::DestroyGroup(AssetGroup& group)
         gi.handles.Free();
     }
 
-    ReadWriteMutexWriteScope wlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexWriteScope wlock(gAssetMan.groupsMutex);
     gAssetMan.groups.Remove(group.mHandle);
 }
 
@@ -2045,7 +2087,7 @@ void* Asset::LockObjData(AssetHandle handle)
     if (!handle.IsValid())
         return nullptr;
 
-    ReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
     if (!gAssetMan.assetDb.IsValid(handle)) {
         ASSERT(0);
         return nullptr;
@@ -2083,7 +2125,7 @@ void Asset::UnlockObjData(AssetHandle handle)
     if (!handle.IsValid())
         return;
 
-    ReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
     if (!gAssetMan.assetDb.IsValid(handle))
         return;
 
@@ -2098,7 +2140,7 @@ const AssetParams* Asset::GetParams(AssetHandle handle)
     if (!handle.IsValid())
         return nullptr;
 
-    ReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.assetMutex);
     return gAssetMan.assetDb.IsValid(handle) ? gAssetMan.assetDb.Data(handle)->params : nullptr;
 }
 
@@ -2145,11 +2187,8 @@ void Asset::Update()
                 {
                     SpinLockMutexScope lock(server.pendingTasksMutex);
                     numLoadTasks = Min(ASSET_SERVER_MAX_IN_FLIGHT, server.pendingTasks.Count());
-                    if (numLoadTasks) {
-                        for (uint32 i = 0; i < numLoadTasks; i++) 
-                            server.loadTaskDatas[i] = server.pendingTasks[i];
-                        server.pendingTasks.ShiftLeft(numLoadTasks);            
-                    }
+                    for (uint32 i = 0; i < numLoadTasks; i++) 
+                        server.loadTaskDatas[i] = server.pendingTasks.PopFront();
                 }
 
                 server.numLoadTasks = numLoadTasks;
@@ -2194,7 +2233,7 @@ void Asset::Update()
                 AssetGroup group = Asset::CreateGroup();
 
                 {
-                    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+                    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
                     AssetGroupInternal& groupData = gAssetMan.groups.Data(group.mHandle);
 
                     groupData.loadList.Reserve(numItems);
@@ -2330,7 +2369,7 @@ const char* AssetData::GetMetaValue(const char* key, const char* defaultValue) c
                                                                                             
 void AssetGroup::AddToLoadQueue(const AssetParams* paramsArray, uint32 numAssets, AssetHandle* outHandles) const
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
     ASSERT_MSG(Atomic::LoadExplicit(&group.state, AtomicMemoryOrder::Acquire) == uint32(AssetGroupState::Idle), 
                "AssetGroup should only be populated while it's not loading or unloading");
@@ -2373,7 +2412,7 @@ void AssetGroup::Load()
     MutexScope lock(gAssetMan.pendingJobsMutex);
     uint32 index = gAssetMan.pendingJobs.FindIf([handle = mHandle](const AssetJobItem& item) { return item.groupHandle == handle; });
     if (index == -1 || gAssetMan.pendingJobs[index].type == AssetJobType::Unload) {
-        ReadWriteMutexReadScope groupsLock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope groupsLock(gAssetMan.groupsMutex);
         AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
 
         if (!group.loadList.IsEmpty()) {
@@ -2399,7 +2438,7 @@ void AssetGroup::Unload()
     uint32 index = gAssetMan.pendingJobs.FindIf([handle = mHandle](const AssetJobItem& item) { return item.groupHandle == handle; });
 
     if (index == -1 || gAssetMan.pendingJobs[index].type == AssetJobType::Load) {
-        ReadWriteMutexReadScope groupsLock(gAssetMan.groupsMutex);
+        JobsReadWriteMutexReadScope groupsLock(gAssetMan.groupsMutex);
         AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
 
         if (!group.handles.IsEmpty()) {
@@ -2420,7 +2459,7 @@ void AssetGroup::Unload()
 
 void AssetGroup::Wait()
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
     while (Atomic::LoadExplicit(&group.state, AtomicMemoryOrder::Acquire) != uint32(AssetGroupState::Loaded)) {
         OS::PauseCPU();
@@ -2436,35 +2475,35 @@ bool AssetGroup::IsValid() const
 
 bool AssetGroup::IsLoadFinished() const
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
     return Atomic::LoadExplicit(&group.state, AtomicMemoryOrder::Acquire) == uint32(AssetGroupState::Loaded);
 }
 
 bool AssetGroup::IsIdle() const
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
     return Atomic::LoadExplicit(&group.state, AtomicMemoryOrder::Acquire) == uint32(AssetGroupState::Idle);
 }
 
 AssetGroupState AssetGroup::GetState() const
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
     return (AssetGroupState)Atomic::LoadExplicit(&group.state, AtomicMemoryOrder::Acquire);
 }
 
 bool AssetGroup::HasItemsInQueue() const
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
     return !group.loadList.IsEmpty();
 }
 
 Span<AssetHandle> AssetGroup::GetAssetHandles(MemAllocator* alloc) const
 {
-    ReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
+    JobsReadWriteMutexReadScope rdlock(gAssetMan.groupsMutex);
     AssetGroupInternal& group = gAssetMan.groups.Data(mHandle);
 
     AssetHandle* handles = Mem::AllocCopy<AssetHandle>(group.handles.Ptr(), group.handles.Count(), alloc);
@@ -4,11 +4,14 @@
 
 #include "../Core/Allocators.h"
 #include "../Core/JsonParser.h"
+#include "../Core/Hash.h"
+#include "../Core/BlitSort.h"
+#include "../Core/MathScalar.h"
 
 #include "../Common/VirtualFS.h"
 
 static constexpr uint32 FONT_ASSET_TYPE = MakeFourCC('F', 'O', 'N', 'T');
-static constexpr uint32 FONT_ASSET_CACHE_VERSION = 1;
+static constexpr uint32 FONT_ASSET_CACHE_VERSION = 2;
 
 struct AssetFontImpl final : AssetTypeImplBase
 {
@@ -24,6 +27,54 @@ struct AssetFontManager
 
 static AssetFontManager gFontMgr;
 
+namespace Font
+{
+    INLINE uint32 _MakeKerningKey(uint32 firstId, uint32 secondId)
+    {
+        return (firstId << 16) | (secondId & 0xffff);
+    }
+
+    static void _CreateLookupTables(FontData* font, MemAllocator* alloc)
+    {
+        ASSERT_MSG(font->numGlyphs < FONT_INVALID_GLYPH, "Too many glyphs in the font");
+
+        font->asciiGlyphIndices = Mem::AllocTyped<uint16>(FONT_ASCII_TABLE_SIZE, alloc);
+        for (uint32 i = 0; i < FONT_ASCII_TABLE_SIZE; i++)
+            font->asciiGlyphIndices[i] = FONT_INVALID_GLYPH;
+
+        font->glyphMap = Mem::AllocTyped<FontGlyphMapItem>(font->numGlyphs, alloc);
+        for (uint32 i = 0; i < font->numGlyphs; i++) {
+            uint16 unicode = font->glyphIds[i];
+            font->glyphMap[i] = FontGlyphMapItem { .unicode = unicode, .glyphIndex = uint16(i) };
+            if (unicode < FONT_ASCII_TABLE_SIZE && font->asciiGlyphIndices[unicode] == FONT_INVALID_GLYPH)
+                font->asciiGlyphIndices[unicode] = uint16(i);
+        }
+        BlitSort<FontGlyphMapItem>(font->glyphMap.Get(), font->numGlyphs, 
+                                   [](const FontGlyphMapItem& a, const FontGlyphMapItem& b)->int { return int(a.unicode) - int(b.unicode); });
+
+        if (font->numKernings) {
+            // Load factor of 0.5 at most
+            uint32 tableSize = uint32(M::NearestPow2(int(font->numKernings*2)));
+            uint32 mask = tableSize - 1;
+            font->kerningTableSize = tableSize;
+            font->kerningTable = Mem::AllocZeroTyped<uint32>(tableSize, alloc);
+
+            for (uint32 i = 0; i < font->numKernings; i++) {
+                const FontKerning& kern = font->kernings[i];
+                uint32 key = _MakeKerningKey(kern.firstId, kern.secondId);
+                uint32 index = Hash::Uint32(key) & mask;
+                while (font->kerningTable[index]) {
+                    const FontKerning& existing = font->kernings[font->kerningTable[index] - 1];
+                    if (_MakeKerningKey(existing.firstId, existing.secondId) == key)
+                        break;
+                    index = (index + 1) & mask;
+                }
+                font->kerningTable[index] = i + 1;
+            }
+        }
+    }
+} // Font
+
 bool Font::InitializeManager()
 {
     static uint8 blankFontData[sizeof(FontData) + sizeof(FontGlyph) + 32];
@@ -160,6 +211,8 @@ bool AssetFontImpl::Bake(const AssetParams& params, AssetData* data, const Span<
         }
     }
 
+    Font::_CreateLookupTables(font, &tempAlloc);
+
     // Try to load the source font file
     Path fileDir = params.path.GetDirectory();
     Path sourceFontTTF = Path::JoinUnix(fileDir, filename).Append(".ttf");
@@ -192,4 +245,52 @@ bool AssetFontImpl::Bake(const AssetParams& params, AssetData* data, const Span<
 bool AssetFontImpl::Reload(void*, void*)
 {
     return false;
-}
\ No newline at end of file
+}
+
+uint32 Font::FindGlyph(const FontData& font, uint32 unicode)
+{
+    if (unicode < FONT_ASCII_TABLE_SIZE && !font.asciiGlyphIndices.IsNull()) {
+        uint16 index = font.asciiGlyphIndices[unicode];
+        return index != FONT_INVALID_GLYPH ? index : UINT32_MAX;
+    }
+
+    if (font.glyphMap.IsNull() || unicode > UINT16_MAX)
+        return UINT32_MAX;
+
+    const FontGlyphMapItem* items = font.glyphMap.Get();
+    uint32 first = 0;
+    uint32 count = font.numGlyphs;
+    while (count > 0) {
+        uint32 step = count >> 1;
+        uint32 mid = first + step;
+        if (items[mid].unicode < unicode) {
+            first = mid + 1;
+            count -= step + 1;
+        }
+        else {
+            count = step;
+        }
+    }
+
+    return (first < font.numGlyphs && items[first].unicode == unicode) ? items[first].glyphIndex : UINT32_MAX;
+}
+
+float Font::GetKerning(const FontData& font, uint32 firstUnicode, uint32 secondUnicode)
+{
+    if (font.kerningTableSize == 0)
+        return 0;
+
+    const uint32* table = font.kerningTable.Get();
+    const FontKerning* kernings = font.kernings.Get();
+    uint32 key = _MakeKerningKey(firstUnicode, secondUnicode);
+    uint32 mask = font.kerningTableSize - 1;
+    uint32 index = Hash::Uint32(key) & mask;
+    while (table[index]) {
+        const FontKerning& kern = kernings[table[index] - 1];
+        if (kern.firstId == firstUnicode && kern.secondId == secondUnicode)
+            return kern.xadvance;
+        index = (index + 1) & mask;
+    }
+
+    return 0;
+}
@@ -5,6 +5,9 @@
 
 struct AssetGroup;
 
+inline constexpr uint32 FONT_ASCII_TABLE_SIZE = 128;
+inline constexpr uint16 FONT_INVALID_GLYPH = 0xffff;
+
 struct FontGlyph
 {
     float xadvance;
@@ -19,6 +22,12 @@ struct FontKerning
     float xadvance;
 };
 
+struct FontGlyphMapItem
+{
+    uint16 unicode;
+    uint16 glyphIndex;
+};
+
 // SERIALIZED
 struct FontData
 {
@@ -38,6 +47,12 @@ struct FontData
     RelativePtr<FontGlyph> glyphs;
     RelativePtr<FontKerning> kernings;
     RelativePtr<uint8> fontSourceData;  // TTF/OTF file
+
+    // Lookup tables, generated by the baker
+    uint32 kerningTableSize;                    // Power of two
+    RelativePtr<uint16> asciiGlyphIndices;      // FONT_ASCII_TABLE_SIZE entries. Index into glyphs or FONT_INVALID_GLYPH
+    RelativePtr<FontGlyphMapItem> glyphMap;     // numGlyphs entries, sorted by unicode for binary search
+    RelativePtr<uint32> kerningTable;           // Open addressing (linear probe) with key=(firstId<<16)|secondId. Value: Index+1 into kernings, 0=empty
 };
 
 namespace Font
@@ -47,4 +62,8 @@ namespace Font
 
     // DataType: AssetObjPtrScope<FontData>
     API AssetHandleFont Load(const char* path, const AssetGroup& group);
+
+    // Returns index into FontData::glyphs or UINT32_MAX if the font doesn't have the character
+    API uint32 FindGlyph(const FontData& font, uint32 unicode);
+    API float GetKerning(const FontData& font, uint32 firstUnicode, uint32 secondUnicode);
 }
\ No newline at end of file
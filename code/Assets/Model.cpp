@@ -20,7 +20,12 @@
 #include "../Tool/MeshOptimizer.h"
 
 static constexpr uint32 MODEL_ASSET_TYPE = MakeFourCC('M', 'O', 'D', 'L');
-static constexpr uint32 MODEL_ASSET_CACHE_VERSION = 3;
+static constexpr uint32 MODEL_ASSET_CACHE_VERSION = 6;
+static constexpr size_t MODEL_BAKE_MAX_MEMORY_SIZE = 2*SIZE_GB;
+
+#if CONFIG_TOOLMODE
+static_assert(MODEL_MAX_LODS == MESHOPT_MAX_LODS);
+#endif
 
 struct ModelVertexAttribute
 {
@@ -129,13 +134,167 @@ namespace ModelUtil
         }
     }
 
+    static bool _IsQuantizedFormat(GfxFormat fmt)
+    {
+        return fmt == GfxFormat::R16G16_SNORM || fmt == GfxFormat::R16G16B16A16_SNORM ||
+               fmt == GfxFormat::R16G16_SFLOAT || fmt == GfxFormat::R16G16B16A16_SFLOAT;
+    }
+
+    // Makes a full-precision layout out of a layout with quantized attributes, which the loader and optimizer work with
+    // Returns false if the layout doesn't have any quantized attributes, in which case outLayout is the same as layout
+    static bool _MakeFloatLayout(const GeometryVertexLayout& layout, GeometryVertexLayout* outLayout)
+    {
+        *outLayout = layout;
+
+        bool quantized = false;
+        for (uint32 i = 0; i < GEOMETRY_MAX_VERTEX_ATTRIBUTES && !layout.vertexAttributes[i].semantic.IsEmpty(); i++)
+            quantized |= _IsQuantizedFormat(layout.vertexAttributes[i].format);
+        if (!quantized)
+            return false;
+
+        uint32 offsets[GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER] {};
+        for (uint32 i = 0; i < GEOMETRY_MAX_VERTEX_ATTRIBUTES && !layout.vertexAttributes[i].semantic.IsEmpty(); i++) {
+            GfxVertexInputAttributeDesc& attr = outLayout->vertexAttributes[i];
+            if (_IsQuantizedFormat(attr.format)) {
+                if (attr.semantic == "POSITION" || attr.semantic == "NORMAL" || attr.semantic == "BINORMAL")
+                    attr.format = GfxFormat::R32G32B32_SFLOAT;
+                else if (attr.semantic == "TEXCOORD")
+                    attr.format = GfxFormat::R32G32_SFLOAT;
+                else
+                    attr.format = GfxFormat::R32G32B32A32_SFLOAT;
+            }
+
+            attr.offset = offsets[attr.binding];
+            offsets[attr.binding] += Geometry::GetVertexStride(attr.format);
+        }
+
+        for (uint32 i = 0; i < GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER && layout.vertexBufferStrides[i]; i++)
+            outLayout->vertexBufferStrides[i] = offsets[i];
+
+        return true;
+    }
+
+    // Converts full-precision vertex buffers (srcLayout) to the quantized formats requested by dstLayout
+    // Vertex buffers are re-created and mesh buffer offsets/sizes are updated accordingly
+    static void _QuantizeVertices(ModelData* model, GeometryCpuBuffers* cpuBuffers, const GeometryVertexLayout& srcLayout, 
+                                  const GeometryVertexLayout& dstLayout, MemAllocator* alloc)
+    {
+        GeometryCpuBuffers dstBuffers {};
+        ASSERT(model->numMeshes);
+
+        uint64* meshDstOffsets = Mem::AllocTyped<uint64>(model->numMeshes*model->numVertexBuffers, alloc);
+        for (uint32 i = 0; i < model->numMeshes; i++) {
+            const ModelMesh& mesh = model->meshes[i];
+            for (uint32 b = 0; b < model->numVertexBuffers; b++) {
+                meshDstOffsets[i*model->numVertexBuffers + b] = dstBuffers.vertexBufferSizes[b];
+                dstBuffers.vertexBufferSizes[b] += uint64(dstLayout.vertexBufferStrides[b])*mesh.numVertices;
+                dstBuffers.vertexBufferSizes[b] = AlignValue<uint64>(dstBuffers.vertexBufferSizes[b], 16ull);
+            }
+        }
+
+        for (uint32 b = 0; b < model->numVertexBuffers; b++)
+            dstBuffers.vertexBuffers[b] = (uint8*)alloc->Malloc(dstBuffers.vertexBufferSizes[b]);
+
+        for (uint32 i = 0; i < model->numMeshes; i++) {
+            ModelMesh& mesh = model->meshes[i];
+
+            uint64 meshOffsets[GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER] {};
+            for (uint32 b = 0; b < model->numVertexBuffers; b++)
+                meshOffsets[b] = meshDstOffsets[i*model->numVertexBuffers + b];
+
+            // Position bounds are used for normalizing the positions to [-1, 1]
+            const GfxVertexInputAttributeDesc* posAttr = dstLayout.FindAttribute("POSITION", 0);
+            if (posAttr && posAttr->format == GfxFormat::R16G16B16A16_SNORM) {
+                uint32 posStride;
+                uint8* posPtr = srcLayout.GetVertexAttributePointer(mesh.vertexBufferOffsets, *cpuBuffers, "POSITION", 0, posStride);
+                ASSERT(posPtr);
+                AABB bounds = AABB_EMPTY;
+                for (uint32 v = 0; v < mesh.numVertices; v++)
+                    AABB::AddPoint(bounds, *((Float3*)(posPtr + posStride*v)));
+
+                Float3 extents = bounds.Extents();
+                mesh.positionOffset = bounds.Center();
+                mesh.positionScale = Float3(Max(extents.x, M_FLOAT32_EPSILON), Max(extents.y, M_FLOAT32_EPSILON), Max(extents.z, M_FLOAT32_EPSILON));
+            }
+
+            for (uint32 ai = 0; ai < GEOMETRY_MAX_VERTEX_ATTRIBUTES && !dstLayout.vertexAttributes[ai].semantic.IsEmpty(); ai++) {
+                const GfxVertexInputAttributeDesc& dstAttr = dstLayout.vertexAttributes[ai];
+                const GfxVertexInputAttributeDesc& srcAttr = srcLayout.vertexAttributes[ai];
+                ASSERT(srcAttr.semantic == dstAttr.semantic.CStr() && srcAttr.binding == dstAttr.binding);
+
+                uint32 srcStride = srcLayout.vertexBufferStrides[srcAttr.binding];
+                uint32 dstStride = dstLayout.vertexBufferStrides[dstAttr.binding];
+                const uint8* src = cpuBuffers->vertexBuffers[srcAttr.binding] + mesh.vertexBufferOffsets[srcAttr.binding] + srcAttr.offset;
+                uint8* dst = dstBuffers.vertexBuffers[dstAttr.binding] + meshOffsets[dstAttr.binding] + dstAttr.offset;
+                uint32 numComponents = Geometry::GetVertexStride(srcAttr.format)/sizeof(float);
+                bool isPosition = dstAttr.semantic == "POSITION";
+
+                for (uint32 v = 0; v < mesh.numVertices; v++) {
+                    const float* s = (const float*)(src + srcStride*v);
+                    uint8* d = dst + dstStride*v;
+
+                    switch (dstAttr.format) {
+                    case GfxFormat::R16G16B16A16_SNORM: {
+                        int16* q = (int16*)d;
+                        if (isPosition) {
+                            q[0] = Geometry::QuantizeSnorm16((s[0] - mesh.positionOffset.x)/mesh.positionScale.x);
+                            q[1] = Geometry::QuantizeSnorm16((s[1] - mesh.positionOffset.y)/mesh.positionScale.y);
+                            q[2] = Geometry::QuantizeSnorm16((s[2] - mesh.positionOffset.z)/mesh.positionScale.z);
+                            q[3] = INT16_MAX;
+                        }
+                        else {
+                            for (uint32 c = 0; c < 4; c++)
+                                q[c] = c < numComponents ? Geometry::QuantizeSnorm16(s[c]) : 0;
+                        }
+                        break;
+                    }
+                    case GfxFormat::R16G16_SNORM:
+                        Geometry::EncodeOctahedral(Float3(s[0], s[1], s[2]), (int16*)d);
+                        break;
+                    case GfxFormat::R16G16_SFLOAT:
+                    case GfxFormat::R16G16B16A16_SFLOAT: {
+                        uint16* h = (uint16*)d;
+                        uint32 numDstComponents = dstAttr.format == GfxFormat::R16G16_SFLOAT ? 2 : 4;
+                        for (uint32 c = 0; c < numDstComponents; c++)
+                            h[c] = Geometry::QuantizeHalf(c < numComponents ? s[c] : 0);
+                        break;
+                    }
+                    default:
+                        ASSERT(dstAttr.format == srcAttr.format);
+                        memcpy(d, s, Geometry::GetVertexStride(srcAttr.format));
+                        break;
+                    }
+                }
+            }
+
+            for (uint32 b = 0; b < model->numVertexBuffers; b++) {
+                mesh.vertexBufferOffsets[b] = meshOffsets[b];
+                mesh.vertexBufferSizes[b] = uint64(dstLayout.vertexBufferStrides[b])*mesh.numVertices;
+            }
+        }
+
+        for (uint32 b = 0; b < model->numVertexBuffers; b++) {
+            cpuBuffers->vertexBuffers[b] = dstBuffers.vertexBuffers[b];
+            cpuBuffers->vertexBufferSizes[b] = dstBuffers.vertexBufferSizes[b];
+        }
+    }
+
     #if CONFIG_TOOLMODE
-    static void _Optimize(ModelData* model, GeometryCpuBuffers* cpuBuffers, const ModelLoadParams& modelParams)
+    // Returns the new model blob, because LOD/Meshlet data is appended to the model and it needs to be re-created
+    static Pair<ModelData*, uint32> _Optimize(ModelData* model, uint32 modelBufferSize, GeometryCpuBuffers* cpuBuffers, 
+                                              const ModelLoadParams& modelParams, MemBumpAllocatorBase* alloc)
     {
-        MemTempAllocator tmpAlloc;
-        MeshOptModel bakeModel;
-        bakeModel.meshes = tmpAlloc.MallocTyped<MeshOptMesh*>(model->numMeshes);
-        bakeModel.numMeshes = model->numMeshes;
+        MemThreadSafeAllocator outputAlloc(alloc);
+        MeshOptModel bakeModel {
+            .meshes = Mem::AllocTyped<MeshOptMesh*>(model->numMeshes, alloc),
+            .numMeshes = model->numMeshes,
+            .generateMeshlets = modelParams.generateMeshlets,
+            .numLods = Min(modelParams.numLods, MODEL_MAX_LODS),
+            .alloc = &outputAlloc
+        };
+
+        if (modelParams.lodReduction > 0)
+            bakeModel.lodReduction = modelParams.lodReduction;
 
         for (uint32 i = 0; i < model->numMeshes; i++) {
             ModelMesh& srcMesh = model->meshes[i];
@@ -144,7 +303,7 @@ namespace ModelUtil
             mallocMesh.AddMemberArray<uint32>(offsetof(MeshOptMesh, indexBuffer), srcMesh.numIndices);
             mallocMesh.AddMemberArray<uint32>(offsetof(MeshOptMesh, vertexStrides), model->numVertexBuffers);
             mallocMesh.AddMemberArray<MeshOptSubmesh>(offsetof(MeshOptMesh, submeshes), srcMesh.numSubmeshes);
-            MeshOptMesh* bakeMesh = mallocMesh.Calloc(&tmpAlloc);
+            MeshOptMesh* bakeMesh = mallocMesh.Calloc(alloc);
 
             for (uint32 k = 0; k < model->numVertexBuffers; k++) {
                 bakeMesh->vertexBuffers[k] = cpuBuffers->vertexBuffers[k] + srcMesh.vertexBufferOffsets[k];
@@ -182,10 +341,82 @@ namespace ModelUtil
 
         MeshOpt::Optimize(&bakeModel);
 
+        uint32 numLodIndices = 0;
         for (uint32 i = 0; i < model->numMeshes; i++) {
             ModelMesh& srcMesh = model->meshes[i];
             srcMesh.numVertices = bakeModel.meshes[i]->numVertices;
+            numLodIndices += bakeModel.meshes[i]->numLodIndices;
+        }
+
+        if (!bakeModel.numLods && !bakeModel.generateMeshlets)
+            return Pair<ModelData*, uint32>(model, modelBufferSize);
+
+        // LOD indices are appended to each mesh's indices, so we have to re-create the index buffer
+        if (numLodIndices) {
+            uint64 indexBufferSize = 0;
+            for (uint32 i = 0; i < model->numMeshes; i++) {
+                const MeshOptMesh* bakeMesh = bakeModel.meshes[i];
+                indexBufferSize += sizeof(uint32)*(bakeMesh->numIndices + bakeMesh->numLodIndices);
+                indexBufferSize = AlignValue<uint64>(indexBufferSize, 16ull);
+            }
+
+            uint8* indexBuffer = (uint8*)alloc->Malloc(indexBufferSize);
+            uint64 indexBufferOffset = 0;
+            for (uint32 i = 0; i < model->numMeshes; i++) {
+                ModelMesh& mesh = model->meshes[i];
+                const MeshOptMesh* bakeMesh = bakeModel.meshes[i];
+
+                uint32* indices = (uint32*)(indexBuffer + indexBufferOffset);
+                memcpy(indices, cpuBuffers->indexBuffer + mesh.indexBufferOffset, sizeof(uint32)*mesh.numIndices);
+                if (bakeMesh->numLodIndices)
+                    memcpy(indices + mesh.numIndices, bakeMesh->lodIndexBuffer, sizeof(uint32)*bakeMesh->numLodIndices);
+
+                mesh.indexBufferOffset = indexBufferOffset;
+                mesh.indexBufferSize = sizeof(uint32)*(mesh.numIndices + bakeMesh->numLodIndices);
+                indexBufferOffset = AlignValue<uint64>(indexBufferOffset + mesh.indexBufferSize, 16ull);
+            }
+
+            cpuBuffers->indexBuffer = indexBuffer;
+            cpuBuffers->indexBufferSize = indexBufferSize;
+        }
+
+        // Copy the model blob and append meshlets data to the end of it. RelativePtrs stay valid with raw copies
+        ModelData* newModel = Mem::AllocCopyRawBytes<ModelData>(model, modelBufferSize, alloc);
+        for (uint32 i = 0; i < newModel->numMeshes; i++) {
+            ModelMesh& mesh = newModel->meshes[i];
+            const MeshOptMesh* bakeMesh = bakeModel.meshes[i];
+
+            for (uint32 k = 0; k < mesh.numSubmeshes; k++) {
+                ModelSubmesh& submesh = mesh.submeshes[k];
+                const MeshOptSubmesh& bakeSubmesh = bakeMesh->submeshes[k];
+
+                submesh.numLods = bakeSubmesh.numLods;
+                for (uint32 l = 0; l < bakeSubmesh.numLods; l++) {
+                    submesh.lods[l] = {
+                        .startIndex = mesh.numIndices + bakeSubmesh.lods[l].startIndex,
+                        .numIndices = bakeSubmesh.lods[l].numIndices,
+                        .error = bakeSubmesh.lods[l].error
+                    };
+                }
+
+                submesh.meshletStart = bakeSubmesh.meshletStart;
+                submesh.numMeshlets = bakeSubmesh.numMeshlets;
+            }
+
+            if (bakeMesh->numMeshlets) {
+                static_assert(sizeof(ModelMeshlet) == sizeof(MeshOptMeshlet));
+                mesh.numMeshlets = bakeMesh->numMeshlets;
+                mesh.numMeshletVertices = bakeMesh->numMeshletVertices;
+                mesh.numMeshletTriangles = bakeMesh->numMeshletTriangles;
+                mesh.meshlets = (ModelMeshlet*)Mem::AllocCopy<MeshOptMeshlet>(bakeMesh->meshlets, bakeMesh->numMeshlets, alloc);
+                mesh.meshletVertices = Mem::AllocCopy<uint32>(bakeMesh->meshletVertices, bakeMesh->numMeshletVertices, alloc);
+                mesh.meshletTriangles = Mem::AllocCopy<uint8>(bakeMesh->meshletTriangles, bakeMesh->numMeshletTriangles, alloc);
+            }
         }
+
+        size_t newModelBufferSize = alloc->GetOffset() - alloc->GetPointerOffset(newModel);
+        ASSERT(newModelBufferSize <= UINT32_MAX);
+        return Pair<ModelData*, uint32>(newModel, uint32(newModelBufferSize));
     }
     #endif // CONFIG_TOOLMODE
 
@@ -492,7 +723,7 @@ namespace GLTF
             ModelUtil::_CalculateTangents(mesh, cpuBuffers, vertexLayout);
     }
 
-    static Pair<ModelData*, uint32> _Load(Blob& fileBlob, const Path& fileDir, MemTempAllocator* tmpAlloc, const ModelLoadParams& params, 
+    static Pair<ModelData*, uint32> _Load(Blob& fileBlob, const Path& fileDir, MemBumpAllocatorBase* alloc, const ModelLoadParams& params, 
                                       String<256>* outErrorDesc, GeometryCpuBuffers* outCpuBuffers)
     {
         const GeometryVertexLayout& layout = params.layout;
@@ -502,12 +733,12 @@ namespace GLTF
             .type = cgltf_file_type_invalid,
             .memory = {
                 .alloc_func = [](void* user, cgltf_size size)->void* { 
-                    return reinterpret_cast<MemTempAllocator*>(user)->Malloc(size); 
+                    return reinterpret_cast<MemAllocator*>(user)->Malloc(size); 
                 },
                 .free_func = [](void* user, void* ptr) { 
-                    reinterpret_cast<MemTempAllocator*>(user)->Free(ptr);
+                    reinterpret_cast<MemAllocator*>(user)->Free(ptr);
                 },
-                .user_data = tmpAlloc
+                .user_data = alloc
             },
             .file = {
                 .read = [](const cgltf_memory_options*, const cgltf_file_options* fileOpts, 
@@ -532,16 +763,24 @@ namespace GLTF
         }
 
         // Load Data buffers
+        // Buffers are mapped instead of copied into the allocator, because they are only read once while converting the
+        // vertex/index data below. They are unmapped right before returning
         ASSERT_ALWAYS(data->buffers_count, "Model does not contain any data buffers");
-        for (uint32 i = 0; i < (uint32)data->buffers_count; i++) {
+        uint32 numBuffers = (uint32)data->buffers_count;
+        Blob* bufferBlobs = Mem::AllocTyped<Blob>(numBuffers, alloc);
+        for (uint32 i = 0; i < numBuffers; i++) {
+            PLACEMENT_NEW(&bufferBlobs[i], Blob);
             Path bufferFilepath = Path::JoinUnix(fileDir, data->buffers[i].uri);
-            Blob bufferBlob = Vfs::ReadFile(bufferFilepath.CStr(), VfsFlags::None, tmpAlloc);
-            if (!bufferBlob.IsValid()) {
+            bufferBlobs[i] = Vfs::ReadFile(bufferFilepath.CStr(), VfsFlags::Mapped, alloc);
+            if (!bufferBlobs[i].IsValid()) {
                 outErrorDesc->FormatSelf("Load model buffer failed: %s", bufferFilepath.CStr());
+                for (uint32 k = 0; k < i; k++)
+                    bufferBlobs[k].Free();
                 return {};
             }
-            bufferBlob.Detach(&data->buffers[i].data, &data->buffers[i].size);
-            data->buffers[i].data_free_method = cgltf_data_free_method_memory_free;
+            data->buffers[i].data = const_cast<void*>(bufferBlobs[i].Data());
+            data->buffers[i].size = bufferBlobs[i].Size();
+            data->buffers[i].data_free_method = cgltf_data_free_method_none;
         }
 
         // Gather materials and remove duplicates by looking up data hash
@@ -554,8 +793,8 @@ namespace GLTF
         };
 
         uint32 numTotalTextures = 0;
-        Array<MaterialData> materials(tmpAlloc);
-        Array<uint32> materialsMap(tmpAlloc);     // count = NumMeshes*NumSubmeshPerMesh: maps each gltf material index to materials array
+        Array<MaterialData> materials(alloc);
+        Array<uint32> materialsMap(alloc);     // count = NumMeshes*NumSubmeshPerMesh: maps each gltf material index to materials array
 
         for (uint32 i = 0; i < uint32(data->meshes_count); i++) {
             cgltf_mesh* mesh = &data->meshes[i];
@@ -565,7 +804,7 @@ namespace GLTF
                 if (prim->material) {
                     uint32 hash;
                     uint32 numTextures;
-                    ModelMaterial* mtl = GLTF::_CreateMaterial(&numTextures, &hash, prim->material, fileDir.CStr(), tmpAlloc);
+                    ModelMaterial* mtl = GLTF::_CreateMaterial(&numTextures, &hash, prim->material, fileDir.CStr(), alloc);
 
                     numTotalTextures += numTextures;
 
@@ -574,7 +813,7 @@ namespace GLTF
                         index = materials.Count();
                         MaterialData mtlData { 
                             .mtl = mtl, 
-                            .size = uint32(tmpAlloc->GetOffset() - tmpAlloc->GetPointerOffset(mtl)), 
+                            .size = uint32(alloc->GetOffset() - alloc->GetPointerOffset(mtl)), 
                             .id = IndexToId(index),
                             .hash = hash
                         };
@@ -588,7 +827,7 @@ namespace GLTF
         }
 
         // Start creating the model. This is where the blob data starts
-        ModelData* model = tmpAlloc->MallocZeroTyped<ModelData>();
+        ModelData* model = Mem::AllocZeroTyped<ModelData>(1, alloc);
         model->rootTransform = ModelTransform();
         model->layout = layout;
         model->numMaterialTextures = numTotalTextures;
@@ -602,7 +841,7 @@ namespace GLTF
         }
 
         // Meshes
-        model->meshes = tmpAlloc->MallocZeroTyped<ModelMesh>((uint32)data->meshes_count);
+        model->meshes = Mem::AllocZeroTyped<ModelMesh>((uint32)data->meshes_count, alloc);
         model->numMeshes = (uint32)data->meshes_count;
         uint32 mtlIndex = 0;
 
@@ -613,11 +852,12 @@ namespace GLTF
             if (mesh->name == nullptr) {
                 char name[32];
                 Str::PrintFmt(name, sizeof(name), "Mesh_%u", i);
-                mesh->name = Mem::AllocCopy<char>(name, Str::Len(name)+1, tmpAlloc);
+                mesh->name = Mem::AllocCopy<char>(name, Str::Len(name)+1, alloc);
             }
 
             dstMesh->name = mesh->name;
-            dstMesh->submeshes = tmpAlloc->MallocZeroTyped<ModelSubmesh>(uint32(mesh->primitives_count));
+            dstMesh->positionScale = Float3(1.0f, 1.0f, 1.0f);
+            dstMesh->submeshes = Mem::AllocZeroTyped<ModelSubmesh>(uint32(mesh->primitives_count), alloc);
             dstMesh->numSubmeshes = uint32(mesh->primitives_count);
 
             // NumVertices/Indices/MaterialsIds
@@ -649,15 +889,15 @@ namespace GLTF
         // Construct materials (from previously created array)
         if (materials.Count()) {
             model->numMaterials = materials.Count();
-            model->materials = tmpAlloc->MallocZeroTyped<RelativePtr<ModelMaterial>>(materials.Count());
+            model->materials = Mem::AllocZeroTyped<RelativePtr<ModelMaterial>>(materials.Count(), alloc);
             for (uint32 i = 0; i < materials.Count(); i++) {
                 const MaterialData& m = materials[i];
-                model->materials[i] = Mem::AllocCopyRawBytes<ModelMaterial>(m.mtl, m.size, tmpAlloc);
+                model->materials[i] = Mem::AllocCopyRawBytes<ModelMaterial>(m.mtl, m.size, alloc);
             }
         }
 
         // Nodes
-        model->nodes = tmpAlloc->MallocZeroTyped<ModelNode>((uint32)data->nodes_count);
+        model->nodes = Mem::AllocZeroTyped<ModelNode>((uint32)data->nodes_count, alloc);
         model->numNodes = (uint32)data->nodes_count;
 
         for (uint32 i = 0; i < (uint32)data->nodes_count; i++) {
@@ -668,7 +908,7 @@ namespace GLTF
             if (srcNode->name == nullptr) {
                 char name[32];
                 Str::PrintFmt(name, sizeof(name), "Node_%u", i);
-                srcNode->name = Mem::AllocCopy<char>(name, sizeof(name), tmpAlloc);
+                srcNode->name = Mem::AllocCopy<char>(name, sizeof(name), alloc);
             }
 
             dstNode->localTransform = ModelTransform();
@@ -714,14 +954,14 @@ namespace GLTF
 
             if (srcNode->children_count) {
                 dstNode->numChilds = (uint32)srcNode->children_count;
-                dstNode->childIds = tmpAlloc->MallocZeroTyped<uint32>((uint32)srcNode->children_count);
+                dstNode->childIds = Mem::AllocZeroTyped<uint32>((uint32)srcNode->children_count, alloc);
                 for (uint32 ci = 0; ci < (uint32)srcNode->children_count; ci++)
                     dstNode->childIds[ci] = FindNodeByName(srcNode->children[ci]->name);
             }
         }
 
         // Allocate one big chunk and copy the temp data over to it
-        size_t modelBufferSize = tmpAlloc->GetOffset() - tmpAlloc->GetPointerOffset(model);
+        size_t modelBufferSize = alloc->GetOffset() - alloc->GetPointerOffset(model);
         ASSERT(modelBufferSize <= UINT32_MAX);
 
         // Buffers
@@ -748,8 +988,8 @@ namespace GLTF
         }
 
         for (uint32 vertexBufferIdx = 0; vertexBufferIdx < model->numVertexBuffers; vertexBufferIdx++)
-            cpuBuffers->vertexBuffers[vertexBufferIdx] = (uint8*)tmpAlloc->Malloc(cpuBuffers->vertexBufferSizes[vertexBufferIdx]);
-        cpuBuffers->indexBuffer = (uint8*)tmpAlloc->Malloc(cpuBuffers->indexBufferSize);
+            cpuBuffers->vertexBuffers[vertexBufferIdx] = (uint8*)alloc->Malloc(cpuBuffers->vertexBufferSizes[vertexBufferIdx]);
+        cpuBuffers->indexBuffer = (uint8*)alloc->Malloc(cpuBuffers->indexBufferSize);
 
         for (uint32 i = 0; i < (uint32)data->meshes_count; i++) {
             cgltf_mesh* mesh = &data->meshes[i];
@@ -776,6 +1016,9 @@ namespace GLTF
             dstNode->bounds = bounds;
         }
 
+        for (uint32 i = 0; i < numBuffers; i++)
+            bufferBlobs[i].Free();
+
         return Pair<ModelData*, uint32>(model, (uint32)modelBufferSize);
     }
 
@@ -812,22 +1055,50 @@ bool AssetModelImpl::Bake(const AssetParams& params, AssetData* data, const Span
 {
     const ModelLoadParams* modelParams = (const ModelLoadParams*)params.extraParams;
 
-    MemTempAllocator tmpAlloc;
+    // We cannot use temp allocators here, because MeshOpt dispatches jobs and waits on them. 
+    // So this task might continue on a different thread
+    MemBumpAllocatorVM bakeAlloc;
+    bakeAlloc.Initialize(MODEL_BAKE_MAX_MEMORY_SIZE, SIZE_MB);
+
     Blob fileBlob(const_cast<uint8*>(srcData.Ptr()), srcData.Count());
     fileBlob.SetSize(srcData.Count());
 
+    // Loading and optimization works on full-precision vertices. Quantization happens at the end if requested by the layout
+    ModelLoadParams loadParams = *modelParams;
+    bool quantize = ModelUtil::_MakeFloatLayout(modelParams->layout, &loadParams.layout);
+
     Path fileDir = params.path.GetDirectory();
     GeometryCpuBuffers cpuBuffers {};
-    Pair<ModelData*, uint32> modelResult = GLTF::_Load(fileBlob, fileDir, &tmpAlloc, *modelParams, outErrorDesc, &cpuBuffers);
-    ModelData* model = modelResult.first;
-    uint32 modelBufferSize = modelResult.second;
-    if (!model)
+    Pair<ModelData*, uint32> modelResult = GLTF::_Load(fileBlob, fileDir, &bakeAlloc, loadParams, outErrorDesc, &cpuBuffers);
+    if (!modelResult.first) {
+        bakeAlloc.Release();
         return false;
+    }
 
     #if CONFIG_TOOLMODE
-    ModelUtil::_Optimize(model, &cpuBuffers, *modelParams);
+    modelResult = ModelUtil::_Optimize(modelResult.first, modelResult.second, &cpuBuffers, loadParams, &bakeAlloc);
     #endif // CONFIG_TOOLMODE
 
+    ModelData* model = modelResult.first;
+    uint32 modelBufferSize = modelResult.second;
+
+    if (quantize) {
+        uint64 srcVertexBytes = 0;
+        uint64 dstVertexBytes = 0;
+        for (uint32 i = 0; i < model->numVertexBuffers; i++)
+            srcVertexBytes += cpuBuffers.vertexBufferSizes[i];
+
+        TimerStopWatch stopwatch;
+        ModelUtil::_QuantizeVertices(model, &cpuBuffers, loadParams.layout, modelParams->layout, &bakeAlloc);
+        model->layout = modelParams->layout;
+
+        for (uint32 i = 0; i < model->numVertexBuffers; i++)
+            dstVertexBytes += cpuBuffers.vertexBufferSizes[i];
+        LOG_VERBOSE("Model %s: Quantized vertices %llu -> %llu bytes (%.1f%%) in %.1f ms", params.path.CStr(), 
+                    srcVertexBytes, dstVertexBytes, 100.0*double(dstVertexBytes)/double(Max<uint64>(srcVertexBytes, 1)), 
+                    stopwatch.ElapsedMS());
+    }
+
     data->SetObjData(model, modelBufferSize);
 
     // Dependencies (Textures)
@@ -890,6 +1161,7 @@ bool AssetModelImpl::Bake(const AssetParams& params, AssetData* data, const Span
         data->AddGpuBufferObject(&model->indexBuffer, desc, cpuBuffers.indexBuffer);
     }
 
+    bakeAlloc.Release();
     return true;
 }
 
@@ -911,3 +1183,147 @@ AssetHandleModel Model::Load(const char* path, const ModelLoadParams& params, co
 
     return group.AddToLoadQueue(assetParams);
 }
+
+ModelSubmeshLod Model::SelectLod(const ModelSubmesh& submesh, float distance, float projScale, float maxPixelError)
+{
+    ModelSubmeshLod lod {
+        .startIndex = submesh.startIndex,
+        .numIndices = submesh.numIndices,
+        .error = 0
+    };
+
+    distance = Max(distance, 0.0001f);
+    for (uint32 i = 0; i < submesh.numLods; i++) {
+        if (submesh.lods[i].error*projScale/distance > maxPixelError)
+            break;
+        lod = submesh.lods[i];
+    }
+
+    return lod;
+}
+
+Float3 Model::DequantizePosition(const ModelMesh& mesh, const int16 quantized[4])
+{
+    Float3 pos(Max(float(quantized[0])/32767.0f, -1.0f), 
+               Max(float(quantized[1])/32767.0f, -1.0f), 
+               Max(float(quantized[2])/32767.0f, -1.0f));
+    return Float3(mesh.positionOffset.x + mesh.positionScale.x*pos.x,
+                  mesh.positionOffset.y + mesh.positionScale.y*pos.y,
+                  mesh.positionOffset.z + mesh.positionScale.z*pos.z);
+}
+
+Float3 Model::DecodeOctahedral(const int16 encoded[2])
+{
+    float x = Max(float(encoded[0])/32767.0f, -1.0f);
+    float y = Max(float(encoded[1])/32767.0f, -1.0f);
+    float z = 1.0f - M::Abs(x) - M::Abs(y);
+    if (z < 0) {
+        float ox = x;
+        x = (1.0f - M::Abs(y))*M::Sign(ox);
+        y = (1.0f - M::Abs(ox))*M::Sign(y);
+    }
+    return M::Float3Norm(Float3(x, y, z));
+}
+
+bool Model::RunQuantizeBenchmark(const char* filepath, const GeometryVertexLayout& layout, ModelQuantizeBenchmarkResult* outResult)
+{
+    *outResult = {};
+
+    ModelLoadParams loadParams { .layout = layout };
+    if (!ModelUtil::_MakeFloatLayout(layout, &loadParams.layout)) {
+        LOG_ERROR("Vertex layout doesn't have any quantized attributes");
+        return false;
+    }
+
+    MemBumpAllocatorVM alloc;
+    alloc.Initialize(MODEL_BAKE_MAX_MEMORY_SIZE, SIZE_MB);
+
+    Blob fileBlob = Vfs::ReadFile(filepath, VfsFlags::None, &alloc);
+    if (!fileBlob.IsValid()) {
+        LOG_ERROR("Opening model '%s' failed", filepath);
+        alloc.Release();
+        return false;
+    }
+
+    String<256> errorDesc;
+    GeometryCpuBuffers cpuBuffers {};
+    Path fileDir = Path(filepath).GetDirectory();
+    ModelData* model = GLTF::_Load(fileBlob, fileDir, &alloc, loadParams, &errorDesc, &cpuBuffers).first;
+    if (!model) {
+        LOG_ERROR("Loading model '%s' failed: %s", filepath, errorDesc.CStr());
+        alloc.Release();
+        return false;
+    }
+
+    // Keep the full-precision buffers around for measuring the error. _QuantizeVertices doesn't free them
+    GeometryCpuBuffers srcBuffers = cpuBuffers;
+    uint64* srcOffsets = Mem::AllocTyped<uint64>(model->numMeshes*GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER, &alloc);
+    for (uint32 i = 0; i < model->numMeshes; i++) {
+        memcpy(&srcOffsets[i*GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER], model->meshes[i].vertexBufferOffsets, 
+               sizeof(uint64)*GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER);
+        outResult->numVertices += model->meshes[i].numVertices;
+    }
+    outResult->numMeshes = model->numMeshes;
+
+    for (uint32 i = 0; i < model->numVertexBuffers; i++)
+        outResult->floatVertexBytes += cpuBuffers.vertexBufferSizes[i];
+
+    TimerStopWatch quantizeStopWatch;
+    ModelUtil::_QuantizeVertices(model, &cpuBuffers, loadParams.layout, layout, &alloc);
+    outResult->quantizeMS = quantizeStopWatch.ElapsedMS();
+
+    for (uint32 i = 0; i < model->numVertexBuffers; i++)
+        outResult->quantizedVertexBytes += cpuBuffers.vertexBufferSizes[i];
+
+    const GfxVertexInputAttributeDesc* posAttr = layout.FindAttribute("POSITION", 0);
+    const GfxVertexInputAttributeDesc* normalAttr = layout.FindAttribute("NORMAL", 0);
+    bool decodePositions = posAttr && posAttr->format == GfxFormat::R16G16B16A16_SNORM;
+    bool decodeNormals = normalAttr && normalAttr->format == GfxFormat::R16G16_SNORM;
+
+    for (uint32 i = 0; i < model->numMeshes; i++) {
+        const ModelMesh& mesh = model->meshes[i];
+        Float3* positions = Mem::AllocTyped<Float3>(mesh.numVertices, &alloc);
+        Float3* normals = Mem::AllocTyped<Float3>(mesh.numVertices, &alloc);
+
+        uint64 dstOffsets[GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER];
+        memcpy(dstOffsets, mesh.vertexBufferOffsets, sizeof(dstOffsets));
+        uint32 posStride = 0, normalStride = 0;
+        const uint8* posPtr = decodePositions ? layout.GetVertexAttributePointer(dstOffsets, cpuBuffers, "POSITION", 0, posStride) : nullptr;
+        const uint8* normalPtr = decodeNormals ? layout.GetVertexAttributePointer(dstOffsets, cpuBuffers, "NORMAL", 0, normalStride) : nullptr;
+
+        TimerStopWatch decodeStopWatch;
+        if (posPtr) {
+            for (uint32 v = 0; v < mesh.numVertices; v++)
+                positions[v] = DequantizePosition(mesh, (const int16*)(posPtr + posStride*v));
+        }
+        if (normalPtr) {
+            for (uint32 v = 0; v < mesh.numVertices; v++)
+                normals[v] = DecodeOctahedral((const int16*)(normalPtr + normalStride*v));
+        }
+        outResult->decodeMS += decodeStopWatch.ElapsedMS();
+
+        uint64* meshSrcOffsets = &srcOffsets[i*GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER];
+        if (posPtr) {
+            const uint8* srcPtr = loadParams.layout.GetVertexAttributePointer(meshSrcOffsets, srcBuffers, "POSITION", 0, posStride);
+            for (uint32 v = 0; v < mesh.numVertices; v++) {
+                float err = Float3::Len(positions[v] - *((const Float3*)(srcPtr + posStride*v)));
+                outResult->maxPositionError = Max(outResult->maxPositionError, err);
+            }
+        }
+
+        if (normalPtr) {
+            const uint8* srcPtr = loadParams.layout.GetVertexAttributePointer(meshSrcOffsets, srcBuffers, "NORMAL", 0, normalStride);
+            for (uint32 v = 0; v < mesh.numVertices; v++) {
+                Float3 srcNormal = *((const Float3*)(srcPtr + normalStride*v));
+                float len = Float3::Len(srcNormal);
+                if (len < M_FLOAT32_EPSILON)
+                    continue;
+                float cosAngle = Clamp(Float3::Dot(normals[v], srcNormal) / len, -1.0f, 1.0f);
+                outResult->maxNormalErrorDeg = Max(outResult->maxNormalErrorDeg, M::ToDeg(M::ACos(cosAngle)));
+            }
+        }
+    }
+
+    alloc.Release();
+    return true;
+}
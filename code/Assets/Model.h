@@ -98,11 +98,37 @@ struct ModelMaterial
     bool unlit;
 };
 
+inline constexpr uint32 MODEL_MAX_LODS = 4;
+
+struct ModelSubmeshLod
+{
+    uint32 startIndex;      // Relative to the mesh index buffer, same as ModelSubmesh::startIndex
+    uint32 numIndices;
+    float error;            // Absolute simplification error in mesh space units
+};
+
+// Meshlets are generated from the base LOD of each submesh
+struct ModelMeshlet
+{
+    Float3 center;          // Bounding sphere
+    float radius;
+    Float3 coneAxis;        // Backface culling cone
+    float coneCutoff;
+    uint32 vertexOffset;    // Index into ModelMesh::meshletVertices
+    uint32 triangleOffset;  // Index into ModelMesh::meshletTriangles
+    uint32 numVertices;
+    uint32 numTriangles;
+};
+
 struct ModelSubmesh 
 {
     uint32 startIndex;
     uint32 numIndices;
     uint32 materialId;
+    uint32 numLods;                             // Number of simplified LODs, excluding the base level
+    ModelSubmeshLod lods[MODEL_MAX_LODS];
+    uint32 meshletStart;                        // Index into ModelMesh::meshlets
+    uint32 numMeshlets;
 };
 
 struct ModelMesh 
@@ -116,6 +142,18 @@ struct ModelMesh
     uint64 indexBufferSize;
     uint64 indexBufferOffset;
     RelativePtr<ModelSubmesh> submeshes;
+
+    // Dequantization of 16bit normalized positions: Position = positionOffset + positionScale*Position_SNORM
+    // Only applies if POSITION format in the vertex layout is R16G16B16A16_SNORM. Otherwise offset=0, scale=1
+    Float3 positionOffset;
+    Float3 positionScale;
+
+    uint32 numMeshlets;
+    uint32 numMeshletVertices;
+    uint32 numMeshletTriangles;                 // Size of meshletTriangles array in bytes
+    RelativePtr<ModelMeshlet> meshlets;
+    RelativePtr<uint32> meshletVertices;        // Indices to mesh vertices
+    RelativePtr<uint8> meshletTriangles;        // Three local indices (into meshlet vertices) per triangle
 };
 
 struct ModelTransform
@@ -155,10 +193,30 @@ struct ModelData
     GfxBufferHandle indexBuffer;
 };
 
+struct ModelQuantizeBenchmarkResult
+{
+    uint32 numMeshes;
+    uint32 numVertices;
+    uint64 floatVertexBytes;        // Vertex data size with the full-precision version of the layout
+    uint64 quantizedVertexBytes;
+    double quantizeMS;
+    double decodeMS;                // CPU decode of all positions and normals (DequantizePosition/DecodeOctahedral)
+    float maxPositionError;         // In mesh space units
+    float maxNormalErrorDeg;
+};
+
 // provide this for loading "Model" asset
+// Vertex attributes are quantized at bake time if the layout requests these formats:
+//  - POSITION: R16G16B16A16_SNORM, normalized to mesh bounds (see ModelMesh::positionOffset/positionScale)
+//  - NORMAL/TANGENT/BINORMAL: R16G16_SNORM (octahedral encoded, tangent handedness is dropped) or R16G16B16A16_SNORM
+//  - TEXCOORD/COLOR: R16G16_SFLOAT or R16G16B16A16_SFLOAT
 struct ModelLoadParams 
 {
     GeometryVertexLayout layout;
+    uint32 numLods;             // Number of simplified LODs to generate for each submesh (Max: MODEL_MAX_LODS)
+    float lodReduction;         // Ratio of index count of each LOD to the previous one. Default (=0): 0.5
+    bool generateMeshlets;
+    uint8 _padding[3];          // Structure should have no holes because we are hashing it for asset-manager
 };
 
 namespace Model
@@ -168,4 +226,17 @@ namespace Model
 
     // DataType: AssetObjPtrScope<ModelData>
     API AssetHandleModel Load(const char* path, const ModelLoadParams& params, const AssetGroup& group);
+
+    // Picks the coarsest LOD that its projected error is less than `maxPixelError` 
+    // `projScale`: ViewportHeight / (2*tan(FovY/2)) for perspective projection
+    // Returns the base level if submesh doesn't have any LODs
+    API ModelSubmeshLod SelectLod(const ModelSubmesh& submesh, float distance, float projScale, float maxPixelError = 1.0f);
+
+    // Decoding of quantized vertex attributes on CPU. Shaders should do the same math on their inputs
+    API Float3 DequantizePosition(const ModelMesh& mesh, const int16 quantized[4]);
+    API Float3 DecodeOctahedral(const int16 encoded[2]);
+
+    // Loads a gltf model with the full-precision and quantized versions of `layout`, then decodes the quantized positions 
+    // and normals on CPU. `layout` should have quantized POSITION and/or NORMAL attributes (see ModelLoadParams)
+    API bool RunQuantizeBenchmark(const char* filepath, const GeometryVertexLayout& layout, ModelQuantizeBenchmarkResult* outResult);
 }
@@ -7,6 +7,7 @@
 #include "../Common/JunkyardSettings.h"
 
 #include "../Tool/ShaderCompiler.h"
+#include "../Tool/Console.h"
 
 #include "../Graphics/GfxBackend.h"
 
@@ -47,12 +48,34 @@ bool Shader::InitializeManager()
 
     Asset::RegisterType(shaderIncludeTypeDesc);
 
+    #if CONFIG_TOOLMODE
+    auto ShaderStatsFn = [](int, const char**, char* outResponse, uint32 responseSize, void*)->bool {
+        ShaderCompilerStats stats = ShaderCompiler::GetStats();
+        Str::PrintFmt(outResponse, responseSize, "Cache hits: %u (disk: %u), misses: %u, failed: %u, compile: %.1f ms, cache: %.1f ms",
+                      stats.numCacheHits, stats.numDiskCacheHits, stats.numCacheMisses, stats.numFailed, 
+                      stats.compileTimeMS, stats.cacheTimeMS);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "shader-stats",
+        .help = "Get shader compiler cache stats",
+        .callback = ShaderStatsFn
+    });
+    #endif
+
     return true;
 }
 
 void Shader::ReleaseManager()
 {
     #if CONFIG_TOOLMODE
+    ShaderCompilerStats stats = ShaderCompiler::GetStats();
+    if (stats.numCacheHits || stats.numCacheMisses) {
+        LOG_VERBOSE("Shader compiler: %u cache hits, %u misses, %.1f ms compiling", 
+                    stats.numCacheHits, stats.numCacheMisses, stats.compileTimeMS);
+    }
+    ShaderCompiler::ReleaseCache();
     ShaderCompiler::ReleaseLiveSessions();
     #endif
 
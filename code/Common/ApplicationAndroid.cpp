@@ -364,6 +364,8 @@ static void appAndroidCleanup()
 
         Remote::Release();
         Vfs::Release();
+        Log::ReleaseAsync();
+        Log::ReleaseBinarySink();
 
         gApp.cleanupCalled = true;
     }
@@ -725,6 +727,12 @@ bool App::Run(const AppDesc& desc)
     MemTempAllocator::EnableCallstackCapture(SettingsJunkyard::Get().debug.captureStacktraceForTempAllocator);
     Debug::SetCaptureStacktraceForFiberProtector(SettingsJunkyard::Get().debug.captureStacktraceForFiberProtector);
     Log::SetSettings(static_cast<LogLevel>(SettingsJunkyard::Get().engine.logLevel), SettingsJunkyard::Get().engine.breakOnErrors, SettingsJunkyard::Get().engine.treatWarningsAsErrors);
+    if (SettingsJunkyard::Get().engine.logAsync)
+        Log::InitializeAsync();
+    if (!SettingsJunkyard::Get().engine.logBinaryFilepath.IsEmpty() && SettingsJunkyard::Get().engine.logBinaryLevel != SettingsEngine::LogLevel::Default) {
+        Log::InitializeBinarySink(SettingsJunkyard::Get().engine.logBinaryFilepath.CStr(), static_cast<LogLevel>(SettingsJunkyard::Get().engine.logBinaryLevel),
+                                  uint64(SettingsJunkyard::Get().engine.logBinaryMaxFileSize)*SIZE_MB);
+    }
 
     // RemoteServices
     if (!Remote::Initialize()) {
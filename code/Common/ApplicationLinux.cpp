@@ -45,6 +45,7 @@ struct AppWindowState
     GLFWwindow* window;
     RectInt mainRect;
     bool windowModified;
+    bool quit;
     
     Float2 mousePos;
     InputMouseButton mouseButton;
@@ -477,6 +478,12 @@ bool App::Run(const AppDesc &desc)
     MemTempAllocator::EnableCallstackCapture(settings.debug.captureStacktraceForTempAllocator);
     Debug::SetCaptureStacktraceForFiberProtector(settings.debug.captureStacktraceForFiberProtector);
     Log::SetSettings(static_cast<LogLevel>(settings.engine.logLevel), SettingsJunkyard::Get().engine.breakOnErrors, SettingsJunkyard::Get().engine.treatWarningsAsErrors);
+    if (settings.engine.logAsync)
+        Log::InitializeAsync();
+    if (!settings.engine.logBinaryFilepath.IsEmpty() && settings.engine.logBinaryLevel != SettingsEngine::LogLevel::Default) {
+        Log::InitializeBinarySink(settings.engine.logBinaryFilepath.CStr(), static_cast<LogLevel>(settings.engine.logBinaryLevel),
+                                  uint64(settings.engine.logBinaryMaxFileSize)*SIZE_MB);
+    }
 
     if (desc.windowTitle)
         Str::Copy(gApp.windowTitle, sizeof(gApp.windowTitle), desc.windowTitle);
@@ -504,7 +511,7 @@ bool App::Run(const AppDesc &desc)
     }
 
     // Window creation
-    if (settings.graphics.IsGraphicsEnabled()) {
+    if (settings.graphics.IsWindowEnabled()) {
         glfwWindowHint(GLFW_SCALE_TO_MONITOR, GLFW_TRUE);
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
         _LoadInitRects();
@@ -584,11 +591,26 @@ bool App::Run(const AppDesc &desc)
             tmPrev = tmNow;
         }
     }
+    else if (settings.graphics.nullBackend) {
+        // Null graphics backend: No window and no events, just keep updating until App::Quit is called
+        while (!gApp.quit) {
+            tmNow = Timer::GetTicks();
+            float dt = float(Timer::ToSec(tmNow - tmPrev));
+            if (!gApp.overrideUpdateCallback.first)
+                desc.callbacks->Update(dt);
+            else
+                gApp.overrideUpdateCallback.first(dt, gApp.overrideUpdateCallback.second);
+
+            tmPrev = tmNow;
+        }
+    }
 
     gApp.desc.callbacks->Cleanup();
 
     Remote::Release();
     Vfs::Release();
+    Log::ReleaseAsync();
+    Log::ReleaseBinarySink();
 
     if (gApp.window) {
         _SaveInitRects();
@@ -610,6 +632,13 @@ void* App::GetNativeWindowHandle()
     return gApp.window;
 }
 
+void App::Quit()
+{
+    gApp.quit = true;
+    if (gApp.window)
+        glfwSetWindowShouldClose(gApp.window, GLFW_TRUE);
+}
+
 void* App::GetNativeAppHandle()
 {
     return IntToPtr(getpid());
@@ -714,7 +743,10 @@ void App::OverrideUpdateCallback(AppUpdateOverrideCallback callback, void* userD
 
 void App::SetCursor(AppMouseCursor cursor)
 {
-    ASSERT(gApp.window);
+    // Windowless apps (null graphics backend) still run ImGui, which sets the cursor every frame
+    if (!gApp.window)
+        return;
+
     if (cursor != AppMouseCursor::None)
         glfwSetCursor(gApp.window, gApp.cursors[uint32(cursor)]);
 }
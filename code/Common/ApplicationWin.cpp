@@ -860,6 +860,12 @@ namespace App
         MemTempAllocator::EnableCallstackCapture(settings.debug.captureStacktraceForTempAllocator);
         Debug::SetCaptureStacktraceForFiberProtector(settings.debug.captureStacktraceForFiberProtector);
         Log::SetSettings(static_cast<LogLevel>(settings.engine.logLevel), SettingsJunkyard::Get().engine.breakOnErrors, SettingsJunkyard::Get().engine.treatWarningsAsErrors);
+        if (settings.engine.logAsync)
+            Log::InitializeAsync();
+        if (!settings.engine.logBinaryFilepath.IsEmpty() && settings.engine.logBinaryLevel != SettingsEngine::LogLevel::Default) {
+            Log::InitializeBinarySink(settings.engine.logBinaryFilepath.CStr(), static_cast<LogLevel>(settings.engine.logBinaryLevel),
+                                      uint64(settings.engine.logBinaryMaxFileSize)*SIZE_MB);
+        }
 
         if (desc.windowTitle)
             Str::Copy(gApp.windowTitle, sizeof(gApp.windowTitle), desc.windowTitle);
@@ -882,7 +888,7 @@ namespace App
         _LoadInitRects();  // may modify window/framebuffer dimensions 
         _InitKeyTable();
 
-        if (settings.graphics.IsGraphicsEnabled()) {
+        if (settings.graphics.IsWindowEnabled()) {
             _InitDPI();
             if (!_CreateMainWindow()) {
                 ASSERT_MSG(0, "Creating win32 window failed");
@@ -911,7 +917,7 @@ namespace App
         uint64 tmPrev = tmNow;
         bool quit = false;
         while (!quit && !gApp.quitFromConsole) {
-            if (settings.graphics.IsGraphicsEnabled()) {
+            if (settings.graphics.IsWindowEnabled()) {
                 MSG msg;
 
                 // Block when window is minimized
@@ -971,8 +977,10 @@ namespace App
 
         Remote::Release();
         Vfs::Release();
+        Log::ReleaseAsync();
+        Log::ReleaseBinarySink();
     
-        if (settings.graphics.IsGraphicsEnabled()) {
+        if (settings.graphics.IsWindowEnabled()) {
             DestroyWindow(gApp.hwnd);
 
             wchar_t className[128];
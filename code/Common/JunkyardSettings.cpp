@@ -79,10 +79,30 @@ bool SettingsJunkyardParser::ParseSetting(uint32 categoryId, const char* key, co
             engine->remoteServicesUrl = value;
             return true;
         }
+        else if (Str::IsEqualNoCase(key, "remoteServicesCompress")) {
+            engine->remoteServicesCompress = Str::ToBool(value);
+            return true;
+        }
         else if (Str::IsEqualNoCase(key, "logLevel")) {
             engine->logLevel = settingsParseEngineLogLevel(value);
             return true;
         }
+        else if (Str::IsEqualNoCase(key, "logAsync")) {
+            engine->logAsync = Str::ToBool(value);
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "logBinaryFilepath")) {
+            engine->logBinaryFilepath = value;
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "logBinaryLevel")) {
+            engine->logBinaryLevel = settingsParseEngineLogLevel(value);
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "logBinaryMaxFileSize")) {
+            engine->logBinaryMaxFileSize = Str::ToUint(value);
+            return true;
+        }
         else if (Str::IsEqualNoCase(key, "jobsNumShortTaskThreads")) {
             engine->jobsNumShortTaskThreads = Str::ToUint(value);
             return true;
@@ -91,6 +111,18 @@ bool SettingsJunkyardParser::ParseSetting(uint32 categoryId, const char* key, co
             engine->jobsNumLongTaskThreads = Str::ToUint(value);
             return true;
         }
+        else if (Str::IsEqualNoCase(key, "jobsPinThreads")) {
+            engine->jobsPinThreads = Str::ToBool(value);
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "jobsPinAvoidSmtSiblings")) {
+            engine->jobsPinAvoidSmtSiblings = Str::ToBool(value);
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "jobsPinReserveMainThreadCore")) {
+            engine->jobsPinReserveMainThreadCore = Str::ToBool(value);
+            return true;
+        }
         else if (Str::IsEqualNoCase(key, "debugAllocations")) {
             engine->debugAllocations = Str::ToBool(value);
             return true;
@@ -115,6 +147,14 @@ bool SettingsJunkyardParser::ParseSetting(uint32 categoryId, const char* key, co
             engine->useCacheOnly = Str::ToBool(value);
             return true;
         }
+        else if (Str::IsEqualNoCase(key, "profilerEnable")) {
+            engine->profilerEnable = Str::ToBool(value);
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "profilerHitchThreshold")) {
+            engine->profilerHitchThreshold = Str::ToUint(value);
+            return true;
+        }
     }
     else if (category == SettingsCategory::Graphics) {
         SettingsGraphics* graphics = &gSettingsJunkyard.settings.graphics;
@@ -190,6 +230,14 @@ bool SettingsJunkyardParser::ParseSetting(uint32 categoryId, const char* key, co
             graphics->enableGpuCrashDumps = Str::ToBool(value);
             return true;
         }
+        else if (Str::IsEqualNoCase(key, "null")) {
+            graphics->nullBackend = Str::ToBool(value);
+            return true;
+        }
+        else if (Str::IsEqualNoCase(key, "nullFrameCount")) {
+            graphics->nullBackendFrameCount = Str::ToUint(value);
+            return true;
+        }
     }
     else if (category == SettingsCategory::Tooling) {
         SettingsTooling* tooling = &gSettingsJunkyard.settings.tooling;
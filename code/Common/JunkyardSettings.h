@@ -41,8 +41,11 @@ struct SettingsGraphics
     bool enableGpuCrashDumps = false;       // Enables gpu crash dumps. currently, only works for nvidia through nvidia aftermath SDK
     uint32 gpuIndex = uint32(-1);           // By default, graphics backend prefers the discrete GPUs
     uint32 msaa = 4;                        // Use MSAA (multisampling) for renderers
+    bool nullBackend = false;               // Null backend: no window/device, only tracks resources and counts commands. For CPU benchmarks (cmdline="-GraphicsNull=1")
+    uint32 nullBackendFrameCount = 0;       // Null backend quits the app after this many frames and logs the stats. 0 runs until quit
 
     inline bool IsGraphicsEnabled() const { return enable & !headless; }
+    inline bool IsWindowEnabled() const { return IsGraphicsEnabled() & !nullBackend; }
 };
 
 struct SettingsTooling
@@ -75,15 +78,25 @@ struct SettingsEngine
 
     bool connectToServer = false;               // Connects to server
     String<256> remoteServicesUrl = "127.0.0.1:6006";   // Url to server. Divide port number with colon
+    bool remoteServicesCompress = true;         // Asks server to compress large RemoteServices messages (LZ)
     LogLevel logLevel = DEFAULT_LOG_LEVEL;
+    bool logAsync = false;                      // Writes logs to sinks from a background thread, callers only format and queue them
+    String<256> logBinaryFilepath;              // Writes logs to this file in binary form (see Log::InitializeBinarySink). Empty means disabled
+    LogLevel logBinaryLevel = LogLevel::Verbose;    // Log level of the binary file, independent from logLevel
+    uint32 logBinaryMaxFileSize = 16;           // Binary log file is rotated after this size (MB)
     uint32 jobsNumShortTaskThreads = 0;         // Number of threads to spawn for short task jobs
     uint32 jobsNumLongTaskThreads = 0;          // Number of threads to spawn for long task jobs
+    bool jobsPinThreads = false;                // Pin job threads to cores by CPU topology (see JobsInitParams::pinThreads)
+    bool jobsPinAvoidSmtSiblings = true;        // With pinning, keep other threads off the SMT siblings of short task cores
+    bool jobsPinReserveMainThreadCore = true;   // With pinning, reserve the first core for the main thread
     bool debugAllocations = false;              // Use heap allocator instead for major allocators, like temp/budget/etc.
     bool trackAllocations = false;              // Use tracker in Proxy allocators
     bool breakOnErrors = false;                 // Break when LOG_ERROR happens
     bool treatWarningsAsErrors = false;         // Break when LOG_WARNING happens
     bool enableMemPro = false;                  // Enables MemPro instrumentation (https://www.puredevsoftware.com/mempro/index.htm)
     bool useCacheOnly = DEFAULT_CACHE_USAGE;    // This option only uses cache to load assets and bypasses Remote or Local disk assets
+    bool profilerEnable = false;                // Records zones with the built-in profiler when Tracy is not enabled (see CONFIG_ENABLE_PROFILER)
+    uint32 profilerHitchThreshold = 0;          // Frames longer than this (ms) dump the last few frames to "hitch-N.json". 0 means disabled
 };
 
 struct SettingsDebug
@@ -7,269 +7,959 @@
 #include "../Core/Log.h"
 #include "../Core/Arrays.h"
 #include "../Core/Blobs.h"
+#include "../Core/Hash.h"
+#include "../Core/Atomic.h"
 #include "../Core/Allocators.h"
 
 static constexpr uint32 kCmdFlag = MakeFourCC('U', 'S', 'R', 'C');
 static constexpr uint32 kCmdHello = MakeFourCC('H', 'E', 'L', 'O');
 static constexpr uint32 kCmdBye = MakeFourCC('B', 'Y', 'E', '0');
+static constexpr uint32 kCmdBenchmark = MakeFourCC('B', 'E', 'N', 'C');
 
 // Only used in client response packets
 static constexpr uint32 kResultError = MakeFourCC('E', 'R', 'O', 'R');
 static constexpr uint32 kResultOk = MakeFourCC('O', 'K', '0', '0');
 
+// Sent with the hello packet. Client and server must have the same version to complete the handshake
+static constexpr uint32 REMOTE_PROTOCOL_VERSION = 3;
+
+// Hello flags. Client sends the features it wants, server replies with the ones it accepts
+static constexpr uint32 REMOTE_HELLO_FLAG_COMPRESS = 0x1;
+
+// Payloads smaller than this are never compressed, it's not worth the CPU time
+static constexpr uint32 REMOTE_COMPRESS_MIN_SIZE = 4*SIZE_KB;
+static constexpr uint32 REMOTE_COMPRESS_HASH_BITS = 12;
+static constexpr uint32 REMOTE_READ_CHUNK_SIZE = 64*SIZE_KB;
+static constexpr uint32 REMOTE_MAX_PACKET_SIZE = 512*SIZE_MB;  // Larger packets are treated as corrupt and the connection is dropped
+static constexpr uint32 REMOTE_SERVER_POLL_TIMEOUT = 100;    // msecs. Server thread checks for quit in this interval
+static constexpr uint32 REMOTE_BENCHMARK_MAX_INFLIGHT_BYTES = 256*SIZE_KB;
+
+// Client -> Server
+struct RemotePacketRequest
+{
+    uint32 flag;        // kCmdFlag
+    uint32 cmd;
+    uint32 requestId;
+    uint32 dataSize;            // Size of the data that is sent over the wire after the header
+    uint32 uncompressedSize;    // Zero if data is not compressed
+};
+
+// Server -> Client
+// If result is kResultError, data starts with the error string (see Blob::WriteStringBinary)
+struct RemotePacketResponse
+{
+    uint32 flag;        // kCmdFlag
+    uint32 cmd;
+    uint32 requestId;
+    uint32 result;      // kResultOk/kResultError
+    uint32 dataSize;
+    uint32 uncompressedSize;
+};
+
+// Response that is waiting in the peer's write queue. Payloads are merged into 'data' (Mem::Alloc)
+struct RemotePeerPacket
+{
+    RemotePacketResponse header;
+    void* data;
+    uint32 dataSize;
+    bool compress;
+};
+
+// Responses are not written by the thread that produces them (server thread or async handlers). They are queued and 
+// written by the peer's own writer thread, so a slow client or a large response doesn't stall the other peers
+struct RemotePeer
+{
+    Mutex writeMtx;                         // Protects 'writeQueue' and 'writeQuit'
+    Semaphore writeSem;                     // Posted once per queued packet, and once more on quit
+    Thread writeThread;
+    Array<RemotePeerPacket> writeQueue;
+    SocketTCP sock;
+    Blob rxBuffer;      // Incoming data that doesn't yet make a complete packet
+    String<64> url;
+    uint32 id;
+    bool saidHello;
+    bool compress;      // Negotiated in hello
+    bool writeQuit;
+};
+
 struct RemoteServicesContext
 {
-    Mutex serverPeerMtx;
+    ReadWriteMutex peersMtx;
+    ReadWriteMutex commandsMtx;
+    Mutex clientMtx;
+
     Thread serverThread;
+    Thread clientThread;
 
     SocketTCP serverSock;
-    SocketTCP serverPeerSock;
     SocketTCP clientSock;
+    SocketPoller serverPoller;
+    Array<RemotePeer*> peers;       // Only modified by the server thread and protected by 'peersMtx'
+    uint32 nextPeerId;
+
     RemoteDisconnectCallback disconnectFn;
-    uint8 _padding1[8];
     Array<RemoteCommandDesc> commands;
-    uint8 _padding2[40];
+    HashTable<uint32> commandsLookup;   // FourCC -> Index to 'commands'
 
-    Mutex clientMtx;
-    Thread clientThread;
     String<128> peerUrl;
+    AtomicUint32 nextRequestId;
     bool serverQuit;
     bool clientQuit;
     bool clientIsConnected;
+    bool clientCompress;
 };
 
 static RemoteServicesContext gRemoteServices;
 
 namespace Remote
 {
-    static int _PeerThreadFn(void* userData)
+    static bool _FindCommand(uint32 cmdCode, RemoteCommandDesc* outDesc)
     {
-        uint8 tmpBuffer[4096];
-        SocketTCP* sock = reinterpret_cast<SocketTCP*>(userData);
-    
-        bool saidHello = false;
-        bool quit = false;
-    
-        while (!gRemoteServices.serverQuit && !quit) {
-            uint32 packet[3] = {0, 0, 0};       // {kCmdFlag, CmdCode, DataSize}
-            uint32 bytesRead = sock->Read(packet, sizeof(packet));
-            if (bytesRead == UINT32_MAX || bytesRead == 0) {
-                SocketErrorCode::Enum errCode = sock->GetErrorCode();
-                if (errCode == SocketErrorCode::ConnectionReset || bytesRead == 0) {
-                    LOG_INFO("RemoteServices: Disconnected from client '%s'", gRemoteServices.peerUrl.CStr());
+        ReadWriteMutexReadScope lock(gRemoteServices.commandsMtx);
+        uint32 index = gRemoteServices.commandsLookup.FindAndFetch(cmdCode, UINT32_MAX);
+        if (index != UINT32_MAX) {
+            *outDesc = gRemoteServices.commands[index];
+            return true;
+        }
+        return false;
+    }
+
+    // Reads exactly 'size' bytes from a blocking socket
+    static bool _ReadAll(SocketTCP* sock, void* dst, uint32 size)
+    {
+        uint8* dstBytes = reinterpret_cast<uint8*>(dst);
+        while (size) {
+            uint32 bytesRead = sock->Read(dstBytes, size);
+            if (bytesRead == UINT32_MAX || bytesRead == 0)
+                return false;
+            dstBytes += bytesRead;
+            size -= bytesRead;
+        }
+        return true;
+    }
+
+    // LZ77 block compression with LZ4 style sequences: [token][literals][offset:16][match length]
+    // Token has the literal length in the high nibble and the match length in the low nibble. 15 means more length bytes follow
+    // The last sequence only has literals. Returns compressed size, or 0 if the output doesn't fit into 'dstCapacity'
+    static constexpr uint32 REMOTE_LZ_MIN_MATCH = 4;
+    static constexpr uint32 REMOTE_LZ_END_LITERALS = 8;     // Matches never extend into the last bytes
+
+    static uint8* _LZWriteLength(uint8* op, const uint8* opEnd, uint32 len)
+    {
+        for (; len >= 255; len -= 255) {
+            if (op >= opEnd)
+                return nullptr;
+            *op++ = 255;
+        }
+        if (op >= opEnd)
+            return nullptr;
+        *op++ = uint8(len);
+        return op;
+    }
+
+    static bool _LZReadLength(const uint8** pIp, const uint8* ipEnd, uint32* len)
+    {
+        const uint8* ip = *pIp;
+        uint8 b;
+        do {
+            if (ip >= ipEnd)
+                return false;
+            b = *ip++;
+            *len += b;
+        } while (b == 255);
+        *pIp = ip;
+        return true;
+    }
+
+    static uint32 _CompressLZ(const uint8* src, uint32 srcSize, uint8* dst, uint32 dstCapacity, uint32* hashTable)
+    {
+        uint8* op = dst;
+        const uint8* opEnd = dst + dstCapacity;
+
+        auto WriteSequence = [&op, opEnd](const uint8* literals, uint32 numLiterals, uint32 offset, uint32 matchLen)->bool {
+            uint32 litCode = Min<uint32>(numLiterals, 15);
+            uint32 matchCode = matchLen ? Min<uint32>(matchLen - REMOTE_LZ_MIN_MATCH, 15) : 0;
+            if (op >= opEnd)
+                return false;
+            *op++ = uint8((litCode << 4) | matchCode);
+
+            if (litCode == 15 && (op = _LZWriteLength(op, opEnd, numLiterals - 15)) == nullptr)
+                return false;
+            if (uint32(opEnd - op) < numLiterals)
+                return false;
+            memcpy(op, literals, numLiterals);
+            op += numLiterals;
+
+            if (matchLen) {
+                if (opEnd - op < 2)
+                    return false;
+                *op++ = uint8(offset & 0xff);
+                *op++ = uint8(offset >> 8);
+                if (matchCode == 15 && (op = _LZWriteLength(op, opEnd, matchLen - REMOTE_LZ_MIN_MATCH - 15)) == nullptr)
+                    return false;
+            }
+            return true;
+        };
+
+        auto Read32 = [](const uint8* p)->uint32 { uint32 v; memcpy(&v, p, sizeof(v)); return v; };
+
+        uint32 anchor = 0;
+        if (srcSize > REMOTE_LZ_END_LITERALS + REMOTE_LZ_MIN_MATCH) {
+            uint32 matchLimit = srcSize - REMOTE_LZ_END_LITERALS;
+            uint32 ip = 0;
+            while (ip + REMOTE_LZ_MIN_MATCH <= matchLimit) {
+                uint32 seq = Read32(src + ip);
+                uint32 h = (seq*2654435761u) >> (32 - REMOTE_COMPRESS_HASH_BITS);
+                uint32 ref = hashTable[h];  // position + 1, zero is empty
+                hashTable[h] = ip + 1;
+
+                if (ref && ip - (ref - 1) <= UINT16_MAX && Read32(src + ref - 1) == seq) {
+                    --ref;
+                    uint32 matchLen = REMOTE_LZ_MIN_MATCH;
+                    while (ip + matchLen < matchLimit && src[ref + matchLen] == src[ip + matchLen])
+                        ++matchLen;
+
+                    if (!WriteSequence(src + anchor, ip - anchor, ip - ref, matchLen))
+                        return 0;
+                    ip += matchLen;
+                    anchor = ip;
                 }
                 else {
-                    LOG_DEBUG("RemoteServices: Socket Error: %s", SocketErrorCode::ToStr(errCode));
+                    ip += 1 + ((ip - anchor) >> 6);     // Skip faster through incompressible data
                 }
-                break;
             }
-        
-            // Drop packets that does not have the header
-            if (packet[0] != kCmdFlag) {
-                LOG_DEBUG("RemoteServices: Invalid packet");
+        }
+
+        if (!WriteSequence(src + anchor, srcSize - anchor, 0, 0))
+            return 0;
+        return uint32(op - dst);
+    }
+
+    static bool _DecompressLZ(const uint8* src, uint32 srcSize, uint8* dst, uint32 dstSize)
+    {
+        const uint8* ip = src;
+        const uint8* ipEnd = src + srcSize;
+        uint8* op = dst;
+        uint8* opEnd = dst + dstSize;
+
+        while (ip < ipEnd) {
+            uint8 token = *ip++;
+
+            uint32 numLiterals = token >> 4;
+            if (numLiterals == 15 && !_LZReadLength(&ip, ipEnd, &numLiterals))
+                return false;
+            if (uint32(ipEnd - ip) < numLiterals || uint32(opEnd - op) < numLiterals)
+                return false;
+            memcpy(op, ip, numLiterals);
+            ip += numLiterals;
+            op += numLiterals;
+
+            if (ip == ipEnd)
                 break;
+
+            if (ipEnd - ip < 2)
+                return false;
+            uint32 offset = uint32(ip[0]) | (uint32(ip[1]) << 8);
+            ip += 2;
+
+            uint32 matchLen = token & 0xf;
+            if (matchLen == 15 && !_LZReadLength(&ip, ipEnd, &matchLen))
+                return false;
+            matchLen += REMOTE_LZ_MIN_MATCH;
+
+            if (offset == 0 || offset > uint32(op - dst) || uint32(opEnd - op) < matchLen)
+                return false;
+
+            const uint8* match = op - offset;
+            if (offset >= matchLen) {
+                memcpy(op, match, matchLen);
+                op += matchLen;
             }
-        
-            uint32 cmdCode = packet[1];
-            if (!saidHello && cmdCode == kCmdHello) {
-                // Hello back
-                const uint32 hello[] = {kCmdFlag, kCmdHello, 0};
-                sock->Write(hello, sizeof(hello));
-                saidHello = true;
+            else {
+                // Overlapping match (repeating pattern)
+                for (uint32 i = 0; i < matchLen; i++)
+                    *op++ = *match++;
             }
-            else if (saidHello) {
-                if (cmdCode == kCmdBye) {
-                    // bye back and close
-                    const uint32 bye[] = {kCmdFlag, kCmdBye, 0};
-                    sock->Write(bye, sizeof(bye));
-                    saidHello = false;
-                    quit = true;
+        }
+
+        return op == opEnd;
+    }
+
+    // Writes the header followed by payload buffers without merging them
+    // If 'compress' is set and the payload is large enough, it is compressed first. Compressed data is only sent if it's smaller
+    // Header's 'dataSize' and 'uncompressedSize' fields are set by this function
+    template <typename _Header>
+    static bool _WritePacket(SocketTCP* sock, _Header* header, const SocketBuffer* payloads, uint32 numPayloads, bool compress)
+    {
+        ASSERT(numPayloads < SOCKET_MAX_GATHER_BUFFERS);
+
+        uint64 payloadSize = 0;
+        for (uint32 i = 0; i < numPayloads; i++)
+            payloadSize += payloads[i].size;
+        ASSERT(payloadSize + sizeof(_Header) <= UINT32_MAX);
+        if (payloadSize > REMOTE_MAX_PACKET_SIZE) {
+            LOG_ERROR("RemoteServices: Packet is too large to send (%llu bytes, max = %u)", payloadSize, REMOTE_MAX_PACKET_SIZE);
+            return false;
+        }
+
+        header->dataSize = uint32(payloadSize);
+        header->uncompressedSize = 0;
+
+        if (compress && payloadSize >= REMOTE_COMPRESS_MIN_SIZE) {
+            MemTempAllocator tmpAlloc;
+
+            const uint8* uncompressed;
+            if (numPayloads == 1) {
+                uncompressed = (const uint8*)payloads[0].data;
+            }
+            else {
+                uint8* merged = tmpAlloc.MallocTyped<uint8>(uint32(payloadSize));
+                uint32 offset = 0;
+                for (uint32 i = 0; i < numPayloads; i++) {
+                    if (payloads[i].size)
+                        memcpy(merged + offset, payloads[i].data, payloads[i].size);
+                    offset += payloads[i].size;
                 }
-                else {
-                    // Read custom command and execute it's callbacks if found
-                    // Custom commands have an extra size+data section ([header] + [cmd] + [size] = 3*uint32)
-                    uint32 cmdIdx = gRemoteServices.commands.FindIf([cmdCode](const RemoteCommandDesc& cmd) { return cmd.cmdFourCC == cmdCode; });
-                    if (cmdIdx != INVALID_INDEX && bytesRead >= sizeof(uint32)*3) {
-                        const RemoteCommandDesc& cmd = gRemoteServices.commands[cmdIdx];
-                        ASSERT(cmd.serverFn);
-                    
-                        uint32 dataSize = packet[2];
-                    
-                        MemTempAllocator tmpAlloc;
-                        Blob dataBlob(&tmpAlloc);
-                        if (dataSize > 0) {
-                            dataBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
-                            dataBlob.Reserve(dataSize);
-                        
-                            while (dataSize) {
-                                bytesRead = sock->Read(tmpBuffer, Min<uint32>(dataSize, sizeof(tmpBuffer)));
-                                if (bytesRead == UINT32_MAX) {
-                                    SocketErrorCode::Enum errCode = sock->GetErrorCode();
-                                    if (errCode == SocketErrorCode::ConnectionReset) {
-                                        LOG_INFO("RemoteServices: Disconnected from client '%s'", gRemoteServices.peerUrl.CStr());
-                                    }
-                                    else {
-                                        LOG_DEBUG("RemoteServices: Socket Error: %s", SocketErrorCode::ToStr(errCode));
-                                    }
-                                    quit = true;
-                                    break;
-                                }
-                            
-                                dataBlob.Write(tmpBuffer, bytesRead);
-                                dataSize -= bytesRead;
-                            }
-                        }
-                    
-                    
-                        Blob outgoingDataBlob(&tmpAlloc);
-                        outgoingDataBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
-                    
-                        char errorDesc[REMOTE_ERROR_SIZE];   errorDesc[0] = '\0';
-                        bool r = cmd.serverFn(cmd.cmdFourCC, dataBlob, &outgoingDataBlob, cmd.serverUserData, errorDesc);
-                    
-                        // send the reply back to the client only if the callback is not async
-                        if (!cmd.async || !r)
-                            SendResponse(cmdCode, outgoingDataBlob, !r, errorDesc);
-                    
-                        outgoingDataBlob.Free();
-                        dataBlob.Free();
-                    }
-                    else {
-                        LOG_DEBUG("RemoteServices: Invalid incoming command: 0x%x (%c%c%c%c)", cmdCode,
-                                cmdCode&0xff, (cmdCode>>8)&0xff, (cmdCode>>16)&0xff, cmdCode>>24);
-                    }
+                uncompressed = merged;
+            }
+
+            uint8* compressed = tmpAlloc.MallocTyped<uint8>(uint32(payloadSize));
+            uint32* hashTable = tmpAlloc.MallocZeroTyped<uint32>(1u << REMOTE_COMPRESS_HASH_BITS);
+            uint32 compressedSize = _CompressLZ(uncompressed, uint32(payloadSize), compressed, uint32(payloadSize), hashTable);
+            if (compressedSize) {
+                header->dataSize = compressedSize;
+                header->uncompressedSize = uint32(payloadSize);
+
+                const SocketBuffer buffers[] = {
+                    { header, sizeof(_Header) },
+                    { compressed, compressedSize }
+                };
+                return sock->WriteGather(buffers, CountOf(buffers)) == sizeof(_Header) + compressedSize;
+            }
+        }
+
+        SocketBuffer buffers[SOCKET_MAX_GATHER_BUFFERS];
+        buffers[0] = { header, sizeof(_Header) };
+        for (uint32 i = 0; i < numPayloads; i++)
+            buffers[i + 1] = payloads[i];
+        return sock->WriteGather(buffers, numPayloads + 1) == sizeof(_Header) + uint32(payloadSize);
+    }
+
+    // Decompresses packet data if it's compressed, otherwise 'outBlob' just points to the data
+    static bool _ReadPacketData(const void* data, uint32 dataSize, uint32 uncompressedSize, Blob* outBlob)
+    {
+        if (uncompressedSize) {
+            outBlob->Reserve(uncompressedSize);
+            if (!_DecompressLZ((const uint8*)data, dataSize, (uint8*)outBlob->Data(), uncompressedSize)) {
+                LOG_DEBUG("RemoteServices: Invalid compressed data");
+                return false;
+            }
+            outBlob->SetSize(uncompressedSize);
+        }
+        else if (dataSize) {
+            *outBlob = Blob(const_cast<void*>(data), dataSize);
+            outBlob->SetSize(dataSize);
+        }
+        return true;
+    }
+
+    // MT: Thread-safe. Only queues the response, it's written to the socket by the peer's writer thread
+    static bool _WriteResponse(RemotePeer* peer, const RemoteRequest& req, uint32 cmdCode, const Blob* blobs, uint32 numBlobs,
+                               bool error, const char* errorDesc)
+    {
+        // Error message goes first (Same layout as Blob::WriteStringBinary), so the client can skip it and pass the rest to the handler
+        uint32 errorLen = error ? Str::Len(errorDesc ? errorDesc : "") : 0;
+
+        uint64 dataSize = error ? sizeof(errorLen) + errorLen : 0;
+        for (uint32 i = 0; i < numBlobs; i++)
+            dataSize += blobs[i].Size();
+        if (dataSize > REMOTE_MAX_PACKET_SIZE) {
+            LOG_ERROR("RemoteServices: Packet is too large to send (%llu bytes, max = %u)", dataSize, REMOTE_MAX_PACKET_SIZE);
+            return false;
+        }
+
+        RemotePeerPacket packet {
+            .header = {
+                .flag = kCmdFlag,
+                .cmd = cmdCode,
+                .requestId = req.requestId,
+                .result = !error ? kResultOk : kResultError
+            },
+            .data = dataSize ? Mem::Alloc(dataSize) : nullptr,
+            .dataSize = uint32(dataSize),
+            .compress = peer->compress
+        };
+
+        uint8* dst = (uint8*)packet.data;
+        if (error) {
+            memcpy(dst, &errorLen, sizeof(errorLen));
+            dst += sizeof(errorLen);
+            if (errorLen)
+                memcpy(dst, errorDesc, errorLen);
+            dst += errorLen;
+        }
+        for (uint32 i = 0; i < numBlobs; i++) {
+            if (blobs[i].Size())
+                memcpy(dst, blobs[i].Data(), blobs[i].Size());
+            dst += blobs[i].Size();
+        }
+
+        {
+            MutexScope lock(peer->writeMtx);
+            if (!peer->writeQuit) {
+                peer->writeQueue.Push(packet);
+                packet.data = nullptr;
+            }
+        }
+
+        if (packet.data) {
+            Mem::Free(packet.data);
+            return false;
+        }
+        peer->writeSem.Post();
+        return true;
+    }
+
+    static int _PeerWriterThreadFn(void* userData)
+    {
+        RemotePeer* peer = reinterpret_cast<RemotePeer*>(userData);
+        bool failed = false;
+
+        for (;;) {
+            peer->writeSem.Wait();
+
+            RemotePeerPacket packet;
+            {
+                MutexScope lock(peer->writeMtx);
+                if (peer->writeQueue.IsEmpty()) {
+                    if (peer->writeQuit)
+                        break;
+                    continue;
                 }
+                packet = peer->writeQueue.PopFirst();
             }
-            else {
-                // Something went wrong. Handshake is not complete. Drop the connection
-                quit = true;
+
+            // Keep draining the queue after a failure, so the packets are freed. The peer is dropped by the server thread
+            if (!failed) {
+                const SocketBuffer payload { packet.data, packet.dataSize };
+                failed = !_WritePacket(&peer->sock, &packet.header, &payload, packet.dataSize ? 1 : 0, packet.compress);
+                if (failed)
+                    LOG_DEBUG("RemoteServices: Writing to client '%s' failed", peer->url.CStr());
             }
+            Mem::Free(packet.data);
         }
-    
-        sock->Close();
+
         return 0;
     }
 
+    static void _ClosePeer(RemotePeer* peer)
+    {
+        {
+            ReadWriteMutexWriteScope lock(gRemoteServices.peersMtx);
+            uint32 index = gRemoteServices.peers.Find(peer);
+            if (index != UINT32_MAX)
+                gRemoteServices.peers.RemoveAndSwap(index);
+        }
+
+        // Nothing can queue new packets after this. Writer thread flushes whatever is left (bye for example) and quits
+        {
+            MutexScope lock(peer->writeMtx);
+            peer->writeQuit = true;
+        }
+        peer->writeSem.Post();
+        peer->writeThread.Stop();
+        ASSERT(peer->writeQueue.IsEmpty());
+
+        if (peer->sock.IsValid()) {
+            gRemoteServices.serverPoller.Remove(peer->sock);
+            peer->sock.Close();
+        }
+        peer->rxBuffer.Free();
+        peer->writeQueue.Free();
+        peer->writeSem.Release();
+        peer->writeMtx.Release();
+        Mem::Free(peer);
+    }
+
+    // Returns false if the packet is invalid or the handshake is not complete, so the peer should be dropped
+    static bool _HandleRequest(RemotePeer* peer, const RemotePacketRequest& header, const Blob& dataBlob)
+    {
+        const RemoteRequest req {
+            .peerId = peer->id,
+            .requestId = header.requestId
+        };
+
+        if (!peer->saidHello) {
+            // Hello: {version, flags}
+            uint32 version = 0;
+            uint32 flags = 0;
+            if (header.cmd != kCmdHello || dataBlob.Read<uint32>(&version) != sizeof(version))
+                return false;   // Handshake is not complete. Drop the connection
+            dataBlob.Read<uint32>(&flags);
+
+            if (version != REMOTE_PROTOCOL_VERSION) {
+                LOG_WARNING("RemoteServices: Client '%s' protocol version mismatch (client: %u, server: %u)",
+                            peer->url.CStr(), version, REMOTE_PROTOCOL_VERSION);
+                _WriteResponse(peer, req, kCmdHello, nullptr, 0, true, "Protocol version mismatch");
+                return false;
+            }
+
+            // Reply with the flags that we accept. Hello response itself is never compressed
+            uint32 acceptedFlags = flags & REMOTE_HELLO_FLAG_COMPRESS;
+            Blob flagsBlob(&acceptedFlags, sizeof(acceptedFlags));
+            flagsBlob.SetSize(sizeof(acceptedFlags));
+            peer->saidHello = _WriteResponse(peer, req, kCmdHello, &flagsBlob, 1, false, nullptr);
+            peer->compress = (acceptedFlags & REMOTE_HELLO_FLAG_COMPRESS) != 0;
+            if (peer->compress)
+                LOG_VERBOSE("RemoteServices: Client '%s' uses compression", peer->url.CStr());
+            return peer->saidHello;
+        }
+
+        if (header.cmd == kCmdBye) {
+            // bye back and close
+            _WriteResponse(peer, req, kCmdBye, nullptr, 0, false, nullptr);
+            return false;
+        }
+
+        RemoteCommandDesc cmd;
+        if (!_FindCommand(header.cmd, &cmd)) {
+            LOG_DEBUG("RemoteServices: Invalid incoming command: 0x%x (%c%c%c%c)", header.cmd,
+                      header.cmd&0xff, (header.cmd>>8)&0xff, (header.cmd>>16)&0xff, header.cmd>>24);
+            return true;
+        }
+        ASSERT(cmd.serverFn);
+
+        MemTempAllocator tmpAlloc;
+        Blob outgoingDataBlob(&tmpAlloc);
+        outgoingDataBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
+
+        char errorDesc[REMOTE_ERROR_SIZE];   errorDesc[0] = '\0';
+        bool r = cmd.serverFn(cmd.cmdFourCC, req, dataBlob, &outgoingDataBlob, cmd.serverUserData, errorDesc);
+
+        // send the reply back to the client only if the callback is not async
+        if (!cmd.async || !r)
+            SendResponse(req, header.cmd, outgoingDataBlob, !r, errorDesc);
+
+        outgoingDataBlob.Free();
+        return true;
+    }
+
+    // Receives whatever is available on the socket and dispatches all complete packets
+    // Returns false if the peer is disconnected or sent invalid data
+    static bool _ReceivePeer(RemotePeer* peer)
+    {
+        Blob& rx = peer->rxBuffer;
+        if (rx.Capacity() - rx.Size() < REMOTE_READ_CHUNK_SIZE)
+            rx.Reserve(rx.Size() + REMOTE_READ_CHUNK_SIZE);
+
+        uint32 bytesRead = peer->sock.Read((uint8*)rx.Data() + rx.Size(), uint32(rx.Capacity() - rx.Size()));
+        if (bytesRead == UINT32_MAX || bytesRead == 0) {
+            SocketErrorCode::Enum errCode = peer->sock.GetErrorCode();
+            if (errCode == SocketErrorCode::ConnectionReset || bytesRead == 0)
+                LOG_INFO("RemoteServices: Disconnected from client '%s'", peer->url.CStr());
+            else
+                LOG_DEBUG("RemoteServices: Socket Error: %s", SocketErrorCode::ToStr(errCode));
+            return false;
+        }
+        rx.SetSize(rx.Size() + bytesRead);
+
+        // Dispatch all complete packets. Pipelined requests can arrive within a single read
+        const uint8* data = (const uint8*)rx.Data();
+        size_t offset = 0;
+        size_t size = rx.Size();
+        bool keep = true;
+        while (keep && size - offset >= sizeof(RemotePacketRequest)) {
+            RemotePacketRequest header;
+            memcpy(&header, data + offset, sizeof(header));
+
+            // Drop packets that does not have the header
+            if (header.flag != kCmdFlag) {
+                LOG_DEBUG("RemoteServices: Invalid packet");
+                return false;
+            }
+
+            // Sizes are used for reserving buffers before any of the data arrives, so don't trust them
+            if (header.dataSize > REMOTE_MAX_PACKET_SIZE || header.uncompressedSize > REMOTE_MAX_PACKET_SIZE) {
+                LOG_WARNING("RemoteServices: Packet from '%s' is too large (%u bytes). Dropping the client", peer->url.CStr(),
+                            Max(header.dataSize, header.uncompressedSize));
+                return false;
+            }
+
+            // Incomplete packet, wait for more data
+            if (size - offset - sizeof(header) < header.dataSize)
+                break;
+
+            // Incoming data is either decompressed into a temp blob or referenced directly from the receive buffer
+            MemTempAllocator tmpAlloc;
+            Blob dataBlob(&tmpAlloc);
+            if (!_ReadPacketData(data + offset + sizeof(header), header.dataSize, header.uncompressedSize, &dataBlob))
+                return false;
+
+            keep = _HandleRequest(peer, header, dataBlob);
+            offset += sizeof(header) + header.dataSize;
+        }
+
+        // Move remaining partial packet to the start of the buffer
+        if (offset) {
+            size_t remaining = size - offset;
+            if (remaining)
+                memmove(const_cast<void*>(rx.Data()), (const uint8*)rx.Data() + offset, remaining);
+            rx.SetSize(remaining);
+        }
+
+        // Make sure we have room for the rest of a large packet, so it's received with fewer reads
+        // Header of the remaining partial packet is already validated in the loop above
+        if (keep && rx.Size() >= sizeof(RemotePacketRequest)) {
+            const RemotePacketRequest* header = (const RemotePacketRequest*)rx.Data();
+            size_t packetSize = sizeof(RemotePacketRequest) + header->dataSize;
+            if (packetSize > rx.Capacity())
+                rx.Reserve(packetSize);
+        }
+
+        return keep;
+    }
+
+    static void _AcceptPeer()
+    {
+        char peerUrl[128];
+        SocketTCP sock = gRemoteServices.serverSock.Accept(peerUrl, sizeof(peerUrl));
+        if (!sock.IsValid())
+            return;
+
+        if (gRemoteServices.peers.Count() >= REMOTE_SERVER_MAX_PEERS) {
+            LOG_WARNING("RemoteServices: Rejected connection '%s'. Too many clients (max = %u)", peerUrl, REMOTE_SERVER_MAX_PEERS);
+            sock.Close();
+            return;
+        }
+
+        LOG_INFO("RemoteServices: Incoming connection: %s", peerUrl);
+
+        // Every packet is written with a single call, so there is nothing to gain from Nagle, only the latency of streamed responses
+        sock.SetNoDelay(true);
+
+        RemotePeer* peer = PLACEMENT_NEW(Mem::AllocZero(sizeof(RemotePeer)), RemotePeer);
+        peer->id = ++gRemoteServices.nextPeerId;
+        peer->sock = sock;
+        peer->url = peerUrl;
+        peer->writeMtx.Initialize();
+        peer->writeSem.Initialize();
+        peer->rxBuffer.SetGrowPolicy(Blob::GrowPolicy::Multiply);
+
+        if (!gRemoteServices.serverPoller.Add(peer->sock, peer->id)) {
+            peer->sock.Close();
+            peer->writeSem.Release();
+            peer->writeMtx.Release();
+            Mem::Free(peer);
+            return;
+        }
+
+        peer->writeThread.Start(ThreadDesc {
+            .entryFn = _PeerWriterThreadFn,
+            .userData = peer,
+            .name = "RemoteServicesPeerWriter",
+            .stackSize = 64*SIZE_KB
+        });
+
+        ReadWriteMutexWriteScope lock(gRemoteServices.peersMtx);
+        gRemoteServices.peers.Push(peer);
+    }
+
     static int _ServerThread(void*)
     {
+        uint16 port = SettingsJunkyard::Get().tooling.serverPort;
         gRemoteServices.serverSock = SocketTCP::CreateListener();
-    
-        if (gRemoteServices.serverSock.Listen(SettingsJunkyard::Get().tooling.serverPort, 1)) {
-            LOG_INFO("(init) RemoteServices: Listening for incomming connection on port: %d", SettingsJunkyard::Get().tooling.serverPort);
-            char peerUrl[128];
-            while (!gRemoteServices.serverQuit) {
-                gRemoteServices.serverPeerSock = gRemoteServices.serverSock.Accept(peerUrl, sizeof(peerUrl));
-                if (gRemoteServices.serverPeerSock.IsValid()) {
-                    LOG_INFO("RemoteServices: Incoming connection: %s", peerUrl);
-                    gRemoteServices.peerUrl = peerUrl;
-                
-                    Thread thrd;
-                    thrd.Start(ThreadDesc {
-                        .entryFn = _PeerThreadFn,
-                        .userData = &gRemoteServices.serverPeerSock,
-                        .name = "ServerSessionPipe"
-                    });
-                    thrd.Stop(); // wait on the service to finish
+
+        if (!gRemoteServices.serverSock.IsValid() ||
+            !gRemoteServices.serverSock.Listen(port, REMOTE_SERVER_MAX_PEERS) ||
+            !gRemoteServices.serverPoller.Initialize(REMOTE_SERVER_MAX_PEERS + 1))
+        {
+            gRemoteServices.serverSock.Close();
+            return -1;
+        }
+
+        // userData=0 is the listener, peers are identified by their ids
+        gRemoteServices.serverPoller.Add(gRemoteServices.serverSock, 0);
+        LOG_INFO("(init) RemoteServices: Listening for incomming connections on port: %d", port);
+
+        SocketPollEvent events[REMOTE_SERVER_MAX_PEERS + 1];
+        while (!gRemoteServices.serverQuit) {
+            uint32 numEvents = gRemoteServices.serverPoller.Wait(events, CountOf(events), REMOTE_SERVER_POLL_TIMEOUT);
+            if (numEvents == UINT32_MAX) {
+                LOG_ERROR("RemoteServices: Waiting on server sockets failed");
+                break;
+            }
+
+            for (uint32 i = 0; i < numEvents && !gRemoteServices.serverQuit; i++) {
+                const SocketPollEvent& ev = events[i];
+                if (ev.userData == 0) {
+                    _AcceptPeer();
+                    continue;
                 }
+
+                uint32 peerId = uint32(ev.userData);
+                uint32 peerIdx = gRemoteServices.peers.FindIf([peerId](const RemotePeer* p) { return p->id == peerId; });
+                if (peerIdx == UINT32_MAX)
+                    continue;
+                RemotePeer* peer = gRemoteServices.peers[peerIdx];
+
+                // Note that we may still have data to read before the hangup, Read returns 0 after that
+                if (!_ReceivePeer(peer))
+                    _ClosePeer(peer);
             }
         }
-    
+
+        // Say bye to all remaining clients
+        while (!gRemoteServices.peers.IsEmpty()) {
+            RemotePeer* peer = gRemoteServices.peers.Last();
+            if (peer->saidHello && peer->sock.IsConnected()) {
+                _WriteResponse(peer, RemoteRequest {.peerId = peer->id}, kCmdBye, nullptr, 0, false, nullptr);
+            }
+            _ClosePeer(peer);
+        }
+
+        gRemoteServices.serverPoller.Release();
         gRemoteServices.serverSock.Close();
         return 0;
     }
 
+    // Receives packet data from a blocking socket directly into a pre-sized blob, then decompresses it if needed
+    static bool _ReceivePacketData(SocketTCP* sock, const RemotePacketResponse& header, Blob* outBlob)
+    {
+        if (header.dataSize == 0)
+            return true;
+
+        if (header.uncompressedSize) {
+            // Reserve before the scratch temp allocator, so allocations stay in stack order
+            outBlob->Reserve(header.uncompressedSize);
+
+            MemTempAllocator tmpAlloc;
+            uint8* compressed = tmpAlloc.MallocTyped<uint8>(header.dataSize);
+            if (!_ReadAll(sock, compressed, header.dataSize))
+                return false;
+            if (!_DecompressLZ(compressed, header.dataSize, (uint8*)outBlob->Data(), header.uncompressedSize)) {
+                LOG_DEBUG("RemoteServices: Invalid compressed data");
+                return false;
+            }
+            outBlob->SetSize(header.uncompressedSize);
+            return true;
+        }
+        else {
+            outBlob->Reserve(header.dataSize);
+            if (!_ReadAll(sock, const_cast<void*>(outBlob->Data()), header.dataSize))
+                return false;
+            outBlob->SetSize(header.dataSize);
+            return true;
+        }
+    }
+
     static int _ClientThreadFn(void*)
     {
-        uint8 tmpBuffer[4096];
         SocketTCP* sock = &gRemoteServices.clientSock;
         ASSERT(sock->IsValid());
-    
+
         bool quit = false;
         while (!gRemoteServices.clientQuit && !quit) {
-            uint32 packet[4] = {0, 0, 0, 0};       // {kCmdFlag, CmdCode, ErrorIndicator, DataSize}
-            uint32 bytesRead = sock->Read(packet, sizeof(packet));
-            if (bytesRead == UINT32_MAX) {
+            RemotePacketResponse header;
+            if (!_ReadAll(sock, &header, sizeof(header))) {
                 LOG_DEBUG("RemoteServices: Socket Error: %s", SocketErrorCode::ToStr(sock->GetErrorCode()));
                 break;
             }
-        
+
             // Drop packets that does not have the header
-            if (packet[0] != kCmdFlag) {
+            if (header.flag != kCmdFlag) {
                 LOG_DEBUG("RemoteServices: Invalid packet");
                 break;
             }
-        
-            uint32 cmdCode = packet[1];
-            if (cmdCode == kCmdBye) {
+
+            if (header.dataSize > REMOTE_MAX_PACKET_SIZE || header.uncompressedSize > REMOTE_MAX_PACKET_SIZE) {
+                LOG_WARNING("RemoteServices: Packet from server is too large (%u bytes). Disconnecting", 
+                            Max(header.dataSize, header.uncompressedSize));
+                break;
+            }
+
+            MemTempAllocator tmpAlloc;
+            Blob incomingDataBlob(&tmpAlloc);
+            if (!_ReceivePacketData(sock, header, &incomingDataBlob)) {
+                LOG_DEBUG("RemoteServices: Socket Error: %s", SocketErrorCode::ToStr(sock->GetErrorCode()));
+                break;
+            }
+
+            if (header.cmd == kCmdBye) {
                 // bye back and close
-                const uint32 bye[] = {kCmdFlag, kCmdBye, 0};
-                sock->Write(bye, sizeof(bye));
+                const RemotePacketRequest bye {.flag = kCmdFlag, .cmd = kCmdBye};
+                sock->Write(&bye, sizeof(bye));
                 quit = true;
+                continue;
             }
-            else {
-                uint32 cmdIdx = gRemoteServices.commands.FindIf([cmdCode](const RemoteCommandDesc& cmd) { return cmd.cmdFourCC == cmdCode; });
-                if (cmdIdx != INVALID_INDEX) {
-                    const RemoteCommandDesc& cmd = gRemoteServices.commands[cmdIdx];
-                    ASSERT(cmd.clientFn);
-                
-                    uint32 dataSize = packet[3];
-                
-                    MemTempAllocator tmpAlloc;
-                    Blob incomingDataBlob(&tmpAlloc);
-                    if (dataSize > 0) {
-                        incomingDataBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
-                        incomingDataBlob.Reserve(dataSize);
-                    
-                        while (dataSize) {
-                            bytesRead = sock->Read(tmpBuffer, Min<uint32>(dataSize, sizeof(tmpBuffer)));
-                            if (bytesRead == UINT32_MAX) {
-                                LOG_DEBUG("RemoteServices: Socket Error: %s", SocketErrorCode::ToStr(sock->GetErrorCode()));
-                                quit = true;
-                                break;
-                            }
-                            incomingDataBlob.Write(tmpBuffer, bytesRead);
-                            dataSize -= bytesRead;
-                        }
-                    }
-                
-                    // Check for errors
-                    char errorDesc[REMOTE_ERROR_SIZE];
-                    memset(errorDesc, 0x0, sizeof(errorDesc));
-                
-                    if (packet[2] == kResultError) {
-                        uint32 errorLen;
-                        sock->Read(&errorLen, sizeof(errorLen));
-                        if (errorLen)
-                            sock->Read(errorDesc, sizeof(errorDesc));
-                    }
-                    else {
-                        ASSERT(packet[2] == kResultOk);
-                    }
-                
-                    cmd.clientFn(cmdCode, incomingDataBlob, cmd.clientUserData, packet[2] == kResultError, errorDesc);
+
+            RemoteCommandDesc cmd;
+            if (_FindCommand(header.cmd, &cmd)) {
+                ASSERT(cmd.clientFn);
+
+                // Error string comes before the data
+                char errorDesc[REMOTE_ERROR_SIZE];
+                errorDesc[0] = '\0';
+                if (header.result == kResultError) {
+                    incomingDataBlob.ReadStringBinary(errorDesc, sizeof(errorDesc));
                 }
                 else {
-                    LOG_DEBUG("RemoteServices: Invalid response command from server: 0x%x (%c%c%c%c)", cmdCode,
-                            cmdCode&0xff, (cmdCode>>8)&0xff, (cmdCode>>16)&0xff, cmdCode>>24);
+                    ASSERT(header.result == kResultOk);
                 }
+
+                cmd.clientFn(header.cmd, header.requestId, incomingDataBlob, cmd.clientUserData, header.result == kResultError, errorDesc);
+            }
+            else {
+                LOG_DEBUG("RemoteServices: Invalid response command from server: 0x%x (%c%c%c%c)", header.cmd,
+                          header.cmd&0xff, (header.cmd>>8)&0xff, (header.cmd>>16)&0xff, header.cmd>>24);
             }
         }   // while not quit
-    
+
         SocketErrorCode::Enum errCode = sock->GetErrorCode();
         sock->Close();
-    
+
         if (gRemoteServices.disconnectFn)
             gRemoteServices.disconnectFn(gRemoteServices.peerUrl.CStr(), gRemoteServices.clientQuit, errCode);
         gRemoteServices.clientIsConnected = false;
         return 0;
     }
+
+    // Sends hello with the protocol version and requested features and waits for the server to accept
+    // Returns the features that server accepted in 'outAcceptedFlags'
+    static bool _Handshake(SocketTCP* sock, uint32 flags, uint32* outAcceptedFlags)
+    {
+        struct HelloPacket
+        {
+            RemotePacketRequest header;
+            uint32 version;
+            uint32 flags;
+        };
+
+        const HelloPacket hello {
+            .header = {
+                .flag = kCmdFlag,
+                .cmd = kCmdHello,
+                .dataSize = sizeof(uint32)*2
+            },
+            .version = REMOTE_PROTOCOL_VERSION,
+            .flags = flags
+        };
+        if (sock->Write(&hello, sizeof(hello)) != sizeof(hello))
+            return false;
+
+        RemotePacketResponse response;
+        if (!_ReadAll(sock, &response, sizeof(response)) || response.flag != kCmdFlag || response.cmd != kCmdHello || 
+            response.uncompressedSize != 0 || response.dataSize > REMOTE_ERROR_SIZE)
+        {
+            return false;
+        }
+
+        uint8 data[REMOTE_ERROR_SIZE + sizeof(uint32)];
+        if (!_ReadAll(sock, data, response.dataSize))
+            return false;
+        Blob dataBlob(data, sizeof(data));
+        dataBlob.SetSize(response.dataSize);
+
+        if (response.result != kResultOk) {
+            char errorDesc[REMOTE_ERROR_SIZE];
+            dataBlob.ReadStringBinary(errorDesc, sizeof(errorDesc));
+            LOG_ERROR("RemoteServices: Server refused the connection: %s", errorDesc);
+            return false;
+        }
+
+        *outAcceptedFlags = 0;
+        dataBlob.Read<uint32>(outAcceptedFlags);
+        return true;
+    }
+
+    static bool _BenchmarkServerFn(uint32, const RemoteRequest&, const Blob& incomingData, Blob* outgoingData, void*, char*)
+    {
+        if (incomingData.Size())
+            outgoingData->Write(incomingData.Data(), incomingData.Size());
+        return true;
+    }
+
+    struct BenchmarkClientData
+    {
+        const char* url;
+        const uint8* payload;
+        uint32 numRequests;
+        uint32 payloadSize;
+        bool compress;
+        uint32 numCompleted;
+        uint64 numBytes;
+        uint64 numWireBytes;
+    };
+
+    static int _BenchmarkClientThreadFn(void* userData)
+    {
+        BenchmarkClientData* client = reinterpret_cast<BenchmarkClientData*>(userData);
+
+        uint32 acceptedFlags = 0;
+        SocketTCP sock = SocketTCP::Connect(client->url);
+        if (!sock.IsValid() || !sock.IsConnected() || 
+            !_Handshake(&sock, client->compress ? REMOTE_HELLO_FLAG_COMPRESS : 0, &acceptedFlags))
+        {
+            sock.Close();
+            return -1;
+        }
+        bool compress = (acceptedFlags & REMOTE_HELLO_FLAG_COMPRESS) != 0;
+        sock.SetNoDelay(true);
+
+        // Keep multiple requests in flight, but not too much data so we don't deadlock on full socket buffers
+        uint32 maxInflight = Clamp<uint32>(REMOTE_BENCHMARK_MAX_INFLIGHT_BYTES / Max(client->payloadSize, 1u), 1, 32);
+        uint32 numSent = 0;
+        uint32 numReceived = 0;
+        uint64 numWireBytes = 0;
+        const SocketBuffer payload { client->payload, client->payloadSize };
+
+        while (numReceived < client->numRequests) {
+            while (numSent < client->numRequests && numSent - numReceived < maxInflight) {
+                RemotePacketRequest header {
+                    .flag = kCmdFlag,
+                    .cmd = kCmdBenchmark,
+                    .requestId = numSent + 1
+                };
+                if (!_WritePacket(&sock, &header, &payload, 1, compress))
+                    break;
+                numWireBytes += header.dataSize;
+                numSent++;
+            }
+
+            RemotePacketResponse response;
+            if (!_ReadAll(&sock, &response, sizeof(response)) || response.cmd != kCmdBenchmark || response.result != kResultOk)
+                break;
+
+            MemTempAllocator tmpAlloc;
+            Blob responseBlob(&tmpAlloc);
+            if (!_ReceivePacketData(&sock, response, &responseBlob) || responseBlob.Size() != client->payloadSize)
+                break;
+
+            numWireBytes += response.dataSize;
+            numReceived++;
+        }
+
+        const RemotePacketRequest bye {.flag = kCmdFlag, .cmd = kCmdBye};
+        sock.Write(&bye, sizeof(bye));
+        sock.Close();
+
+        client->numCompleted = numReceived;
+        client->numBytes = uint64(numReceived)*client->payloadSize*2;
+        client->numWireBytes = numWireBytes;
+        return 0;
+    }
 } // Remote
 
 bool Remote::Initialize()
 {
-    gRemoteServices.serverPeerMtx.Initialize();
+    gRemoteServices.peersMtx.Initialize();
+    gRemoteServices.commandsMtx.Initialize();
     gRemoteServices.clientMtx.Initialize();
-    
+
+    RegisterCommand(RemoteCommandDesc {
+        .cmdFourCC = kCmdBenchmark,
+        .serverFn = _BenchmarkServerFn
+    });
+
     if (SettingsJunkyard::Get().tooling.enableServer) {
         LOG_INFO("(init) RemoteServices: Starting RemoteServices server in port %u...", SettingsJunkyard::Get().tooling.serverPort);
         gRemoteServices.serverThread.Start(ThreadDesc {
@@ -282,67 +972,60 @@ bool Remote::Initialize()
 
 void Remote::Release()
 {
+    // Server thread closes all sockets on exit
     gRemoteServices.serverQuit = true;
-    if (gRemoteServices.serverPeerSock.IsValid())
-        gRemoteServices.serverPeerSock.Close();
-    if (gRemoteServices.serverSock.IsValid())
-        gRemoteServices.serverSock.Close();
     gRemoteServices.serverThread.Stop();
-    
+
     gRemoteServices.clientQuit = true;
     if (gRemoteServices.clientSock.IsValid())
         gRemoteServices.clientSock.Close();
     gRemoteServices.clientThread.Stop();
-    
-    gRemoteServices.serverPeerMtx.Release();
+
+    gRemoteServices.peersMtx.Release();
+    gRemoteServices.commandsMtx.Release();
     gRemoteServices.clientMtx.Release();
+    gRemoteServices.peers.Free();
     gRemoteServices.commands.Free();
+    gRemoteServices.commandsLookup.Free();
 }
 
 bool Remote::Connect(const char* url, RemoteDisconnectCallback disconnectFn)
 {
     ASSERT_MSG(!gRemoteServices.clientIsConnected, "Client is already connected");
-    
+
     MutexScope mtx(gRemoteServices.clientMtx);
-    
+
     if (gRemoteServices.clientIsConnected) {
         ASSERT(gRemoteServices.clientSock.IsConnected());
         return true;
     }
-    
+
     gRemoteServices.clientThread.Stop();
     LOG_INFO("(init) RemoteServices: Connecting to remote server: %s ...", url);
-    
+
     gRemoteServices.clientSock = SocketTCP::Connect(url);
     SocketTCP* sock = &gRemoteServices.clientSock;
     if (!sock->IsValid() || !sock->IsConnected()) {
         LOG_ERROR("RemoteServices: Connecting to remote url '%s' failed", url);
         return false;
     }
-    
-    // Say hello
-    const uint32 hello[] = {kCmdFlag, kCmdHello, 0};
-    if (sock->Write(hello, sizeof(hello)) != sizeof(hello)) {
-        LOG_ERROR("RemoteServices: Connecting to remote url '%s' failed", url);
-        sock->Close();
-        return false;
-    }
-    
-    // Receive hello and complete the handshake
-    uint32 response[3];
-    if (sock->Read(response, sizeof(response)) != sizeof(response) ||
-        response[0] != kCmdFlag || response[1] != kCmdHello)
-    {
-        LOG_ERROR("RemoteServices: Invalid response from disk server: %s", url);
+    sock->SetNoDelay(true);
+
+    // Say hello and receive hello to complete the handshake
+    uint32 acceptedFlags = 0;
+    uint32 flags = SettingsJunkyard::Get().engine.remoteServicesCompress ? REMOTE_HELLO_FLAG_COMPRESS : 0;
+    if (!_Handshake(sock, flags, &acceptedFlags)) {
+        LOG_ERROR("RemoteServices: Invalid response from server: %s", url);
         sock->Close();
         return false;
     }
-    
+    gRemoteServices.clientCompress = (acceptedFlags & REMOTE_HELLO_FLAG_COMPRESS) != 0;
+
     gRemoteServices.clientThread.Start(ThreadDesc {
         .entryFn = _ClientThreadFn,
         .name = "RemoteServicesClient"
     });
-    
+
     LOG_INFO("(init) RemoteServices: Connected to remote server: %s", url);
     gRemoteServices.disconnectFn = disconnectFn;
     gRemoteServices.peerUrl = url;
@@ -368,95 +1051,149 @@ bool Remote::IsConnected()
 }
 
 // MT: This function is thread-safe, multiple calls to remoteExecuteCommand from several threads locks it
-void Remote::ExecuteCommand(uint32 cmdCode, const Blob& data)
+uint32 Remote::ExecuteCommand(uint32 cmdCode, const Blob& data)
 {
-    uint32 cmdIdx = gRemoteServices.commands.FindIf([cmdCode](const RemoteCommandDesc& cmd) { return cmd.cmdFourCC == cmdCode; });
-    if (cmdIdx != INVALID_INDEX) {
-        MutexScope mtx(gRemoteServices.clientMtx);
-        SocketTCP* sock = &gRemoteServices.clientSock;
-        if (sock->IsValid() && sock->IsConnected()) {
-            uint32 dataSize = static_cast<uint32>(data.Size());
-            const uint32 cmdHeader[] = {kCmdFlag, cmdCode, dataSize};
-            
-            Blob outgoing;      // TODO: use temp allocator
-            outgoing.Reserve(sizeof(cmdHeader) + dataSize);
-            outgoing.Write(cmdHeader, sizeof(cmdHeader));
-            if (dataSize)
-                outgoing.Write(data.Data(), dataSize);
-            sock->Write(outgoing.Data(), static_cast<uint32>(outgoing.Size()));
-            outgoing.Free();
-        }
-    }
-    else {
+    RemoteCommandDesc cmd;
+    if (!_FindCommand(cmdCode, &cmd)) {
         LOG_DEBUG("RemoteServices: Invalid command: 0x%x (%c%c%c%c)", cmdCode,
                   cmdCode&0xff, (cmdCode>>8)&0xff, (cmdCode>>16)&0xff, cmdCode>>24);
         ASSERT(0);
+        return 0;
+    }
+
+    // RequestId=0 is reserved for invalid/internal packets
+    uint32 requestId = Atomic::FetchAdd(&gRemoteServices.nextRequestId, 1) + 1;
+    if (requestId == 0)
+        requestId = Atomic::FetchAdd(&gRemoteServices.nextRequestId, 1) + 1;
+
+    ASSERT(data.Size() <= UINT32_MAX);
+    RemotePacketRequest header {
+        .flag = kCmdFlag,
+        .cmd = cmdCode,
+        .requestId = requestId
+    };
+    const SocketBuffer payload { data.Data(), uint32(data.Size()) };
+
+    MutexScope mtx(gRemoteServices.clientMtx);
+    SocketTCP* sock = &gRemoteServices.clientSock;
+    if (sock->IsValid() && sock->IsConnected()) {
+        if (_WritePacket(sock, &header, &payload, 1, gRemoteServices.clientCompress))
+            return requestId;
     }
+
+    return 0;
 }
 
 void Remote::RegisterCommand(const RemoteCommandDesc& desc)
 {
-    if (gRemoteServices.commands.FindIf([fourCC = desc.cmdFourCC](const RemoteCommandDesc& cmd)
-                                        { return cmd.cmdFourCC == fourCC; }) != INVALID_INDEX)
-    {
+    ReadWriteMutexWriteScope lock(gRemoteServices.commandsMtx);
+
+    if (gRemoteServices.commandsLookup.Find(desc.cmdFourCC) != UINT32_MAX) {
         LOG_ERROR("Remote command with FourCC 0x%x (%c%c%c%c) is already registered", desc.cmdFourCC,
                   desc.cmdFourCC&0xff, (desc.cmdFourCC>>8)&0xff, (desc.cmdFourCC>>16)&0xff, desc.cmdFourCC>>24);
         ASSERT(0);
         return;
     }
-    
+
+    gRemoteServices.commandsLookup.Add(desc.cmdFourCC, gRemoteServices.commands.Count());
     gRemoteServices.commands.Push(desc);
 }
 
-// MT: This function is thread-safe, but be aware of too many calls at the same time, because it locks the thread
-void Remote::SendResponse(uint32 cmdCode, const Blob& data, bool error, const char* errorDesc)
+// MT: This function is thread-safe. Responses are only queued, each client has its own writer thread
+void Remote::SendResponse(const RemoteRequest& req, uint32 cmdCode, const Blob& data, bool error, const char* errorDesc)
 {
-    Remote::SendResponseMerge(cmdCode, &data, 1, error, errorDesc);
+    Remote::SendResponseMerge(req, cmdCode, &data, 1, error, errorDesc);
 }
 
-void Remote::SendResponseMerge(uint32 cmdCode, const Blob* blobs, uint32 numBlobs, bool error, const char* errorDesc)
+void Remote::SendResponseMerge(const RemoteRequest& req, uint32 cmdCode, const Blob* blobs, uint32 numBlobs, bool error, const char* errorDesc)
 {
     ASSERT(numBlobs);
     ASSERT(blobs);
 
-    uint32 cmdIdx = gRemoteServices.commands.FindIf([cmdCode](const RemoteCommandDesc& cmd) { return cmd.cmdFourCC == cmdCode; });
-    if (cmdIdx != INVALID_INDEX) {
-        MutexScope mtx(gRemoteServices.serverPeerMtx);
-        SocketTCP* sock = &gRemoteServices.serverPeerSock;
-        if (sock->IsValid() && sock->IsConnected()) {
-            uint32 dataSize = 0;
-            for (uint32 i = 0; i < numBlobs; i++) {
-                ASSERT(blobs[i].Size() <= UINT32_MAX);
-                dataSize += uint32(blobs[i].Size());
-            }
+    // Peers are only removed with the write lock, so the peer stays alive until we are done writing
+    ReadWriteMutexReadScope lock(gRemoteServices.peersMtx);
+    uint32 peerIdx = gRemoteServices.peers.FindIf([peerId = req.peerId](const RemotePeer* p) { return p->id == peerId; });
+    if (peerIdx == UINT32_MAX) {
+        LOG_DEBUG("RemoteServices: Client (Id: %u) for response 0x%x is disconnected", req.peerId, cmdCode);
+        return;
+    }
 
-            const uint32 cmdHeader[] = {kCmdFlag, cmdCode, !error ? kResultOk : kResultError, dataSize};
-            
-            MemTempAllocator tmp;
-            Blob dataOut(&tmp);
-            dataOut.SetGrowPolicy(Blob::GrowPolicy::Multiply);
-            dataOut.Reserve(dataSize + sizeof(cmdHeader) + (error ? REMOTE_ERROR_SIZE : 0));
-            
-            dataOut.Write(cmdHeader, sizeof(cmdHeader));
-
-            for (uint32 i = 0; i < numBlobs; i++) {
-                if (blobs[i].Size())
-                    dataOut.Write(blobs[i].Data(), blobs[i].Size());
-            }
-            
-            // Append error message to the end
-            if (error) {
-                ASSERT(errorDesc);
-                dataOut.WriteStringBinary(errorDesc, Str::Len(errorDesc));
-            }
-            
-            sock->Write(dataOut.Data(), static_cast<uint32>(dataOut.Size()));
-            dataOut.Free();
+    RemotePeer* peer = gRemoteServices.peers[peerIdx];
+    if (peer->sock.IsValid() && peer->sock.IsConnected())
+        _WriteResponse(peer, req, cmdCode, blobs, numBlobs, error, errorDesc);
+}
+
+bool Remote::RunBenchmark(const char* url, uint32 numClients, uint32 numRequestsPerClient, uint32 payloadSize, bool compress,
+                          RemoteBenchmarkResult* outResult)
+{
+    ASSERT(outResult);
+    ASSERT(numClients);
+
+    // Leave one slot on the server for the regular client connection
+    numClients = Min(numClients, REMOTE_SERVER_MAX_PEERS - 1);
+
+    MemTempAllocator tmpAlloc;
+    BenchmarkClientData* clients = tmpAlloc.MallocZeroTyped<BenchmarkClientData>(numClients);
+    Thread* threads = NEW_ARRAY(&tmpAlloc, Thread, numClients);
+
+    // Payload is made of random words from a small dictionary, so it compresses roughly like text/baked data
+    uint8* payload = tmpAlloc.MallocTyped<uint8>(Max(payloadSize, 1u));
+    {
+        uint32 seed = 0x9E3779B9;
+        auto Random = [&seed]()->uint32 { seed = seed*1664525u + 1013904223u; return seed >> 8; };
+
+        uint8 words[64][8];
+        for (uint32 i = 0; i < CountOf(words); i++) {
+            for (uint32 k = 0; k < CountOf(words[i]); k++)
+                words[i][k] = uint8(Random());
         }
+
+        for (uint32 i = 0; i < payloadSize; i++)
+            payload[i] = (Random() & 0x3) == 0 ? uint8(Random()) : words[(i >> 3) % 64 ^ (Random() & 0x3)][i & 7];
     }
-    else {
-        LOG_DEBUG("RemoteServices: Invalid command: 0x%x", cmdCode);
-        ASSERT(0);
+
+    TimerStopWatch stopwatch;
+    for (uint32 i = 0; i < numClients; i++) {
+        clients[i] = BenchmarkClientData {
+            .url = url,
+            .payload = payload,
+            .numRequests = numRequestsPerClient,
+            .payloadSize = payloadSize,
+            .compress = compress
+        };
+
+        threads[i].Start(ThreadDesc {
+            .entryFn = _BenchmarkClientThreadFn,
+            .userData = &clients[i],
+            .name = "RemoteBenchmarkClient"
+        });
+    }
+
+    uint32 numFailed = 0;
+    for (uint32 i = 0; i < numClients; i++) {
+        if (threads[i].Stop() != 0)
+            ++numFailed;
     }
+    double durationMS = stopwatch.ElapsedMS();
+
+    *outResult = RemoteBenchmarkResult {
+        .numClients = numClients,
+        .durationMS = float(durationMS)
+    };
+
+    for (uint32 i = 0; i < numClients; i++) {
+        outResult->numRequests += clients[i].numCompleted;
+        outResult->numBytes += clients[i].numBytes;
+        outResult->numWireBytes += clients[i].numWireBytes;
+    }
+
+    if (durationMS > 0) {
+        outResult->requestsPerSec = float(double(outResult->numRequests)*1000.0/durationMS);
+        outResult->megabytesPerSec = float(double(outResult->numBytes)/double(SIZE_MB)*1000.0/durationMS);
+    }
+
+    if (numFailed)
+        LOG_WARNING("RemoteServices: %u benchmark clients failed to connect to '%s'", numFailed, url);
+    return numFailed < numClients;
 }
 
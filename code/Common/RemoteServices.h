@@ -6,11 +6,24 @@
 struct Blob;
 
 static constexpr uint32 REMOTE_ERROR_SIZE = 1024;
+static constexpr uint32 REMOTE_SERVER_MAX_PEERS = 64;
 
-// Note: These Handlers are called from RemoteServices worker threads, implementations should consider making their state thread-safe
-using RemoteCommandServerHandlerCallback = bool(*)(uint32 cmd, const Blob& incomingData, Blob* outgoingData, 
+// Identifies an incoming request on the server. Async handlers keep a copy of it and pass it to `Remote::SendResponse`
+// so the reply is routed to the right client and matched with the request, responses can be sent in any order
+struct RemoteRequest
+{
+    uint32 peerId;
+    uint32 requestId;
+};
+
+// Note: Payloads larger than a few KB are LZ compressed on the wire when both sides agree on it during the handshake
+//       (see SettingsEngine::remoteServicesCompress). Handlers always receive and return uncompressed data
+// Note: Server handlers are called from the RemoteServices server thread and client handlers are called from client thread
+//       Implementations should consider making their state thread-safe
+//       Responses are queued and written to each client by its own writer thread, so handlers never block on the socket
+using RemoteCommandServerHandlerCallback = bool(*)(uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, 
                                                    void* userData, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
-using RemoteCommandClientHandlerCallback = void(*)(uint32 cmd, const Blob& incomingData,
+using RemoteCommandClientHandlerCallback = void(*)(uint32 cmd, uint32 requestId, const Blob& incomingData,
                                                    void* userData, bool error, const char* errorDesc);
 using RemoteDisconnectCallback = void(*)(const char* url, bool onPurpose, SocketErrorCode::Enum errCode);
 
@@ -24,13 +37,31 @@ struct RemoteCommandDesc
     bool async;     // This means that server doesn't return immediate results, they are sent with `Remote::SendResponse`
 };
 
+struct RemoteBenchmarkResult
+{
+    uint32 numClients;
+    uint32 numRequests;     // Total number of requests completed by all clients
+    uint64 numBytes;        // Total payload bytes sent and received
+    uint64 numWireBytes;    // Total payload bytes that went through the sockets (after compression)
+    float durationMS;
+    float requestsPerSec;
+    float megabytesPerSec;
+};
+
 namespace Remote
 {
     API void RegisterCommand(const RemoteCommandDesc& desc);
-    API void ExecuteCommand(uint32 cmdCode, const Blob& data);
+
+    // Returns the requestId that is passed to the client handler with the response. Returns 0 if the command is not sent
+    API uint32 ExecuteCommand(uint32 cmdCode, const Blob& data);
     API bool IsConnected();
-    API void SendResponse(uint32 cmdCode, const Blob& data, bool error, const char* errorDesc);
-    API void SendResponseMerge(uint32 cmdCode, const Blob* blobs, uint32 numBlobs, bool error, const char* errorDesc);
+    API void SendResponse(const RemoteRequest& req, uint32 cmdCode, const Blob& data, bool error, const char* errorDesc);
+    API void SendResponseMerge(const RemoteRequest& req, uint32 cmdCode, const Blob* blobs, uint32 numBlobs, bool error, const char* errorDesc);
+
+    // Opens `numClients` connections to the server at `url` and pipelines echo requests on all of them
+    // Useful for measuring the server throughput over the loopback: "localhost:port"
+    API bool RunBenchmark(const char* url, uint32 numClients, uint32 numRequestsPerClient, uint32 payloadSize, bool compress,
+                          RemoteBenchmarkResult* outResult);
 
     API bool Initialize();
     API void Release();
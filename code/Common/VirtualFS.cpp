@@ -10,6 +10,7 @@
 #include "../Core/Arrays.h"
 #include "../Core/Allocators.h"
 #include "../Core/Hash.h"
+#include "../Core/Jobs.h"
 
 #include "../Engine.h"
 
@@ -26,11 +27,13 @@
 //    ╚██████╔╝███████╗╚██████╔╝██████╔╝██║  ██║███████╗███████║
 //     ╚═════╝ ╚══════╝ ╚═════╝ ╚═════╝ ╚═╝  ╚═╝╚══════╝╚══════╝
                                                               
-static constexpr uint32 VFS_REMOTE_READ_FILE_CMD = MakeFourCC('F', 'R', 'D', '0');
+static constexpr uint32 VFS_REMOTE_READ_FILES_CMD = MakeFourCC('F', 'R', 'D', 'B');
 static constexpr uint32 VFS_REMOTE_WRITE_FILE_CMD = MakeFourCC('F', 'W', 'T', '0');
 static constexpr uint32 VFS_REMOTE_READ_FILE_INFO_CMD = MakeFourCC('F', 'I', 'N', 'F');
 static constexpr uint32 VFS_REMOTE_MONITOR_CHANGES_CMD = MakeFourCC('D', 'M', 'O', 'N');
 static constexpr uint32 VFS_REMOTE_MONITOR_CHANGES_INTERVAL = 1000;
+static constexpr size_t VFS_REMOTE_CACHE_MAX_SIZE = 64*SIZE_MB;
+static constexpr size_t VFS_REMOTE_CACHE_MAX_FILE_SIZE = 8*SIZE_MB;
 
 struct VfsMountPoint
 {
@@ -73,14 +76,46 @@ struct VfsAsyncManager
 {
     Semaphore semaphore;
     Thread thread;
-    Array<VfsFileReadWriteRequest> requests;
+    RingQueue<VfsFileReadWriteRequest> requests;
     Mutex requestsMtx;
 };
 
+// Client-side copy of a remote file. Entries are validated against the server's modification time
+// On watched mounts, they are also evicted by file change notifications and served without going to the network
+struct VfsRemoteCacheEntry
+{
+    Path path;          // Without the leading '/'. Compared on lookups, the hash only rejects mismatches early
+    uint32 pathHash;
+    uint64 lastModified;
+    uint64 lastUsed;    // Least recently used entries are evicted first when the cache is full
+    Blob data;
+};
+
+// Server-side state for every file of a batched read request, until it's read from disk and sent back
+struct VfsRemoteReadFileRequest
+{
+    RemoteRequest req;
+    uint64 lastModified;
+};
+
 struct VfsRemoteManager
 {
     Mutex requestsMtx;
     Array<VfsFileReadWriteRequest> requests;
+
+    Mutex cacheMtx;
+    Array<VfsRemoteCacheEntry> cache;
+    size_t cacheSize;
+    uint64 cacheTick;
+};
+
+// Blobs returned by VfsFlags::Mapped use this allocator, so Blob::Free unmaps the file instead of freeing memory
+struct VfsMappedFileAllocator final : MemAllocator
+{
+    void* Malloc(size_t, uint32) override { ASSERT_MSG(0, "Mapped file blobs cannot allocate memory"); return nullptr; }
+    void* Realloc(void*, size_t, uint32) override { ASSERT_MSG(0, "Mapped file blobs are read-only and cannot be resized"); return nullptr; }
+    void  Free(void* ptr, uint32) override;
+    MemAllocatorType GetType() const override { return MemAllocatorType::Unknown; }
 };
 
 struct VfsManager
@@ -97,12 +132,30 @@ struct VfsManager
     VfsAsyncManager asyncMgr;
     VfsRemoteManager remoteMgr;
 
+    VfsMappedFileAllocator mappedAlloc;
+    SpinLockMutex mappedFilesMtx;
+    Array<MappedFile> mappedFiles;
+
     bool quit;
     bool initialized;
 };
 
 static VfsManager gVfs;
 
+void VfsMappedFileAllocator::Free(void* ptr, uint32)
+{
+    if (!ptr)
+        return;
+
+    SpinLockMutexScope lock(gVfs.mappedFilesMtx);
+    uint32 index = gVfs.mappedFiles.FindIf([ptr](const MappedFile& mf) { return mf.Data() == ptr; });
+    ASSERT_MSG(index != UINT32_MAX, "Pointer is not a mapped file");
+    if (index != UINT32_MAX) {
+        gVfs.mappedFiles[index].Close();
+        gVfs.mappedFiles.RemoveAndSwap(index);
+    }
+}
+
 #if CONFIG_TOOLMODE
     #define DMON_IMPL
     #define DMON_MALLOC(size) Mem::Alloc(size, &gVfs.alloc)
@@ -125,18 +178,24 @@ namespace Vfs
     static uint32 _FindMount(const char* path);
     static uint32 _ResolveDiskPath(char* dstPath, uint32 dstPathSize, const char* path, VfsFlags flags);
     static Blob _DiskReadFile(const char* path, VfsFlags flags, MemAllocator* alloc, Path* outResolvedPath = nullptr);
+    static Blob _DiskMapFile(const char* path);
     static size_t _DiskWriteFile(const char* path, VfsFlags flags, const Blob& blob);
-    static void _MonitorChangesClientCallback(uint32 cmd, const Blob& incomingData, void*, bool error, const char* errorDesc);
-    static bool _MonitorChangesServerCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
+    static void _MonitorChangesClientCallback(uint32 cmd, uint32 requestId, const Blob& incomingData, void*, bool error, const char* errorDesc);
+    static bool _MonitorChangesServerCallback([[maybe_unused]] uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
     static int _AsyncWorkerThread(void*);
-    static void _RemoteReadFileComplete(const char* path, const Blob& blob, void*);
+    static void _RemoteReadFilesComplete(const char* path, const Blob& blob, void*);
     static void _RemoteWriteFileComplete(const char* path, size_t bytesWritten, Blob&, void*);
-    static bool _ReadFileHandlerServerFn(uint32 cmd, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
-    static bool _ReadFileInfoHandlerServerFn(uint32 cmd, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
-    static bool _WriteFileHandlerServerFn(uint32 cmd, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
-    static void _ReadFileHandlerClientFn([[maybe_unused]] uint32 cmd, const Blob& incomingData, void* userData, bool error, const char* errorDesc);
-    static void _ReadFileInfoHandlerClientFn([[maybe_unused]] uint32 cmd, const Blob& incomingData, void* userData, bool error, const char* errorDesc);
-    static void _WriteFileHandlerClientFn([[maybe_unused]] uint32 cmd, const Blob& incomingData, void* userData, bool error, const char* errorDesc);
+    static bool _ReadFilesHandlerServerFn(uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
+    static bool _ReadFileInfoHandlerServerFn([[maybe_unused]] uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
+    static bool _WriteFileHandlerServerFn(uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE]);
+    static void _ReadFilesHandlerClientFn([[maybe_unused]] uint32 cmd, uint32 requestId, const Blob& incomingData, void* userData, bool error, const char* errorDesc);
+    static void _ReadFileInfoHandlerClientFn([[maybe_unused]] uint32 cmd, uint32 requestId, const Blob& incomingData, void* userData, bool error, const char* errorDesc);
+    static void _WriteFileHandlerClientFn([[maybe_unused]] uint32 cmd, uint32 requestId, const Blob& incomingData, void* userData, bool error, const char* errorDesc);
+    static void _RemoteReadFiles(const char** paths, uint32 numPaths, VfsFlags flags, VfsReadAsyncCallback readResultFn, void* user, MemAllocator* alloc);
+    static Blob _RemoteCopyFileData(const void* data, size_t size, VfsFlags flags, MemAllocator* alloc);
+    static uint32 _RemoteCacheFind(const char* path);
+    static void _RemoteCacheStore(const char* path, uint64 lastModified, const void* data, size_t size);
+    static void _RemoteCacheEvict(const char* path);
 
     #if CONFIG_TOOLMODE
     static void _DmonCallback(dmon_watch_id watchId, dmon_action action, const char* rootDir, const char* filepath, const char*, void*);
@@ -332,9 +391,30 @@ static uint32 Vfs::_ResolveDiskPath(char* dstPath, uint32 dstPathSize, const cha
     return index;
 }
 
+static Blob Vfs::_DiskMapFile(const char* path)
+{
+    MappedFile mf;
+    if (!mf.Open(path, MappedFileFlags::Prefetch))
+        return Blob();
+
+    Blob blob;
+    blob.Attach(const_cast<void*>(mf.Data()), mf.GetSize(), &gVfs.mappedAlloc);
+
+    SpinLockMutexScope lock(gVfs.mappedFilesMtx);
+    gVfs.mappedFiles.Push(mf);
+    return blob;
+}
+
 static Blob Vfs::_DiskReadFile(const char* path, VfsFlags flags, MemAllocator* alloc, Path* outResolvedPath)
 {
     auto LoadFromDisk = [](const char* path, VfsFlags flags, MemAllocator* alloc)->Blob {
+        // Empty files or failed mappings fall back to the regular read
+        if ((flags & (VfsFlags::Mapped|VfsFlags::TextFile)) == VfsFlags::Mapped) {
+            Blob blob = _DiskMapFile(path);
+            if (blob.IsValid())
+                return blob;
+        }
+
         File f;
         Blob blob(alloc ? alloc : &gVfs.alloc);
 
@@ -361,9 +441,15 @@ static Blob Vfs::_DiskReadFile(const char* path, VfsFlags flags, MemAllocator* a
     ASSERT_MSG(GetMountType(path) != VfsMountType::Remote, "Remote mounts cannot read files in blocking mode");
 
     char resolvedPath[PATH_CHARS_MAX];
-    if (_ResolveDiskPath(resolvedPath, sizeof(resolvedPath), path, flags) != UINT32_MAX) {
+    uint32 mountIdx = _ResolveDiskPath(resolvedPath, sizeof(resolvedPath), path, flags);
+    if (mountIdx != UINT32_MAX) {
         if (outResolvedPath)
             *outResolvedPath = resolvedPath;
+
+        // Watched mounts are edited while we are running: A mapping faults (SIGBUS) if the file gets truncated and 
+        // on Windows, it keeps the editors from saving the file (sharing violation). So always copy them
+        if (gVfs.mounts[mountIdx].watchId)
+            flags &= ~VfsFlags::Mapped;
         return LoadFromDisk(resolvedPath, flags, alloc);
     }
     else {
@@ -704,7 +790,7 @@ static void Vfs::_DmonCallback(dmon_watch_id watchId, dmon_action action, const
 }
 #endif // CONFIG_TOOLMODE
 
-static void Vfs::_MonitorChangesClientCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, void*, bool error, const char* errorDesc)
+static void Vfs::_MonitorChangesClientCallback([[maybe_unused]] uint32 cmd, uint32, const Blob& incomingData, void*, bool error, const char* errorDesc)
 {
     ASSERT(cmd == VFS_REMOTE_MONITOR_CHANGES_CMD);
     UNUSED(error);
@@ -727,6 +813,8 @@ static void Vfs::_MonitorChangesClientCallback([[maybe_unused]] uint32 cmd, cons
             });
 
             if (index != UINT32_MAX && gVfs.mounts[index].type == VfsMountType::Remote && gVfs.mounts[index].watchId) {
+                _RemoteCacheEvict(filepath);
+
                 for (uint32 k = 0; k < gVfs.fileChangeCallbacks.Count(); k++ ) {
                     VfsFileChangeCallback callback = gVfs.fileChangeCallbacks[k];
                     callback(filepath);
@@ -736,7 +824,7 @@ static void Vfs::_MonitorChangesClientCallback([[maybe_unused]] uint32 cmd, cons
     }
 }
 
-static bool Vfs::_MonitorChangesServerCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, Blob* outgoingData, 
+static bool Vfs::_MonitorChangesServerCallback([[maybe_unused]] uint32 cmd, const RemoteRequest&, const Blob& incomingData, Blob* outgoingData, 
                                             void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE])
 {
     ASSERT(cmd == VFS_REMOTE_MONITOR_CHANGES_CMD);
@@ -775,8 +863,8 @@ static int Vfs::_AsyncWorkerThread(void*)
         bool haveReq = false;
         {
             MutexScope mtx(mgr->requestsMtx);
-            if (mgr->requests.Count()) {
-                req = mgr->requests.PopFirst();
+            if (!mgr->requests.IsEmpty()) {
+                req = mgr->requests.PopFront();
                 haveReq = true;
             }
         }
@@ -788,6 +876,8 @@ static int Vfs::_AsyncWorkerThread(void*)
                 Blob blob;
                 if (req.mountType == VfsMountType::Local)
                     blob = _DiskReadFile(req.path.CStr(), req.flags, req.alloc);
+                else if (req.mountType == VfsMountType::Remote)
+                    blob = req.blob;    // Served from the remote cache, see _RemoteReadFiles
                 #if PLATFORM_MOBILE
                 else if (req.mountType == VfsMountType::PackageBundle)
                     blob = _PackageBundleReadFile(req.path.CStr(), req.flags, req.alloc);
@@ -821,50 +911,99 @@ static int Vfs::_AsyncWorkerThread(void*)
 
 void Vfs::ReadFileAsync(const char* path, VfsFlags flags, VfsReadAsyncCallback readResultFn, void* user, MemAllocator* alloc)
 {
-    ASSERT(gVfs.initialized);
+    ReadFilesAsync(&path, 1, flags, readResultFn, user, alloc);
+}
 
-    VfsFileReadWriteRequest req {
-        .cmd = VfsCommand::Read,
-        .flags = flags,
-        .path = path,
-        .alloc = alloc,
-        .user = user,
-        .callbacks = { .readFn = readResultFn }
-    };
+Blob Vfs::ReadFileAwait(const char* path, VfsFlags flags, MemAllocator* alloc)
+{
+    // Suspending needs a job that can move between threads, otherwise we would only be blocking the worker with extra steps
+    if (!gVfs.initialized || !Jobs::IsRunningOnCurrentThread() || MemTempAllocator::IsActive())
+        return ReadFile(path, flags, alloc);
 
-    uint32 idx = _FindMount(path);
-    if (idx != UINT32_MAX && gVfs.mounts[idx].type == VfsMountType::Remote) {
-        if (Remote::IsConnected()) {
-            req.mountType = VfsMountType::Remote;
+    struct AwaitData
+    {
+        JobsEvent event;
+        Blob blob;
+    };
 
-            {
-                VfsRemoteManager* mgr = &gVfs.remoteMgr;
-                MutexScope mtx(mgr->requestsMtx);
-                mgr->requests.Push(req);
-            }
+    AwaitData data;
+    data.event.Initialize();
 
-            MemTempAllocator tmpAlloc;
-            Blob paramsBlob;
-            paramsBlob.SetAllocator(&tmpAlloc);
-            paramsBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
+    ReadFileAsync(path, flags, [](const char*, const Blob& blob, void* userData) {
+        AwaitData* data = (AwaitData*)userData;
+        if (blob.IsValid())
+            const_cast<Blob&>(blob).MoveTo(&data->blob);
+        data->event.Raise();
+    }, &data, alloc);
 
-            paramsBlob.WriteStringBinary(path, Str::Len(path));
+    data.event.Wait();
+    data.event.Release();
+    return data.blob;
+}
 
-            Remote::ExecuteCommand(VFS_REMOTE_READ_FILE_CMD, paramsBlob);
-            paramsBlob.Free();
+void Vfs::ReadFilesAsync(const char** paths, uint32 numPaths, VfsFlags flags, VfsReadAsyncCallback readResultFn, void* user, MemAllocator* alloc)
+{
+    ASSERT(gVfs.initialized);
+    ASSERT(readResultFn);
+
+    // Remote files are gathered and requested from the server with a single batch
+    MemTempAllocator tmpAlloc;
+    const char** remotePaths = tmpAlloc.MallocTyped<const char*>(numPaths);
+    uint32 numRemotePaths = 0;
+    uint32 numDiskRequests = 0;
+
+    for (uint32 i = 0; i < numPaths; i++) {
+        const char* path = paths[i];
+        uint32 idx = _FindMount(path);
+        if (idx != UINT32_MAX && gVfs.mounts[idx].type == VfsMountType::Remote) {
+            if (Remote::IsConnected())
+                remotePaths[numRemotePaths++] = path;
+            else
+                LOG_WARNING("Mount point '%s' connection has lost, file '%s' cannot be loaded", gVfs.mounts[idx].path.CStr(), path);
         }
         else {
-            LOG_WARNING("Mount point '%s' connection has lost, file '%s' cannot be loaded", gVfs.mounts[idx].path.CStr(), path);
+            VfsFileReadWriteRequest req {
+                .mountType = idx != UINT32_MAX ? gVfs.mounts[idx].type : VfsMountType::Local,
+                .cmd = VfsCommand::Read,
+                .flags = flags,
+                .path = path,
+                .alloc = alloc,
+                .user = user,
+                .callbacks = { .readFn = readResultFn }
+            };
+
+            VfsAsyncManager* diskMgr = &gVfs.asyncMgr;
+            MutexScope mtx(diskMgr->requestsMtx);
+            diskMgr->requests.PushBack(req);
+            ++numDiskRequests;
         }
     }
-    else {
-        req.mountType = idx != UINT32_MAX ? gVfs.mounts[idx].type : VfsMountType::Local;
 
-        VfsAsyncManager* diskMgr = &gVfs.asyncMgr;
-        MutexScope mtx(diskMgr->requestsMtx);
-        diskMgr->requests.Push(req);
-        diskMgr->semaphore.Post();
+    if (numRemotePaths)
+        _RemoteReadFiles(remotePaths, numRemotePaths, flags, readResultFn, user, alloc);
+
+    for (uint32 i = 0; i < numDiskRequests; i++)
+        gVfs.asyncMgr.semaphore.Post();
+}
+
+void Vfs::PrefetchFiles(const char** paths, uint32 numPaths)
+{
+    ASSERT(gVfs.initialized);
+    if (!Remote::IsConnected())
+        return;
+
+    MemTempAllocator tmpAlloc;
+    const char** remotePaths = tmpAlloc.MallocTyped<const char*>(numPaths);
+    uint32 numRemotePaths = 0;
+    for (uint32 i = 0; i < numPaths; i++) {
+        uint32 idx = _FindMount(paths[i]);
+        if (idx != UINT32_MAX && gVfs.mounts[idx].type == VfsMountType::Remote)
+            remotePaths[numRemotePaths++] = paths[i];
     }
+
+    // Requests without callbacks only fill the client-side cache
+    if (numRemotePaths)
+        _RemoteReadFiles(remotePaths, numRemotePaths, VfsFlags::None, nullptr, nullptr, nullptr);
 }
 
 void Vfs::WriteFileAsync(const char* path, const Blob& blob, VfsFlags flags, VfsWriteAsyncCallback writeResultFn, void* user)
@@ -925,7 +1064,7 @@ void Vfs::WriteFileAsync(const char* path, const Blob& blob, VfsFlags flags, Vfs
 
         {
             MutexScope mtx(diskMgr->requestsMtx);
-            diskMgr->requests.Push(req);
+            diskMgr->requests.PushBack(req);
         }
         
         diskMgr->semaphore.Post();
@@ -939,31 +1078,198 @@ void Vfs::WriteFileAsync(const char* path, const Blob& blob, VfsFlags flags, Vfs
 //    ██╔══██╗██╔══╝  ██║╚██╔╝██║██║   ██║   ██║   ██╔══╝      ██║██║   ██║
 //    ██║  ██║███████╗██║ ╚═╝ ██║╚██████╔╝   ██║   ███████╗    ██║╚██████╔╝
 //    ╚═╝  ╚═╝╚══════╝╚═╝     ╚═╝ ╚═════╝    ╚═╝   ╚══════╝    ╚═╝ ╚═════╝ 
-static void Vfs::_RemoteReadFileComplete(const char* path, const Blob& blob, void*)
+// Caller should lock cacheMtx
+static uint32 Vfs::_RemoteCacheFind(const char* path)
 {
-    bool error = !blob.IsValid();
-    char errorDesc[REMOTE_ERROR_SIZE];   errorDesc[0] = '\0';
-    if (error)
-        Str::Copy(errorDesc, sizeof(errorDesc), path);
+    if (path[0] == '/')
+        ++path;
+    uint32 pathHash = Hash::Fnv32Str(path);
+    return gVfs.remoteMgr.cache.FindIf([path, pathHash](const VfsRemoteCacheEntry& e) 
+        { return e.pathHash == pathHash && e.path.IsEqual(path); });
+}
 
+static void Vfs::_RemoteCacheStore(const char* path, uint64 lastModified, const void* data, size_t size)
+{
+    VfsRemoteManager* mgr = &gVfs.remoteMgr;
+    MutexScope mtx(mgr->cacheMtx);
+
+    uint32 index = _RemoteCacheFind(path);
+    if (size > VFS_REMOTE_CACHE_MAX_FILE_SIZE) {
+        if (index != UINT32_MAX) {
+            mgr->cacheSize -= mgr->cache[index].data.Size();
+            mgr->cache[index].data.Free();
+            mgr->cache.RemoveAndSwap(index);
+        }
+        return;
+    }
 
-    if (!error) {
+    VfsRemoteCacheEntry* entry;
+    if (index != UINT32_MAX) {
+        entry = &mgr->cache[index];
+        mgr->cacheSize -= entry->data.Size();
+        entry->data.Free();
+    }
+    else {
+        if (path[0] == '/')
+            ++path;
+        entry = mgr->cache.Push();
+        *entry = { .path = path, .pathHash = Hash::Fnv32Str(path) };
+    }
+
+    entry->lastModified = lastModified;
+    entry->lastUsed = ++mgr->cacheTick;
+    entry->data.SetAllocator(&gVfs.alloc);
+    entry->data.Reserve(Max<size_t>(size, 1));
+    entry->data.Write(data, size);
+    mgr->cacheSize += size;
+
+    // Evict least recently used entries until we are under the budget
+    while (mgr->cacheSize > VFS_REMOTE_CACHE_MAX_SIZE) {
+        uint32 lruIndex = 0;
+        for (uint32 i = 1; i < mgr->cache.Count(); i++) {
+            if (mgr->cache[i].lastUsed < mgr->cache[lruIndex].lastUsed)
+                lruIndex = i;
+        }
+        mgr->cacheSize -= mgr->cache[lruIndex].data.Size();
+        mgr->cache[lruIndex].data.Free();
+        mgr->cache.RemoveAndSwap(lruIndex);
+    }
+}
+
+static void Vfs::_RemoteCacheEvict(const char* path)
+{
+    VfsRemoteManager* mgr = &gVfs.remoteMgr;
+    MutexScope mtx(mgr->cacheMtx);
+    if (uint32 index = _RemoteCacheFind(path); index != UINT32_MAX) {
+        mgr->cacheSize -= mgr->cache[index].data.Size();
+        mgr->cache[index].data.Free();
+        mgr->cache.RemoveAndSwap(index);
+    }
+}
+
+static Blob Vfs::_RemoteCopyFileData(const void* data, size_t size, VfsFlags flags, MemAllocator* alloc)
+{
+    Blob blob(alloc ? alloc : &gVfs.alloc);
+    bool isText = (flags & VfsFlags::TextFile) == VfsFlags::TextFile;
+    blob.Reserve(size + (isText ? 1 : 0));
+    blob.Write(data, size);
+    if (isText)
+        blob.Write<char>('\0');
+    return blob;
+}
+
+static void Vfs::_RemoteReadFiles(const char** paths, uint32 numPaths, VfsFlags flags, VfsReadAsyncCallback readResultFn, void* user, 
+                                  MemAllocator* alloc)
+{
+    VfsRemoteManager* mgr = &gVfs.remoteMgr;
+
+    // Request: numFiles + {path, cachedLastModified}[numFiles]
+    //          cachedLastModified is non-zero if we have a cached copy. Server doesn't send the data back if it's not modified
+    MemTempAllocator tmpAlloc;
+    Blob paramsBlob(&tmpAlloc);
+    paramsBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
+    paramsBlob.Write<uint32>(0);
+    uint32 numRequested = 0;
+    uint32 numServedFromCache = 0;
+
+    for (uint32 i = 0; i < numPaths; i++) {
+        const char* path = paths[i];
+        uint32 mountIdx = _FindMount(path);
+        ASSERT(mountIdx != UINT32_MAX);
+        bool isWatched = gVfs.mounts[mountIdx].watchId != 0;
+
+        VfsFileReadWriteRequest req {
+            .mountType = VfsMountType::Remote,
+            .cmd = VfsCommand::Read,
+            .flags = flags,
+            .path = path,
+            .alloc = alloc,
+            .user = user,
+            .callbacks = { .readFn = readResultFn }
+        };
+
+        uint64 cachedLastModified = 0;
+        {
+            MutexScope mtx(mgr->cacheMtx);
+            if (uint32 index = _RemoteCacheFind(path); index != UINT32_MAX) {
+                VfsRemoteCacheEntry& entry = mgr->cache[index];
+                entry.lastUsed = ++mgr->cacheTick;
+                cachedLastModified = entry.lastModified;
+                if (readResultFn)
+                    req.blob = _RemoteCopyFileData(entry.data.Data(), entry.data.Size(), flags, alloc);
+            }
+        }
+
+        // Watched mounts get change notifications that evict the cache, so cached files are up to date: skip the network
+        if (cachedLastModified && isWatched) {
+            if (readResultFn) {
+                VfsAsyncManager* diskMgr = &gVfs.asyncMgr;
+                MutexScope mtx(diskMgr->requestsMtx);
+                diskMgr->requests.PushBack(req);
+                ++numServedFromCache;
+            }
+            continue;
+        }
+
+        // If the same file is already in flight (prefetched or requested by someone else), wait for that response instead
+        bool isPending;
+        {
+            MutexScope mtx(mgr->requestsMtx);
+            isPending = mgr->requests.FindIf([path](const VfsFileReadWriteRequest& r) 
+                { return r.cmd == VfsCommand::Read && r.path.IsEqual(path); }) != UINT32_MAX;
+            if (readResultFn || !isPending)
+                mgr->requests.Push(req);
+        }
+
+        if (!isPending) {
+            paramsBlob.WriteStringBinary(path, Str::Len(path));
+            paramsBlob.Write<uint64>(cachedLastModified);
+            ++numRequested;
+        }
+    }
+
+    for (uint32 i = 0; i < numServedFromCache; i++)
+        gVfs.asyncMgr.semaphore.Post();
+
+    if (numRequested) {
+        *reinterpret_cast<uint32*>(const_cast<void*>(paramsBlob.Data())) = numRequested;
+        Remote::ExecuteCommand(VFS_REMOTE_READ_FILES_CMD, paramsBlob);
+    }
+    paramsBlob.Free();
+}
+
+static void Vfs::_RemoteReadFilesComplete(const char* path, const Blob& blob, void* user)
+{
+    // Allocated in _ReadFilesHandlerServerFn
+    VfsRemoteReadFileRequest* fileReq = reinterpret_cast<VfsRemoteReadFileRequest*>(user);
+    ASSERT(fileReq);
+
+    if (blob.IsValid()) {
+        // Response: path + lastModified + notModified + file data
         MemTempAllocator tmpAlloc;
-        Blob responseBlob;
-        responseBlob.SetAllocator(&tmpAlloc);      // TODO: use temp allocator
+        Blob responseBlob(&tmpAlloc);
         responseBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
         responseBlob.WriteStringBinary(path, Str::Len(path));
-        responseBlob.Write(blob.Data(), blob.Size());
-        Remote::SendResponse(VFS_REMOTE_READ_FILE_CMD, responseBlob, error, errorDesc);
+        responseBlob.Write<uint64>(fileReq->lastModified);
+        responseBlob.Write<uint8>(0);
+
+        const Blob blobs[] = {responseBlob, blob};
+        Remote::SendResponseMerge(fileReq->req, VFS_REMOTE_READ_FILES_CMD, blobs, CountOf(blobs), false, nullptr);
         responseBlob.Free();
     }
     else {
-        Remote::SendResponse(VFS_REMOTE_READ_FILE_CMD, blob, error, errorDesc); 
+        Remote::SendResponse(fileReq->req, VFS_REMOTE_READ_FILES_CMD, blob, true, path); 
     }
+
+    Mem::Free(fileReq, &gVfs.alloc);
 }
 
-static void Vfs::_RemoteWriteFileComplete(const char* path, size_t bytesWritten, Blob&, void*)
+static void Vfs::_RemoteWriteFileComplete(const char* path, size_t bytesWritten, Blob&, void* user)
 {
+    // Copy of the request that is allocated in _WriteFileHandlerServerFn
+    RemoteRequest* req = reinterpret_cast<RemoteRequest*>(user);
+    ASSERT(req);
+
     bool error = bytesWritten == 0;
     char errorDesc[REMOTE_ERROR_SIZE];   errorDesc[0] = '\0';
     if (error)
@@ -974,35 +1280,69 @@ static void Vfs::_RemoteWriteFileComplete(const char* path, size_t bytesWritten,
         Blob responseBlob;
         responseBlob.SetAllocator(&tmpAlloc);      // TODO: use temp allocator
         responseBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
-        responseBlob.Write(path, Str::Len(path));
+        responseBlob.WriteStringBinary(path, Str::Len(path));
         responseBlob.Write<size_t>(bytesWritten);
 
-        Remote::SendResponse(VFS_REMOTE_WRITE_FILE_CMD, responseBlob, error, errorDesc);
+        Remote::SendResponse(*req, VFS_REMOTE_WRITE_FILE_CMD, responseBlob, error, errorDesc);
         responseBlob.Free();
     }
     else {
-        Remote::SendResponse(VFS_REMOTE_WRITE_FILE_CMD, Blob(), error, errorDesc); 
+        Remote::SendResponse(*req, VFS_REMOTE_WRITE_FILE_CMD, Blob(), error, errorDesc); 
     }
+
+    Mem::Free(req, &gVfs.alloc);
 }
 
-static bool Vfs::_ReadFileHandlerServerFn(uint32 cmd, const Blob& incomingData, Blob* outgoingData, 
-                                          void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE])
+static bool Vfs::_ReadFilesHandlerServerFn(uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, 
+                                           void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE])
 {
-    ASSERT(cmd == VFS_REMOTE_READ_FILE_CMD);
-    UNUSED(cmd);
+    ASSERT(cmd == VFS_REMOTE_READ_FILES_CMD);
     UNUSED(outgoingData);
     UNUSED(outgoingErrorDesc);
 
-    char filepath[PATH_CHARS_MAX]; 
-    incomingData.ReadStringBinary(filepath, sizeof(filepath));
+    uint32 numFiles = 0;
+    incomingData.Read<uint32>(&numFiles);
 
-    // The async process finished when the program returns into the callback `vfsRemoteReadFileComplete`
-    ReadFileAsync(filepath, VfsFlags::None, _RemoteReadFileComplete, nullptr, &gVfs.alloc);
+    // Every file is responded separately as soon as it's read, so the client can start processing the first ones early
+    for (uint32 i = 0; i < numFiles; i++) {
+        char filepath[PATH_CHARS_MAX];
+        uint64 cachedLastModified = 0;
+        incomingData.ReadStringBinary(filepath, sizeof(filepath));
+        incomingData.Read<uint64>(&cachedLastModified);
+
+        ASSERT_MSG(GetMountType(filepath) != VfsMountType::Remote, "Remote mounts cannot read files in this mode");
+        PathInfo info = GetFileInfo(filepath);
+        if (info.type != PathType::File) {
+            Remote::SendResponse(req, cmd, Blob(), true, filepath);
+            continue;
+        }
+
+        if (cachedLastModified && cachedLastModified == info.lastModified) {
+            MemTempAllocator tmpAlloc;
+            Blob responseBlob(&tmpAlloc);
+            responseBlob.SetGrowPolicy(Blob::GrowPolicy::Multiply);
+            responseBlob.WriteStringBinary(filepath, Str::Len(filepath));
+            responseBlob.Write<uint64>(info.lastModified);
+            responseBlob.Write<uint8>(1);
+            Remote::SendResponse(req, cmd, responseBlob, false, nullptr);
+            responseBlob.Free();
+            continue;
+        }
+
+        // The async process finishes when the program returns into the callback `_RemoteReadFilesComplete`
+        // Request is copied, because the response can be sent later and in any order
+        VfsRemoteReadFileRequest* fileReq = Mem::AllocTyped<VfsRemoteReadFileRequest>(1, &gVfs.alloc);
+        *fileReq = {
+            .req = req,
+            .lastModified = info.lastModified
+        };
+        ReadFileAsync(filepath, VfsFlags::None, _RemoteReadFilesComplete, fileReq, &gVfs.alloc);
+    }
     
     return true;
 }
 
-static bool Vfs::_ReadFileInfoHandlerServerFn(uint32 cmd, const Blob& incomingData, Blob* outgoingData, void*, 
+static bool Vfs::_ReadFileInfoHandlerServerFn([[maybe_unused]] uint32 cmd, const RemoteRequest&, const Blob& incomingData, Blob* outgoingData, void*, 
                                               char outgoingErrorDesc[REMOTE_ERROR_SIZE])
 {
     ASSERT(cmd == VFS_REMOTE_READ_FILE_INFO_CMD);
@@ -1027,10 +1367,10 @@ static bool Vfs::_ReadFileInfoHandlerServerFn(uint32 cmd, const Blob& incomingDa
     }
 }
 
-static bool Vfs::_WriteFileHandlerServerFn(uint32 cmd, const Blob& incomingData, Blob* outgoingData, 
+static bool Vfs::_WriteFileHandlerServerFn(uint32 cmd, const RemoteRequest& req, const Blob& incomingData, Blob* outgoingData, 
                                            void*, char outgoingErrorDesc[REMOTE_ERROR_SIZE])
 {
-    ASSERT(cmd == VFS_REMOTE_READ_FILE_CMD);
+    ASSERT(cmd == VFS_REMOTE_WRITE_FILE_CMD);
     UNUSED(cmd);
     UNUSED(outgoingData);
     UNUSED(outgoingErrorDesc);
@@ -1048,66 +1388,104 @@ static bool Vfs::_WriteFileHandlerServerFn(uint32 cmd, const Blob& incomingData,
         Blob blob;
         blob.Reserve((uint8*)incomingData.Data() + incomingData.ReadOffset(), bufferSize);
         // The async process finished when the program returns into the callback `vfsRemoteReadFileComplete`
-        WriteFileAsync(filepath, blob, flags, _RemoteWriteFileComplete, nullptr);
+        // Incoming data is only valid during this call, so the blob must always be copied
+        RemoteRequest* reqCopy = Mem::AllocTyped<RemoteRequest>(1, &gVfs.alloc);
+        *reqCopy = req;
+        WriteFileAsync(filepath, blob, flags & ~VfsFlags::NoCopyWriteBlob, _RemoteWriteFileComplete, reqCopy);
     }
     
     return bufferSize > 0;
 }
 
-static void Vfs::_ReadFileHandlerClientFn([[maybe_unused]] uint32 cmd, const Blob& incomingData, void* userData, 
-                                          bool error, const char* errorDesc)
+static void Vfs::_ReadFilesHandlerClientFn([[maybe_unused]] uint32 cmd, uint32, const Blob& incomingData, void* userData, 
+                                           bool error, const char* errorDesc)
 {
-    ASSERT(cmd == VFS_REMOTE_READ_FILE_CMD);
+    ASSERT(cmd == VFS_REMOTE_READ_FILES_CMD);
     UNUSED(userData);
 
-    auto PopRequest = [](const char* filepath, VfsFileReadWriteRequest* pReq)->bool {
+    char filepath[PATH_CHARS_MAX];
+    uint64 lastModified = 0;
+    uint8 notModified = 0;
+    if (!error) {
+        incomingData.ReadStringBinary(filepath, sizeof(filepath));
+        incomingData.Read<uint64>(&lastModified);
+        incomingData.Read<uint8>(&notModified);
+    }
+    else {
+        Str::Copy(filepath, sizeof(filepath), errorDesc);
+    }
+
+    const void* fileData = (const uint8*)incomingData.Data() + incomingData.ReadOffset();
+    size_t fileSize = incomingData.Size() - incomingData.ReadOffset();
+    if (error)
+        _RemoteCacheEvict(filepath);
+    else if (!notModified)
+        _RemoteCacheStore(filepath, lastModified, fileData, fileSize);
+
+    // There can be multiple requests waiting for the same file. Including prefetches that don't have callbacks
+    MemTempAllocator tmpAlloc;
+    Array<VfsFileReadWriteRequest> reqs(&tmpAlloc);
+    {
         VfsRemoteManager* mgr = &gVfs.remoteMgr;
         MutexScope mtx(mgr->requestsMtx);
-        if (uint32 index = mgr->requests.FindIf([filepath](const VfsFileReadWriteRequest& req)->bool 
-            { return req.path.IsEqual(filepath); }); index != UINT32_MAX)
-        {
-            *pReq = mgr->requests.Pop(index);
-            return true;
-        }
-        else {
-            ASSERT_MSG(0, "Request '%s' not found", filepath);
-            return false;
+        for (uint32 i = 0; i < mgr->requests.Count();) {
+            const VfsFileReadWriteRequest& req = mgr->requests[i];
+            if (req.cmd == VfsCommand::Read && req.path.IsEqual(filepath))
+                reqs.Push(mgr->requests.Pop(i));
+            else
+                ++i;
         }
-    };
-    
-    if (!error) {
-        char filepath[PATH_CHARS_MAX];
-        incomingData.ReadStringBinary(filepath, sizeof(filepath));
-        
-        VfsFileReadWriteRequest req;
-        if (PopRequest(filepath, &req)) {
-            Blob blob(req.alloc ? req.alloc : &gVfs.alloc);
+    }
+    ASSERT_MSG(reqs.Count(), "Request '%s' not found", filepath);
 
-            size_t fileSize = incomingData.Size() - incomingData.ReadOffset();
-            blob.Reserve(fileSize);
-            incomingData.Read(const_cast<void*>(blob.Data()), blob.Capacity());
-            blob.SetSize(fileSize);
+    for (VfsFileReadWriteRequest& req : reqs) {
+        if (!req.callbacks.readFn) {
+            req.blob.Free();
+            continue;
+        }
 
-            if (req.callbacks.readFn)
-                req.callbacks.readFn(filepath, blob, req.user);
+        // Requests that were deduplicated into an in-flight one may not have had a cached copy when they were made
+        // Take it from the cache now, or if it's been evicted meanwhile, request the whole file again
+        if (!error && notModified && !req.blob.IsValid()) {
+            VfsRemoteManager* mgr = &gVfs.remoteMgr;
+            bool cached = false;
+            {
+                MutexScope mtx(mgr->cacheMtx);
+                if (uint32 index = _RemoteCacheFind(filepath); index != UINT32_MAX) {
+                    VfsRemoteCacheEntry& entry = mgr->cache[index];
+                    entry.lastUsed = ++mgr->cacheTick;
+                    req.blob = _RemoteCopyFileData(entry.data.Data(), entry.data.Size(), req.flags, req.alloc);
+                    cached = true;
+                }
+            }
 
-            blob.Free();
+            if (!cached) {
+                const char* path = filepath;
+                _RemoteReadFiles(&path, 1, req.flags, req.callbacks.readFn, req.user, req.alloc);
+                continue;
+            }
         }
-    }
-    else {
-        const char* filepath = errorDesc;
 
-        VfsFileReadWriteRequest req;
-        if (PopRequest(filepath, &req)) {
-            ASSERT(req.callbacks.readFn);
-            Blob blob(req.alloc ? req.alloc : &gVfs.alloc);  // empty blob
-            req.callbacks.readFn(filepath, blob, req.user);
-            blob.Free();
+        Blob blob(req.alloc ? req.alloc : &gVfs.alloc);     // empty blob on errors
+        if (!error) {
+            if (notModified) {
+                req.blob.MoveTo(&blob);     // Copied from the cache when the request was made
+            }
+            else {
+                req.blob.Free();            // Stale cached copy, if any
+                blob = _RemoteCopyFileData(fileData, fileSize, req.flags, req.alloc);
+            }
+        }
+        else {
+            req.blob.Free();
         }
+
+        req.callbacks.readFn(filepath, blob, req.user);
+        blob.Free();
     }
 }
 
-static void Vfs::_WriteFileHandlerClientFn([[maybe_unused]] uint32 cmd, const Blob& incomingData, void* userData, 
+static void Vfs::_WriteFileHandlerClientFn([[maybe_unused]] uint32 cmd, uint32, const Blob& incomingData, void* userData, 
                                            bool error, const char* errorDesc)
 {
     ASSERT(cmd == VFS_REMOTE_WRITE_FILE_CMD);
@@ -1153,7 +1531,7 @@ static void Vfs::_WriteFileHandlerClientFn([[maybe_unused]] uint32 cmd, const Bl
     }
 }
 
-static void Vfs::_ReadFileInfoHandlerClientFn([[maybe_unused]] uint32 cmd, const Blob& incomingData, void* userData, 
+static void Vfs::_ReadFileInfoHandlerClientFn([[maybe_unused]] uint32 cmd, uint32, const Blob& incomingData, void* userData, 
                                               bool error, const char* errorDesc)
 {
     ASSERT(cmd == VFS_REMOTE_READ_FILE_INFO_CMD);
@@ -1231,6 +1609,8 @@ bool Vfs::Initialize()
         VfsRemoteManager* mgr = &gVfs.remoteMgr;
         mgr->requestsMtx.Initialize();
         mgr->requests.SetAllocator(&gVfs.alloc);
+        mgr->cacheMtx.Initialize();
+        mgr->cache.SetAllocator(&gVfs.alloc);
     }
 
     // Hot-reload
@@ -1244,9 +1624,9 @@ bool Vfs::Initialize()
     }
 
     Remote::RegisterCommand({
-        .cmdFourCC = VFS_REMOTE_READ_FILE_CMD,
-        .serverFn = _ReadFileHandlerServerFn,
-        .clientFn = _ReadFileHandlerClientFn,
+        .cmdFourCC = VFS_REMOTE_READ_FILES_CMD,
+        .serverFn = _ReadFilesHandlerServerFn,
+        .clientFn = _ReadFilesHandlerClientFn,
         .async = true 
     });
 
@@ -1299,6 +1679,12 @@ void Vfs::Release()
         VfsRemoteManager* mgr = &gVfs.remoteMgr;
         mgr->requestsMtx.Release();
         mgr->requests.Free();
+
+        for (VfsRemoteCacheEntry& entry : mgr->cache)
+            entry.data.Free();
+        mgr->cacheMtx.Release();
+        mgr->cache.Free();
+        mgr->cacheSize = 0;
     }
 
     // Hot-reload
@@ -1313,6 +1699,16 @@ void Vfs::Release()
         gVfs.fileChangeCallbacks.Free();
     }
 
+    // Mapped files
+    {
+        SpinLockMutexScope lock(gVfs.mappedFilesMtx);
+        if (!gVfs.mappedFiles.IsEmpty())
+            LOG_WARNING("VirtualFS: %u mapped file blobs are not freed", gVfs.mappedFiles.Count());
+        for (MappedFile& mf : gVfs.mappedFiles)
+            mf.Close();
+        gVfs.mappedFiles.Free();
+    }
+
     gVfs.mounts.Free();
 
     gVfs.initialized = false;
@@ -12,7 +12,11 @@ enum class VfsFlags : uint32
     TextFile = 0x2,
     Append = 0x4,
     CreateDirs = 0x8,
-    NoCopyWriteBlob = 0x10 // The original blob we passed to WriteFileAsync is not copied
+    NoCopyWriteBlob = 0x10, // The original blob we passed to WriteFileAsync is not copied
+    Mapped = 0x20       // Local files: Returned blob is a read-only view of the memory-mapped file instead of a copy. Blob::Free unmaps it
+                        // Ignored with TextFile (no null-terminator) and on watched mounts (the file may change under the mapping)
+                        // 'alloc' is not used for mapped blobs, only when it falls back to a regular read
+                        // The blob cannot be written to, resized or detached
 };
 ENABLE_BITMASK(VfsFlags);
 
@@ -45,6 +49,21 @@ namespace Vfs
     API size_t WriteFile(const char* path, const Blob& blob, VfsFlags flags);
 
     API void ReadFileAsync(const char* path, VfsFlags flags, VfsReadAsyncCallback readResultFn, void* user, MemAllocator* alloc = Mem::GetDefaultAlloc());
+
+    // Issues the read through the async path and suspends the running job until it's complete, so the worker thread can run 
+    // other jobs in the meantime. The job may resume on another worker thread, so don't keep thread-bound data (temp allocators, etc.) across the call
+    // 'alloc' must be thread-safe. Falls back to ReadFile outside of jobs or if the job cannot be suspended (see JobsEvent)
+    API Blob ReadFileAwait(const char* path, VfsFlags flags, MemAllocator* alloc = Mem::GetDefaultAlloc());
+
+    // Reads multiple files and calls readResultFn for each one of them
+    // Files on remote mounts are requested with a single message and the server streams them back as soon as each one is read
+    // Remote files are kept in a small client-side cache, keyed by path and the server's modification time
+    API void ReadFilesAsync(const char** paths, uint32 numPaths, VfsFlags flags, VfsReadAsyncCallback readResultFn, void* user, 
+                            MemAllocator* alloc = Mem::GetDefaultAlloc());
+
+    // Fetches files on remote mounts into the client-side cache ahead of time, so later reads don't wait on the network
+    // Files that are not on remote mounts are ignored
+    API void PrefetchFiles(const char** paths, uint32 numPaths);
     API void WriteFileAsync(const char* path, const Blob& blob, VfsFlags flags, VfsWriteAsyncCallback writeResultFn, void* user);
 
     API VfsMountType GetMountType(const char* path);
@@ -223,6 +223,11 @@ MemTempContext::~MemTempContext()
     init = false;
 }
 
+bool MemTempAllocator::IsActive()
+{
+    return !_GetMemTempContext().allocStack.IsEmpty();
+}
+
 void MemTempAllocator::Reset()
 {
     PROFILE_ZONE("TempAllocator.Reset");
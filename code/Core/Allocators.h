@@ -118,6 +118,7 @@ struct MemTempAllocator final : MemAllocator
     API static void EnableCallstackCapture(bool capture);
     API static void GetStats(MemAllocator* alloc, Stats** outStats, uint32* outCount);
     API static void Reset();
+    API static bool IsActive();     // Returns true if there are any temp allocators alive on the current thread
 
 private:
     ID mId = 0;
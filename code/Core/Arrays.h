@@ -12,6 +12,11 @@
 // 
 // StaticArray: Pretty much same as array but with fixed capacity. Stays on stack.
 // 
+// RingQueue: Growable double-ended queue on top of a ring-buffer. Push/Pop at both ends are O(1)
+//      - Use it instead of Array for FIFOs, because Array::PopFirst shifts the whole buffer
+//      - Same rules as Array apply: POD types only, can only grow if it has an allocator
+//      - Not thread-safe. For lock-free cross-thread queues, see MpscQueue in System.h
+// 
 
 #include "Base.h"
 
@@ -164,6 +169,70 @@ private:
 };
 
 
+//    ██████╗ ██╗███╗   ██╗ ██████╗      ██████╗ ██╗   ██╗███████╗██╗   ██╗███████╗
+//    ██╔══██╗██║████╗  ██║██╔════╝     ██╔═══██╗██║   ██║██╔════╝██║   ██║██╔════╝
+//    ██████╔╝██║██╔██╗ ██║██║  ███╗    ██║   ██║██║   ██║█████╗  ██║   ██║█████╗  
+//    ██╔══██╗██║██║╚██╗██║██║   ██║    ██║▄▄ ██║██║   ██║██╔══╝  ██║   ██║██╔══╝  
+//    ██║  ██║██║██║ ╚████║╚██████╔╝    ╚██████╔╝╚██████╔╝███████╗╚██████╔╝███████╗
+//    ╚═╝  ╚═╝╚═╝╚═╝  ╚═══╝ ╚═════╝      ╚══▀▀═╝  ╚═════╝ ╚══════╝ ╚═════╝ ╚══════╝
+template <typename _T>
+struct RingQueue
+{
+    RingQueue() : RingQueue(Mem::GetDefaultAlloc()) {}
+    explicit RingQueue(MemAllocator* alloc) : mAlloc(alloc) {}
+    explicit RingQueue(void* buffer, size_t size);
+
+    void SetAllocator(MemAllocator* alloc);
+    void Reserve(uint32 capacity);
+    void Reserve(uint32 capacity, void* buffer, size_t size);
+    void Free();
+    static size_t GetMemoryRequirement(uint32 capacity);
+
+    _T* PushBack(const _T& item);
+    _T* PushFront(const _T& item);
+    _T PopFront();
+    _T PopBack();
+
+    _T& Front();
+    _T& Back();
+    _T& operator[](uint32 index);   // index is relative to the front of the queue
+    const _T& operator[](uint32 index) const;
+
+    uint32 Count() const;
+    uint32 Capacity() const;
+    bool IsEmpty() const;
+    bool IsFull() const;
+    void Clear();
+
+    // _Func = [capture](const _T& item)->bool
+    template <typename _Func> uint32 FindIf(_Func findFunc);
+
+    // C++ stl crap compatibility. we just want to use for(auto t : queue) syntax sugar
+    struct Iterator 
+    {
+        Iterator(RingQueue<_T>* queue, uint32 index) : _queue(queue), mIndex(index) {}
+        _T& operator*() { return (*_queue)[mIndex]; }
+        void operator++() { ++mIndex; }
+        bool operator!=(Iterator it) { return mIndex != it.mIndex; }
+        RingQueue<_T>* _queue;
+        uint32 mIndex;
+    };
+    
+    Iterator begin()    { return Iterator(this, 0); }
+    Iterator end()      { return Iterator(this, mCount); }
+
+private:
+    uint32 WrapIndex(uint32 index) const { return index >= mCapacity ? (index - mCapacity) : index; }
+    bool Grow();
+
+    MemAllocator* mAlloc = nullptr;
+    _T* mBuffer = nullptr;
+    uint32 mCapacity = 0;
+    uint32 mHead = 0;       // Index of the front item in mBuffer
+    uint32 mCount = 0;
+};
+
+
 //    ██╗███╗   ██╗██╗     ██╗███╗   ██╗███████╗███████╗
 //    ██║████╗  ██║██║     ██║████╗  ██║██╔════╝██╔════╝
 //    ██║██╔██╗ ██║██║     ██║██╔██╗ ██║█████╗  ███████╗
@@ -715,5 +784,206 @@ template <typename _Func> inline uint32 StaticArray<_T, _MaxCount>::FindIf(_Func
     return UINT32_MAX;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// @impl RingQueue
+template <typename _T>
+inline RingQueue<_T>::RingQueue(void* buffer, size_t size)
+{
+    ASSERT(buffer);
+    mCapacity = uint32(size / sizeof(_T));
+    ASSERT(mCapacity);
+    mBuffer = reinterpret_cast<_T*>(buffer);
+}
+
+template <typename _T>
+inline void RingQueue<_T>::SetAllocator(MemAllocator* alloc)
+{
+    ASSERT_MSG(mBuffer == nullptr, "buffer should be freed/uninitialized before setting allocator");
+    mAlloc = alloc;
+}
+
+template <typename _T>
+inline void RingQueue<_T>::Reserve(uint32 capacity)
+{
+    ASSERT(mAlloc);
+    capacity = Max(capacity, 8u);
+    if (capacity <= mCapacity)
+        return;
+
+    // Unwrap the items to the beginning of the new buffer
+    _T* buffer = Mem::AllocTyped<_T>(capacity, mAlloc);
+    if (mCount) {
+        uint32 firstCount = Min(mCount, mCapacity - mHead);
+        memcpy((void*)buffer, mBuffer + mHead, sizeof(_T)*firstCount);
+        if (firstCount < mCount)
+            memcpy((void*)(buffer + firstCount), mBuffer, sizeof(_T)*(mCount - firstCount));
+    }
+
+    if (mBuffer)
+        Mem::Free(mBuffer, mAlloc);
+    mBuffer = buffer;
+    mCapacity = capacity;
+    mHead = 0;
+}
+
+template <typename _T>
+inline void RingQueue<_T>::Reserve(uint32 capacity, void* buffer, [[maybe_unused]] size_t size)
+{
+    capacity = Max(capacity, 8u);
+
+    ASSERT(buffer);
+    ASSERT_MSG(mBuffer == nullptr, "RingQueue should not be initialized before reserve by pointer");
+    ASSERT_MSG(size >= capacity*sizeof(_T), "Buffer should have at least %u bytes long (size=%u)", capacity*sizeof(_T), size);
+    
+    mAlloc = nullptr;
+    mCapacity = capacity;
+    mBuffer = (_T*)buffer;
+    mHead = 0;
+    mCount = 0;
+}
+
+template <typename _T>
+inline void RingQueue<_T>::Free()
+{
+    if (mAlloc)
+        Mem::Free(mBuffer, mAlloc);
+
+    mBuffer = nullptr;
+    mCapacity = 0;
+    mHead = 0;
+    mCount = 0;
+}
+
+template <typename _T>
+inline size_t RingQueue<_T>::GetMemoryRequirement(uint32 capacity)
+{
+    capacity = Max(capacity, 8u);
+    return capacity * sizeof(_T);
+}
+
+template <typename _T>
+inline bool RingQueue<_T>::Grow()
+{
+    if (mAlloc) {
+        Reserve(mCapacity ? (mCapacity << 1) : 8);
+        return true;
+    } 
+    else {
+        ASSERT(mBuffer);
+        ASSERT_MSG(mCount < mCapacity, "RingQueue overflow, capacity=%u", mCapacity);
+        return false;
+    }
+}
+
+template <typename _T>
+inline _T* RingQueue<_T>::PushBack(const _T& item)
+{
+    if (mCount == mCapacity && !Grow())
+        return nullptr;
+
+    _T* dest = &mBuffer[WrapIndex(mHead + mCount)];
+    ++mCount;
+    *dest = item;
+    return dest;
+}
+
+template <typename _T>
+inline _T* RingQueue<_T>::PushFront(const _T& item)
+{
+    if (mCount == mCapacity && !Grow())
+        return nullptr;
+
+    mHead = mHead ? (mHead - 1) : (mCapacity - 1);
+    ++mCount;
+    _T* dest = &mBuffer[mHead];
+    *dest = item;
+    return dest;
+}
+
+template <typename _T>
+inline _T RingQueue<_T>::PopFront()
+{
+    ASSERT(mCount > 0);
+    _T item = mBuffer[mHead];
+    mHead = WrapIndex(mHead + 1);
+    --mCount;
+    return item;
+}
+
+template <typename _T>
+inline _T RingQueue<_T>::PopBack()
+{
+    ASSERT(mCount > 0);
+    --mCount;
+    return mBuffer[WrapIndex(mHead + mCount)];
+}
 
+template <typename _T>
+inline _T& RingQueue<_T>::Front()
+{
+    ASSERT(mCount > 0);
+    return mBuffer[mHead];
+}
 
+template <typename _T>
+inline _T& RingQueue<_T>::Back()
+{
+    ASSERT(mCount > 0);
+    return mBuffer[WrapIndex(mHead + mCount - 1)];
+}
+
+template <typename _T>
+inline _T& RingQueue<_T>::operator[](uint32 index)
+{
+    ASSERT_MSG(index < mCount, "Index out of bounds (count: %u, index: %u)", mCount, index);
+    return mBuffer[WrapIndex(mHead + index)];
+}
+
+template <typename _T>
+inline const _T& RingQueue<_T>::operator[](uint32 index) const
+{
+    ASSERT_MSG(index < mCount, "Index out of bounds (count: %u, index: %u)", mCount, index);
+    return mBuffer[WrapIndex(mHead + index)];
+}
+
+template <typename _T>
+inline uint32 RingQueue<_T>::Count() const
+{
+    return mCount;
+}
+
+template <typename _T>
+inline uint32 RingQueue<_T>::Capacity() const
+{
+    return mCapacity;
+}
+
+template <typename _T>
+inline bool RingQueue<_T>::IsEmpty() const
+{
+    return mCount == 0;
+}
+
+template <typename _T>
+inline bool RingQueue<_T>::IsFull() const
+{
+    return mCount == mCapacity;
+}
+
+template <typename _T>
+inline void RingQueue<_T>::Clear()
+{
+    mHead = 0;
+    mCount = 0;
+}
+
+template <typename _T>
+template <typename _Func> inline uint32 RingQueue<_T>::FindIf(_Func findFunc)
+{
+    for (uint32 i = 0; i < mCount; i++) {
+        if (findFunc(mBuffer[WrapIndex(mHead + i)]))
+            return i;
+    }
+    
+    return UINT32_MAX;
+}
@@ -14,6 +14,8 @@
 //  - CONFIG_VALIDATE_IO_READ_WRITES (default=1): Validates IO read/writes with ASSERT to not get truncated 
 //  - CONFIG_ENABLE_ASSERT (default=1 on DEBUG and none-final, otherwise 0): Enables assertions checks, with the exception of ASSERT_ALWAYS
 //  - TRACY_ENABLE: comment/uncomment this macro to enable Tracy profiler. This macro is already defined in "ReleaseDev" config
+//  - CONFIG_ENABLE_PROFILER (default=1 on none-final builds without TRACY_ENABLE): Built-in CPU profiler behind PROFILE_ZONE macros. 
+//                                   Records zones into per-thread ring-buffers and dumps them to chrome trace json (see TracyHelper.h)
 //
 
 #if !defined(CONFIG_FINAL_BUILD)
@@ -76,4 +78,16 @@
     #define CONFIG_TEMP_ALLOC_PAGE_SIZE 256*SIZE_KB
 #endif
 
-// #define TRACY_ENABLE
\ No newline at end of file
+// #define TRACY_ENABLE
+
+// Built-in profiler and Tracy share the PROFILE_ZONE macros, so only one of them can be active
+#if defined(TRACY_ENABLE)
+    #undef CONFIG_ENABLE_PROFILER
+    #define CONFIG_ENABLE_PROFILER 0
+#elif !defined(CONFIG_ENABLE_PROFILER)
+    #if !CONFIG_FINAL_BUILD
+        #define CONFIG_ENABLE_PROFILER 1
+    #else
+        #define CONFIG_ENABLE_PROFILER 0
+    #endif
+#endif
@@ -79,6 +79,12 @@
 //                           #define CJ5_TOKEN_HELPERS 0, before including the header
 //      - CJ5_API: API decleration can be override by defining this macro. (default is extern)
 //                 example: #define CJ5_API static
+//      - CJ5_NO_SIMD: Disables SSE2/NEON scanning of strings and whitespace runs
+// 
+// Local changes (Junkyard):
+//      This copy diverges from upstream cj5 by the SIMD scanning: cj5__scan_string and cj5__skip_whitespace, and their calls in
+//      cj5__parse_string and the whitespace cases of cj5_parse_with_factory. Re-apply them when updating from upstream
+//      Define CJ5_NO_SIMD to get the same scalar code paths as upstream
 // 
 #pragma once
 
@@ -244,6 +250,112 @@ static const uint32_t CJ5__FALSE_FOURCC = CJ5__FOURCC('f', 'a', 'l', 's');
 static const uint32_t CJ5__FNV1_32_INIT = 0x811c9dc5;
 static const uint32_t CJ5__FNV1_32_PRIME = 0x01000193;
 
+// SIMD scanning: Strings and whitespace runs are scanned 16 bytes at a time
+// Masks have CJ5__SIMD_MASK_BITS bits per byte (movemask on SSE2, narrowed nibbles on NEON)
+#    define CJ5__SIMD 0
+#    if !defined(CJ5_NO_SIMD)
+#        if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#            include <emmintrin.h>
+#            undef CJ5__SIMD
+#            define CJ5__SIMD 1
+#            define CJ5__SIMD_MASK_BITS 1
+typedef __m128i cj5__vec;
+static inline cj5__vec cj5__vec_load(const char* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline cj5__vec cj5__vec_eq(cj5__vec v, char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); }
+static inline cj5__vec cj5__vec_or(cj5__vec a, cj5__vec b) { return _mm_or_si128(a, b); }
+static inline uint64_t cj5__vec_mask(cj5__vec v) { return (uint64_t)(uint32_t)_mm_movemask_epi8(v); }
+#        elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#            include <arm_neon.h>
+#            undef CJ5__SIMD
+#            define CJ5__SIMD 1
+#            define CJ5__SIMD_MASK_BITS 4
+typedef uint8x16_t cj5__vec;
+static inline cj5__vec cj5__vec_load(const char* p) { return vld1q_u8((const uint8_t*)p); }
+static inline cj5__vec cj5__vec_eq(cj5__vec v, char c) { return vceqq_u8(v, vdupq_n_u8((uint8_t)c)); }
+static inline cj5__vec cj5__vec_or(cj5__vec a, cj5__vec b) { return vorrq_u8(a, b); }
+static inline uint64_t cj5__vec_mask(cj5__vec v) 
+{ 
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0); 
+}
+#        endif
+#    endif
+
+#    if CJ5__SIMD
+#        if defined(_MSC_VER)
+#            include <intrin.h>
+static inline int cj5__ctz64(uint64_t x)
+{
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)(x & 0xffffffff)))
+        return (int)index;
+    _BitScanForward(&index, (unsigned long)(x >> 32));
+    return (int)index + 32;
+}
+#        else
+static inline int cj5__ctz64(uint64_t x) { return __builtin_ctzll(x); }
+#        endif
+
+static const uint64_t CJ5__SIMD_MASK_ALL = CJ5__SIMD_MASK_BITS == 1 ? 0xffff : 0xffffffffffffffffull;
+static const uint64_t CJ5__SIMD_MASK_FIRST_BITS = CJ5__SIMD_MASK_BITS == 1 ? 0xffff : 0x1111111111111111ull;   // One bit per byte
+#    endif // CJ5__SIMD
+
+// Returns the position of the first quote (`str_open`) or escape character, starting from `pos`. Returns `len` if not found
+static inline int cj5__scan_string(const char* json5, int pos, int len, char str_open)
+{
+#    if CJ5__SIMD
+    for (; pos + 16 <= len; pos += 16) {
+        cj5__vec v = cj5__vec_load(json5 + pos);
+        uint64_t mask = cj5__vec_mask(cj5__vec_or(cj5__vec_eq(v, str_open), cj5__vec_eq(v, '\\')));
+        if (mask)
+            return pos + cj5__ctz64(mask) / CJ5__SIMD_MASK_BITS;
+    }
+#    endif
+    for (; pos < len; pos++) {
+        if (json5[pos] == str_open || json5[pos] == '\\')
+            return pos;
+    }
+    return len;
+}
+
+// Skips ' ', '\t', '\r' and '\n' characters, starting from `pos` and returns the position of the first non-whitespace character
+// Number of new lines is added to `num_lines` and `has_eol` is set if any '\r' or '\n' is skipped
+static inline int cj5__skip_whitespace(const char* json5, int pos, int len, int* num_lines, bool* has_eol)
+{
+#    if CJ5__SIMD
+    for (; pos + 16 <= len; pos += 16) {
+        cj5__vec v = cj5__vec_load(json5 + pos);
+        cj5__vec nl = cj5__vec_eq(v, '\n');
+        cj5__vec eol = cj5__vec_or(nl, cj5__vec_eq(v, '\r'));
+        cj5__vec ws = cj5__vec_or(eol, cj5__vec_or(cj5__vec_eq(v, ' '), cj5__vec_eq(v, '\t')));
+        uint64_t non_ws_mask = ~cj5__vec_mask(ws) & CJ5__SIMD_MASK_ALL;
+
+        // only count the new lines before the first non-whitespace character
+        uint64_t valid_mask = non_ws_mask ? ((non_ws_mask & (0 - non_ws_mask)) - 1) : CJ5__SIMD_MASK_ALL;
+        uint64_t nl_mask = cj5__vec_mask(nl) & valid_mask & CJ5__SIMD_MASK_FIRST_BITS;
+        if (cj5__vec_mask(eol) & valid_mask)
+            *has_eol = true;
+        for (; nl_mask; nl_mask &= nl_mask - 1)
+            ++(*num_lines);
+        if (non_ws_mask)
+            return pos + cj5__ctz64(non_ws_mask) / CJ5__SIMD_MASK_BITS;
+    }
+#    endif
+    for (; pos < len; pos++) {
+        char c = json5[pos];
+        if (c == '\n') {
+            ++(*num_lines);
+            *has_eol = true;
+        }
+        else if (c == '\r') {
+            *has_eol = true;
+        }
+        else if (c != ' ' && c != '\t') {
+            break;
+        }
+    }
+    return pos;
+}
+
 typedef struct cj5__parser {
     int pos;
     int next_id;
@@ -545,6 +657,10 @@ static bool cj5__parse_string(cj5__parser* parser, cj5_result* r, const char* js
     ++parser->pos;
 
     for (; parser->pos < len; parser->pos++) {
+        // jump to the next quote or escape, other characters don't need any processing
+        parser->pos = cj5__scan_string(json5, parser->pos, len, str_open);
+        if (parser->pos >= len)
+            break;
         char c = json5[parser->pos];
 
         // end of string
@@ -735,15 +851,18 @@ cj5_result cj5_parse_with_factory(const char* json5, int len, cj5_factory factor
             break;
 
         case '\r':
-            can_comment = true;
-            break;
         case '\n':
-            ++parser.line;
-            can_comment = true;
-            break;
         case '\t':
-        case ' ':
+        case ' ': {
+            int num_lines = 0;
+            bool has_eol = false;
+            parser.pos = cj5__skip_whitespace(json5, parser.pos, len, &num_lines, &has_eol) - 1;
+            parser.line += num_lines;
+            if (has_eol) {
+                can_comment = true;
+            }
             break;
+        }
 
         case ':':
             can_comment = false;
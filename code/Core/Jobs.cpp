@@ -32,9 +32,12 @@ namespace _limits
 {
     inline constexpr uint32 JOBS_MAX_INSTANCES = 1024;
     inline constexpr uint32 JOBS_MAX_PENDING = JOBS_MAX_INSTANCES*4;
+    inline constexpr uint32 JOBS_TELEMETRY_MAX_FRAMES = 256;        // Must be power of two
 
 #ifdef TRACY_ENABLE
     inline constexpr uint32 JOBS_TRACY_MAX_STACKDEPTH = 8;
+#elif CONFIG_ENABLE_PROFILER
+    inline constexpr uint32 JOBS_PROFILER_MAX_STACKDEPTH = 16;
 #endif
 }
 
@@ -101,6 +104,9 @@ struct JobsFiberProperties
     JobsFiberProperties* prev;
     JobsStackSize stackSize;
     uint32 index;
+    uint64 dispatchTick;
+    const JobsCancelToken* cancelToken;
+    uint64 deadlineTick;        // 0 means no deadline
 };
 
 struct JobsSignalInternal
@@ -111,6 +117,52 @@ struct JobsSignalInternal
 };
 static_assert(sizeof(JobsSignalInternal) <= sizeof(JobsSignal), "Mismatch sizes between JobsSignal and JobsSignalInternal");
 
+// Lives on the stack of the waiter until the lock is handed over to it
+struct JobsMutexWaiter
+{
+    JobsFiber* fiber;           // nullptr if the waiter is not parked and spins on 'granted' instead
+    JobsMutexWaiter* next;
+    AtomicUint32 granted;
+};
+
+struct JobsMutexWaitList
+{
+    JobsMutexWaiter* mFirst;
+    JobsMutexWaiter* mLast;
+
+    inline void Push(JobsMutexWaiter* waiter);
+    inline JobsMutexWaiter* PopFirst();
+    inline JobsMutexWaiter* PopAll();
+    inline bool IsEmpty() const { return mFirst == nullptr; }
+};
+
+struct JobsMutexInternal
+{
+    SpinLockMutex lock;         // Protects the state below. Also held while the waiting fiber is being parked (see _ParkCurrentFiber)
+    uint32 spinCount;
+    AtomicUint32 locked;        // Written under 'lock', but also peeked without it while spinning
+    JobsMutexWaitList waiters;
+};
+static_assert(sizeof(JobsMutexInternal) <= sizeof(JobsMutex), "Mismatch sizes between JobsMutex and JobsMutexInternal");
+
+struct JobsReadWriteMutexInternal
+{
+    SpinLockMutex lock;
+    uint32 numReaders;
+    bool writer;
+    JobsMutexWaitList readers;
+    JobsMutexWaitList writers;
+};
+static_assert(sizeof(JobsReadWriteMutexInternal) <= sizeof(JobsReadWriteMutex), "Mismatch sizes between JobsReadWriteMutex and JobsReadWriteMutexInternal");
+
+struct JobsEventInternal
+{
+    SpinLockMutex lock;
+    AtomicUint32 raised;        // 0: Not raised, 1: Raised, 2: Raise is in progress (set under 'lock', 1 is stored after unlock)
+    JobsMutexWaitList waiters;
+};
+static_assert(sizeof(JobsEventInternal) <= sizeof(JobsEvent), "Mismatch sizes between JobsEvent and JobsEventInternal");
+
 #ifdef TRACY_ENABLE
 struct JobsTracyZone
 {
@@ -129,13 +181,29 @@ struct JobsFiber
     JobsSignalInternal* signal;
     #ifdef TRACY_ENABLE
     StaticArray<JobsTracyZone, _limits::JOBS_TRACY_MAX_STACKDEPTH> tracyZonesStack;
+    #elif CONFIG_ENABLE_PROFILER
+    StaticArray<ProfilerZone*, _limits::JOBS_PROFILER_MAX_STACKDEPTH> profilerZonesStack;
     #endif
 };
 
+// Written only by the owner worker thread, collected and reset with atomic exchanges by EndTelemetryFrame
+struct alignas(CACHE_LINE_SIZE) JobsWorkerCounters
+{
+    AtomicUint64 busyTicks;
+    AtomicUint64 spinTicks;
+    AtomicUint64 idleTicks;
+    AtomicUint64 idleSinceTick;     // Non-zero while sleeping. EndTelemetryFrame moves it forward, so long sleeps are split between frames
+    AtomicUint32 numRuns;
+    AtomicUint32 numYields;
+    AtomicUint32 latencyHistogram[JOBS_TELEMETRY_LATENCY_BUCKETS];
+};
+
 struct JobsThreadData
 {
     JobsFiber* curFiber;
+    JobsWorkerCounters* counters;
     JobsInstance* waitInstance;
+    SpinLockMutex* parkLock;        // Fiber is parked on a JobsMutex. This lock is released after the fiber is switched out
     JobsType type;
     uint32 threadIndex;
     uint32 threadId;
@@ -155,6 +223,8 @@ struct JobsWaitingList
 {
     JobsFiberProperties* mWaitingList[static_cast<uint32>(JobsPriority::_Count)];
     JobsFiberProperties* mWaitingListLast[static_cast<uint32>(JobsPriority::_Count)];
+    AtomicUint32 mDepth[static_cast<uint32>(JobsPriority::_Count)];       // Modified under the lock, but read by the telemetry without it
+    AtomicUint32 mMaxDepth[static_cast<uint32>(JobsPriority::_Count)];
 
     inline void AddToList(JobsFiberProperties* props);
     inline void RemoveFromList(JobsFiberProperties* props);
@@ -182,30 +252,72 @@ struct alignas(CACHE_LINE_SIZE) JobsAtomicPool
 // so if you dispatch a ton of jobs without waiting on them, it might get overloaded and run out of memory
 // Currently, jobs system creates 3 of these allocators. One per stack-size enum
 // Each pool in an allocator can contain (NumShortTasks + NumLongTasks)*2 allocations and will grow up to 16 of these pools
+// Pools are only reserved as virtual memory. Each slot has a guard page below it. Note that minicoro places the mco_coro
+// header, context and storage at the start of the allocation, directly below the stack, so an overflow first clobbers the
+// fiber's own header (caught by the magic number check in McoFreeFn) and only faults when it runs past it into the guard.
+// It never reaches the neighbouring slots though. Slots are committed when they are first handed out and the OS only backs
+// the pages that the fiber actually touches. Stack depth is measured when the fiber is recycled (see _MeasureStackUsage)
 struct JobsFiberMemAllocator
 {
     struct Pool
     {
         uint8** ptrs;
         uint8* buffer;
+        uint32* stackUsage;     // Per-slot, deepest stack usage measured so far
         Pool* next;
         uint32 index;
+        uint32 numCommitted;    // Slots are handed out in order the first time, so [0, numCommitted) are committed
     };
 
     SpinLockMutex mLock;
 
     size_t mAllocationSize;
-    uint32 mBufferAlignment;
+    size_t mSlotSize;           // mAllocationSize + guard page
     Pool* mPools;
     uint32 mNumItemsInPool;
+    uint32 mNumPools;
+    uint32 mNumInUse;
+    uint32 mMaxInUse;
+    uint32 mMaxInUseFrame;      // Reset by the telemetry every frame
+    size_t mStackHighWater;
 
     void Initialize(size_t allocationSize);
     void Release();
     void* Allocate();
-    void Free(void* ptr);
+    void Free(void* ptr, const void* stackBase, size_t stackSize);
     Pool* CreatePool();
 };
 
+struct JobsTelemetry
+{
+    JobsWorkerCounters* workers;        // ShortTask workers, then LongTask workers
+    uint32 numWorkers;
+    AtomicUint32 numDispatches[uint32(JobsType::_Count)];
+    AtomicUint32 numDropped[uint32(JobsType::_Count)];
+
+    SpinLockMutex framesLock;
+    JobsTelemetryFrame* frames;         // Ring buffer of the last JOBS_TELEMETRY_MAX_FRAMES
+    JobsTelemetryWorker* frameWorkers;  // numWorkers per frame
+    uint64 numFrames;
+    uint64 lastFrameTick;
+};
+
+// Thread affinities computed from the CPU topology when JobsInitParams::pinThreads is set
+struct JobsPlacement
+{
+    uint16 shortTaskProcs[SYS_MAX_PROCESSORS];  // One processor per ShortTask worker, UINT16_MAX: not pinned
+    uint16 longTaskProcs[SYS_MAX_PROCESSORS];   // Shared by all LongTask workers
+    uint16 mainThreadProcs[SYS_MAX_PROCESSORS]; // SMT siblings of the reserved core
+    uint16 allProcs[SYS_MAX_PROCESSORS];        // Used for unpinning
+    uint32 numLongTaskProcs;
+    uint32 numMainThreadProcs;
+    uint32 numAllProcs;
+    uint32 mainThreadId;                        // Thread that called Initialize, only that one gets mainThreadProcs
+    bool valid;
+    bool pinned;                                // Workers only
+    bool mainThreadPinned;
+};
+
 struct JobsContext
 {
     JobsInitParams initParams;
@@ -221,6 +333,9 @@ struct JobsContext
     JobsAtomicPool<JobsInstance, _limits::JOBS_MAX_INSTANCES>* instancePool;
     JobsAtomicPool<JobsFiberProperties, _limits::JOBS_MAX_PENDING>* fiberPropsPool;
 
+    JobsTelemetry telemetry;
+    JobsPlacement placement;
+
     AtomicUint32 quit;
 };
 
@@ -284,7 +399,10 @@ namespace Jobs
             }
             ASSERT(alloc);
 
-            return alloc->Free(ptr);
+            // mco_coro header lives at the start of our allocation, right below the stack
+            const mco_coro* co = reinterpret_cast<const mco_coro*>(ptr);
+            ASSERT_MSG(co->magic_number == MCO_MAGIC_NUMBER, "Fiber stack overflow, mco_coro header is corrupt");
+            return alloc->Free(ptr, co->stack_base, co->stack_size);
         };    
 
         ASSERT(props->stackSize != JobsStackSize::_Count);
@@ -347,6 +465,10 @@ namespace Jobs
                 #endif
             }
         }
+        #elif CONFIG_ENABLE_PROFILER
+        // Zones continue on this thread from now on
+        for (ProfilerZone* zone : fiber->profilerZonesStack)
+            Profiler::ResumeZone(zone);
         #endif
 
         //------------------------------------------------------------------------------------------------------------------
@@ -376,15 +498,25 @@ namespace Jobs
             for (uint32 i = fiber->tracyZonesStack.Count(); i-- > 0;) 
                 TracyCZoneEnd(fiber->tracyZonesStack[i].ctx);
         }
+        #elif CONFIG_ENABLE_PROFILER
+        if (fiber->co->state != MCO_DEAD) {
+            for (uint32 i = fiber->profilerZonesStack.Count(); i-- > 0;) 
+                Profiler::SuspendZone(fiber->profilerZonesStack[i]);
+        }
         #endif
 
         tdata->curFiber = nullptr;
         gIsInFiber = false;
+
+        if (fiber->co->state != MCO_DEAD)
+            Atomic::FetchAddExplicit(&tdata->counters->numYields, 1, AtomicMemoryOrder::Relaxed);
     
         JobsInstance* inst = fiber->props->instance;
         if (fiber->co->state == MCO_DEAD) {
             #ifdef TRACY_ENABLE
             ASSERT_MSG(fiber->tracyZonesStack.IsEmpty(), "Tracy zones stack currently have %u remaining items", fiber->tracyZonesStack.Count());
+            #elif CONFIG_ENABLE_PROFILER
+            ASSERT_MSG(fiber->profilerZonesStack.IsEmpty(), "Profiler zones stack currently have %u remaining items", fiber->profilerZonesStack.Count());
             #endif
 
             if (Atomic::FetchSub(&inst->counter, 1) == 1) {     // Job is finished with all the fibers
@@ -396,6 +528,14 @@ namespace Jobs
 
             _DestroyFiber(fiber);
         }
+        else if (tdata->parkLock) {
+            // Parked on a mutex: The fiber is not added to the waiting list here. Whoever hands over the lock will do that (see _WakeWaiters)
+            // Lock is released only now that the fiber is completely switched out, so it can't be resumed on another thread before that
+            ASSERT(fiber->co->state == MCO_SUSPENDED);
+            SpinLockMutex* parkLock = tdata->parkLock;
+            tdata->parkLock = nullptr;
+            parkLock->Exit();
+        }
         else {
             // Yielding, Coming back from WaitForCompletion
             ASSERT(fiber->co->state == MCO_SUSPENDED);
@@ -412,6 +552,36 @@ namespace Jobs
         }
     }
 
+    static void _RecordStartLatency(JobsWorkerCounters* counters, uint64 latencyTicks)
+    {
+        uint64 us = uint64(Timer::ToUS(latencyTicks));
+        uint32 bucket = 0;
+        while (us && bucket < JOBS_TELEMETRY_LATENCY_BUCKETS - 1) {
+            us >>= 1;
+            bucket++;
+        }
+        Atomic::FetchAddExplicit(&counters->latencyHistogram[bucket], 1, AtomicMemoryOrder::Relaxed);
+    }
+
+    static bool _IsDropped(const JobsFiberProperties* props, uint64 tick)
+    {
+        return (props->cancelToken && props->cancelToken->IsCancelled()) || (props->deadlineTick && tick > props->deadlineTick);
+    }
+
+    // Must be called under waitingListLock, after the props is removed from the waiting list
+    // Same as finishing the job, so whoever waits on the instance counter is released when the rest of the group is done
+    static void _DropProps(JobsFiberProperties* props)
+    {
+        JobsInstance* inst = props->instance;
+        Atomic::FetchAddExplicit(&gJobs.telemetry.numDropped[uint32(inst->type)], 1, AtomicMemoryOrder::Relaxed);
+        gJobs.fiberPropsPool->Delete(props);
+
+        if (Atomic::FetchSub(&inst->counter, 1) == 1) {
+            if (inst->isAutoDelete)
+                gJobs.instancePool->Delete(inst);
+        }
+    }
+
     static int _WorkerThread(void* userData)
     {
         // Allocate and initialize thread-data for worker threads
@@ -420,14 +590,23 @@ namespace Jobs
         tdata->threadIndex = (param >> 32) & 0xffffffff;
         tdata->type = static_cast<JobsType>(uint32(param & 0xffffffff));
         tdata->threadId = Thread::GetCurrentId();
+        uint32 workerIndex = tdata->threadIndex - 1;
+        if (tdata->type == JobsType::LongTask)
+            workerIndex += gJobs.numThreads[uint32(JobsType::ShortTask)];
+        tdata->counters = &gJobs.telemetry.workers[workerIndex];
         tdata->init = true;
 
         uint32 spinCount = !PLATFORM_MOBILE;
         uint32 typeIndex = uint32(tdata->type);
+        JobsWorkerCounters* counters = tdata->counters;
     
         // Watch out for this atomic check. It still might deadlock the threads (Quit=1) in rare occasions
         while (Atomic::LoadExplicit(&gJobs.quit, AtomicMemoryOrder::Acquire) != 1) {
+            Atomic::StoreExplicit(&counters->idleSinceTick, Timer::GetTicks(), AtomicMemoryOrder::Relaxed);
             gJobs.semaphores[typeIndex].Wait();
+            uint64 wakeTick = Timer::GetTicks();
+            uint64 idleSinceTick = Atomic::ExchangeExplicit(&counters->idleSinceTick, 0, AtomicMemoryOrder::Relaxed);
+            Atomic::FetchAddExplicit(&counters->idleTicks, Timer::Diff(wakeTick, idleSinceTick), AtomicMemoryOrder::Relaxed);
 
             bool waitingListIsLive = false;
             JobsFiber* fiber = nullptr;
@@ -438,10 +617,23 @@ namespace Jobs
                 for (uint32 prioIdx = 0; prioIdx < static_cast<uint32>(JobsPriority::_Count); prioIdx++) {
                     JobsWaitingList* list = &gJobs.waitingLists[typeIndex];
                     JobsFiberProperties* props = list->mWaitingList[prioIdx];
+
+                    // Background jobs only get the spare time: Lists are visited in priority order and we stop at the first 
+                    // runnable fiber, so we only get here if nothing in High/Normal could run in this pass. Fibers that are
+                    // still waiting there (possibly on Background children) must not keep the Background list from running
     
                     while (props) {
                         waitingListIsLive = true;
 
+                        // Cancelled or expired before it got the chance to start: Drop it without creating the fiber
+                        if (props->fiber == nullptr && _IsDropped(props, wakeTick)) {
+                            JobsFiberProperties* next = props->next;
+                            list->RemoveFromList(props);
+                            _DropProps(props);
+                            props = next;
+                            continue;
+                        }
+
                         // Choose the fiber to continue based on these 3 conditions:
                         //  1) There is no fiber assigned to props. so it's the first run
                         //  2) Fiber is not waiting on any children jobs
@@ -452,8 +644,10 @@ namespace Jobs
                             ((tmpFiber->childCounter == nullptr || Atomic::LoadExplicit(tmpFiber->childCounter, AtomicMemoryOrder::Acquire) == 0) &&
                             (tmpFiber->signal == nullptr || Atomic::CompareExchange_Strong(&tmpFiber->signal->signaled, &one, 0))))
                         {
-                            if (tmpFiber == nullptr)
+                            if (tmpFiber == nullptr) {
                                 props->fiber = _CreateFiber(props);
+                                _RecordStartLatency(counters, Timer::Diff(wakeTick, props->dispatchTick));
+                            }
 
                             fiber = props->fiber;
                             fiber->childCounter = nullptr;
@@ -469,9 +663,17 @@ namespace Jobs
             }
 
             if (fiber) {
+                uint64 runTick = Timer::GetTicks();
+                Atomic::FetchAddExplicit(&counters->spinTicks, runTick - wakeTick, AtomicMemoryOrder::Relaxed);
+                Atomic::FetchAddExplicit(&counters->numRuns, 1, AtomicMemoryOrder::Relaxed);
+
                 _SetFiberToCurrentThread(fiber);
+
+                Atomic::FetchAddExplicit(&counters->busyTicks, Timer::Diff(Timer::GetTicks(), runTick), AtomicMemoryOrder::Relaxed);
+                continue;
             }
-            else if (waitingListIsLive) {
+            
+            if (waitingListIsLive) {
                 // Try picking another fiber cuz there are still workers in the waiting list but we couldn't pick them up
                 // TODO: we probably need to modify something here to not spin the threads with waiting signals
                 gJobs.semaphores[typeIndex].Post();
@@ -481,6 +683,8 @@ namespace Jobs
                 else
                     Thread::SwitchContext();
             }
+
+            Atomic::FetchAddExplicit(&counters->spinTicks, Timer::Diff(Timer::GetTicks(), wakeTick), AtomicMemoryOrder::Relaxed);
         }
 
         Mem::Free(_GetThreadData());
@@ -488,7 +692,8 @@ namespace Jobs
     }
 
     static JobsInstance* _DispatchInternal(bool isAutoDelete, JobsType type, JobsCallback callback, void* userData, 
-                                        uint32 groupSize, JobsPriority prio, JobsStackSize stackSize)
+                                        uint32 groupSize, JobsPriority prio, JobsStackSize stackSize,
+                                        const JobsCancelToken* cancelToken, uint32 deadlineMS)
     {
         ASSERT(groupSize);
 
@@ -515,6 +720,21 @@ namespace Jobs
         #endif
 
         // Push workers to the end of the list, will be collected by fiber threads
+        uint64 dispatchTick = Timer::GetTicks();
+        Atomic::FetchAddExplicit(&gJobs.telemetry.numDispatches[uint32(type)], numFibers, AtomicMemoryOrder::Relaxed);
+
+        // Already cancelled: Nothing is queued and the handle is completed right away
+        if (cancelToken && cancelToken->IsCancelled()) {
+            Atomic::FetchAddExplicit(&gJobs.telemetry.numDropped[uint32(type)], numFibers, AtomicMemoryOrder::Relaxed);
+            Atomic::StoreExplicit(&instance->counter, 0, AtomicMemoryOrder::Release);
+            if (isAutoDelete) {
+                gJobs.instancePool->Delete(instance);
+                return nullptr;
+            }
+            return instance;
+        }
+
+        uint64 deadlineTick = deadlineMS ? (dispatchTick + uint64(deadlineMS)*1000000ull) : 0;
         {
             JobsLockScope lock(gJobs.waitingListLock);
             for (uint32 i = 0; i < numFibers; i++) {
@@ -525,7 +745,10 @@ namespace Jobs
                     .instance = instance,
                     .prio = prio,
                     .stackSize = stackSize,
-                    .index = i
+                    .index = i,
+                    .dispatchTick = dispatchTick,
+                    .cancelToken = cancelToken,
+                    .deadlineTick = deadlineTick
                 };
     
                 gJobs.waitingLists[uint32(type)].AddToList(props);
@@ -536,6 +759,98 @@ namespace Jobs
         gJobs.semaphores[uint32(type)].Post(numFibers);
         return instance;
     }
+
+    // Returns the current fiber if it can be parked on a mutex, otherwise the caller should spin-wait
+    static JobsFiber* _GetParkableFiber()
+    {
+        if (!gIsInFiber || MemTempAllocator::IsActive())
+            return nullptr;
+        return _GetThreadData()->curFiber;
+    }
+
+    // 'lock' must be held by the caller and the waiter must already be in a wait list of the mutex
+    // Lock is released by the worker thread after the fiber is switched out. We continue from here after the lock is handed over to us
+    static void _ParkCurrentFiber(JobsFiber* fiber, SpinLockMutex* lock)
+    {
+        JobsThreadData* tdata = _GetThreadData();
+        ASSERT(tdata->curFiber == fiber);
+        ASSERT(tdata->parkLock == nullptr);
+
+        fiber->ownerTid = tdata->threadId;
+        tdata->parkLock = lock;
+
+        // Jump out of the fiber
+        // Back to `jobsThreadFn::jobsSetFiberToCurrentThread
+        {
+            mco_coro* co = fiber->co;
+            ASSERT(co);
+            ASSERT(co->state != MCO_SUSPENDED);
+            ASSERT(co->state != MCO_DEAD);
+            co->state = MCO_SUSPENDED;
+
+            #ifdef _MCO_USE_ASAN
+            void* bottom_old = nullptr;
+            size_t size_old = 0;
+            __sanitizer_finish_switch_fiber(co->asan_prev_stack, (const void**)&bottom_old, &size_old);
+            #endif
+
+            #ifdef _MCO_USE_TSAN
+            void* tsan_prev_fiber = co->tsan_prev_fiber;
+            co->tsan_prev_fiber = nullptr;
+            __tsan_switch_to_fiber(tsan_prev_fiber, 0);
+            #endif
+
+            Debug::FiberScopeProtector_Check();
+
+            _mco_context* context = (_mco_context*)co->context;
+            _mco_switch(&context->ctx, &context->back_ctx);
+        }
+    }
+
+    // Waits on the waiter until the lock is handed over. 'lock' must be held by the caller and is released by this function
+    static void _WaitForHandover(JobsMutexWaiter* waiter, SpinLockMutex* lock)
+    {
+        if (waiter->fiber) {
+            _ParkCurrentFiber(waiter->fiber, lock);
+            ASSERT(Atomic::LoadExplicit(&waiter->granted, AtomicMemoryOrder::Acquire));
+        }
+        else {
+            lock->Exit();
+
+            uint32 spinCount = !PLATFORM_MOBILE;
+            while (!Atomic::LoadExplicit(&waiter->granted, AtomicMemoryOrder::Acquire)) {
+                if (spinCount++ & 1023)
+                    OS::PauseCPU();
+                else
+                    Thread::SwitchContext();
+            }
+        }
+    }
+
+    // Hands over the lock to the list of waiters. Must be called outside the mutex lock.
+    // Waiters live on the stacks of the waiting fibers/threads, so we can't touch them after they are granted
+    static void _WakeWaiters(JobsMutexWaiter* waiter)
+    {
+        while (waiter) {
+            JobsMutexWaiter* next = waiter->next;
+            JobsFiber* fiber = waiter->fiber;
+
+            Atomic::StoreExplicit(&waiter->granted, 1, AtomicMemoryOrder::Release);
+            if (fiber) {
+                // Fiber is completely switched out at this point, because the worker releases the mutex lock after that
+                fiber->childCounter = nullptr;
+                fiber->signal = nullptr;
+                uint32 typeIndex = uint32(fiber->props->instance->type);
+                {
+                    JobsLockScope lk(gJobs.waitingListLock);
+                    gJobs.waitingLists[typeIndex].AddToList(fiber->props);
+                }
+                gJobs.semaphores[typeIndex].Post();
+            }
+
+            waiter = next;
+        }
+    }
 } // Jobs
 
 void Jobs::WaitForCompletionAndDelete(JobsHandle instance)
@@ -593,7 +908,7 @@ void Jobs::WaitForCompletionAndDelete(JobsHandle instance)
     gJobs.instancePool->Delete(instance);
 }
 
-void Jobs::YieldCurrent()
+bool Jobs::YieldCurrent()
 {
     JobsThreadData* tdata = _GetThreadData();
     ASSERT_MSG(tdata, "YieldCurrent() can only be called within the task threads");
@@ -627,6 +942,9 @@ void Jobs::YieldCurrent()
         _mco_context* context = (_mco_context*)co->context;
         _mco_switch(&context->ctx, &context->back_ctx);
     }
+
+    const JobsCancelToken* token = curFiber->props->cancelToken;
+    return !token || !token->IsCancelled();
 }
 
 bool Jobs::IsRunning(JobsHandle handle)
@@ -643,14 +961,39 @@ void Jobs::Delete(JobsHandle handle)
     gJobs.instancePool->Delete(handle);
 }
 
-JobsHandle Jobs::Dispatch(JobsType type, JobsCallback callback, void* userData, uint32 groupSize, JobsPriority prio, JobsStackSize stackSize)
+JobsHandle Jobs::Dispatch(JobsType type, JobsCallback callback, void* userData, uint32 groupSize, JobsPriority prio, JobsStackSize stackSize,
+                          const JobsCancelToken* cancelToken, uint32 deadlineMS)
+{
+    return _DispatchInternal(false, type, callback, userData, groupSize, prio, stackSize, cancelToken, deadlineMS);
+}
+
+void Jobs::DispatchAndForget(JobsType type, JobsCallback callback, void* userData, uint32 groupSize, JobsPriority prio, JobsStackSize stackSize,
+                             const JobsCancelToken* cancelToken, uint32 deadlineMS)
+{
+    _DispatchInternal(true, type, callback, userData, groupSize, prio, stackSize, cancelToken, deadlineMS);
+}
+
+bool Jobs::IsCurrentCancelled()
 {
-    return _DispatchInternal(false, type, callback, userData, groupSize, prio, stackSize);
+    JobsThreadData* tdata = _GetThreadData();
+    ASSERT_MSG(tdata && tdata->curFiber, "IsCurrentCancelled() can only be called within running jobs");
+    const JobsCancelToken* token = tdata->curFiber->props->cancelToken;
+    return token && token->IsCancelled();
 }
 
-void Jobs::DispatchAndForget(JobsType type, JobsCallback callback, void* userData, uint32 groupSize, JobsPriority prio, JobsStackSize stackSize)
+void JobsCancelToken::Cancel()
 {
-    _DispatchInternal(true, type, callback, userData, groupSize, prio, stackSize);
+    Atomic::StoreExplicit(&mCancelled, 1, AtomicMemoryOrder::Release);
+}
+
+void JobsCancelToken::Reset()
+{
+    Atomic::StoreExplicit(&mCancelled, 0, AtomicMemoryOrder::Release);
+}
+
+bool JobsCancelToken::IsCancelled() const
+{
+    return Atomic::LoadExplicit(const_cast<uint32*>(&mCancelled), AtomicMemoryOrder::Acquire) != 0;
 }
 
 uint32 Jobs::GetWorkerThreadsCount(JobsType type)
@@ -660,12 +1003,343 @@ uint32 Jobs::GetWorkerThreadsCount(JobsType type)
 }
 
 
+//    ████████╗███████╗██╗     ███████╗███╗   ███╗███████╗████████╗██████╗ ██╗   ██╗
+//    ╚══██╔══╝██╔════╝██║     ██╔════╝████╗ ████║██╔════╝╚══██╔══╝██╔══██╗╚██╗ ██╔╝
+//       ██║   █████╗  ██║     █████╗  ██╔████╔██║█████╗     ██║   ██████╔╝ ╚████╔╝ 
+//       ██║   ██╔══╝  ██║     ██╔══╝  ██║╚██╔╝██║██╔══╝     ██║   ██╔══██╗  ╚██╔╝  
+//       ██║   ███████╗███████╗███████╗██║ ╚═╝ ██║███████╗   ██║   ██║  ██║   ██║   
+//       ╚═╝   ╚══════╝╚══════╝╚══════╝╚═╝     ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   
+void Jobs::EndTelemetryFrame()
+{
+    JobsTelemetry& tm = gJobs.telemetry;
+    if (!tm.workers)
+        return;
+
+    uint64 tick = Timer::GetTicks();
+    uint32 numShortTaskWorkers = gJobs.numThreads[uint32(JobsType::ShortTask)];
+
+    SpinLockMutexScope lock(tm.framesLock);
+    uint32 frameIndex = uint32(tm.numFrames & (_limits::JOBS_TELEMETRY_MAX_FRAMES - 1));
+    JobsTelemetryFrame& frame = tm.frames[frameIndex];
+    JobsTelemetryWorker* workers = &tm.frameWorkers[frameIndex*tm.numWorkers];
+
+    memset(&frame, 0x0, sizeof(frame));
+    frame.numFrames = 1;
+    frame.durationMS = float(Timer::ToMS(Timer::Diff(tick, tm.lastFrameTick)));
+    tm.lastFrameTick = tick;
+
+    // Note that busy time is added when the fiber switches out, so a fiber that runs across frames lands in the last one
+    for (uint32 i = 0; i < tm.numWorkers; i++) {
+        JobsWorkerCounters& c = tm.workers[i];
+        uint32 typeIndex = uint32(i < numShortTaskWorkers ? JobsType::ShortTask : JobsType::LongTask);
+
+        // Worker is still sleeping: Take the idle time so far
+        unsigned long long idleSinceTick = Atomic::LoadExplicit(&c.idleSinceTick, AtomicMemoryOrder::Relaxed);
+        if (idleSinceTick && idleSinceTick < tick &&
+            Atomic::CompareExchangeExplicit_Strong(&c.idleSinceTick, &idleSinceTick, tick, AtomicMemoryOrder::Relaxed, AtomicMemoryOrder::Relaxed))
+        {
+            Atomic::FetchAddExplicit(&c.idleTicks, tick - idleSinceTick, AtomicMemoryOrder::Relaxed);
+        }
+
+        workers[i] = JobsTelemetryWorker {
+            .busyMS = float(Timer::ToMS(Atomic::ExchangeExplicit(&c.busyTicks, 0, AtomicMemoryOrder::Relaxed))),
+            .spinMS = float(Timer::ToMS(Atomic::ExchangeExplicit(&c.spinTicks, 0, AtomicMemoryOrder::Relaxed))),
+            .idleMS = float(Timer::ToMS(Atomic::ExchangeExplicit(&c.idleTicks, 0, AtomicMemoryOrder::Relaxed))),
+            .numRuns = Atomic::ExchangeExplicit(&c.numRuns, 0, AtomicMemoryOrder::Relaxed),
+            .numYields = Atomic::ExchangeExplicit(&c.numYields, 0, AtomicMemoryOrder::Relaxed)
+        };
+
+        for (uint32 b = 0; b < JOBS_TELEMETRY_LATENCY_BUCKETS; b++)
+            frame.latencyHistogram[typeIndex][b] += Atomic::ExchangeExplicit(&c.latencyHistogram[b], 0, AtomicMemoryOrder::Relaxed);
+    }
+
+    for (uint32 typeIndex = 0; typeIndex < uint32(JobsType::_Count); typeIndex++) {
+        frame.numDispatches[typeIndex] = Atomic::ExchangeExplicit(&tm.numDispatches[typeIndex], 0, AtomicMemoryOrder::Relaxed);
+        frame.numDropped[typeIndex] = Atomic::ExchangeExplicit(&tm.numDropped[typeIndex], 0, AtomicMemoryOrder::Relaxed);
+
+        JobsWaitingList& list = gJobs.waitingLists[typeIndex];
+        for (uint32 prioIndex = 0; prioIndex < uint32(JobsPriority::_Count); prioIndex++) {
+            uint32 depth = Atomic::LoadExplicit(&list.mDepth[prioIndex], AtomicMemoryOrder::Relaxed);
+            frame.maxQueueDepth[typeIndex][prioIndex] = Atomic::ExchangeExplicit(&list.mMaxDepth[prioIndex], depth, AtomicMemoryOrder::Relaxed);
+        }
+    }
+
+    for (uint32 i = 0; i < uint32(JobsStackSize::_Count); i++) {
+        JobsFiberMemAllocator& alloc = gJobs.fiberAllocators[i];
+        SpinLockMutexScope allocLock(alloc.mLock);
+        frame.maxFibersInUse[i] = alloc.mMaxInUseFrame;
+        alloc.mMaxInUseFrame = alloc.mNumInUse;
+    }
+
+    ++tm.numFrames;
+}
+
+bool Jobs::GetTelemetry(uint32 numFrames, JobsTelemetryFrame* outFrame, JobsTelemetryWorker* outWorkers)
+{
+    ASSERT(outFrame);
+    JobsTelemetry& tm = gJobs.telemetry;
+
+    SpinLockMutexScope lock(tm.framesLock);
+    numFrames = uint32(Min<uint64>(Min(numFrames, _limits::JOBS_TELEMETRY_MAX_FRAMES), tm.numFrames));
+    if (numFrames == 0)
+        return false;
+
+    memset(outFrame, 0x0, sizeof(*outFrame));
+    if (outWorkers)
+        memset(outWorkers, 0x0, sizeof(JobsTelemetryWorker)*tm.numWorkers);
+
+    for (uint64 f = tm.numFrames - numFrames; f < tm.numFrames; f++) {
+        uint32 frameIndex = uint32(f & (_limits::JOBS_TELEMETRY_MAX_FRAMES - 1));
+        const JobsTelemetryFrame& frame = tm.frames[frameIndex];
+
+        outFrame->numFrames += frame.numFrames;
+        outFrame->durationMS += frame.durationMS;
+        for (uint32 t = 0; t < uint32(JobsType::_Count); t++) {
+            outFrame->numDispatches[t] += frame.numDispatches[t];
+            outFrame->numDropped[t] += frame.numDropped[t];
+            for (uint32 p = 0; p < uint32(JobsPriority::_Count); p++)
+                outFrame->maxQueueDepth[t][p] = Max(outFrame->maxQueueDepth[t][p], frame.maxQueueDepth[t][p]);
+            for (uint32 b = 0; b < JOBS_TELEMETRY_LATENCY_BUCKETS; b++)
+                outFrame->latencyHistogram[t][b] += frame.latencyHistogram[t][b];
+        }
+        for (uint32 i = 0; i < uint32(JobsStackSize::_Count); i++)
+            outFrame->maxFibersInUse[i] = Max(outFrame->maxFibersInUse[i], frame.maxFibersInUse[i]);
+
+        if (outWorkers) {
+            const JobsTelemetryWorker* workers = &tm.frameWorkers[frameIndex*tm.numWorkers];
+            for (uint32 i = 0; i < tm.numWorkers; i++) {
+                outWorkers[i].busyMS += workers[i].busyMS;
+                outWorkers[i].spinMS += workers[i].spinMS;
+                outWorkers[i].idleMS += workers[i].idleMS;
+                outWorkers[i].numRuns += workers[i].numRuns;
+                outWorkers[i].numYields += workers[i].numYields;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Jobs::DumpTelemetryJson(const char* filepath, uint32 numFrames)
+{
+    ASSERT(filepath);
+    JobsTelemetry& tm = gJobs.telemetry;
+
+    MemTempAllocator tempAlloc;
+    Array<char> out(&tempAlloc);
+    char line[512];
+    uint32 lineLen;
+    uint32 numShortTaskWorkers = gJobs.numThreads[uint32(JobsType::ShortTask)];
+
+    auto WriteUintArray = [&out, &line](const uint32* values, uint32 count) {
+        out.Push('[');
+        for (uint32 i = 0; i < count; i++) {
+            uint32 len = Str::PrintFmt(line, sizeof(line), i ? ",%u" : "%u", values[i]);
+            out.Extend(line, len);
+        }
+        out.Push(']');
+    };
+
+    // Copy the frames under the lock and format them after, so the frame recording doesn't wait on the formatting
+    JobsTelemetryFrame* frames;
+    JobsTelemetryWorker* frameWorkers;
+    uint64 firstFrame;
+    uint32 numWorkers = tm.numWorkers;
+    {
+        SpinLockMutexScope lock(tm.framesLock);
+        numFrames = uint32(Min<uint64>(Min(numFrames, _limits::JOBS_TELEMETRY_MAX_FRAMES), tm.numFrames));
+        if (numFrames == 0) {
+            LOG_WARNING("Jobs: No telemetry frames are recorded yet");
+            return false;
+        }
+
+        frames = Mem::AllocTyped<JobsTelemetryFrame>(numFrames, &tempAlloc);
+        frameWorkers = Mem::AllocTyped<JobsTelemetryWorker>(numFrames*numWorkers, &tempAlloc);
+        firstFrame = tm.numFrames - numFrames;
+        for (uint32 i = 0; i < numFrames; i++) {
+            uint32 frameIndex = uint32((firstFrame + i) & (_limits::JOBS_TELEMETRY_MAX_FRAMES - 1));
+            frames[i] = tm.frames[frameIndex];
+            memcpy(&frameWorkers[i*numWorkers], &tm.frameWorkers[frameIndex*numWorkers], sizeof(JobsTelemetryWorker)*numWorkers);
+        }
+    }
+
+    lineLen = Str::PrintFmt(line, sizeof(line), 
+                            "{\"numShortTaskThreads\":%u,\"numLongTaskThreads\":%u,\"latencyBucketsUS\":\"<1,<2,<4,..,>=%u\",\"frames\":[\n",
+                            numShortTaskWorkers, gJobs.numThreads[uint32(JobsType::LongTask)], 1u << (JOBS_TELEMETRY_LATENCY_BUCKETS - 2));
+    out.Extend(line, lineLen);
+
+    for (uint32 k = 0; k < numFrames; k++) {
+        const JobsTelemetryFrame& frame = frames[k];
+        const JobsTelemetryWorker* workers = &frameWorkers[k*numWorkers];
+
+        lineLen = Str::PrintFmt(line, sizeof(line), "%s{\"frame\":%llu,\"durationMS\":%.3f,\"numDispatches\":", 
+                                k ? ",\n" : "", firstFrame + k, frame.durationMS);
+        out.Extend(line, lineLen);
+        WriteUintArray(frame.numDispatches, uint32(JobsType::_Count));
+
+        out.Extend(",\"numDropped\":", 14);
+        WriteUintArray(frame.numDropped, uint32(JobsType::_Count));
+
+        out.Extend(",\"maxQueueDepth\":[", 18);
+        for (uint32 t = 0; t < uint32(JobsType::_Count); t++) {
+            if (t)
+                out.Push(',');
+            WriteUintArray(frame.maxQueueDepth[t], uint32(JobsPriority::_Count));
+        }
+
+        out.Extend("],\"latencyHistogram\":[", 22);
+        for (uint32 t = 0; t < uint32(JobsType::_Count); t++) {
+            if (t)
+                out.Push(',');
+            WriteUintArray(frame.latencyHistogram[t], JOBS_TELEMETRY_LATENCY_BUCKETS);
+        }
+
+        out.Extend("],\"maxFibersInUse\":", 19);
+        WriteUintArray(frame.maxFibersInUse, uint32(JobsStackSize::_Count));
+
+        out.Extend(",\"workers\":[", 12);
+        for (uint32 i = 0; i < numWorkers; i++) {
+            const JobsTelemetryWorker& w = workers[i];
+            lineLen = Str::PrintFmt(line, sizeof(line), 
+                                    "%s{\"name\":\"%s_%u\",\"busyMS\":%.3f,\"spinMS\":%.3f,\"idleMS\":%.3f,\"numRuns\":%u,\"numYields\":%u}",
+                                    i ? "," : "", i < numShortTaskWorkers ? "ShortTask" : "LongTask", 
+                                    i < numShortTaskWorkers ? i + 1 : i - numShortTaskWorkers + 1,
+                                    w.busyMS, w.spinMS, w.idleMS, w.numRuns, w.numYields);
+            out.Extend(line, lineLen);
+        }
+        out.Extend("]}", 2);
+    }
+    out.Extend("\n]}\n", 4);
+
+    bool r = false;
+    File file;
+    if (file.Open(filepath, FileOpenFlags::Write)) {
+        r = file.Write(out.Ptr(), out.Count()) == out.Count();
+        file.Close();
+    }
+
+    if (!r) {
+        LOG_ERROR("Jobs: Writing telemetry to '%s' failed", filepath);
+        return false;
+    }
+
+    LOG_INFO("Jobs: Telemetry of the last %u frames written to '%s'", numFrames, filepath);
+    return true;
+}
+
 //    ██╗███╗   ██╗██╗████████╗ ██╗██████╗ ███████╗██╗███╗   ██╗██╗████████╗
 //    ██║████╗  ██║██║╚══██╔══╝██╔╝██╔══██╗██╔════╝██║████╗  ██║██║╚══██╔══╝
 //    ██║██╔██╗ ██║██║   ██║  ██╔╝ ██║  ██║█████╗  ██║██╔██╗ ██║██║   ██║   
 //    ██║██║╚██╗██║██║   ██║ ██╔╝  ██║  ██║██╔══╝  ██║██║╚██╗██║██║   ██║   
 //    ██║██║ ╚████║██║   ██║██╔╝   ██████╔╝███████╗██║██║ ╚████║██║   ██║   
 //    ╚═╝╚═╝  ╚═══╝╚═╝   ╚═╝╚═╝    ╚═════╝ ╚══════╝╚═╝╚═╝  ╚═══╝╚═╝   ╚═╝   
+namespace Jobs
+{
+    static void _ComputePlacement(const SysCpuTopology& topo, JobsPlacement* placement)
+    {
+        const JobsInitParams& params = gJobs.initParams;
+        uint32 numShortTaskThreads = Min(gJobs.numThreads[uint32(JobsType::ShortTask)], SYS_MAX_PROCESSORS);
+
+        for (uint32 i = 0; i < topo.numProcessors; i++)
+            placement->allProcs[i] = topo.processors[i].id;
+        placement->numAllProcs = topo.numProcessors;
+
+        // Processors are sorted by cache domain and core, so the first one is the main thread's core
+        // Then we spread ShortTask workers on the first processor of each core, which keeps neighbour workers on the same LLC
+        uint32 reservedCore = (params.pinReserveMainThreadCore && topo.numCores > 1) ? topo.processors[0].coreIndex : UINT32_MAX;
+        bool usedCores[SYS_MAX_PROCESSORS] = {};
+        bool usedProcs[SYS_MAX_PROCESSORS] = {};
+        uint32 workerIndex = 0;
+
+        for (uint32 i = 0; i < topo.numProcessors && workerIndex < numShortTaskThreads; i++) {
+            const SysCpuTopology::Processor& proc = topo.processors[i];
+            if (proc.coreIndex != reservedCore && proc.smtIndex == 0) {
+                usedCores[proc.coreIndex] = true;
+                usedProcs[i] = true;
+                placement->shortTaskProcs[workerIndex++] = proc.id;
+            }
+        }
+
+        // Ran out of physical cores. Sibling threads are the next best thing, unless they are reserved for LongTasks
+        if (!params.pinAvoidSmtSiblings) {
+            for (uint32 i = 0; i < topo.numProcessors && workerIndex < numShortTaskThreads; i++) {
+                const SysCpuTopology::Processor& proc = topo.processors[i];
+                if (proc.coreIndex != reservedCore && !usedProcs[i]) {
+                    usedProcs[i] = true;
+                    placement->shortTaskProcs[workerIndex++] = proc.id;
+                }
+            }
+        }
+
+        for (; workerIndex < numShortTaskThreads; workerIndex++)
+            placement->shortTaskProcs[workerIndex] = UINT16_MAX;
+
+        // LongTask threads mostly wait on IO, they can share whatever is left
+        placement->numLongTaskProcs = 0;
+        placement->numMainThreadProcs = 0;
+        for (uint32 i = 0; i < topo.numProcessors; i++) {
+            const SysCpuTopology::Processor& proc = topo.processors[i];
+            if (proc.coreIndex == reservedCore)
+                placement->mainThreadProcs[placement->numMainThreadProcs++] = proc.id;
+            else if (!usedProcs[i] && !(params.pinAvoidSmtSiblings && usedCores[proc.coreIndex]))
+                placement->longTaskProcs[placement->numLongTaskProcs++] = proc.id;
+        }
+
+        // Nothing left: LongTasks can run anywhere (mostly sleeping anyways)
+        if (placement->numLongTaskProcs == 0) {
+            memcpy(placement->longTaskProcs, placement->allProcs, sizeof(uint16)*placement->numAllProcs);
+            placement->numLongTaskProcs = placement->numAllProcs;
+        }
+
+        placement->valid = true;
+    }
+
+    static void _ApplyPlacement(bool pinned)
+    {
+        JobsPlacement& placement = gJobs.placement;
+        if (!placement.valid || placement.pinned == pinned)
+            return;
+
+        bool r = true;
+        for (uint32 i = 0; i < gJobs.numThreads[uint32(JobsType::ShortTask)]; i++) {
+            Thread& thrd = gJobs.threads[uint32(JobsType::ShortTask)][i];
+            if (pinned && i < SYS_MAX_PROCESSORS && placement.shortTaskProcs[i] != UINT16_MAX)
+                r &= thrd.SetAffinity(&placement.shortTaskProcs[i], 1);
+            else
+                r &= thrd.SetAffinity(placement.allProcs, placement.numAllProcs);
+        }
+
+        for (uint32 i = 0; i < gJobs.numThreads[uint32(JobsType::LongTask)]; i++) {
+            Thread& thrd = gJobs.threads[uint32(JobsType::LongTask)][i];
+            if (pinned)
+                r &= thrd.SetAffinity(placement.longTaskProcs, placement.numLongTaskProcs);
+            else
+                r &= thrd.SetAffinity(placement.allProcs, placement.numAllProcs);
+        }
+
+        if (!r)
+            LOG_WARNING("Jobs: Setting thread affinities failed");
+        placement.pinned = pinned;
+    }
+
+    // Only called by Initialize/Release, on the thread that owns the reserved core. Worker pinning can be toggled from
+    // anywhere (see RunPinningBenchmark), but it must never move the affinity of whatever thread happens to call it
+    static void _ApplyMainThreadPlacement(bool pinned)
+    {
+        JobsPlacement& placement = gJobs.placement;
+        if (!placement.valid || !placement.numMainThreadProcs || placement.mainThreadPinned == pinned)
+            return;
+        ASSERT(placement.mainThreadId == Thread::GetCurrentId());
+
+        bool r = pinned ? 
+            Thread::SetCurrentThreadAffinity(placement.mainThreadProcs, placement.numMainThreadProcs) :
+            Thread::SetCurrentThreadAffinity(placement.allProcs, placement.numAllProcs);
+        if (!r)
+            LOG_WARNING("Jobs: Setting main thread affinity failed");
+        placement.mainThreadPinned = pinned;
+    }
+} // Jobs
+
 void Jobs::Initialize(const JobsInitParams& initParams)
 {
     ASSERT(initParams.alloc);
@@ -705,6 +1379,17 @@ void Jobs::Initialize(const JobsInitParams& initParams)
     gJobs.instancePool = JobsAtomicPool<JobsInstance, _limits::JOBS_MAX_INSTANCES>::Create(initParams.alloc);
     gJobs.fiberPropsPool = JobsAtomicPool<JobsFiberProperties, _limits::JOBS_MAX_PENDING>::Create(initParams.alloc);
 
+    // Telemetry
+    {
+        JobsTelemetry& tm = gJobs.telemetry;
+        tm.numWorkers = gJobs.numThreads[uint32(JobsType::ShortTask)] + gJobs.numThreads[uint32(JobsType::LongTask)];
+        tm.workers = Mem::AllocAlignedTyped<JobsWorkerCounters>(tm.numWorkers, alignof(JobsWorkerCounters), initParams.alloc);
+        memset(tm.workers, 0x0, sizeof(JobsWorkerCounters)*tm.numWorkers);
+        tm.frames = Mem::AllocZeroTyped<JobsTelemetryFrame>(_limits::JOBS_TELEMETRY_MAX_FRAMES, initParams.alloc);
+        tm.frameWorkers = Mem::AllocZeroTyped<JobsTelemetryWorker>(_limits::JOBS_TELEMETRY_MAX_FRAMES*tm.numWorkers, initParams.alloc);
+        tm.lastFrameTick = Timer::GetTicks();
+    }
+
     // Initialize and start the threads
     // LongTasks
     gJobs.threads[uint32(JobsType::LongTask)] = NEW_ARRAY(initParams.alloc, Thread, gJobs.numThreads[uint32(JobsType::LongTask)]);
@@ -740,6 +1425,21 @@ void Jobs::Initialize(const JobsInitParams& initParams)
         gJobs.threads[uint32(JobsType::ShortTask)][i].SetPriority(ThreadPriority::High);
     }
 
+    if (initParams.pinThreads) {
+        SysCpuTopology topo;
+        if (OS::GetCpuTopology(&topo)) {
+            _ComputePlacement(topo, &gJobs.placement);
+            gJobs.placement.mainThreadId = Thread::GetCurrentId();
+            _ApplyPlacement(true);
+            _ApplyMainThreadPlacement(true);
+            LOG_VERBOSE("(init) Job threads pinned: %u cores, %u logical processors, %u cache domains", 
+                        topo.numCores, topo.numProcessors, topo.numCacheDomains);
+        }
+        else {
+            LOG_WARNING("Jobs: Thread pinning is not supported on this platform");
+        }
+    }
+
     Debug::FiberScopeProtector_RegisterCallback([](void*)->bool { return gIsInFiber; });
 
     #if TRACY_ENABLE
@@ -777,6 +1477,30 @@ void Jobs::Initialize(const JobsInitParams& initParams)
     };
 
     Tracy::SetZoneCallbacks(TracyEnterZone, TracyExitZone);
+    #elif CONFIG_ENABLE_PROFILER
+    auto ProfilerEnterZone = [](ProfilerZone* zone)
+    {
+        if (gIsInFiber) {
+            JobsThreadData* tdata = _GetThreadData();
+            ASSERT(tdata->curFiber);
+
+            ASSERT_MSG(!tdata->curFiber->profilerZonesStack.IsFull(), "Profile sampling stack is too deep. Either remove samples or increase the JOBS_PROFILER_MAX_STACKDEPTH");
+            tdata->curFiber->profilerZonesStack.Push(zone);
+        }
+    };
+
+    auto ProfilerExitZone = [](ProfilerZone* zone)
+    {
+        if (gIsInFiber) {
+            JobsThreadData* tdata = _GetThreadData();
+            ASSERT(tdata->curFiber);
+            JobsFiber* fiber = tdata->curFiber;
+            if (fiber->profilerZonesStack.Count() && fiber->profilerZonesStack.Last() == zone)
+                fiber->profilerZonesStack.PopLast();
+        }
+    };
+
+    Profiler::SetZoneCallbacks(ProfilerEnterZone, ProfilerExitZone);
     #endif  // TRACY_ENABLE
 
     LOG_INFO("(init) Job dispatcher: %u short task threads, %u long task threads", 
@@ -786,6 +1510,7 @@ void Jobs::Initialize(const JobsInitParams& initParams)
 
 void Jobs::Release()
 {
+    _ApplyMainThreadPlacement(false);   // Main thread affinity outlives the job system
     Atomic::StoreExplicit(&gJobs.quit, 1, AtomicMemoryOrder::Release);
 
     gJobs.semaphores[uint32(JobsType::ShortTask)].Post(gJobs.numThreads[uint32(JobsType::ShortTask)]);
@@ -811,6 +1536,13 @@ void Jobs::Release()
 
     for (uint32 i = 0; i < uint32(JobsStackSize::_Count); i++)
         gJobs.fiberAllocators[i].Release();
+
+    if (gJobs.telemetry.workers)
+        Mem::FreeAligned(gJobs.telemetry.workers, alignof(JobsWorkerCounters), gJobs.initParams.alloc);
+    if (gJobs.telemetry.frames)
+        Mem::Free(gJobs.telemetry.frames, gJobs.initParams.alloc);
+    if (gJobs.telemetry.frameWorkers)
+        Mem::Free(gJobs.telemetry.frameWorkers, gJobs.initParams.alloc);
 }
 
 //    ███████╗██╗ ██████╗ ███╗   ██╗ █████╗ ██╗     
@@ -914,6 +1646,459 @@ void JobsSignal::Increment()
 }
 
 
+//    ███╗   ███╗██╗   ██╗████████╗███████╗██╗  ██╗
+//    ████╗ ████║██║   ██║╚══██╔══╝██╔════╝╚██╗██╔╝
+//    ██╔████╔██║██║   ██║   ██║   █████╗   ╚███╔╝ 
+//    ██║╚██╔╝██║██║   ██║   ██║   ██╔══╝   ██╔██╗ 
+//    ██║ ╚═╝ ██║╚██████╔╝   ██║   ███████╗██╔╝ ██╗
+//    ╚═╝     ╚═╝ ╚═════╝    ╚═╝   ╚══════╝╚═╝  ╚═╝
+inline void JobsMutexWaitList::Push(JobsMutexWaiter* waiter)
+{
+    waiter->next = nullptr;
+    if (mLast)
+        mLast->next = waiter;
+    else
+        mFirst = waiter;
+    mLast = waiter;
+}
+
+inline JobsMutexWaiter* JobsMutexWaitList::PopFirst()
+{
+    JobsMutexWaiter* waiter = mFirst;
+    if (waiter) {
+        mFirst = waiter->next;
+        if (!mFirst)
+            mLast = nullptr;
+        waiter->next = nullptr;
+    }
+    return waiter;
+}
+
+inline JobsMutexWaiter* JobsMutexWaitList::PopAll()
+{
+    JobsMutexWaiter* waiter = mFirst;
+    mFirst = mLast = nullptr;
+    return waiter;
+}
+
+void JobsMutex::Initialize(uint32 spinCount)
+{
+    JobsMutexInternal* self = PLACEMENT_NEW(mData, JobsMutexInternal) {};
+    self->spinCount = spinCount;
+}
+
+void JobsMutex::Release()
+{
+    [[maybe_unused]] JobsMutexInternal* self = reinterpret_cast<JobsMutexInternal*>(mData);
+    ASSERT_MSG(!self->locked && self->waiters.IsEmpty(), "JobsMutex is still in use");
+}
+
+bool JobsMutex::TryEnter()
+{
+    JobsMutexInternal* self = reinterpret_cast<JobsMutexInternal*>(mData);
+    SpinLockMutexScope lk(self->lock);
+    if (self->locked)
+        return false;
+    Atomic::StoreExplicit(&self->locked, 1, AtomicMemoryOrder::Relaxed);
+    return true;
+}
+
+void JobsMutex::Enter()
+{
+    JobsMutexInternal* self = reinterpret_cast<JobsMutexInternal*>(mData);
+
+    // Short spin before waiting, lock is usually held for short periods
+    for (uint32 i = 0; i < self->spinCount; i++) {
+        if (!Atomic::LoadExplicit(&self->locked, AtomicMemoryOrder::Relaxed) && TryEnter())
+            return;
+        OS::PauseCPU();
+    }
+
+    self->lock.Enter();
+    if (!self->locked) {
+        Atomic::StoreExplicit(&self->locked, 1, AtomicMemoryOrder::Relaxed);
+        self->lock.Exit();
+        return;
+    }
+
+    // Ownership is handed over to us on Exit, so 'locked' stays true
+    JobsMutexWaiter waiter { .fiber = Jobs::_GetParkableFiber() };
+    self->waiters.Push(&waiter);
+    Jobs::_WaitForHandover(&waiter, &self->lock);
+}
+
+void JobsMutex::Exit()
+{
+    JobsMutexInternal* self = reinterpret_cast<JobsMutexInternal*>(mData);
+
+    JobsMutexWaiter* waiter;
+    {
+        SpinLockMutexScope lk(self->lock);
+        ASSERT_MSG(self->locked, "JobsMutex is not locked");
+        waiter = self->waiters.PopFirst();
+        if (!waiter)
+            Atomic::StoreExplicit(&self->locked, 0, AtomicMemoryOrder::Relaxed);
+    }
+
+    if (waiter)
+        Jobs::_WakeWaiters(waiter);
+}
+
+void JobsReadWriteMutex::Initialize()
+{
+    PLACEMENT_NEW(mData, JobsReadWriteMutexInternal) {};
+}
+
+void JobsReadWriteMutex::Release()
+{
+    [[maybe_unused]] JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+    ASSERT_MSG(!self->writer && self->numReaders == 0 && self->readers.IsEmpty() && self->writers.IsEmpty(), 
+               "JobsReadWriteMutex is still in use");
+}
+
+bool JobsReadWriteMutex::TryRead()
+{
+    JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+    SpinLockMutexScope lk(self->lock);
+    if (self->writer)
+        return false;
+    ++self->numReaders;
+    return true;
+}
+
+bool JobsReadWriteMutex::TryWrite()
+{
+    JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+    SpinLockMutexScope lk(self->lock);
+    if (self->writer || self->numReaders)
+        return false;
+    self->writer = true;
+    return true;
+}
+
+void JobsReadWriteMutex::EnterRead()
+{
+    JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+
+    self->lock.Enter();
+    if (!self->writer) {
+        ++self->numReaders;
+        self->lock.Exit();
+        return;
+    }
+
+    // numReaders is incremented for us by the writer that hands over the lock
+    JobsMutexWaiter waiter { .fiber = Jobs::_GetParkableFiber() };
+    self->readers.Push(&waiter);
+    Jobs::_WaitForHandover(&waiter, &self->lock);
+}
+
+void JobsReadWriteMutex::ExitRead()
+{
+    JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+
+    JobsMutexWaiter* waiter = nullptr;
+    {
+        SpinLockMutexScope lk(self->lock);
+        ASSERT_MSG(self->numReaders, "JobsReadWriteMutex is not read locked");
+        if (--self->numReaders == 0) {
+            waiter = self->writers.PopFirst();
+            if (waiter)
+                self->writer = true;
+        }
+    }
+
+    if (waiter)
+        Jobs::_WakeWaiters(waiter);
+}
+
+void JobsReadWriteMutex::EnterWrite()
+{
+    JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+
+    self->lock.Enter();
+    if (!self->writer && self->numReaders == 0) {
+        self->writer = true;
+        self->lock.Exit();
+        return;
+    }
+
+    JobsMutexWaiter waiter { .fiber = Jobs::_GetParkableFiber() };
+    self->writers.Push(&waiter);
+    Jobs::_WaitForHandover(&waiter, &self->lock);
+}
+
+void JobsReadWriteMutex::ExitWrite()
+{
+    JobsReadWriteMutexInternal* self = reinterpret_cast<JobsReadWriteMutexInternal*>(mData);
+
+    JobsMutexWaiter* waiter;
+    {
+        SpinLockMutexScope lk(self->lock);
+        ASSERT_MSG(self->writer, "JobsReadWriteMutex is not write locked");
+
+        // Readers are preferred: wake all of them at once. Otherwise, hand over to the next writer
+        waiter = self->readers.PopAll();
+        if (waiter) {
+            self->writer = false;
+            for (JobsMutexWaiter* w = waiter; w; w = w->next)
+                ++self->numReaders;
+        }
+        else {
+            waiter = self->writers.PopFirst();
+            self->writer = waiter != nullptr;
+        }
+    }
+
+    if (waiter)
+        Jobs::_WakeWaiters(waiter);
+}
+
+void JobsEvent::Initialize()
+{
+    PLACEMENT_NEW(mData, JobsEventInternal) {};
+}
+
+void JobsEvent::Release()
+{
+    [[maybe_unused]] JobsEventInternal* self = reinterpret_cast<JobsEventInternal*>(mData);
+    ASSERT_MSG(self->waiters.IsEmpty(), "JobsEvent is still being waited on");
+}
+
+void JobsEvent::Raise()
+{
+    JobsEventInternal* self = reinterpret_cast<JobsEventInternal*>(mData);
+
+    JobsMutexWaiter* waiter;
+    {
+        SpinLockMutexScope lk(self->lock);
+        Atomic::StoreExplicit(&self->raised, 2, AtomicMemoryOrder::Relaxed);
+        waiter = self->waiters.PopAll();
+    }
+
+    // The event usually lives on the waiter's stack (Vfs::ReadFileAwait for example) and the waiter is free to destroy it
+    // as soon as it sees raised=1. So this must be the last access to the event, unlocking above included
+    Atomic::StoreExplicit(&self->raised, 1, AtomicMemoryOrder::Release);
+
+    // Waiters are parked until we wake them, so their list nodes are still alive
+    if (waiter)
+        Jobs::_WakeWaiters(waiter);
+}
+
+void JobsEvent::Wait()
+{
+    JobsEventInternal* self = reinterpret_cast<JobsEventInternal*>(mData);
+    if (Atomic::LoadExplicit(&self->raised, AtomicMemoryOrder::Acquire) == 1)
+        return;
+
+    self->lock.Enter();
+    if (Atomic::LoadExplicit(&self->raised, AtomicMemoryOrder::Relaxed)) {
+        self->lock.Exit();
+
+        // Raise has already popped the waiters but hasn't finished yet. Returning now would let the caller destroy 
+        // the event under its feet
+        while (Atomic::LoadExplicit(&self->raised, AtomicMemoryOrder::Acquire) != 1)
+            OS::PauseCPU();
+        return;
+    }
+
+    JobsMutexWaiter waiter { .fiber = Jobs::_GetParkableFiber() };
+    self->waiters.Push(&waiter);
+    Jobs::_WaitForHandover(&waiter, &self->lock);
+}
+
+void JobsEvent::Reset()
+{
+    JobsEventInternal* self = reinterpret_cast<JobsEventInternal*>(mData);
+    Atomic::StoreExplicit(&self->raised, 0, AtomicMemoryOrder::Release);
+}
+
+bool JobsEvent::IsRaised()
+{
+    JobsEventInternal* self = reinterpret_cast<JobsEventInternal*>(mData);
+    return Atomic::LoadExplicit(&self->raised, AtomicMemoryOrder::Acquire) == 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Pinning benchmark
+struct JobsPinningBenchData
+{
+    uint64* buffers;                // One working set per ShortTask worker
+    uint32 bufferCount;             // Number of uint64 items in each buffer
+    uint32 numPasses;
+    AtomicUint64 sum;
+};
+
+static double _JobsPinningBenchRun(JobsPinningBenchData* data, uint32 numJobs)
+{
+    // Each worker keeps hammering its own buffer. The data stays hot in L2 as long as the worker doesn't migrate to another core
+    auto PassesJob = [](uint32, void* userData)
+    {
+        JobsPinningBenchData* data = (JobsPinningBenchData*)userData;
+        JobsThreadData* tdata = Jobs::_GetThreadData();
+        uint64* buffer = data->buffers + size_t(tdata->threadIndex - 1)*data->bufferCount;
+        uint64 sum = 0;
+        for (uint32 pass = 0; pass < data->numPasses; pass++) {
+            for (uint32 i = 0; i < data->bufferCount; i++) {
+                sum += buffer[i];
+                buffer[i] = sum;
+            }
+        }
+        Atomic::FetchAddExplicit(&data->sum, sum, AtomicMemoryOrder::Relaxed);
+    };
+
+    uint64 startTm = Timer::GetTicks();
+    Jobs::WaitForCompletionAndDelete(Jobs::Dispatch(JobsType::ShortTask, PassesJob, data, numJobs));
+    return Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+}
+
+JobsPinningBenchmarkResult Jobs::RunPinningBenchmark(uint32 numJobs, uint32 numPasses)
+{
+    ASSERT_MSG(!gIsInFiber, "Benchmark cannot run inside jobs");
+
+    SysInfo info {};
+    OS::GetSysInfo(&info);
+
+    uint32 numWorkers = gJobs.numThreads[uint32(JobsType::ShortTask)];
+    uint32 bufferSize = Clamp<uint32>(info.L2Cache.size ? info.L2Cache.size : 256*SIZE_KB, 64*SIZE_KB, 2*SIZE_MB);
+    numJobs = Max(numJobs, 1u);
+    numPasses = Max(numPasses, 1u);
+
+    JobsPinningBenchmarkResult result { .numJobs = numJobs, .numPasses = numPasses, .bufferSize = bufferSize };
+
+    if (!gJobs.placement.valid) {
+        SysCpuTopology topo;
+        if (OS::GetCpuTopology(&topo))
+            _ComputePlacement(topo, &gJobs.placement);
+    }
+    result.supported = gJobs.placement.valid;
+
+    JobsPinningBenchData data {
+        .buffers = (uint64*)Mem::AllocAligned(size_t(bufferSize)*numWorkers, CACHE_LINE_SIZE),
+        .bufferCount = bufferSize / uint32(sizeof(uint64)),
+        .numPasses = numPasses
+    };
+    memset(data.buffers, 0x0, size_t(bufferSize)*numWorkers);
+
+    _ApplyPlacement(false);
+    _JobsPinningBenchRun(&data, numWorkers);    // Warm up: page-in buffers and wake up the workers
+    result.unpinnedMS = _JobsPinningBenchRun(&data, numJobs);
+
+    if (result.supported) {
+        _ApplyPlacement(true);
+        _JobsPinningBenchRun(&data, numWorkers);
+        result.pinnedMS = _JobsPinningBenchRun(&data, numJobs);
+    }
+
+    _ApplyPlacement(gJobs.initParams.pinThreads);
+    Mem::FreeAligned(data.buffers, CACHE_LINE_SIZE);
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Cancellation self-test
+struct JobsCancelTestData
+{
+    JobsCancelToken token;              // Shared by the parent and its children
+    uint32 numChildren;
+    AtomicUint32 openGate;              // Blocker jobs keep all LongTask workers busy until it's set, so the children stay queued
+    AtomicUint32 numBlockersStarted;
+    AtomicUint32 childrenDispatched;
+    AtomicUint32 numChildRuns;
+    AtomicUint32 parentSawCancel;
+};
+
+static bool _JobsCancelTestWait(AtomicUint32* value, uint32 expected, uint32 timeoutMS)
+{
+    uint64 startTick = Timer::GetTicks();
+    while (Atomic::LoadExplicit(value, AtomicMemoryOrder::Acquire) != expected) {
+        if (Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTick)) > timeoutMS)
+            return false;
+        Thread::Sleep(0);
+    }
+    return true;
+}
+
+uint32 Jobs::RunCancelSelfTest(uint32 numIterations, uint32 numChildren)
+{
+    ASSERT_MSG(!gIsInFiber, "Self-test cannot run inside jobs");
+    static constexpr uint32 TIMEOUT_MS = 5000;
+
+    auto BlockerJob = [](uint32, void* userData)
+    {
+        JobsCancelTestData* data = (JobsCancelTestData*)userData;
+        Atomic::FetchAdd(&data->numBlockersStarted, 1);
+        while (!Atomic::LoadExplicit(&data->openGate, AtomicMemoryOrder::Acquire))
+            Thread::Sleep(0);
+    };
+
+    auto ParentJob = [](uint32, void* userData)
+    {
+        auto ChildJob = [](uint32, void* userData)
+        {
+            JobsCancelTestData* data = (JobsCancelTestData*)userData;
+            Atomic::FetchAdd(&data->numChildRuns, 1);
+        };
+
+        JobsCancelTestData* data = (JobsCancelTestData*)userData;
+        JobsHandle children = Jobs::Dispatch(JobsType::LongTask, ChildJob, data, data->numChildren, JobsPriority::Normal, 
+                                              JobsStackSize::Small, &data->token);
+        Atomic::StoreExplicit(&data->childrenDispatched, 1, AtomicMemoryOrder::Release);
+        Jobs::WaitForCompletionAndDelete(children);
+        if (Jobs::IsCurrentCancelled())
+            Atomic::StoreExplicit(&data->parentSawCancel, 1, AtomicMemoryOrder::Release);
+    };
+
+    numIterations = Max(numIterations, 1u);
+    numChildren = Max(numChildren, 1u);
+    uint32 numBlockers = gJobs.numThreads[uint32(JobsType::LongTask)];
+    uint32 numFailed = 0;
+
+    for (uint32 iter = 0; iter < numIterations; iter++) {
+        // Leaked if the jobs don't finish in time, because they may still access it
+        JobsCancelTestData* data = Mem::AllocZeroTyped<JobsCancelTestData>(1);
+        data->numChildren = numChildren;
+
+        JobsHandle blockers = Jobs::Dispatch(JobsType::LongTask, BlockerJob, data, numBlockers, JobsPriority::High, JobsStackSize::Small);
+        if (!_JobsCancelTestWait(&data->numBlockersStarted, numBlockers, TIMEOUT_MS)) {
+            LOG_ERROR("Jobs: Cancel self-test timed out waiting for the LongTask workers");
+            Atomic::StoreExplicit(&data->openGate, 1, AtomicMemoryOrder::Release);
+            Jobs::WaitForCompletionAndDelete(blockers);
+            Mem::Free(data);
+            return numFailed + 1;
+        }
+
+        // Parent runs on a ShortTask worker. Its children can't start until we open the gate, which is after the cancel
+        JobsHandle parent = Jobs::Dispatch(JobsType::ShortTask, ParentJob, data, 1, JobsPriority::Normal, JobsStackSize::Small, 
+                                           &data->token);
+        bool dispatched = _JobsCancelTestWait(&data->childrenDispatched, 1, TIMEOUT_MS);
+        data->token.Cancel();
+        Atomic::StoreExplicit(&data->openGate, 1, AtomicMemoryOrder::Release);
+        Jobs::WaitForCompletionAndDelete(blockers);
+
+        // Dropped children must complete the parent's wait, instead of leaving it hanging
+        uint64 startTick = Timer::GetTicks();
+        while (Jobs::IsRunning(parent) && Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTick)) <= TIMEOUT_MS)
+            Thread::Sleep(0);
+        if (Jobs::IsRunning(parent)) {
+            LOG_ERROR("Jobs: Cancel self-test timed out waiting for the parent job");
+            return numFailed + 1;
+        }
+        Jobs::Delete(parent);
+
+        uint32 numChildRuns = Atomic::Load(&data->numChildRuns);
+        if (!dispatched || numChildRuns || !Atomic::Load(&data->parentSawCancel)) {
+            LOG_ERROR("Jobs: Cancel self-test failed (Iteration: %u, Children dispatched: %d, Children ran: %u/%u, Parent cancelled: %d)",
+                      iter, dispatched, numChildRuns, numChildren, Atomic::Load(&data->parentSawCancel));
+            numFailed++;
+        }
+
+        Mem::Free(data);
+    }
+
+    return numFailed;
+}
+
 //     █████╗ ████████╗ ██████╗ ███╗   ███╗██╗ ██████╗    ██████╗  ██████╗  ██████╗ ██╗     
 //    ██╔══██╗╚══██╔══╝██╔═══██╗████╗ ████║██║██╔════╝    ██╔══██╗██╔═══██╗██╔═══██╗██║     
 //    ███████║   ██║   ██║   ██║██╔████╔██║██║██║         ██████╔╝██║   ██║██║   ██║██║     
@@ -979,6 +2164,11 @@ inline void JobsWaitingList::AddToList(JobsFiberProperties* props)
     *plast = props;
     if (*pfirst == NULL)
         *pfirst = props;
+
+    uint32 depth = Atomic::LoadExplicit(&mDepth[index], AtomicMemoryOrder::Relaxed) + 1;
+    Atomic::StoreExplicit(&mDepth[index], depth, AtomicMemoryOrder::Relaxed);
+    if (depth > Atomic::LoadExplicit(&mMaxDepth[index], AtomicMemoryOrder::Relaxed))
+        Atomic::StoreExplicit(&mMaxDepth[index], depth, AtomicMemoryOrder::Relaxed);
 }
 
 inline void JobsWaitingList::RemoveFromList(JobsFiberProperties* props)
@@ -996,6 +2186,8 @@ inline void JobsWaitingList::RemoveFromList(JobsFiberProperties* props)
     if (*plast == props)
         *plast = props->prev;
     props->prev = props->next = nullptr;
+
+    Atomic::StoreExplicit(&mDepth[index], Atomic::LoadExplicit(&mDepth[index], AtomicMemoryOrder::Relaxed) - 1, AtomicMemoryOrder::Relaxed);
 }
 
 
@@ -1036,7 +2228,7 @@ inline uint32 JobsAndersonLock::Enter()
     uint32 position, next;
 
     if (mWrap) {
-        position = c89atomic_load_explicit_32(&next, c89atomic_memory_order_acquire);
+        position = c89atomic_load_explicit_32(&mNext, c89atomic_memory_order_acquire);
 
         do {
             if (position == UINT32_MAX)
@@ -1047,7 +2239,7 @@ inline uint32 JobsAndersonLock::Enter()
 
         position %= mCount;
     } else {
-        position = c89atomic_fetch_add_32(&next, 1);
+        position = c89atomic_fetch_add_32(&mNext, 1);
         position &= mMask;
     }
 
@@ -1090,22 +2282,31 @@ void JobsFiberMemAllocator::Initialize(size_t allocationSize)
     ASSERT(allocationSize % pageSize == 0);
     allocationSize = AlignValue(allocationSize + pageSize, pageSize);   // Leave some room for mco_coro
 
-    mBufferAlignment = uint32(pageSize);
     mAllocationSize = allocationSize;
+    mSlotSize = allocationSize + pageSize;
     mNumItemsInPool = (gJobs.numThreads[uint32(JobsType::ShortTask)] + gJobs.numThreads[uint32(JobsType::LongTask)]) * 2;
     mPools = nullptr;
+    mNumPools = 0;
+    mNumInUse = 0;
+    mMaxInUse = 0;
+    mMaxInUseFrame = 0;
+    mStackHighWater = 0;
 }
 
 void JobsFiberMemAllocator::Release()
 {
     MemAllocator* alloc = gJobs.initParams.alloc;
+    size_t pageSize = OS::GetPageSize();
     Pool* pool = mPools;
     while (pool) {
         Pool* curPool = pool;
         pool = pool->next;
 
-        Mem::FreeAligned(curPool->buffer, mBufferAlignment, alloc);
+        for (uint32 i = 0; i < curPool->numCommitted; i++)
+            Mem::VirtualDecommit(curPool->buffer + size_t(i)*mSlotSize + pageSize, mAllocationSize);
+        Mem::VirtualRelease(curPool->buffer, mSlotSize*size_t(mNumItemsInPool));
         Mem::Free(curPool->ptrs, alloc);
+        Mem::Free(curPool->stackUsage, alloc);
         Mem::Free(curPool, alloc);
     }
 }
@@ -1133,10 +2334,56 @@ void* JobsFiberMemAllocator::Allocate()
     }
 
     ASSERT(pool && pool->index);
-    return pool->ptrs[--pool->index];
+    uint8* ptr = pool->ptrs[--pool->index];
+
+    // First time use of the slot: Commit everything except the guard page that sits below it
+    uint32 slotIndex = uint32(size_t(ptr - pool->buffer) / mSlotSize);
+    ASSERT(slotIndex <= pool->numCommitted);
+    if (slotIndex == pool->numCommitted) {
+        Mem::VirtualCommit(ptr, mAllocationSize);
+        ++pool->numCommitted;
+    }
+
+    mMaxInUse = Max(mMaxInUse, ++mNumInUse);
+    mMaxInUseFrame = Max(mMaxInUseFrame, mNumInUse);
+    return ptr;
 }
 
-void JobsFiberMemAllocator::Free(void* ptr)
+namespace Jobs
+{
+    // Stacks grow downwards and never-touched stack memory is zero (fresh pages), so scan from the deepest depth we 
+    // already know of, page by page, until we reach a page that is entirely zero
+    // Because stale data of previous fibers stays in the slot, this measures the deepest usage of the slot so far, which
+    // also keeps the scan short (usually a single page) for recycled slots
+    // Note: A large zero-initialized array on the stack that spans a whole page can cut the measurement short
+    static size_t _MeasureStackUsage(const void* stackBase, size_t stackSize, size_t knownUsage)
+    {
+        const size_t pageSize = OS::GetPageSize();
+        const uint8* base = reinterpret_cast<const uint8*>(stackBase);
+        const uint8* top = base + stackSize;
+        const uint8* lowest = top - Min(knownUsage, stackSize);
+        const uint8* chunkEnd = lowest;
+
+        while (chunkEnd > base) {
+            const uint8* chunkStart = reinterpret_cast<const uint8*>(uintptr_t(chunkEnd - 1) & ~uintptr_t(pageSize - 1));
+            chunkStart = Max(chunkStart, base);
+
+            const uint64* word = reinterpret_cast<const uint64*>(AlignValue<uintptr_t>(uintptr_t(chunkStart), sizeof(uint64)));
+            const uint64* end = reinterpret_cast<const uint64*>(chunkEnd);
+            while (word < end && *word == 0)
+                ++word;
+            if (word >= end)
+                break;
+
+            lowest = reinterpret_cast<const uint8*>(word);
+            chunkEnd = chunkStart;
+        }
+
+        return size_t(top - lowest);
+    }
+}
+
+void JobsFiberMemAllocator::Free(void* ptr, const void* stackBase, size_t stackSize)
 {
     SpinLockMutexScope mtx(mLock);
 
@@ -1144,9 +2391,16 @@ void JobsFiberMemAllocator::Free(void* ptr)
     Pool* pool = mPools;
     
     while (pool) {
-        if (uptr >= PtrToInt<uint64>(pool->buffer) && uptr < PtrToInt<uint64>(pool->buffer + mAllocationSize*mNumItemsInPool)) {
+        if (uptr >= PtrToInt<uint64>(pool->buffer) && uptr < PtrToInt<uint64>(pool->buffer + mSlotSize*mNumItemsInPool)) {
             ASSERT_MSG(pool->index < mNumItemsInPool, "Invalid free on this pool");
+
+            uint32 slotIndex = uint32(size_t((uint8*)ptr - pool->buffer) / mSlotSize);
+            size_t usage = Jobs::_MeasureStackUsage(stackBase, stackSize, pool->stackUsage[slotIndex]);
+            pool->stackUsage[slotIndex] = uint32(usage);
+            mStackHighWater = Max(mStackHighWater, usage);
+
             pool->ptrs[pool->index++] = (uint8*)ptr;
+            --mNumInUse;
             return;
         }
 
@@ -1159,16 +2413,48 @@ void JobsFiberMemAllocator::Free(void* ptr)
 JobsFiberMemAllocator::Pool* JobsFiberMemAllocator::CreatePool()
 {
     MemAllocator* alloc = gJobs.initParams.alloc;
+    size_t pageSize = OS::GetPageSize();
+
     Pool* pool = Mem::AllocTyped<Pool>(1, alloc);
     pool->ptrs = Mem::AllocTyped<uint8*>(mNumItemsInPool, alloc);
-    pool->buffer = (uint8*)Mem::AllocAligned(mAllocationSize*size_t(mNumItemsInPool), mBufferAlignment, alloc);
+    pool->stackUsage = Mem::AllocZeroTyped<uint32>(mNumItemsInPool, alloc);
+    pool->buffer = (uint8*)Mem::VirtualReserve(mSlotSize*size_t(mNumItemsInPool));
     pool->index = mNumItemsInPool;
+    pool->numCommitted = 0;
     pool->next = nullptr;
     for (uint32 i = 0; i < mNumItemsInPool; i++)
-        pool->ptrs[mNumItemsInPool - i - 1] = pool->buffer + size_t(i)*mAllocationSize;
+        pool->ptrs[mNumItemsInPool - i - 1] = pool->buffer + size_t(i)*mSlotSize + pageSize;
+    ++mNumPools;
     return pool;
 }
 
+JobsBudgetStats Jobs::GetBudgetStats()
+{
+    JobsBudgetStats stats {};
+
+    for (uint32 i = 0; i < uint32(JobsStackSize::_Count); i++) {
+        JobsFiberMemAllocator& alloc = gJobs.fiberAllocators[i];
+        JobsFiberStackStats& s = stats.stacks[i];
+        size_t pageSize = OS::GetPageSize();
+
+        SpinLockMutexScope mtx(alloc.mLock);
+        s.stackSize = JOBS_STACK_SIZES[i];
+        s.highWater = alloc.mStackHighWater;
+        s.numStacks = alloc.mNumPools*alloc.mNumItemsInPool;
+        s.numInUse = alloc.mNumInUse;
+        s.maxInUse = alloc.mMaxInUse;
+        s.reservedBytes = alloc.mSlotSize*size_t(s.numStacks);
+
+        for (JobsFiberMemAllocator::Pool* pool = alloc.mPools; pool; pool = pool->next) {
+            s.committedBytes += alloc.mAllocationSize*size_t(pool->numCommitted);
+            for (uint32 k = 0; k < pool->numCommitted; k++)
+                s.touchedBytes += AlignValue<size_t>(pool->stackUsage[k], pageSize);
+        }
+    }
+
+    return stats;
+}
+
 bool Jobs::IsRunningOnCurrentThread()
 {
     JobsThreadData* data = _GetThreadData();
@@ -12,6 +12,13 @@
 //      You will also get `groupIndex` in the job callback, so you know which group we are running on
 //
 //      Priority: Higher priorities have a chance of executing sooner than lower ones
+//                Background jobs only start or resume when no queued High/Normal/Low job of the same type can run. 
+//                Queued jobs that are blocked (waiting on children or signals) don't count, so Background still runs while they wait
+//
+// Cancellation:
+//      Jobs can be dispatched with a JobsCancelToken and/or a deadline. Queued jobs that are not started yet are dropped when the token
+//      is cancelled or the deadline has passed. Their handles still complete normally, so waiting on them works as before
+//      Running jobs are not interrupted, they should check the return value of `YieldCurrent` or `IsCurrentCancelled` and return early
 //
 // Thread Model:
 //      threadCount will be fetched from the engine being equal to CpuCoreCount - 1 if set to 0 on initialize. Note that this is actual PhysicalCores, not the Logical ones
@@ -33,6 +40,7 @@ enum class JobsPriority : uint32
     High = 0,
     Normal,
     Low,
+    Background,     // Spare time only, see the notes above
     _Count
 };
 
@@ -51,6 +59,18 @@ enum class JobsStackSize : uint32
     _Count
 };
 
+// Cooperative cancellation for dispatched jobs. Must outlive the jobs that are dispatched with it
+// A single token can be shared by many dispatches, to cancel a whole batch of work (stale asset loads for example)
+struct JobsCancelToken
+{
+    void Cancel();
+    void Reset();
+    bool IsCancelled() const;
+
+private:
+    uint32 mCancelled = 0;
+};
+
 struct alignas(CACHE_LINE_SIZE) JobsSignal
 {
     JobsSignal();
@@ -67,6 +87,94 @@ private:
     uint8 data[128];
 };
 
+// Mutex that suspends the running job on contention instead of blocking the worker thread
+// Waiting fibers are parked on the mutex and put back into the job queue when the lock is handed over to them, 
+// so the worker thread can pick up other jobs in the meantime. Lock ownership is not bound to threads.
+// Callers outside of job threads (main thread for example) spin-wait. So do jobs that have a live MemTempAllocator, 
+// because temp allocators are bound to the thread and the fiber cannot be moved to another one
+struct alignas(CACHE_LINE_SIZE) JobsMutex
+{
+    void Initialize(uint32 spinCount = 32);
+    void Release();
+
+    void Enter();
+    void Exit();
+    bool TryEnter();
+
+private:
+    uint8 mData[128];
+};
+
+struct JobsMutexScope
+{
+    JobsMutexScope() = delete;
+    JobsMutexScope(const JobsMutexScope&) = delete;
+    explicit JobsMutexScope(JobsMutex& mtx) : mMtx(mtx) { mMtx.Enter(); }
+    ~JobsMutexScope() { mMtx.Exit(); }
+
+private:
+    JobsMutex& mMtx;
+};
+
+// Reader/Writer version of JobsMutex. Prefers readers like the pthread implementation, so recursive read locks are allowed
+struct alignas(CACHE_LINE_SIZE) JobsReadWriteMutex
+{
+    void Initialize();
+    void Release();
+
+    bool TryRead();
+    bool TryWrite();
+
+    void EnterRead();
+    void ExitRead();
+
+    void EnterWrite();
+    void ExitWrite();
+
+private:
+    uint8 mData[128];
+};
+
+struct JobsReadWriteMutexReadScope
+{
+    JobsReadWriteMutexReadScope() = delete;
+    JobsReadWriteMutexReadScope(const JobsReadWriteMutexReadScope&) = delete;
+    explicit JobsReadWriteMutexReadScope(JobsReadWriteMutex& mtx) : mMtx(mtx) { mMtx.EnterRead(); }
+    ~JobsReadWriteMutexReadScope() { mMtx.ExitRead(); }
+
+private:
+    JobsReadWriteMutex& mMtx;
+};
+
+struct JobsReadWriteMutexWriteScope
+{
+    JobsReadWriteMutexWriteScope() = delete;
+    JobsReadWriteMutexWriteScope(const JobsReadWriteMutexWriteScope&) = delete;
+    explicit JobsReadWriteMutexWriteScope(JobsReadWriteMutex& mtx) : mMtx(mtx) { mMtx.EnterWrite(); }
+    ~JobsReadWriteMutexWriteScope() { mMtx.ExitWrite(); }
+
+private:
+    JobsReadWriteMutex& mMtx;
+};
+
+// One-shot event that suspends the waiting jobs until it's raised, usually from another thread (IO completion callbacks for example)
+// Unlike JobsSignal, waiting fibers are parked and not polled by the workers. Raise puts them back into the job queue,
+// so they can resume on any worker. Same as JobsMutex, callers outside of job threads or with a live MemTempAllocator spin-wait
+// Event stays raised until Reset is called
+struct alignas(CACHE_LINE_SIZE) JobsEvent
+{
+    void Initialize();
+    void Release();
+
+    void Raise();
+    void Wait();
+    void Reset();
+    bool IsRaised();
+
+private:
+    uint8 mData[128];
+};
+
 struct JobsInitParams
 {
     MemAllocator* alloc = Mem::GetDefaultAlloc();
@@ -75,6 +183,59 @@ struct JobsInitParams
     uint32 defaultShortTaskStackSize = SIZE_MB;
     uint32 defaultLongTaskStackSize = SIZE_MB;
     bool debugAllocations = false;
+    bool pinThreads = false;                // Pin workers to cores (see OS::GetCpuTopology). ShortTask workers get one physical core each
+    bool pinAvoidSmtSiblings = true;        // LongTask workers and extra ShortTask workers stay off the SMT siblings of ShortTask cores
+    bool pinReserveMainThreadCore = true;   // First core is reserved for the main thread (the thread that calls Initialize)
+};
+
+struct JobsPinningBenchmarkResult
+{
+    uint32 numJobs;
+    uint32 numPasses;
+    uint32 bufferSize;              // Per worker working set, sized after L2 cache
+    double unpinnedMS;
+    double pinnedMS;
+    bool supported;                 // False if the platform can't pin threads, pinnedMS is not measured
+};
+
+struct JobsFiberStackStats
+{
+    size_t stackSize;
+    size_t highWater;           // Deepest stack usage (bytes) measured so far, when fibers are recycled
+    size_t reservedBytes;       // Virtual memory reserved for all stacks of this size, including guard pages
+    size_t committedBytes;      // Stacks that are handed out at least once
+    size_t touchedBytes;        // Sum of the measured depth of all stacks. Roughly what the OS has actually backed with memory
+    uint32 numStacks;
+    uint32 numInUse;
+    uint32 maxInUse;
+};
+
+struct JobsBudgetStats
+{
+    JobsFiberStackStats stacks[uint32(JobsStackSize::_Count)];
+};
+
+inline constexpr uint32 JOBS_TELEMETRY_LATENCY_BUCKETS = 16;   // Dispatch-to-start latency buckets: <1us, <2us, <4us, ..., >=16ms
+
+struct JobsTelemetryWorker
+{
+    float busyMS;       // Running fibers
+    float spinMS;       // Woken up, but looking for a runnable fiber or spinning because nothing is runnable yet
+    float idleMS;       // Sleeping on the semaphore
+    uint32 numRuns;     // Fibers that are started or resumed
+    uint32 numYields;   // Fibers that are switched out before finishing (Wait/Yield/Mutex)
+};
+
+// With Jobs::GetTelemetry: Sum of the frames, except maxQueueDepth and maxFibersInUse, which are the maximum of the frames
+struct JobsTelemetryFrame
+{
+    uint32 numFrames;
+    float durationMS;
+    uint32 numDispatches[uint32(JobsType::_Count)];
+    uint32 numDropped[uint32(JobsType::_Count)];        // Cancelled or expired before they started
+    uint32 maxQueueDepth[uint32(JobsType::_Count)][uint32(JobsPriority::_Count)];
+    uint32 latencyHistogram[uint32(JobsType::_Count)][JOBS_TELEMETRY_LATENCY_BUCKETS];
+    uint32 maxFibersInUse[uint32(JobsStackSize::_Count)];
 };
 
 namespace Jobs
@@ -83,12 +244,18 @@ namespace Jobs
     API void Release();
 
     // Dispatches the job and returns the handle. Handle _must_ be waited on later, with a call to `jobsWaitForCompletion`
+    // cancelToken: Group items that are not started yet are dropped after the token is cancelled (see notes above)
+    // deadlineMS: Group items that are not started within this time after dispatch are dropped. 0 means no deadline
     API [[nodiscard]] JobsHandle Dispatch(JobsType type, JobsCallback callback, void* userData = nullptr, 
                                           uint32 groupSize = 1, JobsPriority prio = JobsPriority::Normal, 
-                                          JobsStackSize stackSize = JobsStackSize::Medium);
+                                          JobsStackSize stackSize = JobsStackSize::Medium,
+                                          const JobsCancelToken* cancelToken = nullptr, uint32 deadlineMS = 0);
     // Might yield the current running job as well. Also deletes the JobHandle after it's finished
     API void WaitForCompletionAndDelete(JobsHandle handle);
-    API void YieldCurrent();
+
+    // Returns false if the running job is cancelled, in which case it should return as soon as possible
+    API bool YieldCurrent();
+    API bool IsCurrentCancelled();
 
     API bool IsRunningOnCurrentThread();
     API bool IsRunning(JobsHandle handle);
@@ -97,8 +264,24 @@ namespace Jobs
     // In this version, we don't care about waiting on the handle. Handle will be automatically delete itself after job is finished
     API void DispatchAndForget(JobsType type, JobsCallback callback, void* userData = nullptr, 
                                uint32 groupSize = 1, JobsPriority prio = JobsPriority::Normal, 
-                               JobsStackSize stackSize = JobsStackSize::Medium);
+                               JobsStackSize stackSize = JobsStackSize::Medium,
+                               const JobsCancelToken* cancelToken = nullptr, uint32 deadlineMS = 0);
 
     API uint32 GetWorkerThreadsCount(JobsType type);
+    API JobsBudgetStats GetBudgetStats();
+
+    // Telemetry: Counters are accumulated by the workers, EndTelemetryFrame collects them once per frame (Engine::EndFrame)
+    // outWorkers must hold GetWorkerThreadsCount(ShortTask) + GetWorkerThreadsCount(LongTask) items, ShortTask workers come first
+    API void EndTelemetryFrame();
+    API bool GetTelemetry(uint32 numFrames, JobsTelemetryFrame* outFrame, JobsTelemetryWorker* outWorkers = nullptr);
+    API bool DumpTelemetryJson(const char* filepath, uint32 numFrames);
+
+    // Must be called outside of job threads. Runs the same cache-sensitive ShortTask jobs with and without thread pinning
+    // Only worker pinning is toggled, the main thread affinity is left alone. Pinning state is restored to JobsInitParams::pinThreads afterwards
+    API JobsPinningBenchmarkResult RunPinningBenchmark(uint32 numJobs, uint32 numPasses);
+
+    // Must be called outside of job threads. Cancels a running parent job while its children are still queued (LongTask workers
+    // are kept busy meanwhile) and checks that no child has run and every wait returns. Returns the number of failed iterations
+    API uint32 RunCancelSelfTest(uint32 numIterations, uint32 numChildren);
 }
 
@@ -9,16 +9,56 @@
 #include "StringUtil.h"
 #include "Allocators.h"
 #include "Arrays.h"
+#include "Hash.h"
+#include "System.h"
+
+static constexpr int JSON_KEY_INDEX_MIN_KEYS = 8;            // Objects with less keys are always searched linearly
+static constexpr uint32 JSON_KEY_INDEX_MIN_CAPACITY = 64;
+
+struct JsonKeyIndexSlot
+{
+    uint32 hash;        // Combined hash of the object token id and the key hash
+    int valueId;        // Value token id. 0 means the slot is empty, because token 0 is always the root
+};
+
+// Open addressing table for key lookups, shared between all indexed objects of the document
+// Built once at parse time with JsonParseFlags::BuildKeyIndex and only read after that
+struct JsonKeyIndex
+{
+    JsonKeyIndexSlot* slots;
+    uint32 capacity;            // Power of two. Zero if the document is not indexed
+    uint32 count;
+};
 
 struct JsonContext
 {
     cj5_result r;       // This should always come first, because the wrapper API casts JsonContext to cj5_result*
     uint32 numTokens;
-    MemAllocator* alloc;
+    MemAllocator* alloc;        // nullptr if the context is owned by a JsonTokenArena
     cj5_token* tokens;
+    JsonKeyIndex keyIndex;      // Slots are allocated with the context, or owned by the JsonTokenArena
 };
 
-JsonContext* Json::Parse(const char* json5, uint32 json5Len, JsonErrorLocation* outErrLoc, MemAllocator* alloc)
+namespace Json
+{
+    static void _SetErrorLocation(const cj5_result& r, JsonErrorLocation* outErrLoc);
+    static uint32 _KeyIndexHash(int objectId, uint32 keyHash);
+    static uint32 _KeyIndexCapacity(const cj5_result& r);
+    static void _KeyIndexInsert(JsonKeyIndex& index, uint32 hash, int valueId);
+    static void _KeyIndexBuild(JsonContext* ctx, uint32 capacity);
+}
+
+static void Json::_SetErrorLocation(const cj5_result& r, JsonErrorLocation* outErrLoc)
+{
+    if (outErrLoc) {
+        *outErrLoc = JsonErrorLocation {
+            .line = (uint32)r.error_line,
+            .col = (uint32)r.error_col
+        };
+    }
+}
+
+JsonContext* Json::Parse(const char* json5, uint32 json5Len, JsonErrorLocation* outErrLoc, MemAllocator* alloc, JsonParseFlags flags)
 {
     ASSERT(json5);
     ASSERT(json5Len < INT32_MAX);
@@ -38,45 +78,214 @@ JsonContext* Json::Parse(const char* json5, uint32 json5Len, JsonErrorLocation*
         .user_data = &tokens
     };
 
-    json5Len = json5Len == 0 ? json5Len : Str::Len(json5);
+    json5Len = json5Len != 0 ? json5Len : Str::Len(json5);
     cj5_result r = cj5_parse_with_factory(json5, (int)json5Len, factory);
 
     if (r.error == CJ5_ERROR_NONE) {
         ASSERT(tokens.Count());
 
+        // Key index slots are allocated with the context, so there are no allocations after this and the order of temp allocators is kept
+        uint32 keyIndexCapacity = (flags & JsonParseFlags::BuildKeyIndex) == JsonParseFlags::BuildKeyIndex ? _KeyIndexCapacity(r) : 0;
+
         // TODO: the API and usage is a bit inconvenient. look for better solutions for cj5 API
         MemSingleShotMalloc<JsonContext> mallocator;
         mallocator.AddMemberArray<cj5_token>(offsetof(JsonContext, tokens), tokens.Count());
+        if (keyIndexCapacity)
+            mallocator.AddMemberArray<JsonKeyIndexSlot>(offsetof(JsonContext, keyIndex) + offsetof(JsonKeyIndex, slots), keyIndexCapacity);
         JsonContext* ctx = mallocator.Malloc(alloc);
 
-        ctx->numTokens = tokens.Count();
-        memcpy(ctx->tokens, r.tokens, tokens.Count());
-        ctx->r.tokens = ctx->tokens;
-
+        // Tokens are copied out of temp memory, because it may be popped before the context is destroyed
+        memcpy(ctx->tokens, r.tokens, sizeof(cj5_token)*tokens.Count());
         ctx->r = r;
+        ctx->r.tokens = ctx->tokens;
+        ctx->numTokens = tokens.Count();
         ctx->alloc = alloc;
+        if (keyIndexCapacity)
+            _KeyIndexBuild(ctx, keyIndexCapacity);
+        else
+            memset(&ctx->keyIndex, 0x0, sizeof(ctx->keyIndex));
 
         if (!mainAllocIsTemp)
             MemTempAllocator::PopId(tempMemId);
         return ctx;
     }
     else {
-        if (outErrLoc) {
-            *outErrLoc = JsonErrorLocation {
-                .line = (uint32)r.error_line,
-                .col = (uint32)r.error_col
-            };
-        }
+        _SetErrorLocation(r, outErrLoc);
         if (!mainAllocIsTemp)
             MemTempAllocator::PopId(tempMemId);
         return nullptr;
     }
 }
 
+JsonContext* Json::Parse(const char* json5, uint32 json5Len, JsonTokenArena* arena, JsonErrorLocation* outErrLoc, JsonParseFlags flags)
+{
+    ASSERT(json5);
+    ASSERT(json5Len < INT32_MAX);
+    ASSERT_MSG(arena && arena->mCtx, "Token arena is not initialized");
+
+    JsonContext* ctx = arena->mCtx;
+    ctx->keyIndex.capacity = 0;
+    ctx->keyIndex.count = 0;
+
+    json5Len = json5Len != 0 ? json5Len : Str::Len(json5);
+    cj5_result r = cj5_parse(json5, (int)json5Len, ctx->tokens, (int)arena->mMaxTokens);
+
+    // On overflow, cj5 still counts all the tokens, so we can grow the arena and parse again
+    if (r.error == CJ5_ERROR_OVERFLOW) {
+        uint32 maxTokens = AlignValue<uint32>(uint32(r.num_tokens), 256);
+        Mem::Free(ctx->tokens, arena->mAlloc);
+        ctx->tokens = Mem::AllocTyped<cj5_token>(maxTokens, arena->mAlloc);
+        arena->mMaxTokens = maxTokens;
+        r = cj5_parse(json5, (int)json5Len, ctx->tokens, (int)maxTokens);
+    }
+
+    if (r.error != CJ5_ERROR_NONE) {
+        _SetErrorLocation(r, outErrLoc);
+        return nullptr;
+    }
+
+    ctx->r = r;
+    ctx->numTokens = uint32(r.num_tokens);
+
+    // Key index slots are kept in the arena and only grow, same as tokens
+    if ((flags & JsonParseFlags::BuildKeyIndex) == JsonParseFlags::BuildKeyIndex) {
+        if (uint32 keyIndexCapacity = _KeyIndexCapacity(r); keyIndexCapacity) {
+            if (keyIndexCapacity > arena->mMaxKeyIndexSlots) {
+                Mem::Free(ctx->keyIndex.slots, arena->mAlloc);
+                ctx->keyIndex.slots = Mem::AllocTyped<JsonKeyIndexSlot>(keyIndexCapacity, arena->mAlloc);
+                arena->mMaxKeyIndexSlots = keyIndexCapacity;
+            }
+            _KeyIndexBuild(ctx, keyIndexCapacity);
+        }
+    }
+
+    return ctx;
+}
+
 void Json::Destroy(JsonContext* ctx)
 {
-    if (ctx && ctx->alloc) 
+    if (ctx && ctx->alloc) {
         MemSingleShotMalloc<JsonContext>::Free(ctx, ctx->alloc);
+    }
+}
+
+bool JsonTokenArena::Initialize(uint32 initialNumTokens, MemAllocator* alloc)
+{
+    ASSERT(alloc);
+    ASSERT_MSG(!mCtx, "Token arena is already initialized");
+    
+    mAlloc = alloc;
+    mMaxTokens = Max(initialNumTokens, 16u);
+    mCtx = Mem::AllocZeroTyped<JsonContext>(1, alloc);
+    if (!mCtx)
+        return false;
+    mCtx->tokens = Mem::AllocTyped<cj5_token>(mMaxTokens, alloc);
+    return mCtx->tokens != nullptr;
+}
+
+void JsonTokenArena::Release()
+{
+    if (mCtx) {
+        Mem::Free(mCtx->keyIndex.slots, mAlloc);
+        Mem::Free(mCtx->tokens, mAlloc);
+        Mem::Free(mCtx, mAlloc);
+        mCtx = nullptr;
+    }
+    mMaxTokens = 0;
+    mMaxKeyIndexSlots = 0;
+}
+
+static uint32 Json::_KeyIndexHash(int objectId, uint32 keyHash)
+{
+    return Hash::Int64To32((uint64(uint32(objectId)) << 32) | keyHash);
+}
+
+static void Json::_KeyIndexInsert(JsonKeyIndex& index, uint32 hash, int valueId)
+{
+    const uint32 mask = index.capacity - 1;
+    for (uint32 i = hash & mask; ; i = (i + 1) & mask) {
+        JsonKeyIndexSlot& slot = index.slots[i];
+        if (slot.valueId == 0) {
+            slot.hash = hash;
+            slot.valueId = valueId;
+            index.count++;
+            return;
+        }
+
+        // Duplicate keys: the first one wins, same as cj5_seek. Colliding hashes are verified on lookup
+        if (slot.hash == hash)
+            return;
+    }
+}
+
+// Returns zero if there are no objects large enough to be indexed
+static uint32 Json::_KeyIndexCapacity(const cj5_result& r)
+{
+    uint32 numKeys = 0;
+    for (int i = 0; i < r.num_tokens; i++) {
+        const cj5_token& tok = r.tokens[i];
+        if (tok.type == CJ5_TOKEN_OBJECT && tok.size >= JSON_KEY_INDEX_MIN_KEYS)
+            numKeys += uint32(tok.size);
+    }
+
+    if (numKeys == 0)
+        return 0;
+
+    // Keep the load factor under 50%, so probes stay short
+    uint32 capacity = JSON_KEY_INDEX_MIN_CAPACITY;
+    while (capacity < numKeys*2)
+        capacity <<= 1;
+    return capacity;
+}
+
+// Slots should already be allocated with at least `capacity` entries
+static void Json::_KeyIndexBuild(JsonContext* ctx, uint32 capacity)
+{
+    JsonKeyIndex& index = ctx->keyIndex;
+    const cj5_result& r = ctx->r;
+    ASSERT(index.slots);
+
+    memset(index.slots, 0x0, sizeof(JsonKeyIndexSlot)*capacity);
+    index.capacity = capacity;
+    index.count = 0;
+
+    // Same keys that cj5_seek_hash walks, but for all the large objects in a single pass
+    for (int i = 1; i < r.num_tokens; i++) {
+        const cj5_token& tok = r.tokens[i];
+        if (tok.size != 1 || tok.type != CJ5_TOKEN_STRING || tok.parent_id < 0)
+            continue;
+        const cj5_token& parent = r.tokens[tok.parent_id];
+        if (parent.type == CJ5_TOKEN_OBJECT && parent.size >= JSON_KEY_INDEX_MIN_KEYS)
+            _KeyIndexInsert(index, _KeyIndexHash(tok.parent_id, tok.key_hash), i + 1);
+    }
+}
+
+int Json::_private::Seek(JsonContext* ctx, int parentId, const char* key)
+{
+    ASSERT(ctx);
+    cj5_result* r = &ctx->r;
+    ASSERT(parentId >= 0 && parentId < r->num_tokens);
+
+    uint32 keyHash = cj5__hash_fnv32(key, key + Str::Len(key));
+    const cj5_token& parent = r->tokens[parentId];
+    const JsonKeyIndex& index = ctx->keyIndex;
+    if (!index.capacity || parent.type != CJ5_TOKEN_OBJECT || parent.size < JSON_KEY_INDEX_MIN_KEYS)
+        return cj5_seek_hash(r, parentId, keyHash);
+
+    uint32 hash = _KeyIndexHash(parentId, keyHash);
+    const uint32 mask = index.capacity - 1;
+    for (uint32 i = hash & mask; index.slots[i].valueId; i = (i + 1) & mask) {
+        const JsonKeyIndexSlot& slot = index.slots[i];
+        if (slot.hash == hash) {
+            // The combined hash can collide with another object's key, verify and fallback to linear search if it does
+            const cj5_token& keyTok = r->tokens[slot.valueId - 1];
+            if (keyTok.parent_id == parentId && keyTok.key_hash == keyHash)
+                return slot.valueId;
+            return cj5_seek_hash(r, parentId, keyHash);
+        }
+    }
+
+    return -1;
 }
 
 uint32 JsonNode::GetChildCount() const
@@ -217,3 +426,81 @@ JsonNode JsonNode::GetNextArrayItem(const JsonNode& curItem) const
     }
     return JsonNode(mCtx, -1);
 }
+
+JsonBenchmarkResult Json::RunBenchmark(const char* json5, uint32 json5Len, uint32 numIterations)
+{
+    ASSERT(json5);
+    json5Len = json5Len != 0 ? json5Len : Str::Len(json5);
+    numIterations = Max(numIterations, 1u);
+
+    JsonBenchmarkResult result {
+        .numBytes = uint64(json5Len)*numIterations
+    };
+    double numMegabytes = double(result.numBytes)/double(SIZE_MB);
+
+    TimerStopWatch stopwatch;
+    for (uint32 i = 0; i < numIterations; i++) {
+        JsonContext* ctx = Parse(json5, json5Len, &result.errorLoc, Mem::GetDefaultAlloc());
+        if (!ctx) {
+            result.parseFailed = true;
+            return result;
+        }
+        Destroy(ctx);
+    }
+    result.parseMBPerSec = float(numMegabytes/Max(stopwatch.ElapsedSec(), 0.000001));
+
+    JsonTokenArena arena;
+    if (!arena.Initialize())
+        return result;
+    JsonContext* ctx = nullptr;
+    stopwatch.Reset();
+    for (uint32 i = 0; i < numIterations; i++)
+        ctx = Parse(json5, json5Len, &arena, nullptr);
+    result.arenaParseMBPerSec = float(numMegabytes/Max(stopwatch.ElapsedSec(), 0.000001));
+
+    // Collect every key of every object, then look them up with linear search and through the key index
+    if (ctx)
+        ctx = Parse(json5, json5Len, &arena, &result.errorLoc, JsonParseFlags::BuildKeyIndex);
+    if (!ctx) {
+        arena.Release();
+        result.parseFailed = true;
+        return result;
+    }
+    result.numTokens = ctx->numTokens;
+
+    MemTempAllocator tempAlloc;
+    Array<Pair<int, const char*>> lookups(&tempAlloc);
+    for (int i = 1; i < ctx->r.num_tokens; i++) {
+        const cj5_token& tok = ctx->r.tokens[i];
+        if (tok.type != CJ5_TOKEN_STRING || tok.size != 1 || ctx->r.tokens[tok.parent_id].type != CJ5_TOKEN_OBJECT)
+            continue;
+        uint32 keyLen = uint32(tok.key_end - tok.key_start);
+        char* key = tempAlloc.MallocTyped<char>(keyLen + 1);
+        memcpy(key, json5 + tok.key_start, keyLen);
+        key[keyLen] = 0;
+        lookups.Push(Pair<int, const char*>(tok.parent_id, key));
+    }
+
+    if (lookups.Count()) {
+        uint64 numLookups = uint64(lookups.Count())*numIterations;
+        int checksum = 0;
+
+        stopwatch.Reset();
+        for (uint32 i = 0; i < numIterations; i++) {
+            for (const Pair<int, const char*>& lookup : lookups)
+                checksum += cj5_seek(&ctx->r, lookup.first, lookup.second);
+        }
+        result.seekLookupsPerSec = float(double(numLookups)/Max(stopwatch.ElapsedSec(), 0.000001));
+
+        stopwatch.Reset();
+        for (uint32 i = 0; i < numIterations; i++) {
+            for (const Pair<int, const char*>& lookup : lookups)
+                checksum -= _private::Seek(ctx, lookup.first, lookup.second);
+        }
+        result.indexLookupsPerSec = float(double(numLookups)/Max(stopwatch.ElapsedSec(), 0.000001));
+        ASSERT_MSG(checksum == 0, "Key index returned different results from linear search");
+    }
+
+    arena.Release();
+    return result;
+}
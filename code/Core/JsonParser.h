@@ -5,6 +5,7 @@
 #include "StringUtil.h"
 
 struct JsonContext;
+struct JsonTokenArena;
 
 struct JsonErrorLocation
 {
@@ -12,12 +13,66 @@ struct JsonErrorLocation
     uint32 col;
 };
 
+struct JsonBenchmarkResult
+{
+    bool parseFailed;           // Document has errors, measurements are not valid
+    JsonErrorLocation errorLoc; // Valid if parseFailed is set
+    uint64 numBytes;            // Total bytes parsed by each mode (document size * iterations)
+    uint32 numTokens;
+    float parseMBPerSec;        // Json::Parse with an allocator
+    float arenaParseMBPerSec;   // Json::Parse with a reused JsonTokenArena
+    float seekLookupsPerSec;    // GetChild on every key of every object, linear search (cj5_seek)
+    float indexLookupsPerSec;   // Same lookups through the key index
+};
+
+inline constexpr uint32 JSON_ARENA_DEFAULT_NUM_TOKENS = 1024;
+
+enum class JsonParseFlags : uint32
+{
+    None = 0,
+    BuildKeyIndex = 0x1     // Objects with many keys get a hash index, so GetChild/HasChild on them don't search linearly
+};
+ENABLE_BITMASK(JsonParseFlags);
+
 namespace Json
 {
-    API JsonContext* Parse(const char* json5, uint32 json5Len, JsonErrorLocation* outErrLoc, MemAllocator* alloc = Mem::GetDefaultAlloc());
+    // Note: Unless json5Len is zero, json5 doesn't need to be null-terminated
+    API JsonContext* Parse(const char* json5, uint32 json5Len, JsonErrorLocation* outErrLoc, MemAllocator* alloc = Mem::GetDefaultAlloc(),
+                           JsonParseFlags flags = JsonParseFlags::None);
+
+    // Parses into the token arena, without any allocations once the arena has grown to the largest document
+    // The returned context belongs to the arena and is valid until the next Parse with the same arena. Calling Destroy on it does nothing
+    API JsonContext* Parse(const char* json5, uint32 json5Len, JsonTokenArena* arena, JsonErrorLocation* outErrLoc, 
+                           JsonParseFlags flags = JsonParseFlags::None);
     API void Destroy(JsonContext* ctx);
+
+    // Parses every document `numIterations` times with and without an arena and measures key lookups
+    API JsonBenchmarkResult RunBenchmark(const char* json5, uint32 json5Len, uint32 numIterations);
+
+    namespace _private
+    {
+        // Objects with many keys are looked up through the key index if the document is parsed with JsonParseFlags::BuildKeyIndex
+        // The index is not modified after parsing, so the same JsonContext can be read from multiple threads
+        API int Seek(JsonContext* ctx, int parentId, const char* key);
+    }
 }
 
+// Token storage that is reused between documents. Grows to fit the largest document and keeps the memory
+struct JsonTokenArena
+{
+    bool Initialize(uint32 initialNumTokens = JSON_ARENA_DEFAULT_NUM_TOKENS, MemAllocator* alloc = Mem::GetDefaultAlloc());
+    void Release();
+
+private:
+    friend JsonContext* Json::Parse(const char* json5, uint32 json5Len, JsonTokenArena* arena, JsonErrorLocation* outErrLoc, 
+                                    JsonParseFlags flags);
+
+    JsonContext* mCtx = nullptr;
+    MemAllocator* mAlloc = nullptr;
+    uint32 mMaxTokens = 0;
+    uint32 mMaxKeyIndexSlots = 0;
+};
+
 struct JsonNode
 {
     JsonNode() = default;
@@ -110,12 +165,12 @@ inline JsonNode::JsonNode(JsonContext* _ctx, int _tokenId, int _itemIndex) : mCt
 
 inline bool JsonNode::HasChild(const char* _childNode) const
 {
-    return cj5_seek(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode) != -1;
+    return Json::_private::Seek(mCtx, mTokenId, _childNode) != -1;
 }
 
 inline JsonNode JsonNode::GetChild(const char* _childNode) const
 {
-    int id = cj5_seek(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
     return JsonNode(mCtx, id);
 }
 
@@ -218,40 +273,48 @@ template <> inline Int2 JsonNode::GetValue() const
 
 inline const char* JsonNode::GetChildValueString(const char* _childNode, char* _outValue, uint32 _valueSize, const char* _defaultValue)
 {
-    const char* r = cj5_seekget_string(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _outValue, _valueSize, _defaultValue);
-    if (r == _defaultValue)
-        Str::Copy(_outValue, (int)_valueSize, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    if (id != -1)
+        cj5_get_string(reinterpret_cast<cj5_result*>(mCtx), id, _outValue, (int)_valueSize);
+    else
+        Str::Copy(_outValue, _valueSize, _defaultValue);
     return _outValue;
 }
 
 template <> inline uint32 JsonNode::GetChildValue(const char* _childNode, uint32 _defaultValue)
 {
-    return cj5_seekget_uint(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? cj5_get_uint(reinterpret_cast<cj5_result*>(mCtx), id) : _defaultValue;
 }
 
 template <> inline uint64 JsonNode::GetChildValue(const char* _childNode, uint64 _defaultValue)
 {
-    return cj5_seekget_uint64(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? cj5_get_uint64(reinterpret_cast<cj5_result*>(mCtx), id) : _defaultValue;
 }
 
 template <> inline int JsonNode::GetChildValue(const char* _childNode, int _defaultValue)
 {
-    return cj5_seekget_int(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? cj5_get_int(reinterpret_cast<cj5_result*>(mCtx), id) : _defaultValue;
 }
 
 template <> inline float JsonNode::GetChildValue(const char* _childNode, float _defaultValue)
 {
-    return cj5_seekget_float(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? cj5_get_float(reinterpret_cast<cj5_result*>(mCtx), id) : _defaultValue;
 }
 
 template <> inline double JsonNode::GetChildValue(const char* _childNode, double _defaultValue)
 {
-    return cj5_seekget_double(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? cj5_get_double(reinterpret_cast<cj5_result*>(mCtx), id) : _defaultValue;
 }
 
 template <> inline bool JsonNode::GetChildValue(const char* _childNode, bool _defaultValue)
 {
-    return cj5_seekget_bool(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _defaultValue);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? cj5_get_bool(reinterpret_cast<cj5_result*>(mCtx), id) : _defaultValue;
 }
 
 template <> inline Float4 JsonNode::GetChildValue(const char* _childNode, Float4 _defaultValue)
@@ -280,32 +343,38 @@ template <> inline Int2 JsonNode::GetChildValue(const char* _childNode, Int2 _de
 
 template <> inline uint32 JsonNode::GetChildArrayValues(const char* _childNode, uint32* _values, uint32 _maxValues)
 {
-    return (uint32)cj5_seekget_array_uint(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _values, _maxValues);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? (uint32)cj5_seekget_array_uint(reinterpret_cast<cj5_result*>(mCtx), id, nullptr, _values, _maxValues) : 0;
 }
 
 template <> inline uint32 JsonNode::GetChildArrayValues(const char* _childNode, int* _values, uint32 _maxValues)
 {
-    return (uint32)cj5_seekget_array_int(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _values, _maxValues);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? (uint32)cj5_seekget_array_int(reinterpret_cast<cj5_result*>(mCtx), id, nullptr, _values, _maxValues) : 0;
 }
 
 template <> inline uint32 JsonNode::GetChildArrayValues(const char* _childNode, uint64* _values, uint32 _maxValues)
 {
-    return (uint32)cj5_seekget_array_uint64(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _values, _maxValues);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? (uint32)cj5_seekget_array_uint64(reinterpret_cast<cj5_result*>(mCtx), id, nullptr, _values, _maxValues) : 0;
 }
 
 template <> inline uint32 JsonNode::GetChildArrayValues(const char* _childNode, bool* _values, uint32 _maxValues)
 {
-    return (uint32)cj5_seekget_array_bool(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _values, _maxValues);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? (uint32)cj5_seekget_array_bool(reinterpret_cast<cj5_result*>(mCtx), id, nullptr, _values, _maxValues) : 0;
 }
 
 template <> inline uint32 JsonNode::GetChildArrayValues(const char* _childNode, double* _values, uint32 _maxValues)
 {
-    return (uint32)cj5_seekget_array_double(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _values, _maxValues);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? (uint32)cj5_seekget_array_double(reinterpret_cast<cj5_result*>(mCtx), id, nullptr, _values, _maxValues) : 0;
 }
 
 template <> inline uint32 JsonNode::GetChildArrayValues(const char* _childNode, float* _values, uint32 _maxValues)
 {
-    return (uint32)cj5_seekget_array_float(reinterpret_cast<cj5_result*>(mCtx), mTokenId, _childNode, _values, _maxValues);
+    int id = Json::_private::Seek(mCtx, mTokenId, _childNode);
+    return id != -1 ? (uint32)cj5_seekget_array_float(reinterpret_cast<cj5_result*>(mCtx), id, nullptr, _values, _maxValues) : 0;
 }
 
 
@@ -2,12 +2,15 @@
 
 #include <stdarg.h> // va_list
 #include <stdio.h>  // puts
+#include <time.h>   // time, localtime
 
 #include "TracyHelper.h"
 #include "System.h"
 #include "Debug.h"
 #include "Arrays.h"
 #include "Allocators.h"
+#include "Atomic.h"
+#include "Hash.h"
 
 #if PLATFORM_MOBILE || PLATFORM_OSX
     #define TERM_COLOR_RESET     ""
@@ -34,6 +37,131 @@
 #endif
 
 static constexpr uint32 LOG_MAX_MESSAGE_CHARS = 2048;
+static constexpr uint32 LOG_STACK_MESSAGE_CHARS = 256;      // Most messages fit in here and don't need temp memory for formatting
+static constexpr uint32 LOG_ASYNC_RECORD_ALIGN = 32;
+static constexpr uint32 LOG_BENCHMARK_MAX_THREADS = 32;
+static constexpr uint32 LOG_BINARY_FILE_ID = MakeFourCC('J', 'L', 'O', 'G');
+static constexpr uint32 LOG_BINARY_FILE_VERSION = 1;
+static constexpr uint32 LOG_BINARY_BUFFER_SIZE = 64*SIZE_KB;
+static constexpr uint32 LOG_BINARY_MAX_FORMAT_CHARS = 4096;     // Entries with larger format strings are not written to the binary sink
+static constexpr uint32 LOG_BINARY_MAX_STRING_CHARS = 1024;     // Source file paths and %s arguments are truncated to this
+static constexpr uint32 LOG_BINARY_MAX_ARGS_SIZE = 8*SIZE_KB;   // Arguments that don't fit are dropped and show up as '<?>' in decoded text
+static constexpr uint32 LOG_BINARY_MAX_THREAD_NAME = 32;
+static constexpr uint32 LOG_BINARY_MAX_RECORD_SIZE =    // Format, location and thread definitions + Entry with the largest arguments
+    (7 + LOG_BINARY_MAX_FORMAT_CHARS) + (11 + LOG_BINARY_MAX_STRING_CHARS) + (7 + LOG_BINARY_MAX_THREAD_NAME) + 28 + LOG_BINARY_MAX_ARGS_SIZE;
+
+enum class LogAsyncRecordState : uint32
+{
+    Empty = 0,  // Space is reserved by a producer but the record is not written yet. Logger thread waits on it
+    Ready,
+    Padding,    // Rest of the buffer is skipped, because the record didn't fit at the end
+    Muted,      // Consumed without dispatching to the sinks. Pushed by benchmark threads
+    Binary      // Binary sink entry (LogBinaryAsyncEntry). Logger thread writes it to the binary file
+};
+
+// Records are written back-to-back in the ring buffer and the text comes right after the header
+// Logger thread zeroes the memory of every record it consumes, so reserved space always starts as 'Empty'
+struct alignas(LOG_ASYNC_RECORD_ALIGN) LogAsyncRecord
+{
+    AtomicUint32 state;         // LogAsyncRecordState
+    uint32 size;                // Total size of the record in the buffer, including the header
+    LogLevel type;
+    uint32 channels;
+    uint32 line;
+    uint32 textLen;
+    const char* sourceFile;     // __FILE__ strings are static, so we only keep the pointer
+};
+static_assert(sizeof(LogAsyncRecord) == LOG_ASYNC_RECORD_ALIGN);
+
+// Multi-producer/single-consumer ring buffer of variable sized records
+// Producers reserve space by bumping writeOffset with CAS and the logger thread is the only one that advances readOffset
+// Offsets grow monotonically and are wrapped with the mask when accessing the buffer
+struct LogAsyncContext
+{
+    alignas(CACHE_LINE_SIZE) AtomicUint64 writeOffset;
+    alignas(CACHE_LINE_SIZE) AtomicUint64 readOffset;
+    alignas(CACHE_LINE_SIZE) AtomicUint32 sleeping;       // Logger thread is waiting on wakeSem and producers must post it
+    AtomicUint32 enabled;
+    AtomicUint32 numProducers;  // Producers that are pushing into the buffer. ReleaseAsync waits for them before freeing it
+    uint8* buffer;
+    uint32 bufferSize;          // Power of two
+    AtomicUint32 threadId;
+    Semaphore wakeSem;
+    Thread thread;
+    bool quit;
+};
+
+enum class LogBinaryRecordType : uint8
+{
+    Format = 1,     // u32 id, u16 len, chars
+    Location,       // u32 id, u32 line, u16 len, chars
+    Thread,         // u32 threadId, u16 len, chars
+    Entry           // u64 microsecs since file start, u32 threadId, u8 level, u32 channels, u32 locationId, u32 formatId, u16 argsSize, args
+};
+
+// Arguments are encoded by walking the format string: Integers are stored as 64bit, floats as double, pointers as 64bit
+// and strings as u16 length followed by the characters. '*' width/precision values are stored as integers before the argument
+enum class LogBinaryArgType : uint8
+{
+    None = 0,       // '%%'
+    Int,
+    Uint,
+    Double,
+    String,
+    Pointer,
+    Invalid         // Unsupported or broken spec, encoding/decoding stops here
+};
+
+struct LogBinaryFileHeader
+{
+    uint32 fileId;
+    uint32 version;
+    uint64 startTime;       // Unix time of the file creation. Entry timestamps are relative to this
+};
+
+struct LogFormatSpec
+{
+    uint32 offset;          // Offset of '%' in the format string
+    uint32 len;             // Length of the whole spec, including the conversion character
+    uint32 lengthOffset;    // Offset of the length modifier (hh, l, z, ...) in the format string
+    uint32 lengthLen;
+    uint32 numStars;        // Each '*' in the spec takes an additional int argument
+    int precision;          // -1: none, -2: '*'
+    char lengthMod;         // 0: none, 'H': hh, 'h', 'l', 'L': ll/j/I64, 'z', 't', 'D': long double
+    LogBinaryArgType type;
+};
+
+// Payload of LogAsyncRecordState::Binary records, followed by the format string and the encoded arguments
+// Everything the logger thread needs is captured by the producer, because it cannot query the producer thread or access 'va_list'
+struct LogBinaryAsyncEntry
+{
+    uint64 tick;
+    uint32 threadId;
+    uint16 fmtLen;
+    uint16 argsSize;
+    char threadName[LOG_BINARY_MAX_THREAD_NAME];
+};
+
+// In async mode, the logger thread is the only writer and the mutex is uncontended. Otherwise, every producer takes it
+struct LogBinaryContext
+{
+    Mutex mutex;
+    File file;
+    Path filepath;
+    uint8* buffer;
+    uint32 bufferOffset;
+    uint32 maxFiles;
+    uint64 fileSize;
+    uint64 maxFileSize;
+    uint64 startTick;
+    HashTable<uint32> formats;      // Hash of the format string -> Id. Colliding hashes are probed with the next key
+    HashTable<uint32> locations;    // Hash of source file pointer and line -> Id. Same as 'formats'
+    HashTable<uint32> threads;      // Thread Id -> Thread Id. Just to know which threads are already written
+    Array<Pair<uint32, uint32>> formatRanges;       // Id -> Offset/Length in 'formatChars'. To tell hash collisions apart
+    Array<char> formatChars;
+    Array<Pair<const char*, uint32>> locationKeys;  // Id -> Source file and line. Same as 'formatRanges'
+    LogLevel level;                 // 'Default' when there is no binary sink
+};
 
 struct LogContext
 {
@@ -41,10 +169,18 @@ struct LogContext
     LogLevel logLevel = DEFAULT_LOG_LEVEL;
     bool breakOnErrors;
     bool treatWarningsAsErrors;
+    LogAsyncContext async;
+    LogBinaryContext binary;
 };
 
 static LogContext gLog;
 
+// Set on Log::RunBenchmark threads: All levels are enabled and optionally the sinks are muted, to measure the cost of LOG calls 
+// without the I/O. Thread-local, so logs from the rest of the program are not affected while the benchmark runs
+static thread_local bool gLogBenchmarkThread;
+static thread_local bool gLogMuteSinks;
+static thread_local char gLogThreadName[LOG_BINARY_MAX_THREAD_NAME];     // Cached for the binary sink, fetched on first use
+
 // corrosponds to EngineLogLevel
 static const char* LOG_ENTRY_TYPES[static_cast<uint32>(LogLevel::_Count)] = { 
     "", 
@@ -159,6 +295,9 @@ namespace Log
 
     static void _DispatchLogEntry(const LogEntry& entry)
     {
+        if (gLogMuteSinks)
+            return;
+
         _PrintToTerminal(entry); 
         _PrintToDebugger(entry);
         #ifdef TRACY_ENABLE
@@ -170,62 +309,687 @@ namespace Log
 
         for (Pair<LogCallback, void*> c : gLog.callbacks)
             c.first(entry, c.second);
+    }
 
-        if (entry.type == LogLevel::Error && gLog.breakOnErrors) {
-            ASSERT_MSG(0, "Breaking on error");
+    // Reserves a record with `payloadSize` bytes after the header. Returns nullptr if the record cannot be pushed
+    // and the caller should write it synchronously
+    static LogAsyncRecord* _ReserveAsync(uint32 payloadSize)
+    {
+        LogAsyncContext& ctx = gLog.async;
+        uint32 size = AlignValue<uint32>(uint32(sizeof(LogAsyncRecord)) + payloadSize, LOG_ASYNC_RECORD_ALIGN);
+
+        // Logs from the logger thread itself (sink callbacks) cannot wait for the space to be freed
+        if (size > ctx.bufferSize/2 || Thread::GetCurrentId() == Atomic::Load(&ctx.threadId))
+            return nullptr;
+
+        // Reserve space. If the record doesn't fit at the end of the buffer, the remaining part is reserved as padding
+        const uint32 mask = ctx.bufferSize - 1;
+        unsigned long long offset = Atomic::Load(&ctx.writeOffset);
+        uint32 padding;
+        while (true) {
+            uint32 pos = uint32(offset) & mask;
+            padding = (pos + size) > ctx.bufferSize ? (ctx.bufferSize - pos) : 0;
+            uint64 readOffset = Atomic::LoadExplicit(&ctx.readOffset, AtomicMemoryOrder::Acquire);
+
+            if (offset + padding + size - readOffset > ctx.bufferSize) {
+                // Buffer is full, wait for the logger thread to catch up
+                if (Atomic::Exchange(&ctx.sleeping, 0))
+                    ctx.wakeSem.Post();
+                Thread::SwitchContext();
+                offset = Atomic::Load(&ctx.writeOffset);
+                continue;
+            }
+
+            if (Atomic::CompareExchange_Weak(&ctx.writeOffset, &offset, offset + padding + size))
+                break;
+        }
+
+        if (padding) {
+            LogAsyncRecord* padRecord = reinterpret_cast<LogAsyncRecord*>(ctx.buffer + (uint32(offset) & mask));
+            padRecord->size = padding;
+            Atomic::StoreExplicit(&padRecord->state, uint32(LogAsyncRecordState::Padding), AtomicMemoryOrder::Release);
         }
+
+        LogAsyncRecord* record = reinterpret_cast<LogAsyncRecord*>(ctx.buffer + (uint32(offset + padding) & mask));
+        record->size = size;
+        return record;
     }
 
-    void _private::PrintInfo(uint32 channels, const char* sourceFile, uint32 line, const char* fmt, ...)
+    static void _CommitAsync(LogAsyncRecord* record, LogAsyncRecordState state)
     {
-        if (gLog.logLevel < LogLevel::Info)
+        LogAsyncContext& ctx = gLog.async;
+        Atomic::StoreExplicit(&record->state, uint32(state), AtomicMemoryOrder::Release);
+
+        // Only touch the shared flag with a RMW when the logger is actually sleeping
+        if (Atomic::Load(&ctx.sleeping) && Atomic::Exchange(&ctx.sleeping, 0))
+            ctx.wakeSem.Post();
+    }
+
+    static void _PushAsync(const LogEntry& entry)
+    {
+        LogAsyncRecord* record = _ReserveAsync(entry.textLen + 1);
+        if (!record) {
+            _DispatchLogEntry(entry);
             return;
+        }
+
+        record->type = entry.type;
+        record->channels = entry.channels;
+        record->line = entry.line;
+        record->textLen = entry.textLen;
+        record->sourceFile = entry.sourceFile;
+        memcpy(record + 1, entry.text, entry.textLen + 1);
+        _CommitAsync(record, gLogMuteSinks ? LogAsyncRecordState::Muted : LogAsyncRecordState::Ready);
+    }
+
+    static void _WriteBinaryAsyncRecord(const LogAsyncRecord* record);
+
+    static int _AsyncThread(void*)
+    {
+        LogAsyncContext& ctx = gLog.async;
+        const uint32 mask = ctx.bufferSize - 1;
+        uint64 readOffset = Atomic::Load(&ctx.readOffset);
+        Atomic::Store(&ctx.threadId, Thread::GetCurrentId());
+
+        while (true) {
+            if (readOffset == Atomic::Load(&ctx.writeOffset)) {
+                if (ctx.quit)
+                    break;
+
+                // Announce that we are going to sleep, then check again so we don't miss any record that's pushed in between
+                Atomic::Store(&ctx.sleeping, 1);
+                if (readOffset == Atomic::Load(&ctx.writeOffset) && !ctx.quit)
+                    ctx.wakeSem.Wait();
+                Atomic::Store(&ctx.sleeping, 0);
+                continue;
+            }
+
+            LogAsyncRecord* record = reinterpret_cast<LogAsyncRecord*>(ctx.buffer + (uint32(readOffset) & mask));
+            LogAsyncRecordState state = LogAsyncRecordState(Atomic::LoadExplicit(&record->state, AtomicMemoryOrder::Acquire));
+            if (state == LogAsyncRecordState::Empty) {
+                // Space is reserved, but the producer is still writing it
+                Thread::SwitchContext();
+                continue;
+            }
+
+            uint32 size = record->size;
+            if (state == LogAsyncRecordState::Binary) {
+                _WriteBinaryAsyncRecord(record);
+            }
+            else if (state == LogAsyncRecordState::Ready) {
+                _DispatchLogEntry({
+                    .type = record->type,
+                    .channels = record->channels,
+                    .textLen = record->textLen,
+                    .sourceFileLen = record->sourceFile ? Str::Len(record->sourceFile) : 0,
+                    .line = record->line,
+                    .text = reinterpret_cast<const char*>(record + 1),
+                    .sourceFile = record->sourceFile
+                });
+            }
+
+            memset(record, 0x0, size);
+            readOffset += size;
+            Atomic::StoreExplicit(&ctx.readOffset, readOffset, AtomicMemoryOrder::Release);
+        }
+
+        return 0;
+    }
+
+    static void _SetAssertFailCallback()
+    {
+        // Failed asserts (including out of memory) flush pending entries before breaking
+        if (IsAsync() || gLog.binary.level != LogLevel::Default)
+            Assert::SetFailCallback([](void*) { Flush(); }, nullptr);
+        else
+            Assert::SetFailCallback(nullptr, nullptr);
+    }
+
+    // Parses the next conversion spec of the format string, starting from `offset`. Returns false if there are no more specs
+    static bool _ParseFormatSpec(const char* fmt, uint32 offset, LogFormatSpec* spec)
+    {
+        const char* s = fmt + offset;
+        while (*s && *s != '%')
+            s++;
+        if (*s == 0)
+            return false;
+
+        memset(spec, 0x0, sizeof(*spec));
+        spec->offset = uint32(s - fmt);
+        spec->precision = -1;
+        s++;
+
+        if (*s == '%') {
+            spec->len = 2;
+            spec->type = LogBinaryArgType::None;
+            return true;
+        }
+
+        // Flags (including stb_sprintf's thousands and metric flags)
+        while (*s == '-' || *s == '+' || *s == ' ' || *s == '#' || *s == '0' || *s == '\'' || *s == '$' || *s == '_')
+            s++;
+
+        // Width
+        if (*s == '*') {
+            spec->numStars++;
+            s++;
+        }
+        else {
+            while (*s >= '0' && *s <= '9')
+                s++;
+        }
+
+        // Precision
+        if (*s == '.') {
+            s++;
+            if (*s == '*') {
+                spec->numStars++;
+                spec->precision = -2;
+                s++;
+            }
+            else {
+                spec->precision = 0;
+                while (*s >= '0' && *s <= '9')
+                    spec->precision = spec->precision*10 + (*s++ - '0');
+            }
+        }
+
+        // Length
+        spec->lengthOffset = uint32(s - fmt);
+        switch (*s) {
+        case 'h':   spec->lengthMod = s[1] == 'h' ? 'H' : 'h';  s += s[1] == 'h' ? 2 : 1;   break;
+        case 'l':   spec->lengthMod = s[1] == 'l' ? 'L' : 'l';  s += s[1] == 'l' ? 2 : 1;   break;
+        case 'j':   spec->lengthMod = 'L';  s++;    break;
+        case 'z':   spec->lengthMod = 'z';  s++;    break;
+        case 't':   spec->lengthMod = 't';  s++;    break;
+        case 'L':   spec->lengthMod = 'D';  s++;    break;
+        case 'I':
+            if (s[1] == '6' && s[2] == '4')         { spec->lengthMod = 'L'; s += 3; }
+            else if (s[1] == '3' && s[2] == '2')    { s += 3; }
+            else                                    { spec->lengthMod = 'z'; s++; }
+            break;
+        default:    break;
+        }
+        spec->lengthLen = uint32(s - fmt) - spec->lengthOffset;
+
+        switch (*s) {
+        case 'd': case 'i': case 'c':                                   
+            spec->type = LogBinaryArgType::Int;      
+            break;
+        case 'u': case 'o': case 'x': case 'X': case 'b': case 'B':     
+            spec->type = LogBinaryArgType::Uint;     
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': 
+            spec->type = LogBinaryArgType::Double;   
+            break;
+        case 's':   
+            spec->type = LogBinaryArgType::String;   
+            break;
+        case 'p':   
+            spec->type = LogBinaryArgType::Pointer;  
+            break;
+        default:    
+            spec->type = LogBinaryArgType::Invalid;  
+            break;
+        }
+
+        spec->len = uint32(s - fmt) - spec->offset + 1;
+        return true;
+    }
+
+    // Writes the raw arguments of the format string to dst and returns the written size
+    // Stops at the first argument that doesn't fit or the first unsupported spec
+    static uint32 _EncodeArgs(uint8* dst, uint32 dstSize, const char* fmt, va_list args)
+    {
+        uint32 size = 0;
+        uint32 offset = 0;
+        LogFormatSpec spec;
 
+        auto WriteValue = [dst, dstSize, &size](uint64 value)->bool {
+            if (size + sizeof(value) > dstSize)
+                return false;
+            memcpy(dst + size, &value, sizeof(value));
+            size += sizeof(value);
+            return true;
+        };
+
+        while (_ParseFormatSpec(fmt, offset, &spec)) {
+            if (spec.type == LogBinaryArgType::Invalid)
+                break;
+            offset = spec.offset + spec.len;
+
+            int star = 0;
+            bool fits = true;
+            for (uint32 i = 0; i < spec.numStars && fits; i++) {
+                star = va_arg(args, int);
+                fits = WriteValue(uint64(int64(star)));
+            }
+
+            switch (spec.type) {
+            case LogBinaryArgType::Int: {
+                int64 value;
+                switch (spec.lengthMod) {
+                case 'H':   value = int8(va_arg(args, int));      break;
+                case 'h':   value = int16(va_arg(args, int));     break;
+                case 'l':   value = va_arg(args, long);           break;
+                case 'L':   value = va_arg(args, long long);      break;
+                case 'z':   value = int64(va_arg(args, size_t));  break;
+                case 't':   value = va_arg(args, ptrdiff_t);      break;
+                default:    value = va_arg(args, int);            break;
+                }
+                fits = fits && WriteValue(uint64(value));
+                break;
+            }
+            case LogBinaryArgType::Uint: {
+                uint64 value;
+                switch (spec.lengthMod) {
+                case 'H':   value = uint8(va_arg(args, unsigned int));    break;
+                case 'h':   value = uint16(va_arg(args, unsigned int));   break;
+                case 'l':   value = va_arg(args, unsigned long);          break;
+                case 'L':   value = va_arg(args, unsigned long long);     break;
+                case 'z':   value = va_arg(args, size_t);                 break;
+                case 't':   value = uint64(va_arg(args, ptrdiff_t));      break;
+                default:    value = va_arg(args, unsigned int);           break;
+                }
+                fits = fits && WriteValue(value);
+                break;
+            }
+            case LogBinaryArgType::Double: {
+                double value = spec.lengthMod == 'D' ? double(va_arg(args, long double)) : va_arg(args, double);
+                uint64 bits;
+                memcpy(&bits, &value, sizeof(bits));
+                fits = fits && WriteValue(bits);
+                break;
+            }
+            case LogBinaryArgType::Pointer:
+                fits = fits && WriteValue(uint64(uintptr_t(va_arg(args, void*))));
+                break;
+            case LogBinaryArgType::String: {
+                const char* str = va_arg(args, const char*);
+                if (!str)
+                    str = "null";
+
+                // Precision can be used with strings that are not null-terminated
+                uint32 maxLen = LOG_BINARY_MAX_STRING_CHARS;
+                if (spec.precision >= 0)
+                    maxLen = Min<uint32>(maxLen, uint32(spec.precision));
+                else if (spec.precision == -2 && star >= 0)
+                    maxLen = Min<uint32>(maxLen, uint32(star));
+                uint16 len = 0;
+                while (len < maxLen && str[len])
+                    len++;
+
+                if (fits && size + sizeof(len) + len <= dstSize) {
+                    memcpy(dst + size, &len, sizeof(len));
+                    memcpy(dst + size + sizeof(len), str, len);
+                    size += sizeof(len) + len;
+                }
+                else {
+                    fits = false;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+
+            if (!fits)
+                break;
+        }
+
+        return size;
+    }
+
+    static void _BinaryWriteBytes(LogBinaryContext& ctx, const void* data, uint32 size)
+    {
+        ASSERT(ctx.bufferOffset + size <= LOG_BINARY_BUFFER_SIZE);
+        memcpy(ctx.buffer + ctx.bufferOffset, data, size);
+        ctx.bufferOffset += size;
+    }
+
+    template <typename _T> 
+    static void _BinaryWrite(LogBinaryContext& ctx, _T value)
+    {
+        _BinaryWriteBytes(ctx, &value, sizeof(value));
+    }
+
+    static void _BinaryGetRotatedPath(const LogBinaryContext& ctx, uint32 index, char* path, uint32 pathSize)
+    {
+        if (index == 0)
+            Str::Copy(path, pathSize, ctx.filepath.CStr());
+        else
+            Str::PrintFmt(path, pathSize, "%s.%u", ctx.filepath.CStr(), index);
+    }
+
+    // Rotates the existing files (filepath -> filepath.1 -> filepath.2 ...) and starts a new one
+    // Every file is self-contained, so all the format/location/thread definitions are written again in the new file
+    static bool _BinaryOpenFile(LogBinaryContext& ctx)
+    {
+        ctx.file.Close();
+
+        char src[PATH_CHARS_MAX];
+        char dst[PATH_CHARS_MAX];
+        for (uint32 i = ctx.maxFiles - 1; i > 0; i--) {
+            _BinaryGetRotatedPath(ctx, i - 1, src, sizeof(src));
+            if (!OS::IsPathFile(src))
+                continue;
+            _BinaryGetRotatedPath(ctx, i, dst, sizeof(dst));
+            if (OS::IsPathFile(dst))
+                OS::DeletePath(dst);
+            OS::MovePath(src, dst);
+        }
+
+        ctx.formats.Clear();
+        ctx.locations.Clear();
+        ctx.threads.Clear();
+        ctx.formatRanges.Clear();
+        ctx.formatChars.Clear();
+        ctx.locationKeys.Clear();
+        ctx.fileSize = 0;
+        ctx.startTick = Timer::GetTicks();
+
+        if (!ctx.file.Open(ctx.filepath.CStr(), FileOpenFlags::Write))
+            return false;
+
+        LogBinaryFileHeader header {
+            .fileId = LOG_BINARY_FILE_ID,
+            .version = LOG_BINARY_FILE_VERSION,
+            .startTime = uint64(time(nullptr))
+        };
+        if (ctx.file.Write<LogBinaryFileHeader>(&header, 1) != 1)
+            return false;
+        ctx.fileSize = sizeof(header);
+        return true;
+    }
+
+    static void _BinaryFlush(LogBinaryContext& ctx)
+    {
+        if (ctx.bufferOffset == 0 || !ctx.file.IsOpen())
+            return;
+
+        ctx.fileSize += ctx.file.Write(ctx.buffer, ctx.bufferOffset);
+        ctx.bufferOffset = 0;
+
+        if (ctx.fileSize >= ctx.maxFileSize)
+            _BinaryOpenFile(ctx);
+    }
+
+    // Returns the id of the format string in the current file. Sets `outIsNew` if it's not written to the file yet
+    static uint32 _BinaryFindFormat(LogBinaryContext& ctx, const char* fmt, uint32 fmtLen, bool* outIsNew)
+    {
+        uint32 key = Hash::Fnv32(fmt, fmtLen);
+        while (true) {
+            key = key ? key : 1;    // Zero is the empty slot in the hash table
+            uint32 id = ctx.formats.FindAndFetch(key, UINT32_MAX);
+            if (id == UINT32_MAX) {
+                id = ctx.formatRanges.Count();
+                ctx.formats.Add(key, id);
+                ctx.formatRanges.Push(Pair<uint32, uint32>(ctx.formatChars.Count(), fmtLen));
+                ctx.formatChars.Extend(fmt, fmtLen);
+                *outIsNew = true;
+                return id;
+            }
+
+            const Pair<uint32, uint32>& range = ctx.formatRanges[id];
+            if (range.second == fmtLen && memcmp(ctx.formatChars.Ptr() + range.first, fmt, fmtLen) == 0) {
+                *outIsNew = false;
+                return id;
+            }
+            ++key;  // Another format string has the same hash
+        }
+    }
+
+    static uint32 _BinaryFindLocation(LogBinaryContext& ctx, const char* sourceFile, uint32 line, bool* outIsNew)
+    {
+        uint32 key = Hash::Int64To32(uint64(uintptr_t(sourceFile)) ^ (uint64(line) << 48));
+        while (true) {
+            key = key ? key : 1;
+            uint32 id = ctx.locations.FindAndFetch(key, UINT32_MAX);
+            if (id == UINT32_MAX) {
+                id = ctx.locationKeys.Count();
+                ctx.locations.Add(key, id);
+                ctx.locationKeys.Push(Pair<const char*, uint32>(sourceFile, line));
+                *outIsNew = true;
+                return id;
+            }
+
+            const Pair<const char*, uint32>& loc = ctx.locationKeys[id];
+            if (loc.first == sourceFile && loc.second == line) {
+                *outIsNew = false;
+                return id;
+            }
+            ++key;
+        }
+    }
+
+    // MT: Caller must lock ctx.mutex. `threadName` can be null if the entry is written by the same thread that logged it
+    static void _BinaryWriteEntry(LogBinaryContext& ctx, const LogBinaryAsyncEntry& entry, const char* threadName, LogLevel type, 
+                                  uint32 channels, const char* sourceFile, uint32 line, const char* fmt, const uint8* args)
+    {
+        // Make room for the worst case, so the file cannot get rotated between the definitions and the entry that uses them
+        if (ctx.bufferOffset + LOG_BINARY_MAX_RECORD_SIZE > LOG_BINARY_BUFFER_SIZE)
+            _BinaryFlush(ctx);
+
+        bool isNew;
+        uint32 formatId = _BinaryFindFormat(ctx, fmt, entry.fmtLen, &isNew);
+        if (isNew) {
+            _BinaryWrite<uint8>(ctx, uint8(LogBinaryRecordType::Format));
+            _BinaryWrite<uint32>(ctx, formatId);
+            _BinaryWrite<uint16>(ctx, entry.fmtLen);
+            _BinaryWriteBytes(ctx, fmt, entry.fmtLen);
+        }
+
+        uint32 locationId = _BinaryFindLocation(ctx, sourceFile, line, &isNew);
+        if (isNew) {
+            uint32 fileLen = sourceFile ? Min(Str::Len(sourceFile), LOG_BINARY_MAX_STRING_CHARS) : 0;
+            _BinaryWrite<uint8>(ctx, uint8(LogBinaryRecordType::Location));
+            _BinaryWrite<uint32>(ctx, locationId);
+            _BinaryWrite<uint32>(ctx, line);
+            _BinaryWrite<uint16>(ctx, uint16(fileLen));
+            _BinaryWriteBytes(ctx, sourceFile, fileLen);
+        }
+
+        if (ctx.threads.Find(entry.threadId) == INVALID_INDEX) {
+            ctx.threads.Add(entry.threadId, entry.threadId);
+            char name[LOG_BINARY_MAX_THREAD_NAME];
+            if (!threadName) {
+                Thread::GetCurrentThreadName(name, sizeof(name));
+                threadName = name;
+            }
+            uint32 nameLen = Min(Str::Len(threadName), LOG_BINARY_MAX_THREAD_NAME - 1);
+            _BinaryWrite<uint8>(ctx, uint8(LogBinaryRecordType::Thread));
+            _BinaryWrite<uint32>(ctx, entry.threadId);
+            _BinaryWrite<uint16>(ctx, uint16(nameLen));
+            _BinaryWriteBytes(ctx, threadName, nameLen);
+        }
+
+        // Async entries can be older than the file, if it's rotated while they were waiting in the queue
+        uint64 elapsed = entry.tick > ctx.startTick ? Timer::Diff(entry.tick, ctx.startTick) : 0;
+
+        _BinaryWrite<uint8>(ctx, uint8(LogBinaryRecordType::Entry));
+        _BinaryWrite<uint64>(ctx, uint64(Timer::ToUS(elapsed)));
+        _BinaryWrite<uint32>(ctx, entry.threadId);
+        _BinaryWrite<uint8>(ctx, uint8(type));
+        _BinaryWrite<uint32>(ctx, channels);
+        _BinaryWrite<uint32>(ctx, locationId);
+        _BinaryWrite<uint32>(ctx, formatId);
+        _BinaryWrite<uint16>(ctx, entry.argsSize);
+        _BinaryWriteBytes(ctx, args, entry.argsSize);
+
+        // Errors are usually followed by breaks or crashes, make sure they are on the disk before that
+        if (type == LogLevel::Error)
+            _BinaryFlush(ctx);
+    }
+
+    // Logger thread: Async binary records are written to the file here, so producers never touch the file or its lock
+    static void _WriteBinaryAsyncRecord(const LogAsyncRecord* record)
+    {
+        LogBinaryContext& ctx = gLog.binary;
+        const LogBinaryAsyncEntry* entry = reinterpret_cast<const LogBinaryAsyncEntry*>(record + 1);
+        const char* fmt = reinterpret_cast<const char*>(entry + 1);
+        const uint8* args = reinterpret_cast<const uint8*>(fmt + entry->fmtLen);
+
+        MutexScope lock(ctx.mutex);
+        if (ctx.buffer) {
+            _BinaryWriteEntry(ctx, *entry, entry->threadName, record->type, record->channels, record->sourceFile, record->line, 
+                              fmt, args);
+        }
+    }
+
+    static void _WriteBinary(LogLevel type, uint32 channels, const char* sourceFile, uint32 line, const char* fmt, va_list args)
+    {
+        LogBinaryContext& ctx = gLog.binary;
+
+        uint32 fmtLen = Str::Len(fmt);
+        if (fmtLen > LOG_BINARY_MAX_FORMAT_CHARS)
+            return;
+
+        // Arguments are encoded before taking any locks
         MemTempAllocator tmp;
-        uint32 fmtLen = Str::Len(fmt) + LOG_MAX_MESSAGE_CHARS;
-        char* text = tmp.MallocTyped<char>(fmtLen);
+        uint8* encodedArgs = tmp.MallocTyped<uint8>(LOG_BINARY_MAX_ARGS_SIZE);
+        LogBinaryAsyncEntry entry {
+            .tick = Timer::GetTicks(),
+            .threadId = Thread::GetCurrentId(),
+            .fmtLen = uint16(fmtLen),
+            .argsSize = uint16(_EncodeArgs(encodedArgs, LOG_BINARY_MAX_ARGS_SIZE, fmt, args))
+        };
 
-        va_list args;
-        va_start(args, fmt);
-        Str::PrintFmtArgs(text, fmtLen, fmt, args);
-        va_end(args);
+        // Async mode: Hand the entry over to the logger thread, which also does the flushing and the file rotation
+        if (IsAsync()) {
+            LogAsyncContext& actx = gLog.async;
+            bool pushed = false;
+            Atomic::FetchAdd(&actx.numProducers, 1);
+            if (Atomic::Load(&actx.enabled)) {
+                LogAsyncRecord* record = _ReserveAsync(uint32(sizeof(LogBinaryAsyncEntry)) + fmtLen + entry.argsSize);
+                if (record) {
+                    if (gLogThreadName[0] == 0)
+                        Thread::GetCurrentThreadName(gLogThreadName, sizeof(gLogThreadName));
+                    memcpy(entry.threadName, gLogThreadName, sizeof(entry.threadName));
+
+                    record->type = type;
+                    record->channels = channels;
+                    record->line = line;
+                    record->textLen = 0;
+                    record->sourceFile = sourceFile;
+                    uint8* payload = reinterpret_cast<uint8*>(record + 1);
+                    memcpy(payload, &entry, sizeof(entry));
+                    memcpy(payload + sizeof(entry), fmt, fmtLen);
+                    memcpy(payload + sizeof(entry) + fmtLen, encodedArgs, entry.argsSize);
+                    _CommitAsync(record, LogAsyncRecordState::Binary);
+                    pushed = true;
+                }
+            }
+            Atomic::FetchSub(&actx.numProducers, 1);
 
-        _DispatchLogEntry({
-            .type = LogLevel::Info,
+            if (pushed) {
+                if (type == LogLevel::Error)
+                    Flush();
+                return;
+            }
+        }
+
+        MutexScope lock(ctx.mutex);
+        if (ctx.buffer)
+            _BinaryWriteEntry(ctx, entry, nullptr, type, channels, sourceFile, line, fmt, encodedArgs);
+    }
+
+    static void _Submit(LogLevel type, uint32 channels, const char* sourceFile, uint32 line, const char* text, uint32 textLen)
+    {
+        const LogEntry entry {
+            .type = type,
             .channels = channels,
-            .textLen = Str::Len(text),
+            .textLen = textLen,
             .sourceFileLen = sourceFile ? Str::Len(sourceFile) : 0,
             .line = line,
             .text = text,
             .sourceFile = sourceFile
-        });
+        };
+
+        bool pushed = false;
+        if (IsAsync()) {
+            // Register as a producer and check again, so ReleaseAsync cannot free the buffer while we are pushing
+            LogAsyncContext& ctx = gLog.async;
+            Atomic::FetchAdd(&ctx.numProducers, 1);
+            if (Atomic::Load(&ctx.enabled)) {
+                _PushAsync(entry);
+                pushed = true;
+            }
+            Atomic::FetchSub(&ctx.numProducers, 1);
+
+            // Errors are usually followed by breaks or crashes, make sure they show up before that
+            if (pushed && type == LogLevel::Error)
+                Flush();
+        }
+
+        if (!pushed)
+            _DispatchLogEntry(entry);
+
+        if (type == LogLevel::Error && gLog.breakOnErrors) {
+            ASSERT_MSG(0, "Breaking on error");
+        }
+    }
+
+    static inline bool _IsLevelEnabled(LogLevel level)
+    {
+        return gLog.logLevel >= level || gLog.binary.level >= level || gLogBenchmarkThread;
+    }
+
+    static void _Print(LogLevel level, uint32 channels, const char* sourceFile, uint32 line, const char* fmt, va_list args)
+    {
+        LogLevel type = (level == LogLevel::Warning && gLog.treatWarningsAsErrors) ? LogLevel::Error : level;
+
+        if (gLog.binary.level >= level) {
+            va_list argsCopy;
+            va_copy(argsCopy, args);
+            _WriteBinary(type, channels, sourceFile, line, fmt, argsCopy);
+            va_end(argsCopy);
+        }
+
+        if (gLog.logLevel < level && !gLogBenchmarkThread)
+            return;
+
+        // Try formatting on the stack first and only fallback to temp memory for large messages
+        char text[LOG_STACK_MESSAGE_CHARS];
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        Str::PrintFmtArgs(text, sizeof(text), fmt, argsCopy);
+        va_end(argsCopy);
+
+        uint32 textLen = Str::Len(text);
+        if (textLen < sizeof(text) - 1) {
+            _Submit(type, channels, sourceFile, line, text, textLen);
+        }
+        else {
+            MemTempAllocator tmp;
+            uint32 fmtLen = Str::Len(fmt) + LOG_MAX_MESSAGE_CHARS;
+            char* largeText = tmp.MallocTyped<char>(fmtLen);
+            Str::PrintFmtArgs(largeText, fmtLen, fmt, args);
+            _Submit(type, channels, sourceFile, line, largeText, Str::Len(largeText));
+        }
+    }
+
+    void _private::PrintInfo(uint32 channels, const char* sourceFile, uint32 line, const char* fmt, ...)
+    {
+        if (!_IsLevelEnabled(LogLevel::Info))
+            return;
+
+        va_list args;
+        va_start(args, fmt);
+        _Print(LogLevel::Info, channels, sourceFile, line, fmt, args);
+        va_end(args);
     }
 
     // LogDebug only works in none final builds
     void _private::PrintDebug(uint32 channels, const char* sourceFile, uint32 line, const char* fmt, ...)
     {
         #if !CONFIG_FINAL_BUILD
-            if (gLog.logLevel < LogLevel::Debug)
+            if (!_IsLevelEnabled(LogLevel::Debug))
                 return;
         
-            MemTempAllocator tmp;
-            uint32 fmtLen = Str::Len(fmt) + LOG_MAX_MESSAGE_CHARS;
-            char* text = tmp.MallocTyped<char>(fmtLen);
-
             va_list args;
             va_start(args, fmt);
-            Str::PrintFmtArgs(text, fmtLen, fmt, args);
+            _Print(LogLevel::Debug, channels, sourceFile, line, fmt, args);
             va_end(args);
-
-            _DispatchLogEntry({
-                .type = LogLevel::Debug,
-                .channels = channels,
-                .textLen = Str::Len(text),
-                .sourceFileLen = sourceFile ? Str::Len(sourceFile) : 0,
-                .line = line,
-                .text = text,
-                .sourceFile = sourceFile
-            });
         #else
             UNUSED(channels);
             UNUSED(sourceFile);
@@ -236,77 +1000,173 @@ namespace Log
 
     void _private::PrintVerbose(uint32 channels, const char* sourceFile, uint32 line, const char* fmt, ...)
     {
-        if (gLog.logLevel < LogLevel::Verbose)
+        if (!_IsLevelEnabled(LogLevel::Verbose))
             return;
 
-        MemTempAllocator tmp;
-        uint32 fmtLen = Str::Len(fmt) + LOG_MAX_MESSAGE_CHARS;
-        char* text = tmp.MallocTyped<char>(fmtLen);
-
         va_list args;
         va_start(args, fmt);
-        Str::PrintFmtArgs(text, fmtLen, fmt, args);
+        _Print(LogLevel::Verbose, channels, sourceFile, line, fmt, args);
         va_end(args);
-
-        _DispatchLogEntry({
-            .type = LogLevel::Verbose,
-            .channels = channels,
-            .textLen = Str::Len(text),
-            .sourceFileLen = sourceFile ? Str::Len(sourceFile) : 0,
-            .line = line,
-            .text = text,
-            .sourceFile = sourceFile
-        });
     }
 
     void _private::PrintWarning(uint32 channels, const char* sourceFile, uint32 line, const char* fmt, ...)
     {
-        if (gLog.logLevel < LogLevel::Warning)
+        if (!_IsLevelEnabled(LogLevel::Warning))
             return;
 
-        MemTempAllocator tmp;
-        uint32 fmtLen = Str::Len(fmt) + LOG_MAX_MESSAGE_CHARS;
-        char* text = tmp.MallocTyped<char>(fmtLen);
-
         va_list args;
         va_start(args, fmt);
-        Str::PrintFmtArgs(text, fmtLen, fmt, args);
+        _Print(LogLevel::Warning, channels, sourceFile, line, fmt, args);
         va_end(args);
-
-        _DispatchLogEntry({
-            .type = !gLog.treatWarningsAsErrors ? LogLevel::Warning : LogLevel::Error,
-            .channels = channels,
-            .textLen = Str::Len(text),
-            .sourceFileLen = sourceFile ? Str::Len(sourceFile) : 0,
-            .line = line,
-            .text = text,
-            .sourceFile = sourceFile
-        });
     }
 
     void _private::PrintError(uint32 channels, const char* sourceFile, uint32 line, const char* fmt, ...)
     {
-        if (gLog.logLevel < LogLevel::Error)
+        if (!_IsLevelEnabled(LogLevel::Error))
             return;
 
-        MemTempAllocator tmp;
-        uint32 fmtLen = Str::Len(fmt) + LOG_MAX_MESSAGE_CHARS;
-        char* text = tmp.MallocTyped<char>(fmtLen);
-
         va_list args;
         va_start(args, fmt);
-        Str::PrintFmtArgs(text, fmtLen, fmt, args);
+        _Print(LogLevel::Error, channels, sourceFile, line, fmt, args);
         va_end(args);
+    }
 
-        _DispatchLogEntry({
-            .type = LogLevel::Error,
-            .channels = channels,
-            .textLen = Str::Len(text),
-            .sourceFileLen = sourceFile ? Str::Len(sourceFile) : 0,
-            .line = line,
-            .text = text,
-            .sourceFile = sourceFile        
-        });
+    bool InitializeAsync(uint32 bufferSize)
+    {
+        LogAsyncContext& ctx = gLog.async;
+        ASSERT_MSG(!IsAsync(), "Async logging is already initialized");
+        ASSERT_MSG((bufferSize & (bufferSize - 1)) == 0, "Buffer size must be power of two");
+        ASSERT(bufferSize >= 4*LOG_MAX_MESSAGE_CHARS);
+
+        ctx.buffer = Mem::AllocZeroTyped<uint8>(bufferSize);
+        if (!ctx.buffer)
+            return false;
+        ctx.bufferSize = bufferSize;
+        ctx.quit = false;
+        Atomic::Store(&ctx.writeOffset, 0);
+        Atomic::Store(&ctx.readOffset, 0);
+        Atomic::Store(&ctx.sleeping, 0);
+        ctx.wakeSem.Initialize();
+
+        if (!ctx.thread.Start(ThreadDesc { .entryFn = _AsyncThread, .name = "Logger", .stackSize = 256*SIZE_KB })) {
+            ctx.wakeSem.Release();
+            Mem::Free(ctx.buffer);
+            ctx.buffer = nullptr;
+            return false;
+        }
+        Atomic::StoreExplicit(&ctx.enabled, 1, AtomicMemoryOrder::Release);
+        _SetAssertFailCallback();
+        return true;
+    }
+
+    void ReleaseAsync()
+    {
+        LogAsyncContext& ctx = gLog.async;
+        if (!IsAsync())
+            return;
+
+        // Switch back to sync mode first and wait for the producers that are still pushing
+        // Then let the logger thread drain the buffer and quit
+        Atomic::Store(&ctx.enabled, 0);
+        _SetAssertFailCallback();
+        while (Atomic::Load(&ctx.numProducers))
+            Thread::SwitchContext();
+
+        ctx.quit = true;
+        ctx.wakeSem.Post();
+        ctx.thread.Stop();
+        ctx.wakeSem.Release();
+
+        Mem::Free(ctx.buffer);
+        ctx.buffer = nullptr;
+        Atomic::Store(&ctx.threadId, 0);
+    }
+
+    bool IsAsync()
+    {
+        return Atomic::LoadExplicit(&gLog.async.enabled, AtomicMemoryOrder::Acquire) != 0;
+    }
+
+    void Flush()
+    {
+        LogAsyncContext& ctx = gLog.async;
+        if (IsAsync() && Thread::GetCurrentId() != Atomic::Load(&ctx.threadId)) {
+            uint64 target = Atomic::Load(&ctx.writeOffset);
+            if (Atomic::Exchange(&ctx.sleeping, 0))
+                ctx.wakeSem.Post();
+            while (Atomic::LoadExplicit(&ctx.readOffset, AtomicMemoryOrder::Acquire) < target)
+                Thread::SwitchContext();
+        }
+
+        if (gLog.binary.level != LogLevel::Default) {
+            MutexScope lock(gLog.binary.mutex);
+            _BinaryFlush(gLog.binary);
+        }
+    }
+
+    bool InitializeBinarySink(const char* filepath, LogLevel level, uint64 maxFileSize, uint32 maxFiles)
+    {
+        LogBinaryContext& ctx = gLog.binary;
+        ASSERT_MSG(!ctx.buffer, "Binary log sink is already initialized");
+        ASSERT(filepath && filepath[0]);
+        ASSERT(level != LogLevel::Default);
+
+        ctx.buffer = Mem::AllocTyped<uint8>(LOG_BINARY_BUFFER_SIZE);
+        if (!ctx.buffer)
+            return false;
+        ctx.bufferOffset = 0;
+        ctx.filepath = filepath;
+        ctx.maxFileSize = Max<uint64>(maxFileSize, LOG_BINARY_BUFFER_SIZE);
+        ctx.maxFiles = Max(maxFiles, 1u);
+        ctx.formats.SetAllocator(Mem::GetDefaultAlloc());
+        ctx.locations.SetAllocator(Mem::GetDefaultAlloc());
+        ctx.threads.SetAllocator(Mem::GetDefaultAlloc());
+        ctx.formatRanges.SetAllocator(Mem::GetDefaultAlloc());
+        ctx.formatChars.SetAllocator(Mem::GetDefaultAlloc());
+        ctx.locationKeys.SetAllocator(Mem::GetDefaultAlloc());
+        ctx.formats.Reserve(256);
+        ctx.locations.Reserve(256);
+        ctx.threads.Reserve(32);
+
+        if (!_BinaryOpenFile(ctx)) {
+            ctx.file.Close();
+            Mem::Free(ctx.buffer);
+            ctx.buffer = nullptr;
+            return false;
+        }
+
+        ctx.mutex.Initialize();
+        ctx.level = level;
+        _SetAssertFailCallback();
+        return true;
+    }
+
+    void ReleaseBinarySink()
+    {
+        LogBinaryContext& ctx = gLog.binary;
+        if (!ctx.buffer)
+            return;
+
+        ctx.level = LogLevel::Default;
+        _SetAssertFailCallback();
+
+        // Entries that are still in the async queue are written by the logger thread before we close the file
+        Flush();
+
+        ctx.mutex.Enter();
+        _BinaryFlush(ctx);
+        ctx.file.Close();
+        Mem::Free(ctx.buffer);
+        ctx.buffer = nullptr;
+        ctx.mutex.Exit();
+        ctx.mutex.Release();
+
+        ctx.formats.Free();
+        ctx.locations.Free();
+        ctx.threads.Free();
+        ctx.formatRanges.Free();
+        ctx.formatChars.Free();
+        ctx.locationKeys.Free();
     }
 
     void RegisterCallback(LogCallback callback, void* userData)
@@ -323,3 +1183,328 @@ namespace Log
             gLog.callbacks.RemoveAndSwap(index);
     }
 } // Log
+
+LogBenchmarkResult Log::RunBenchmark(uint32 numThreads, uint32 numCallsPerThread, bool withSinks)
+{
+    struct BenchmarkThreadData
+    {
+        uint32 threadIndex;
+        uint32 numCalls;
+        bool withSinks;
+    };
+
+    auto BenchmarkThreadFn = [](void* userData)->int {
+        const BenchmarkThreadData* data = reinterpret_cast<const BenchmarkThreadData*>(userData);
+        gLogBenchmarkThread = true;
+        gLogMuteSinks = !data->withSinks;
+        for (uint32 i = 0; i < data->numCalls; i++)
+            LOG_VERBOSE("Log benchmark: thread=%u call=%u value=%.3f", data->threadIndex, i, float(i)*0.5f);
+        return 0;
+    };
+
+    numThreads = Clamp(numThreads, 1u, LOG_BENCHMARK_MAX_THREADS);
+    Flush();
+
+    BenchmarkThreadData datas[LOG_BENCHMARK_MAX_THREADS];
+    Thread threads[LOG_BENCHMARK_MAX_THREADS];
+
+    TimerStopWatch stopwatch;
+    for (uint32 i = 0; i < numThreads; i++) {
+        datas[i] = { .threadIndex = i, .numCalls = numCallsPerThread, .withSinks = withSinks };
+        threads[i].Start(ThreadDesc { .entryFn = BenchmarkThreadFn, .userData = &datas[i], .name = "LogBenchmark" });
+    }
+
+    for (uint32 i = 0; i < numThreads; i++)
+        threads[i].Stop();
+    float producerMS = float(stopwatch.ElapsedMS());
+
+    Flush();
+    float totalMS = float(stopwatch.ElapsedMS());
+
+    uint32 numCalls = numThreads*numCallsPerThread;
+    return LogBenchmarkResult {
+        .numThreads = numThreads,
+        .numCalls = numCalls,
+        .producerMS = producerMS,
+        .totalMS = totalMS,
+        .callsPerSec = producerMS > 0 ? float(numCalls)*1000.0f/producerMS : 0
+    };
+}
+
+struct LogBinaryReader
+{
+    const uint8* data;
+    uint32 size;
+    uint32 offset;
+    bool failed;
+
+    template <typename _T> 
+    _T Read()
+    {
+        _T value {};
+        if (offset + sizeof(_T) <= size) {
+            memcpy(&value, data + offset, sizeof(_T));
+            offset += sizeof(_T);
+        }
+        else {
+            failed = true;
+        }
+        return value;
+    }
+
+    // Returns the offset of the null-terminated copy of the string in the pool
+    uint32 ReadString(Array<char>& pool)
+    {
+        uint16 len = Read<uint16>();
+        uint32 poolOffset = pool.Count();
+        if (offset + len <= size) {
+            pool.Extend(reinterpret_cast<const char*>(data + offset), len);
+            offset += len;
+        }
+        else {
+            failed = true;
+        }
+        pool.Push('\0');
+        return poolOffset;
+    }
+
+    bool IsEnd() const { return offset >= size; }
+};
+
+// Walks the format string, same as the encoder, and formats every argument individually
+// Length modifiers are normalized to 64bit, because that's how integers are stored in the file
+static void logDecodeMessage(Array<char>& out, const char* fmt, LogBinaryReader& args)
+{
+    char piece[LOG_MAX_MESSAGE_CHARS];
+    char specStr[64];
+    char str[LOG_BINARY_MAX_STRING_CHARS + 1];
+    uint32 offset = 0;
+    LogFormatSpec spec;
+
+    while (Log::_ParseFormatSpec(fmt, offset, &spec)) {
+        out.Extend(fmt + offset, spec.offset - offset);
+
+        if (spec.type == LogBinaryArgType::Invalid) {
+            offset = spec.offset;
+            break;
+        }
+        offset = spec.offset + spec.len;
+
+        if (spec.type == LogBinaryArgType::None) {
+            out.Push('%');
+            continue;
+        }
+
+        // Rebuild the spec with '*' replaced by the recorded values and without the original length modifier
+        uint32 specLen = 0;
+        specStr[specLen++] = '%';
+        for (uint32 i = spec.offset + 1; i < spec.lengthOffset && specLen < sizeof(specStr) - 16; i++) {
+            if (fmt[i] == '*') {
+                int64 star = args.Read<int64>();
+                specLen += Str::PrintFmt(specStr + specLen, sizeof(specStr) - specLen, "%d", int(star));
+            }
+            else {
+                specStr[specLen++] = fmt[i];
+            }
+        }
+        char conversion = fmt[spec.offset + spec.len - 1];
+        if ((spec.type == LogBinaryArgType::Int || spec.type == LogBinaryArgType::Uint) && conversion != 'c') {
+            specStr[specLen++] = 'l';
+            specStr[specLen++] = 'l';
+        }
+        specStr[specLen++] = conversion;
+        specStr[specLen] = '\0';
+
+        uint32 pieceLen = 0;
+        switch (spec.type) {
+        case LogBinaryArgType::Int: {
+            int64 value = args.Read<int64>();
+            if (!args.failed)
+                pieceLen = conversion == 'c' ? Str::PrintFmt(piece, sizeof(piece), specStr, int(value)) : Str::PrintFmt(piece, sizeof(piece), specStr, (long long)value);
+            break;
+        }
+        case LogBinaryArgType::Uint: {
+            uint64 value = args.Read<uint64>();
+            if (!args.failed)
+                pieceLen = Str::PrintFmt(piece, sizeof(piece), specStr, (unsigned long long)value);
+            break;
+        }
+        case LogBinaryArgType::Double: {
+            uint64 bits = args.Read<uint64>();
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            if (!args.failed)
+                pieceLen = Str::PrintFmt(piece, sizeof(piece), specStr, value);
+            break;
+        }
+        case LogBinaryArgType::Pointer: {
+            uint64 value = args.Read<uint64>();
+            if (!args.failed)
+                pieceLen = Str::PrintFmt(piece, sizeof(piece), specStr, reinterpret_cast<void*>(uintptr_t(value)));
+            break;
+        }
+        case LogBinaryArgType::String: {
+            uint16 len = args.Read<uint16>();
+            if (!args.failed && args.offset + len <= args.size) {
+                memcpy(str, args.data + args.offset, len);
+                str[len] = '\0';
+                args.offset += len;
+                pieceLen = Str::PrintFmt(piece, sizeof(piece), specStr, str);
+            }
+            else {
+                args.failed = true;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (args.failed) {
+            out.Extend("<?>", 3);
+            continue;
+        }
+        out.Extend(piece, Min(pieceLen, uint32(sizeof(piece) - 1)));
+    }
+
+    out.Extend(fmt + offset, Str::Len(fmt + offset));
+}
+
+bool Log::DecodeBinaryFile(const char* binaryFilepath, const char* textFilepath)
+{
+    File file;
+    if (!file.Open(binaryFilepath, FileOpenFlags::Read | FileOpenFlags::SeqScan)) {
+        LOG_ERROR("Log: Opening binary log file '%s' failed", binaryFilepath);
+        return false;
+    }
+
+    uint32 fileSize = uint32(file.GetSize());
+    uint8* data = Mem::AllocTyped<uint8>(Max(fileSize, 1u));
+    uint32 bytesRead = data ? uint32(file.Read(data, fileSize)) : 0;
+    file.Close();
+    if (!data || bytesRead != fileSize) {
+        LOG_ERROR("Log: Reading binary log file '%s' failed", binaryFilepath);
+        Mem::Free(data);
+        return false;
+    }
+
+    LogBinaryReader reader { .data = data, .size = fileSize };
+    LogBinaryFileHeader header = reader.Read<LogBinaryFileHeader>();
+    if (reader.failed || header.fileId != LOG_BINARY_FILE_ID || header.version != LOG_BINARY_FILE_VERSION) {
+        LOG_ERROR("Log: Invalid binary log file: %s", binaryFilepath);
+        Mem::Free(data);
+        return false;
+    }
+
+    struct LogBinaryLocation
+    {
+        uint32 fileOffset;      // In the string pool
+        uint32 line;
+    };
+
+    Array<char> pool;
+    Array<uint32> formats;                  // Id -> Offset in the string pool
+    Array<LogBinaryLocation> locations;     // Id -> Location
+    HashTable<uint32> threads;              // Thread Id -> Offset of the name in the string pool
+    Array<char> out;
+
+    char line[LOG_MAX_MESSAGE_CHARS];
+    time_t startTime = time_t(header.startTime);
+    char startTimeStr[64];
+    strftime(startTimeStr, sizeof(startTimeStr), "%Y-%m-%d %H:%M:%S", localtime(&startTime));
+    uint32 lineLen = Str::PrintFmt(line, sizeof(line), "# Log started at %s\n", startTimeStr);
+    out.Extend(line, lineLen);
+
+    uint32 numEntries = 0;
+    while (!reader.IsEnd() && !reader.failed) {
+        LogBinaryRecordType type = LogBinaryRecordType(reader.Read<uint8>());
+        switch (type) {
+        case LogBinaryRecordType::Format: {
+            uint32 id = reader.Read<uint32>();
+            uint32 poolOffset = reader.ReadString(pool);
+            if (id != formats.Count())
+                reader.failed = true;
+            formats.Push(poolOffset);
+            break;
+        }
+        case LogBinaryRecordType::Location: {
+            uint32 id = reader.Read<uint32>();
+            uint32 lineNum = reader.Read<uint32>();
+            uint32 poolOffset = reader.ReadString(pool);
+            if (id != locations.Count())
+                reader.failed = true;
+            locations.Push(LogBinaryLocation { .fileOffset = poolOffset, .line = lineNum });
+            break;
+        }
+        case LogBinaryRecordType::Thread: {
+            uint32 threadId = reader.Read<uint32>();
+            uint32 poolOffset = reader.ReadString(pool);
+            threads.AddReplaceUnique(threadId, poolOffset);
+            break;
+        }
+        case LogBinaryRecordType::Entry: {
+            uint64 timeUS = reader.Read<uint64>();
+            uint32 threadId = reader.Read<uint32>();
+            uint8 level = reader.Read<uint8>();
+            [[maybe_unused]] uint32 channels = reader.Read<uint32>();
+            uint32 locationId = reader.Read<uint32>();
+            uint32 formatId = reader.Read<uint32>();
+            uint16 argsSize = reader.Read<uint16>();
+            if (reader.failed || reader.offset + argsSize > reader.size || formatId >= formats.Count() || 
+                locationId >= locations.Count() || level >= uint32(LogLevel::_Count)) 
+            {
+                reader.failed = true;
+                break;
+            }
+
+            uint32 threadIndex = threads.Find(threadId);
+            const LogBinaryLocation& loc = locations[locationId];
+            lineLen = Str::PrintFmt(line, sizeof(line), "[+%.6f] [%s] %s%s(%u): ", 
+                                    double(timeUS)/1000000.0,
+                                    threadIndex != INVALID_INDEX ? &pool[threads.Get(threadIndex)] : "",
+                                    LOG_ENTRY_TYPES[level], &pool[loc.fileOffset], loc.line);
+            out.Extend(line, lineLen);
+
+            // Pool can grow while reading the next records, so the pointers are only valid here
+            LogBinaryReader args { .data = reader.data + reader.offset, .size = argsSize };
+            logDecodeMessage(out, &pool[formats[formatId]], args);
+            out.Push('\n');
+
+            reader.offset += argsSize;
+            numEntries++;
+            break;
+        }
+        default:
+            reader.failed = true;
+            break;
+        }
+    }
+
+    bool corrupt = reader.failed;
+    if (corrupt) {
+        lineLen = Str::PrintFmt(line, sizeof(line), "# Log file is truncated or corrupt at offset %u\n", reader.offset);
+        out.Extend(line, lineLen);
+    }
+    Mem::Free(data);
+
+    bool r = false;
+    if (file.Open(textFilepath, FileOpenFlags::Write)) {
+        r = file.Write(out.Ptr(), out.Count()) == out.Count();
+        file.Close();
+    }
+
+    pool.Free();
+    formats.Free();
+    locations.Free();
+    threads.Free();
+    out.Free();
+
+    if (!r) {
+        LOG_ERROR("Log: Writing to '%s' failed", textFilepath);
+        return false;
+    }
+
+    if (corrupt)
+        LOG_WARNING("Log: Binary log file '%s' is truncated or corrupt. Decoded %u entries", binaryFilepath, numEntries);
+    return true;
+}
@@ -27,12 +27,51 @@ struct LogEntry
 // NOTE: custom callbacks should take care of thread-safety for their data
 using LogCallback = void(*)(const LogEntry& entry, void* userData);
 
+struct LogBenchmarkResult
+{
+    uint32 numThreads;
+    uint32 numCalls;        // Total number of LOG calls made by all threads
+    float producerMS;       // Time it took for all threads to return from their LOG calls
+    float totalMS;          // Time it took until all the entries were written to sinks (same as producerMS in sync mode)
+    float callsPerSec;      // Based on producerMS, this is the throughput that the callers see
+};
+
+inline constexpr uint32 LOG_ASYNC_DEFAULT_BUFFER_SIZE = SIZE_MB;
+inline constexpr uint64 LOG_BINARY_DEFAULT_MAX_FILE_SIZE = 16*SIZE_MB;
+inline constexpr uint32 LOG_BINARY_DEFAULT_MAX_FILES = 4;
+
 namespace Log
 {
     API void RegisterCallback(LogCallback callback, void* userData);
     API void UnregisterCallback(LogCallback callback);
     API void SetSettings(LogLevel logLevel, bool breakOnErrors, bool treatWarningsAsErrors);
 
+    // Async mode: LOG calls only format the message and push it to a lock-free ring buffer
+    // A background thread decorates the entries and writes them to all the sinks (terminal, debugger, tracy, callbacks)
+    // Errors and failed asserts flush the buffer before returning, so nothing is lost before a break or a crash
+    // Note: In async mode, callbacks are called from the logger thread
+    API bool InitializeAsync(uint32 bufferSize = LOG_ASYNC_DEFAULT_BUFFER_SIZE);
+    API void ReleaseAsync();
+    API bool IsAsync();
+
+    // Binary file sink: Writes timestamp, thread, level, channels, source location and the raw format arguments of each entry
+    // Format strings, source locations and thread names are written only once per file and entries refer to them by id
+    // When the file reaches maxFileSize, it is rotated to 'filepath.1', 'filepath.2' ... and only the last maxFiles are kept
+    // Existing file from previous runs is also rotated on initialize. Use DecodeBinaryFile (or 'log-decode' command) to read them
+    // Note: `level` is independent of the text log level, so you can record verbose logs without printing them to terminal
+    API bool InitializeBinarySink(const char* filepath, LogLevel level = LogLevel::Verbose, 
+                                  uint64 maxFileSize = LOG_BINARY_DEFAULT_MAX_FILE_SIZE, uint32 maxFiles = LOG_BINARY_DEFAULT_MAX_FILES);
+    API void ReleaseBinarySink();
+    API bool DecodeBinaryFile(const char* binaryFilepath, const char* textFilepath);
+
+    // Blocks until every entry that is pushed before this call is written to sinks and the binary sink is written to disk
+    API void Flush();
+
+    // Makes `numCallsPerThread` LOG_VERBOSE calls from `numThreads` threads at the same time
+    // withSinks=false skips writing to sinks, so only the cost of the LOG calls themselves is measured. numThreads is capped to 32
+    // Note: Sinks are also skipped for other threads while this is running
+    API LogBenchmarkResult RunBenchmark(uint32 numThreads, uint32 numCallsPerThread, bool withSinks);
+
     namespace _private
     {
         API void PrintInfo(uint32 channels, const char* source_file, uint32 line, const char* fmt, ...);
@@ -1,5 +1,7 @@
 #include "Pools.h"
 
+#include "Atomic.h"
+
 DEFINE_HANDLE(HandleDummy);
 
 _private::HandlePoolTable* _private::handleCreatePoolTable(uint32 capacity, MemAllocator* alloc)
@@ -75,6 +77,45 @@ uint32 _private::handleNew(HandlePoolTable* tbl)
     return UINT32_MAX;
 }
 
+void _private::handleNewBatch(HandlePoolTable* tbl, uint32 numHandles, uint32* outHandles)
+{
+    ASSERT_MSG(tbl->count + numHandles <= tbl->capacity, "handle pool table is full");
+
+    uint32 startIndex = tbl->count;
+    uint32* dense = tbl->dense;
+    uint32* sparse = tbl->sparse;
+    for (uint32 i = 0; i < numHandles; i++) {
+        uint32 index = startIndex + i;
+        HandleDummy handle(dense[index]);
+        uint32 sparseIndex = handle.GetSparseIndex();
+        handle.Set(handle.GetGen() + 1, sparseIndex);
+
+        dense[index] = static_cast<uint32>(handle);
+        sparse[sparseIndex] = index;
+        outHandles[i] = static_cast<uint32>(handle);
+    }
+    tbl->count = startIndex + numHandles;
+}
+
+uint32 _private::handleNewConcurrent(HandlePoolTable* tbl)
+{
+    // Free handles are already sitting in the dense array after 'count', so claiming a slot is just bumping the count
+    // Each thread then exclusively owns its dense slot and the sparse entry of the handle that was stored there
+    uint32 index = Atomic::Load(&tbl->count);
+    do {
+        if (index >= tbl->capacity)
+            return 0;
+    } while (!Atomic::CompareExchange_Weak(&tbl->count, &index, index + 1));
+
+    HandleDummy handle(tbl->dense[index]);
+    uint32 sparseIndex = handle.GetSparseIndex();
+    handle.Set(handle.GetGen() + 1, sparseIndex);
+
+    tbl->dense[index] = static_cast<uint32>(handle);
+    tbl->sparse[sparseIndex] = index;
+    return static_cast<uint32>(handle);
+}
+
 void _private::handleDel(HandlePoolTable* tbl, uint32 handle)
 {
     ASSERT(tbl->count > 0);
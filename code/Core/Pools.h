@@ -35,6 +35,8 @@ namespace _private
     API HandlePoolTable* handleClone(HandlePoolTable* tbl, MemAllocator* alloc);
 
     API uint32 handleNew(HandlePoolTable* tbl);
+    API void   handleNewBatch(HandlePoolTable* tbl, uint32 numHandles, uint32* outHandles);
+    API uint32 handleNewConcurrent(HandlePoolTable* tbl);
     API void   handleDel(HandlePoolTable* tbl, uint32 handle);
     API void   handleResetPoolTable(HandlePoolTable* tbl);
     API bool   handleIsValid(const HandlePoolTable* tbl, uint32 handle);
@@ -123,6 +125,52 @@ private:
     Array<_DataType>  mItems;
 };
 
+// Same handle semantics as HandlePool, but data is kept densely packed in the same order as the handles (sparse-set)
+// So iterating or going through Items() is linear in memory, without the handle->sparse-index indirection
+// Remove moves the last item into the removed slot, so data pointers and indices are not stable after removals
+template <typename _HandleType, typename _DataType>
+struct DenseHandlePool
+{
+    DenseHandlePool() : DenseHandlePool(Mem::GetDefaultAlloc()) {}
+    explicit DenseHandlePool(MemAllocator* alloc) : mAlloc(alloc) {}
+
+    void SetAllocator(MemAllocator* alloc);
+    void Reserve(uint32 capacity);
+    void Free();
+
+    [[nodiscard]] _HandleType Add(const _DataType& item);
+    void AddBatch(const _DataType* items, uint32 numItems, _HandleType* outHandles);
+    void Remove(_HandleType handle);
+    void RemoveBatch(const _HandleType* handles, uint32 numHandles);
+
+    // Thread-safe only against other AddConcurrent calls, no Remove/Add/Iteration should happen in the meantime
+    // Doesn't grow the pool, so Reserve enough capacity beforehand. Returns invalid handle if the pool is full
+    [[nodiscard]] _HandleType AddConcurrent(const _DataType& item);
+
+    uint32 Count() const;
+    void Clear();
+    bool IsValid(_HandleType handle) const;
+    _HandleType HandleAt(uint32 index) const;
+    _DataType& Data(uint32 index);
+    _DataType& Data(_HandleType handle);
+    _DataType* Items();     // Dense items: [0..Count)
+    bool IsFull() const;
+    uint32 Capacity() const;
+
+    // _Func = [](const _DataType&)->bool
+    template <typename _Func> _HandleType FindIf(_Func findFunc);
+
+    _DataType* begin()  { return mItems; }
+    _DataType* end()    { return mItems + Count(); }
+
+private:
+    void GrowToFit(uint32 count);
+
+    MemAllocator* mAlloc = nullptr;
+    _private::HandlePoolTable* mHandles = nullptr;
+    _DataType* mItems = nullptr;
+};
+
 #endif  // !__OBJC__
 
 
@@ -401,6 +449,188 @@ inline bool HandlePool<_HandleType, _DataType>::Grow(void* data, size_t size)
     mItems.Reserve(mHandles->capacity << 1, (uint8*)data + handleTableSize, size - handleTableSize);
     return _private::handleGrowPoolTableWithBuffer(&mHandles, data, handleTableSize);
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// @impl DenseHandlePool
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::SetAllocator(MemAllocator* alloc)
+{
+    ASSERT_MSG(mHandles == nullptr, "pool should be freed/uninitialized before setting allocator");
+    mAlloc = alloc;
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::Reserve(uint32 capacity)
+{
+    ASSERT(mAlloc);
+    capacity = Max(capacity, 32u);
+    if (mHandles == nullptr) {
+        mHandles = _private::handleCreatePoolTable(capacity, mAlloc);
+        mItems = Mem::ReallocTyped<_DataType>(mItems, capacity, mAlloc);
+    }
+    else {
+        GrowToFit(capacity);
+    }
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::GrowToFit(uint32 count)
+{
+    ASSERT(mHandles);
+    if (count <= mHandles->capacity)
+        return;
+    ASSERT_MSG(mAlloc, "DenseHandlePool overflow, capacity=%u", mHandles->capacity);
+
+    while (mHandles->capacity < count)
+        _private::handleGrowPoolTable(&mHandles, mAlloc);
+    mItems = Mem::ReallocTyped<_DataType>(mItems, mHandles->capacity, mAlloc);
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::Free()
+{
+    if (mAlloc) {
+        if (mHandles)
+            _private::handleDestroyPoolTable(mHandles, mAlloc);
+        Mem::Free(mItems, mAlloc);
+    }
+    mHandles = nullptr;
+    mItems = nullptr;
+}
+
+template<typename _HandleType, typename _DataType>
+inline _HandleType DenseHandlePool<_HandleType, _DataType>::Add(const _DataType& item)
+{
+    if (mHandles == nullptr)
+        Reserve(32u);
+    else
+        GrowToFit(mHandles->count + 1);
+
+    _HandleType handle(_private::handleNew(mHandles));
+    mItems[mHandles->count - 1] = item;
+    return handle;
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::AddBatch(const _DataType* items, uint32 numItems, _HandleType* outHandles)
+{
+    static_assert(sizeof(_HandleType) == sizeof(uint32));
+    ASSERT(items);
+    ASSERT(outHandles);
+
+    if (mHandles == nullptr)
+        Reserve(numItems);
+    else
+        GrowToFit(mHandles->count + numItems);
+
+    // New handles always take the dense slots right after the current count, so items are copied in one go
+    uint32 startIndex = mHandles->count;
+    _private::handleNewBatch(mHandles, numItems, reinterpret_cast<uint32*>(outHandles));
+    memcpy(mItems + startIndex, items, sizeof(_DataType)*numItems);
+}
+
+template<typename _HandleType, typename _DataType>
+inline _HandleType DenseHandlePool<_HandleType, _DataType>::AddConcurrent(const _DataType& item)
+{
+    ASSERT_MSG(mHandles, "Pool must be reserved before using AddConcurrent");
+
+    _HandleType handle(_private::handleNewConcurrent(mHandles));
+    if (handle.IsValid())
+        mItems[mHandles->sparse[handle.GetSparseIndex()]] = item;
+    return handle;
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::Remove(_HandleType handle)
+{
+    ASSERT(mHandles);
+    uint32 index = mHandles->sparse[handle.GetSparseIndex()];
+    uint32 lastIndex = mHandles->count - 1;
+    _private::handleDel(mHandles, static_cast<uint32>(handle));
+    if (index != lastIndex)
+        mItems[index] = mItems[lastIndex];
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::RemoveBatch(const _HandleType* handles, uint32 numHandles)
+{
+    ASSERT(mHandles);
+    for (uint32 i = 0; i < numHandles; i++)
+        Remove(handles[i]);
+}
+
+template<typename _HandleType, typename _DataType>
+inline uint32 DenseHandlePool<_HandleType, _DataType>::Count() const
+{
+    return mHandles ? mHandles->count : 0;
+}
+
+template<typename _HandleType, typename _DataType>
+inline void DenseHandlePool<_HandleType, _DataType>::Clear()
+{
+    if (mHandles)
+        _private::handleResetPoolTable(mHandles);
+}
+
+template<typename _HandleType, typename _DataType>
+inline bool DenseHandlePool<_HandleType, _DataType>::IsValid(_HandleType handle) const
+{
+    ASSERT(mHandles);
+    return _private::handleIsValid(mHandles, static_cast<uint32>(handle));
+}
+
+template<typename _HandleType, typename _DataType>
+inline _HandleType DenseHandlePool<_HandleType, _DataType>::HandleAt(uint32 index) const
+{
+    ASSERT(mHandles);
+    return _HandleType(_private::handleAt(mHandles, index));
+}
+
+template<typename _HandleType, typename _DataType>
+inline _DataType& DenseHandlePool<_HandleType, _DataType>::Data(uint32 index)
+{
+    ASSERT(mHandles);
+    ASSERT(index < mHandles->count);
+    return mItems[index];
+}
+
+template<typename _HandleType, typename _DataType>
+inline _DataType& DenseHandlePool<_HandleType, _DataType>::Data(_HandleType handle)
+{
+    ASSERT(mHandles);
+    ASSERT_MSG(IsValid(handle), "Invalid handle (%u): Generation=%u, SparseIndex=%u", 
+               uint32(handle), handle.GetGen(), handle.GetSparseIndex());
+    return mItems[mHandles->sparse[handle.GetSparseIndex()]];
+}
+
+template<typename _HandleType, typename _DataType>
+inline _DataType* DenseHandlePool<_HandleType, _DataType>::Items()
+{
+    return mItems;
+}
+
+template<typename _HandleType, typename _DataType>
+inline bool DenseHandlePool<_HandleType, _DataType>::IsFull() const
+{
+    return mHandles && mHandles->count == mHandles->capacity;
+}
+
+template<typename _HandleType, typename _DataType>
+inline uint32 DenseHandlePool<_HandleType, _DataType>::Capacity() const
+{
+    return mHandles ? mHandles->capacity : 32u;
+}
+
+template<typename _HandleType, typename _DataType>
+template<typename _Func> inline _HandleType DenseHandlePool<_HandleType, _DataType>::FindIf(_Func findFunc)
+{
+    for (uint32 i = 0, c = Count(); i < c; i++) {
+        if (findFunc(mItems[i]))
+            return _HandleType(_private::handleAt(mHandles, i));
+    }
+    
+    return _HandleType();
+}
 #endif // !__OBJC__
 
 //----------------------------------------------------------------------------------------------------------------------
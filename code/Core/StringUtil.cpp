@@ -8,6 +8,15 @@
 #include <strings.h>
 #endif
 
+#if COMPILER_MSVC
+#include <intrin.h>     // _BitScanForward
+#endif
+#if CPU_X86 && !COMPILER_MSVC
+#include <immintrin.h>
+#elif CPU_ARM && ARCH_64BIT
+#include <arm_neon.h>
+#endif
+
 #define STB_SPRINTF_IMPLEMENTATION
 PRAGMA_DIAGNOSTIC_PUSH()
 PRAGMA_DIAGNOSTIC_IGNORED_CLANG_GCC("-Wunused-function")
@@ -26,6 +35,9 @@ PRAGMA_DIAGNOSTIC_POP();
 #endif
 
 #include "Arrays.h"
+#include "Atomic.h"
+#include "System.h"
+#include "Log.h"
 
 namespace Str
 {
@@ -89,6 +101,641 @@ namespace Str
     }
 } // Str
 
+//----------------------------------------------------------------------------------------------------------------------
+// SIMD kernels
+// Len and FindChar don't know the length in advance, so they use aligned loads and may read past the terminator. 
+// Aligned loads never cross a page boundary, so this is safe (but it's invisible to ASAN, hence NO_ASAN)
+// The rest only read within the known length of the strings
+#if CPU_X86 && (defined(__SSE2__) || (COMPILER_MSVC && (ARCH_64BIT || _M_IX86_FP >= 2)))
+    #define STR_SIMD_SSE2 1
+    #if COMPILER_CLANG || COMPILER_GCC
+        #define STR_AVX2_FUNC __attribute__((target("avx2")))
+    #else
+        #define STR_AVX2_FUNC
+    #endif
+#else
+    #define STR_SIMD_SSE2 0
+#endif
+
+#if CPU_ARM && ARCH_64BIT
+    #define STR_SIMD_NEON 1
+#else
+    #define STR_SIMD_NEON 0
+#endif
+
+struct StrSimdKernels
+{
+    uint32 (*len)(const char* str);
+    const char* (*findChar)(const char* str, char ch);
+    const char* (*findCharRev)(const char* str, uint32 len, char ch);
+    const char* (*findStr)(const char* str, uint32 len, const char* find, uint32 findLen);
+    bool (*isEqualNoCase)(const char* a, const char* b, uint32 len);
+};
+
+namespace Str
+{
+    FORCE_INLINE uint32 _BitScanFwd(uint32 mask)
+    {
+        ASSERT(mask);
+        #if COMPILER_MSVC
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return uint32(index);
+        #else
+            return uint32(__builtin_ctz(mask));
+        #endif
+    }
+
+    FORCE_INLINE uint32 _BitScanRev(uint32 mask)
+    {
+        ASSERT(mask);
+        #if COMPILER_MSVC
+            unsigned long index;
+            _BitScanReverse(&index, mask);
+            return uint32(index);
+        #else
+            return 31u - uint32(__builtin_clz(mask));
+        #endif
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // Scalar (reference)
+    // https://github.com/lattera/glibc/blob/master/string/strlen.c
+    NO_ASAN static uint32 _LenScalar(const char* str)
+    {
+        const char* char_ptr;
+        const uintptr* longWordPtr;
+        uintptr longword, himagic, lomagic;
+
+        for (char_ptr = str; ((uintptr)char_ptr & (sizeof(longword) - 1)) != 0; ++char_ptr) {
+            if (*char_ptr == '\0')
+                return (uint32)(intptr_t)(char_ptr - str);
+        }
+        longWordPtr = (uintptr*)char_ptr;
+        himagic = 0x80808080L;
+        lomagic = 0x01010101L;
+        #if ARCH_64BIT
+        /* 64-bit version of the magic.  */
+        /* Do the shift in two steps to avoid a warning if long has 32 bits.  */
+        himagic = ((himagic << 16) << 16) | himagic;
+        lomagic = ((lomagic << 16) << 16) | lomagic;
+        #endif
+
+        for (;;) {
+            longword = *longWordPtr++;
+
+            if (((longword - lomagic) & ~longword & himagic) != 0) {
+                const char* cp = (const char*)(longWordPtr - 1);
+
+                if (cp[0] == 0)
+                    return (uint32)(intptr_t)(cp - str);
+                if (cp[1] == 0)
+                    return (uint32)(intptr_t)(cp - str + 1);
+                if (cp[2] == 0)
+                    return (uint32)(intptr_t)(cp - str + 2);
+                if (cp[3] == 0)
+                    return (uint32)(intptr_t)(cp - str + 3);
+                #if ARCH_64BIT
+                if (cp[4] == 0)
+                    return (uint32)(intptr_t)(cp - str + 4);
+                if (cp[5] == 0)
+                    return (uint32)(intptr_t)(cp - str + 5);
+                if (cp[6] == 0)
+                    return (uint32)(intptr_t)(cp - str + 6);
+                if (cp[7] == 0)
+                    return (uint32)(intptr_t)(cp - str + 7);
+                #endif // ARCH_64BIT
+            }
+        }
+
+        #if !COMPILER_MSVC
+            ASSERT_MSG(0, "Not a null-terminated string");
+            return 0;
+        #endif
+    }
+
+    // https://github.com/lattera/glibc/blob/master/string/strchr.c
+    NO_ASAN static const char* _FindCharScalar(const char* str, char ch)
+    {
+        const uint8* charPtr;
+        uintptr* longwordPtr;
+        uintptr longword, magicBits, charmask;
+        uint8 c = (uint8)ch;
+
+        // Handle the first few characters by reading one character at a time.
+        // Do this until CHAR_PTR is aligned on a longword boundary.
+        for (charPtr = (const uint8*)str;
+             ((uintptr)charPtr & (sizeof(longword) - 1)) != 0; ++charPtr) {
+            if (*charPtr == c)
+                return (const char*)charPtr;
+            else if (*charPtr == '\0')
+                return nullptr;
+        }
+
+        longwordPtr = (uintptr*)charPtr;
+        magicBits = (uintptr)-1;
+        magicBits = magicBits / 0xff * 0xfe << 1 >> 1 | 1;
+        charmask = c | (c << 8);
+        charmask |= charmask << 16;
+        #if ARCH_64BIT
+            charmask |= (charmask << 16) << 16;
+        #endif
+
+        for (;;) {
+            longword = *longwordPtr++;
+
+            if ((((longword + magicBits) ^ ~longword) & ~magicBits) != 0 ||
+                ((((longword ^ charmask) + magicBits) ^ ~(longword ^ charmask)) &
+                 ~magicBits) != 0) {
+                const uint8* cp = (const uint8*)(longwordPtr - 1);
+
+                if (*cp == c)
+                    return (const char*)cp;
+                else if (*cp == '\0')
+                    break;
+                if (*++cp == c)
+                    return (const char*)cp;
+                else if (*cp == '\0')
+                    break;
+                if (*++cp == c)
+                    return (const char*)cp;
+                else if (*cp == '\0')
+                    break;
+                if (*++cp == c)
+                    return (const char*)cp;
+                else if (*cp == '\0')
+                    break;
+                #if ARCH_64BIT
+                    if (*++cp == c)
+                        return (const char*)cp;
+                    else if (*cp == '\0')
+                        break;
+                    if (*++cp == c)
+                        return (const char*)cp;
+                    else if (*cp == '\0')
+                        break;
+                    if (*++cp == c)
+                        return (const char*)cp;
+                    else if (*cp == '\0')
+                        break;
+                    if (*++cp == c)
+                        return (const char*)cp;
+                    else if (*cp == '\0')
+                        break;
+                #endif
+            }
+        }
+
+        return nullptr;
+    }
+
+    static const char* _FindCharRevScalar(const char* str, uint32 len, char ch)
+    {
+        if (ch == '\0')
+            return str + len;
+
+        for (uint32 i = len; i-- > 0;) {
+            if (str[i] == ch)
+                return str + i;
+        }
+        return nullptr;
+    }
+
+    // Empty 'find' returns the end of the string
+    static const char* _FindStrScalar(const char* str, uint32 len, const char* find, uint32 findLen)
+    {
+        if (findLen == 0)
+            return str + len;
+
+        for (uint32 i = 0; i + findLen <= len; i++) {
+            if (str[i] == find[0] && memcmp(str + i, find, findLen) == 0)
+                return str + i;
+        }
+        return nullptr;
+    }
+
+    static bool _IsEqualNoCaseScalar(const char* a, const char* b, uint32 len)
+    {
+        for (uint32 i = 0; i < len; i++) {
+            if (Str::ToLower(a[i]) != Str::ToLower(b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    #if STR_SIMD_SSE2
+    //------------------------------------------------------------------------------------------------------------------
+    // SSE2
+    NO_ASAN static uint32 _LenSSE2(const char* str)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        uint32 offset = uint32(uintptr(str) & 15);
+        const char* p = str - offset;
+
+        uint32 mask = uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero))) >> offset;
+        if (mask)
+            return _BitScanFwd(mask);
+
+        for (;;) {
+            p += 16;
+            mask = uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero)));
+            if (mask)
+                return uint32(p - str) + _BitScanFwd(mask);
+        }
+    }
+
+    NO_ASAN static const char* _FindCharSSE2(const char* str, char ch)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i chv = _mm_set1_epi8(ch);
+        uint32 offset = uint32(uintptr(str) & 15);
+        const char* p = str - offset;
+
+        // Stops at the first match or the terminator, whichever comes first
+        __m128i v = _mm_load_si128((const __m128i*)p);
+        uint32 mask = uint32(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, chv)))) >> offset;
+        const char* found;
+        if (mask) {
+            found = str + _BitScanFwd(mask);
+        }
+        else {
+            do {
+                p += 16;
+                v = _mm_load_si128((const __m128i*)p);
+                mask = uint32(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, chv))));
+            } while (!mask);
+            found = p + _BitScanFwd(mask);
+        }
+
+        return *found == ch ? found : nullptr;
+    }
+
+    static const char* _FindCharRevSSE2(const char* str, uint32 len, char ch)
+    {
+        if (ch == '\0')
+            return str + len;
+
+        const __m128i chv = _mm_set1_epi8(ch);
+        uint32 i = len;
+        while (i >= 16) {
+            i -= 16;
+            uint32 mask = uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + i)), chv)));
+            if (mask)
+                return str + i + _BitScanRev(mask);
+        }
+        return _FindCharRevScalar(str, i, ch);
+    }
+
+    // Candidates are the positions that match both the first and the last character of 'find', then they are verified
+    // http://0x80.pl/articles/simd-strfind.html
+    static const char* _FindStrSSE2(const char* str, uint32 len, const char* find, uint32 findLen)
+    {
+        if (findLen == 0 || findLen > len)
+            return _FindStrScalar(str, len, find, findLen);
+
+        const __m128i first = _mm_set1_epi8(find[0]);
+        const __m128i last = _mm_set1_epi8(find[findLen - 1]);
+        uint32 i = 0;
+        for (; i + findLen + 15 <= len; i += 16) {
+            __m128i blockFirst = _mm_loadu_si128((const __m128i*)(str + i));
+            __m128i blockLast = _mm_loadu_si128((const __m128i*)(str + i + findLen - 1));
+            uint32 mask = uint32(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+            while (mask) {
+                uint32 index = i + _BitScanFwd(mask);
+                if (memcmp(str + index + 1, find + 1, findLen - 1) == 0)
+                    return str + index;
+                mask &= mask - 1;
+            }
+        }
+        return _FindStrScalar(str + i, len - i, find, findLen);
+    }
+
+    // 'A'..'Z' are moved to the bottom of the signed range, so a single signed compare finds them
+    FORCE_INLINE __m128i _ToLowerSSE2(__m128i v)
+    {
+        __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(char(0x80 - 'A')));
+        __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(char(0x80 + 26)));
+        return _mm_add_epi8(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+    }
+
+    static bool _IsEqualNoCaseSSE2(const char* a, const char* b, uint32 len)
+    {
+        uint32 i = 0;
+        for (; i + 16 <= len; i += 16) {
+            __m128i va = _ToLowerSSE2(_mm_loadu_si128((const __m128i*)(a + i)));
+            __m128i vb = _ToLowerSSE2(_mm_loadu_si128((const __m128i*)(b + i)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xffff)
+                return false;
+        }
+        return _IsEqualNoCaseScalar(a + i, b + i, len - i);
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // AVX2: Same as SSE2 with 32 byte blocks. Only selected if the CPU supports it (see SelectSimdKernels)
+    // Tails are passed on to the SSE2 versions. The compiler emits vzeroupper on the way out of AVX code by itself
+    NO_ASAN STR_AVX2_FUNC static uint32 _LenAVX2(const char* str)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        uint32 offset = uint32(uintptr(str) & 31);
+        const char* p = str - offset;
+
+        uint32 mask = uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), zero))) >> offset;
+        if (mask)
+            return _BitScanFwd(mask);
+
+        for (;;) {
+            p += 32;
+            mask = uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), zero)));
+            if (mask)
+                return uint32(p - str) + _BitScanFwd(mask);
+        }
+    }
+
+    NO_ASAN STR_AVX2_FUNC static const char* _FindCharAVX2(const char* str, char ch)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i chv = _mm256_set1_epi8(ch);
+        uint32 offset = uint32(uintptr(str) & 31);
+        const char* p = str - offset;
+
+        __m256i v = _mm256_load_si256((const __m256i*)p);
+        uint32 mask = uint32(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, zero), _mm256_cmpeq_epi8(v, chv)))) >> offset;
+        const char* found;
+        if (mask) {
+            found = str + _BitScanFwd(mask);
+        }
+        else {
+            do {
+                p += 32;
+                v = _mm256_load_si256((const __m256i*)p);
+                mask = uint32(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, zero), _mm256_cmpeq_epi8(v, chv))));
+            } while (!mask);
+            found = p + _BitScanFwd(mask);
+        }
+
+        return *found == ch ? found : nullptr;
+    }
+
+    STR_AVX2_FUNC static const char* _FindCharRevAVX2(const char* str, uint32 len, char ch)
+    {
+        if (ch == '\0')
+            return str + len;
+
+        const __m256i chv = _mm256_set1_epi8(ch);
+        uint32 i = len;
+        while (i >= 32) {
+            i -= 32;
+            uint32 mask = uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + i)), chv)));
+            if (mask)
+                return str + i + _BitScanRev(mask);
+        }
+        return _FindCharRevSSE2(str, i, ch);
+    }
+
+    STR_AVX2_FUNC static const char* _FindStrAVX2(const char* str, uint32 len, const char* find, uint32 findLen)
+    {
+        if (findLen == 0 || findLen > len)
+            return _FindStrScalar(str, len, find, findLen);
+
+        const __m256i first = _mm256_set1_epi8(find[0]);
+        const __m256i last = _mm256_set1_epi8(find[findLen - 1]);
+        uint32 i = 0;
+        for (; i + findLen + 31 <= len; i += 32) {
+            __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(str + i));
+            __m256i blockLast = _mm256_loadu_si256((const __m256i*)(str + i + findLen - 1));
+            uint32 mask = uint32(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+            while (mask) {
+                uint32 index = i + _BitScanFwd(mask);
+                if (memcmp(str + index + 1, find + 1, findLen - 1) == 0)
+                    return str + index;
+                mask &= mask - 1;
+            }
+        }
+        return _FindStrSSE2(str + i, len - i, find, findLen);
+    }
+
+    STR_AVX2_FUNC FORCE_INLINE __m256i _ToLowerAVX2(__m256i v)
+    {
+        __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(char(0x80 - 'A')));
+        __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(char(0x80 + 26)), shifted);
+        return _mm256_add_epi8(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+    }
+
+    STR_AVX2_FUNC static bool _IsEqualNoCaseAVX2(const char* a, const char* b, uint32 len)
+    {
+        uint32 i = 0;
+        for (; i + 32 <= len; i += 32) {
+            __m256i va = _ToLowerAVX2(_mm256_loadu_si256((const __m256i*)(a + i)));
+            __m256i vb = _ToLowerAVX2(_mm256_loadu_si256((const __m256i*)(b + i)));
+            if (uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xffffffff)
+                return false;
+        }
+        return _IsEqualNoCaseSSE2(a + i, b + i, len - i);
+    }
+    #endif // STR_SIMD_SSE2
+
+    #if STR_SIMD_NEON
+    //------------------------------------------------------------------------------------------------------------------
+    // Neon: There is no movemask, so compare results are narrowed to 4 bits per byte instead
+    // https://community.arm.com/arm-community-blogs/b/infrastructure-solutions-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
+    FORCE_INLINE uint64 _MaskNeon(uint8x16_t cmp)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+    }
+
+    FORCE_INLINE uint32 _MaskFwdNeon(uint64 mask)
+    {
+        #if COMPILER_MSVC
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return uint32(index) >> 2;
+        #else
+            return uint32(__builtin_ctzll(mask)) >> 2;
+        #endif
+    }
+
+    FORCE_INLINE uint32 _MaskRevNeon(uint64 mask)
+    {
+        #if COMPILER_MSVC
+            unsigned long index;
+            _BitScanReverse64(&index, mask);
+            return uint32(index) >> 2;
+        #else
+            return (63u - uint32(__builtin_clzll(mask))) >> 2;
+        #endif
+    }
+
+    NO_ASAN static uint32 _LenNeon(const char* str)
+    {
+        uint32 offset = uint32(uintptr(str) & 15);
+        const char* p = str - offset;
+
+        uint64 mask = _MaskNeon(vceqzq_u8(vld1q_u8((const uint8*)p))) >> (offset*4);
+        if (mask)
+            return _MaskFwdNeon(mask);
+
+        for (;;) {
+            p += 16;
+            mask = _MaskNeon(vceqzq_u8(vld1q_u8((const uint8*)p)));
+            if (mask)
+                return uint32(p - str) + _MaskFwdNeon(mask);
+        }
+    }
+
+    NO_ASAN static const char* _FindCharNeon(const char* str, char ch)
+    {
+        const uint8x16_t chv = vdupq_n_u8(uint8(ch));
+        uint32 offset = uint32(uintptr(str) & 15);
+        const char* p = str - offset;
+
+        uint8x16_t v = vld1q_u8((const uint8*)p);
+        uint64 mask = _MaskNeon(vorrq_u8(vceqzq_u8(v), vceqq_u8(v, chv))) >> (offset*4);
+        const char* found;
+        if (mask) {
+            found = str + _MaskFwdNeon(mask);
+        }
+        else {
+            do {
+                p += 16;
+                v = vld1q_u8((const uint8*)p);
+                mask = _MaskNeon(vorrq_u8(vceqzq_u8(v), vceqq_u8(v, chv)));
+            } while (!mask);
+            found = p + _MaskFwdNeon(mask);
+        }
+
+        return *found == ch ? found : nullptr;
+    }
+
+    static const char* _FindCharRevNeon(const char* str, uint32 len, char ch)
+    {
+        if (ch == '\0')
+            return str + len;
+
+        const uint8x16_t chv = vdupq_n_u8(uint8(ch));
+        uint32 i = len;
+        while (i >= 16) {
+            i -= 16;
+            uint64 mask = _MaskNeon(vceqq_u8(vld1q_u8((const uint8*)(str + i)), chv));
+            if (mask)
+                return str + i + _MaskRevNeon(mask);
+        }
+        return _FindCharRevScalar(str, i, ch);
+    }
+
+    static const char* _FindStrNeon(const char* str, uint32 len, const char* find, uint32 findLen)
+    {
+        if (findLen == 0 || findLen > len)
+            return _FindStrScalar(str, len, find, findLen);
+
+        const uint8x16_t first = vdupq_n_u8(uint8(find[0]));
+        const uint8x16_t last = vdupq_n_u8(uint8(find[findLen - 1]));
+        uint32 i = 0;
+        for (; i + findLen + 15 <= len; i += 16) {
+            uint8x16_t blockFirst = vld1q_u8((const uint8*)(str + i));
+            uint8x16_t blockLast = vld1q_u8((const uint8*)(str + i + findLen - 1));
+            uint64 mask = _MaskNeon(vandq_u8(vceqq_u8(blockFirst, first), vceqq_u8(blockLast, last)));
+            while (mask) {
+                uint32 index = i + _MaskFwdNeon(mask);
+                if (memcmp(str + index + 1, find + 1, findLen - 1) == 0)
+                    return str + index;
+                mask &= ~(uint64(0xf) << ((index - i)*4));
+            }
+        }
+        return _FindStrScalar(str + i, len - i, find, findLen);
+    }
+
+    FORCE_INLINE uint8x16_t _ToLowerNeon(uint8x16_t v)
+    {
+        uint8x16_t isUpper = vcleq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8('Z' - 'A'));
+        return vaddq_u8(v, vandq_u8(isUpper, vdupq_n_u8(0x20)));
+    }
+
+    static bool _IsEqualNoCaseNeon(const char* a, const char* b, uint32 len)
+    {
+        uint32 i = 0;
+        for (; i + 16 <= len; i += 16) {
+            uint8x16_t va = _ToLowerNeon(vld1q_u8((const uint8*)(a + i)));
+            uint8x16_t vb = _ToLowerNeon(vld1q_u8((const uint8*)(b + i)));
+            if (vminvq_u8(vceqq_u8(va, vb)) != 0xff)
+                return false;
+        }
+        return _IsEqualNoCaseScalar(a + i, b + i, len - i);
+    }
+    #endif // STR_SIMD_NEON
+} // Str
+
+static constexpr StrSimdKernels STR_SIMD_KERNELS_SCALAR = {
+    Str::_LenScalar, Str::_FindCharScalar, Str::_FindCharRevScalar, Str::_FindStrScalar, Str::_IsEqualNoCaseScalar
+};
+
+#if STR_SIMD_SSE2
+static constexpr StrSimdKernels STR_SIMD_KERNELS_SSE2 = {
+    Str::_LenSSE2, Str::_FindCharSSE2, Str::_FindCharRevSSE2, Str::_FindStrSSE2, Str::_IsEqualNoCaseSSE2
+};
+static constexpr StrSimdKernels STR_SIMD_KERNELS_AVX2 = {
+    Str::_LenAVX2, Str::_FindCharAVX2, Str::_FindCharRevAVX2, Str::_FindStrAVX2, Str::_IsEqualNoCaseAVX2
+};
+#endif
+
+#if STR_SIMD_NEON
+static constexpr StrSimdKernels STR_SIMD_KERNELS_NEON = {
+    Str::_LenNeon, Str::_FindCharNeon, Str::_FindCharRevNeon, Str::_FindStrNeon, Str::_IsEqualNoCaseNeon
+};
+#endif
+
+// Null entries are not compiled in
+static constexpr const StrSimdKernels* STR_SIMD_KERNELS[uint32(StrSimdLevel::_Count)] = {
+    &STR_SIMD_KERNELS_SCALAR,
+    #if STR_SIMD_SSE2
+    &STR_SIMD_KERNELS_SSE2,
+    &STR_SIMD_KERNELS_AVX2,
+    #else
+    nullptr,
+    nullptr,
+    #endif
+    #if STR_SIMD_NEON
+    &STR_SIMD_KERNELS_NEON
+    #else
+    nullptr
+    #endif
+};
+
+static constexpr const char* STR_SIMD_LEVEL_NAMES[uint32(StrSimdLevel::_Count)] = {
+    "Scalar",
+    "SSE2",
+    "AVX2",
+    "Neon"
+};
+
+#if STR_SIMD_SSE2
+    static constexpr StrSimdLevel STR_SIMD_BASELINE = StrSimdLevel::SSE2;
+#elif STR_SIMD_NEON
+    static constexpr StrSimdLevel STR_SIMD_BASELINE = StrSimdLevel::Neon;
+#else
+    static constexpr StrSimdLevel STR_SIMD_BASELINE = StrSimdLevel::Scalar;
+#endif
+
+struct StrSimdContext
+{
+    AtomicUint32 level = uint32(STR_SIMD_BASELINE);
+    bool hasAVX2;
+};
+
+static StrSimdContext gStrSimd;
+
+namespace Str
+{
+    FORCE_INLINE const StrSimdKernels& _GetSimdKernels()
+    {
+        return *STR_SIMD_KERNELS[Atomic::LoadExplicit(&gStrSimd.level, AtomicMemoryOrder::Relaxed)];
+    }
+
+    static bool _IsSimdLevelAvailable(StrSimdLevel level)
+    {
+        return STR_SIMD_KERNELS[uint32(level)] && (level != StrSimdLevel::AVX2 || gStrSimd.hasAVX2);
+    }
+} // Str
+
 
 uint32 Str::PrintFmt(char* str, uint32 size, const char* fmt, ...)
 {
@@ -180,58 +827,9 @@ char* Str::Copy(char* RESTRICT dst, uint32 dstSize, const char* RESTRICT src)
     return &dst[num];
 }
 
-// https://github.com/lattera/glibc/blob/master/string/strlen.c
 uint32 Str::Len(const char* str)
 {
-    const char* char_ptr;
-    const uintptr* longWordPtr;
-    uintptr longword, himagic, lomagic;
-
-    for (char_ptr = str; ((uintptr)char_ptr & (sizeof(longword) - 1)) != 0; ++char_ptr) {
-        if (*char_ptr == '\0')
-            return (uint32)(intptr_t)(char_ptr - str);
-    }
-    longWordPtr = (uintptr*)char_ptr;
-    himagic = 0x80808080L;
-    lomagic = 0x01010101L;
-    #if ARCH_64BIT
-    /* 64-bit version of the magic.  */
-    /* Do the shift in two steps to avoid a warning if long has 32 bits.  */
-    himagic = ((himagic << 16) << 16) | himagic;
-    lomagic = ((lomagic << 16) << 16) | lomagic;
-    #endif
-
-    for (;;) {
-        longword = *longWordPtr++;
-
-        if (((longword - lomagic) & ~longword & himagic) != 0) {
-            const char* cp = (const char*)(longWordPtr - 1);
-
-            if (cp[0] == 0)
-                return (uint32)(intptr_t)(cp - str);
-            if (cp[1] == 0)
-                return (uint32)(intptr_t)(cp - str + 1);
-            if (cp[2] == 0)
-                return (uint32)(intptr_t)(cp - str + 2);
-            if (cp[3] == 0)
-                return (uint32)(intptr_t)(cp - str + 3);
-            #if ARCH_64BIT
-            if (cp[4] == 0)
-                return (uint32)(intptr_t)(cp - str + 4);
-            if (cp[5] == 0)
-                return (uint32)(intptr_t)(cp - str + 5);
-            if (cp[6] == 0)
-                return (uint32)(intptr_t)(cp - str + 6);
-            if (cp[7] == 0)
-                return (uint32)(intptr_t)(cp - str + 7);
-            #endif // ARCH_64BIT
-        }
-    }
-
-    #if !COMPILER_MSVC
-        ASSERT_MSG(0, "Not a null-terminated string");
-        return 0;
-    #endif
+    return _GetSimdKernels().len(str);
 }
 
 char* Str::CopyCount(char* RESTRICT dst, uint32 dstSize, const char* RESTRICT src, uint32 count)
@@ -274,25 +872,18 @@ bool Str::IsEqual(const char* s1, const char* s2)
     if (alen != blen)
         return false;
 
-    for (uint32 i = 0; i < alen; i++) {
-        if (s1[i] != s2[i])
-            return false;
-    }
-    return true;
+    return memcmp(s1, s2, alen) == 0;
 }
 
 bool Str::IsEqualNoCase(const char* s1, const char* s2)
 {
-    uint32 alen = Str::Len(s1);
-    uint32 blen = Str::Len(s2);
+    const StrSimdKernels& kernels = _GetSimdKernels();
+    uint32 alen = kernels.len(s1);
+    uint32 blen = kernels.len(s2);
     if (alen != blen)
         return false;
 
-    for (uint32 i = 0; i < alen; i++) {
-        if (Str::ToLower(s1[i]) != Str::ToLower(s2[i]))
-            return false;
-    }
-    return true;    
+    return kernels.isEqualNoCase(s1, s2, alen);
 }
 
 bool Str::IsEqualCount(const char* a, const char* b, uint32 count)
@@ -304,27 +895,20 @@ bool Str::IsEqualCount(const char* a, const char* b, uint32 count)
     if (alen != blen)
         return false;
 
-    for (uint32 i = 0; i < alen; i++) {
-        if (a[i] != b[i])
-            return false;
-    }
-    return true;
+    return memcmp(a, b, alen) == 0;
 }
 
 bool Str::IsEqualNoCaseCount(const char* a, const char* b, uint32 count)
 {
-    uint32 _alen = Str::Len(a);
-    uint32 _blen = Str::Len(b);
+    const StrSimdKernels& kernels = _GetSimdKernels();
+    uint32 _alen = kernels.len(a);
+    uint32 _blen = kernels.len(b);
     uint32 alen = Min(count, _alen);
     uint32 blen = Min(count, _blen);
     if (alen != blen)
         return false;
 
-    for (uint32 i = 0; i < alen; i++) {
-        if (Str::ToLower(a[i]) != Str::ToLower(b[i]))
-            return false;
-    }
-    return true;
+    return kernels.isEqualNoCase(a, b, alen);
 }
 
 int Str::Compare(const char* a, const char* b)
@@ -521,119 +1105,24 @@ char* Str::RemoveChar(char* dst, uint32 dstSize, const char* src, char ch)
     return dst;
 }
 
-// https://github.com/lattera/glibc/blob/master/string/strchr.c
 const char* Str::FindChar(const char* str, char ch)
 {
-    const uint8* charPtr;
-    uintptr* longwordPtr;
-    uintptr longword, magicBits, charmask;
-    uint8 c = (uint8)ch;
-
-    // Handle the first few characters by reading one character at a time.
-    // Do this until CHAR_PTR is aligned on a longword boundary.
-    for (charPtr = (const uint8*)str;
-         ((uintptr)charPtr & (sizeof(longword) - 1)) != 0; ++charPtr) {
-        if (*charPtr == c)
-            return (const char*)charPtr;
-        else if (*charPtr == '\0')
-            return nullptr;
-    }
-
-    longwordPtr = (uintptr*)charPtr;
-    magicBits = (uintptr)-1;
-    magicBits = magicBits / 0xff * 0xfe << 1 >> 1 | 1;
-    charmask = c | (c << 8);
-    charmask |= charmask << 16;
-    #if ARCH_64BIT
-        charmask |= (charmask << 16) << 16;
-    #endif
-
-    for (;;) {
-        longword = *longwordPtr++;
-
-        if ((((longword + magicBits) ^ ~longword) & ~magicBits) != 0 ||
-            ((((longword ^ charmask) + magicBits) ^ ~(longword ^ charmask)) &
-             ~magicBits) != 0) {
-            const uint8* cp = (const uint8*)(longwordPtr - 1);
-
-            if (*cp == c)
-                return (const char*)cp;
-            else if (*cp == '\0')
-                break;
-            if (*++cp == c)
-                return (const char*)cp;
-            else if (*cp == '\0')
-                break;
-            if (*++cp == c)
-                return (const char*)cp;
-            else if (*cp == '\0')
-                break;
-            if (*++cp == c)
-                return (const char*)cp;
-            else if (*cp == '\0')
-                break;
-            #if ARCH_64BIT
-                if (*++cp == c)
-                    return (const char*)cp;
-                else if (*cp == '\0')
-                    break;
-                if (*++cp == c)
-                    return (const char*)cp;
-                else if (*cp == '\0')
-                    break;
-                if (*++cp == c)
-                    return (const char*)cp;
-                else if (*cp == '\0')
-                    break;
-                if (*++cp == c)
-                    return (const char*)cp;
-                else if (*cp == '\0')
-                    break;
-            #endif
-        }
-    }
-
-    return nullptr;
+    return _GetSimdKernels().findChar(str, ch);
 }
 
 const char* Str::FindCharRev(const char* str, char ch)
 {
-    const char *found = nullptr, *p;
-    ch = (uint8)ch;
-    
-    if (ch == '\0')
-        return Str::FindChar(str, '\0');
-    while ((p = Str::FindChar(str, ch)) != NULL) {
-        found = p;
-        str = p + 1;
-    }
-    return (const char*)found;
+    const StrSimdKernels& kernels = _GetSimdKernels();
+    return kernels.findCharRev(str, kernels.len(str), ch);
 }
 
 const char* Str::FindStr(const char* RESTRICT str, const char* RESTRICT find)
 {
     ASSERT(str);
     ASSERT(find);
-    
-    char ch = find[0];
-    const char* _start = Str::FindChar(str, ch);
-    uint32 find_len = Str::Len(find);
-    uint32 len = Str::Len(str);
-    
-    while (_start) {
-        // We have the first character, check the rest
-        len -= (uint32)(intptr_t)(_start - str);
-        if (len < find_len)
-            return NULL;
-        str = _start;
-        
-        if (memcmp(_start, find, find_len) == 0)
-            return str;
-        
-        _start = Str::FindChar(_start + 1, ch);
-    }
-    
-    return nullptr;
+
+    const StrSimdKernels& kernels = _GetSimdKernels();
+    return kernels.findStr(str, kernels.len(str), find, kernels.len(find));
 }
 
 bool Str::ToBool(const char* str)
@@ -723,20 +1212,23 @@ Str::SplitResult Str::Split(const char* str, char ch, MemAllocator* alloc, bool
     char* s = strCopy;
     char* start = s;
     while (*s) {
-        if (*s == ch) {
-            if (start != s || acceptEmptySplits) {
-                *(s++) = 0;
-                splits.Push(start);
-            }
-            
-            if (!acceptEmptySplits)
-                s = const_cast<char*>(Str::SkipChar(s, ch));
-
-            start = s;
+        // Jump to the next separator instead of testing every character
+        char* found = const_cast<char*>(Str::FindChar(s, ch));
+        if (!found || *found == '\0') {
+            s += Str::Len(s);
+            break;
         }
-        else {
-            ++s;
+
+        s = found;
+        if (start != s || acceptEmptySplits) {
+            *(s++) = 0;
+            splits.Push(start);
         }
+        
+        if (!acceptEmptySplits)
+            s = const_cast<char*>(Str::SkipChar(s, ch));
+
+        start = s;
     }
 
     if (start < s) 
@@ -787,4 +1279,226 @@ void Str::FreeSplitResult(SplitResult& sres, MemAllocator* alloc)
 {
     Mem::Free(sres.buffer, alloc);
     Mem::Free(sres.splits.Ptr(), alloc);
-}
\ No newline at end of file
+}
+
+#if STR_SIMD_SSE2
+namespace Str
+{
+    // CPUID only tells that the CPU has AVX2. The OS must also save the upper halves of YMM registers on context switches
+    // Otherwise, the first AVX instruction faults. That's OSXSAVE (CPUID.1:ECX bit 27) and XCR0 bits 1 (SSE) and 2 (AVX)
+    static bool _IsAVXStateEnabledByOS()
+    {
+        #if COMPILER_MSVC
+            int regs[4];
+            __cpuid(regs, 1);
+            if (((regs[2] >> 27) & 0x1) == 0)
+                return false;
+            uint64 xcr0 = _xgetbv(0);
+        #else
+            uint32 eax, ebx, ecx, edx;
+            __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+            if (((ecx >> 27) & 0x1) == 0)
+                return false;
+            uint32 xcr0Lo, xcr0Hi;
+            __asm__ __volatile__("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+            uint64 xcr0 = (uint64(xcr0Hi) << 32) | xcr0Lo;
+        #endif
+        return (xcr0 & 0x6) == 0x6;
+    }
+}
+#endif
+
+void Str::SelectSimdKernels(const SysInfo& info)
+{
+    StrSimdLevel level = STR_SIMD_BASELINE;
+
+    #if STR_SIMD_SSE2
+        gStrSimd.hasAVX2 = info.cpuCapsAVX2 && _IsAVXStateEnabledByOS();
+        if (gStrSimd.hasAVX2)
+            level = StrSimdLevel::AVX2;
+    #else
+        UNUSED(info);
+    #endif
+
+    Atomic::StoreExplicit(&gStrSimd.level, uint32(level), AtomicMemoryOrder::Relaxed);
+}
+
+StrSimdLevel Str::GetSimdLevel()
+{
+    return StrSimdLevel(Atomic::LoadExplicit(&gStrSimd.level, AtomicMemoryOrder::Relaxed));
+}
+
+const char* Str::GetSimdLevelName(StrSimdLevel level)
+{
+    ASSERT(level < StrSimdLevel::_Count);
+    return STR_SIMD_LEVEL_NAMES[uint32(level)];
+}
+
+uint32 Str::RunSimdSelfTest(uint32 numIterations)
+{
+    // Half of the strings end at the last byte of a committed page that is followed by a reserved (inaccessible) one, 
+    // so any read past the terminator that crosses the page boundary faults. The other half start at random offsets
+    constexpr uint32 MAX_LEN = 300;
+    size_t pageSize = OS::GetPageSize();
+    ASSERT(pageSize > MAX_LEN);
+    char* mem = (char*)Mem::VirtualReserve(pageSize*2);
+    Mem::VirtualCommit(mem, pageSize);
+    char* pageEnd = mem + pageSize;
+
+    // Letters at the edges of the case ranges, path separators and their neighbours in the ASCII table
+    static const char ALPHABET[] = "aAbBzZ/\\._-09 @[`{";
+    constexpr uint32 ALPHABET_LEN = CountOf(ALPHABET) - 1;
+
+    char other[MAX_LEN + 1];
+    char find[MAX_LEN + 1];
+    RandomContext rand = Random::CreateContext(0x5eed);
+    uint32 numFailed = 0;
+
+    for (uint32 iter = 0; iter < numIterations; iter++) {
+        uint32 len = uint32(Random::Int(&rand, 0, MAX_LEN));
+        char* str = (iter & 1) ? (pageEnd - len - 1) : (mem + Random::Int(&rand, 0, int(pageSize - len - 1)));
+
+        // Mostly the small alphabet so the searches hit often, sometimes any non-zero byte
+        for (uint32 i = 0; i < len; i++) {
+            str[i] = (Random::Int(&rand) & 7) ? ALPHABET[Random::Int(&rand) % ALPHABET_LEN] : char(Random::Int(&rand, 1, 255));
+        }
+        str[len] = '\0';
+
+        // Case flipped copy, sometimes with one different character
+        for (uint32 i = 0; i <= len; i++) 
+            other[i] = Str::IsInRange(str[i], 'a', 'z') ? Str::ToUpper(str[i]) : Str::ToLower(str[i]);
+        if (len && (Random::Int(&rand) & 1)) {
+            uint32 index = uint32(Random::Int(&rand, 0, int(len) - 1));
+            other[index] = Str::ToLower(str[index]) == 'q' ? 'w' : 'q';
+        }
+
+        // Needle is either a part of the string or a random short one that rarely matches
+        uint32 findLen;
+        if (len && (Random::Int(&rand) & 1)) {
+            uint32 start = uint32(Random::Int(&rand, 0, int(len) - 1));
+            findLen = uint32(Random::Int(&rand, 0, int(Min(len - start, 40u))));
+            memcpy(find, str + start, findLen);
+        }
+        else {
+            findLen = uint32(Random::Int(&rand, 0, 4));
+            for (uint32 i = 0; i < findLen; i++)
+                find[i] = ALPHABET[Random::Int(&rand) % ALPHABET_LEN];
+        }
+        find[findLen] = '\0';
+
+        char ch = (Random::Int(&rand) & 15) ? ALPHABET[Random::Int(&rand) % ALPHABET_LEN] : char(Random::Int(&rand, 0, 255));
+
+        const StrSimdKernels& ref = STR_SIMD_KERNELS_SCALAR;
+        for (uint32 level = uint32(StrSimdLevel::Scalar) + 1; level < uint32(StrSimdLevel::_Count); level++) {
+            if (!_IsSimdLevelAvailable(StrSimdLevel(level)))
+                continue;
+
+            const StrSimdKernels& k = *STR_SIMD_KERNELS[level];
+            const char* failedOp = nullptr;
+            if (k.len(str) != ref.len(str))
+                failedOp = "Len";
+            else if (k.findChar(str, ch) != ref.findChar(str, ch))
+                failedOp = "FindChar";
+            else if (k.findCharRev(str, len, ch) != ref.findCharRev(str, len, ch))
+                failedOp = "FindCharRev";
+            else if (k.findStr(str, len, find, findLen) != ref.findStr(str, len, find, findLen))
+                failedOp = "FindStr";
+            else if (k.isEqualNoCase(str, other, len) != ref.isEqualNoCase(str, other, len))
+                failedOp = "IsEqualNoCase";
+
+            if (failedOp) {
+                if (numFailed < 8) {
+                    LOG_ERROR("String kernel %s.%s does not match scalar (len=%u, ch=0x%x, find='%s')", 
+                              STR_SIMD_LEVEL_NAMES[level], failedOp, len, uint32(uint8(ch)), find);
+                }
+                numFailed++;
+            }
+        }
+    }
+
+    Mem::VirtualDecommit(mem, pageSize);
+    Mem::VirtualRelease(mem, pageSize*2);
+    return numFailed;
+}
+
+StrSimdBenchmarkResult Str::RunSimdBenchmark(uint32 numStrings, uint32 numIterations)
+{
+    numStrings = Clamp(numStrings, 1u, 65536u);
+    numIterations = Max(numIterations, 1u);
+
+    static const char* DIRS[] = {"data", "Textures", "models", "shaders", "cache", "Sponza", "characters", "environment", "ui", "fonts"};
+    static const char* NAMES[] = {"albedo", "Normal", "sponza_column", "DebugDraw", "ImGuiFont", "hero_roughness", "Skybox", "Terrain"};
+    static const char* EXTS[] = {".png", ".gltf", ".hlsl", ".bin", ".asset", ".ttf", ".ktx2", ".json"};
+
+    // Every string has an upper case copy for IsEqualNoCase and its extension as the FindStr needle
+    char** strs = Mem::AllocTyped<char*>(numStrings*2);
+    char** upperStrs = strs + numStrings;
+    uint32* lens = Mem::AllocTyped<uint32>(numStrings);
+    const char** exts = Mem::AllocTyped<const char*>(numStrings);
+    uint32* extLens = Mem::AllocTyped<uint32>(numStrings);
+
+    RandomContext rand = Random::CreateContext(0xbe7c);
+    uint64 totalLen = 0;
+    for (uint32 i = 0; i < numStrings; i++) {
+        char path[PATH_CHARS_MAX];
+        path[0] = '\0';
+        uint32 numDirs = uint32(Random::Int(&rand, 1, 6));
+        for (uint32 d = 0; d < numDirs; d++) {
+            Str::Concat(path, sizeof(path), "/");
+            Str::Concat(path, sizeof(path), DIRS[Random::Int(&rand) % CountOf(DIRS)]);
+        }
+        exts[i] = EXTS[Random::Int(&rand) % CountOf(EXTS)];
+        extLens[i] = Str::Len(exts[i]);
+        char name[64];
+        Str::PrintFmt(name, sizeof(name), "/%s_%u%s", NAMES[Random::Int(&rand) % CountOf(NAMES)], i, exts[i]);
+        Str::Concat(path, sizeof(path), name);
+
+        lens[i] = Str::Len(path);
+        totalLen += lens[i];
+        strs[i] = Mem::AllocCopy<char>(path, lens[i] + 1);
+        upperStrs[i] = Mem::AllocTyped<char>(lens[i] + 1);
+        Str::ToUpper(upperStrs[i], lens[i] + 1, path);
+    }
+
+    // Returns the nanoseconds per string. Results are accumulated so the calls are not optimized out
+    uint64 sink = 0;
+    double numCalls = double(numStrings)*double(numIterations);
+    auto Measure = [&](auto fn)->double {
+        uint64 startTm = Timer::GetTicks();
+        for (uint32 iter = 0; iter < numIterations; iter++) {
+            for (uint32 i = 0; i < numStrings; i++)
+                sink += fn(i);
+        }
+        return Timer::ToUS(Timer::Diff(Timer::GetTicks(), startTm))*1000.0/numCalls;
+    };
+
+    auto MeasureKernels = [&](const StrSimdKernels& k, double* lenNS, double* findCharNS, double* findCharRevNS, 
+                              double* findStrNS, double* isEqualNoCaseNS) {
+        *lenNS = Measure([&](uint32 i)->uint64 { return k.len(strs[i]); });
+        *findCharNS = Measure([&](uint32 i)->uint64 { return uintptr(k.findChar(strs[i], '.')); });
+        *findCharRevNS = Measure([&](uint32 i)->uint64 { return uintptr(k.findCharRev(strs[i], lens[i], '/')); });
+        *findStrNS = Measure([&](uint32 i)->uint64 { return uintptr(k.findStr(strs[i], lens[i], exts[i], extLens[i])); });
+        *isEqualNoCaseNS = Measure([&](uint32 i)->uint64 { return k.isEqualNoCase(strs[i], upperStrs[i], lens[i]); });
+    };
+
+    StrSimdBenchmarkResult result {
+        .level = GetSimdLevel(),
+        .numStrings = numStrings,
+        .avgLen = uint32(totalLen / numStrings)
+    };
+
+    MeasureKernels(STR_SIMD_KERNELS_SCALAR, &result.scalarLenNS, &result.scalarFindCharNS, &result.scalarFindCharRevNS,
+                   &result.scalarFindStrNS, &result.scalarIsEqualNoCaseNS);
+    MeasureKernels(_GetSimdKernels(), &result.simdLenNS, &result.simdFindCharNS, &result.simdFindCharRevNS,
+                   &result.simdFindStrNS, &result.simdIsEqualNoCaseNS);
+    [[maybe_unused]] volatile uint64 keep = sink;
+
+    for (uint32 i = 0; i < numStrings*2; i++)
+        Mem::Free(strs[i]);
+    Mem::Free(strs);
+    Mem::Free(lens);
+    Mem::Free(exts);
+    Mem::Free(extLens);
+
+    return result;
+}
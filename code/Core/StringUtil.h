@@ -6,6 +6,34 @@
 #include "Base.h"
 
 struct MemAllocator;
+struct SysInfo;
+
+// Instruction sets of the string kernels (Len, FindChar, FindCharRev, FindStr, IsEqualNoCase)
+enum class StrSimdLevel : uint32
+{
+    Scalar = 0,     // Reference versions, used when nothing else is compiled in
+    SSE2,           // x86_64 baseline
+    AVX2,
+    Neon,           // arm64 baseline
+    _Count
+};
+
+struct StrSimdBenchmarkResult
+{
+    StrSimdLevel level;             // Selected kernels, compared against the scalar ones
+    uint32 numStrings;
+    uint32 avgLen;
+    double scalarLenNS;             // Per string
+    double simdLenNS;
+    double scalarFindCharNS;
+    double simdFindCharNS;
+    double scalarFindCharRevNS;
+    double simdFindCharRevNS;
+    double scalarFindStrNS;
+    double simdFindStrNS;
+    double scalarIsEqualNoCaseNS;
+    double simdIsEqualNoCaseNS;
+};
 
 namespace Str
 {
@@ -69,6 +97,18 @@ namespace Str
     API SplitResult Split(const char* str, char ch, MemAllocator* alloc, bool acceptEmptySplits = false);
     API SplitResult SplitWhitespace(const char* str, MemAllocator* alloc);
     API void FreeSplitResult(SplitResult& sres, MemAllocator* alloc);
+
+    // The baseline kernels of the target are used until SelectSimdKernels picks the best ones from the detected CPU caps
+    API void SelectSimdKernels(const SysInfo& info);
+    API StrSimdLevel GetSimdLevel();
+    API const char* GetSimdLevelName(StrSimdLevel level);
+
+    // Fuzzes every available SIMD kernel against the scalar ones, also with strings that end right before an inaccessible page
+    // Returns the number of mismatches
+    API uint32 RunSimdSelfTest(uint32 numIterations);
+
+    // Scalar vs selected kernels over path-like strings (directories, file names and extensions)
+    API StrSimdBenchmarkResult RunSimdBenchmark(uint32 numStrings, uint32 numIterations);
 } // Str
 
 
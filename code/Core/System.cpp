@@ -350,6 +350,54 @@ bool SocketTCP::ParseUrl(const char* url, char* address, size_t addressSize, cha
     return true;    
 }
 
+void _private::CpuTopologyFinalize(SysCpuTopology* topology, const uint32* coreKeys, const uint32* cacheKeys)
+{
+    uint32 numProcessors = topology->numProcessors;
+    uint32 uniqueCoreKeys[SYS_MAX_PROCESSORS];
+    uint32 uniqueCacheKeys[SYS_MAX_PROCESSORS];
+    uint32 coreNumProcessors[SYS_MAX_PROCESSORS];
+    uint32 numCores = 0;
+    uint32 numCaches = 0;
+
+    auto FindOrAdd = [](uint32* keys, uint32* count, uint32 key)->uint32 {
+        for (uint32 i = 0; i < *count; i++) {
+            if (keys[i] == key)
+                return i;
+        }
+        keys[*count] = key;
+        return (*count)++;
+    };
+
+    for (uint32 i = 0; i < numProcessors; i++) {
+        SysCpuTopology::Processor& proc = topology->processors[i];
+        uint32 prevNumCores = numCores;
+        proc.coreIndex = uint16(FindOrAdd(uniqueCoreKeys, &numCores, coreKeys[i]));
+        proc.cacheIndex = uint16(FindOrAdd(uniqueCacheKeys, &numCaches, cacheKeys[i]));
+        if (numCores != prevNumCores)
+            coreNumProcessors[proc.coreIndex] = 0;
+        proc.smtIndex = uint16(coreNumProcessors[proc.coreIndex]++);
+    }
+
+    // Insertion sort by cache domain, then core and then SMT thread, so neighbours share caches
+    auto SortKey = [](const SysCpuTopology::Processor& p)->uint64 {
+        return (uint64(p.cacheIndex) << 32) | (uint64(p.coreIndex) << 16) | p.smtIndex;
+    };
+
+    for (uint32 i = 1; i < numProcessors; i++) {
+        SysCpuTopology::Processor proc = topology->processors[i];
+        uint64 key = SortKey(proc);
+        uint32 k = i;
+        while (k > 0 && SortKey(topology->processors[k - 1]) > key) {
+            topology->processors[k] = topology->processors[k - 1];
+            k--;
+        }
+        topology->processors[k] = proc;
+    }
+
+    topology->numCores = numCores;
+    topology->numCacheDomains = numCaches;
+}
+
 void _private::CountersAddThread(size_t stackSize)
 {
     Atomic::FetchAddExplicit(&gSysCounters.numThreads, 1, AtomicMemoryOrder::Relaxed);
@@ -437,4 +485,87 @@ bool SpinLockMutex::TryEnter()
            Atomic::ExchangeExplicit(&mLocked, 1, AtomicMemoryOrder::Acquire) == 0;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// MpscQueue
+void _private::mpscQueueInitialize(MpscQueueState* state, uint32 itemSize, uint32 capacity, MemAllocator* alloc)
+{
+    ASSERT(itemSize);
+    ASSERT(capacity > 1 && capacity <= (1u << 30));
+
+    uint32 pow2Capacity = 2;
+    while (pow2Capacity < capacity)
+        pow2Capacity <<= 1;
+
+    state->enqueuePos = 0;
+    state->dequeuePos = 0;
+    state->mask = pow2Capacity - 1;
+    state->itemSize = itemSize;
+    state->sequences = Mem::AllocTyped<uint32>(pow2Capacity, alloc);
+    state->items = Mem::AllocTyped<uint8>(pow2Capacity*itemSize, alloc);
+    for (uint32 i = 0; i < pow2Capacity; i++)
+        state->sequences[i] = i;
+}
+
+void _private::mpscQueueRelease(MpscQueueState* state, MemAllocator* alloc)
+{
+    Mem::Free(state->sequences, alloc);
+    Mem::Free(state->items, alloc);
+    state->sequences = nullptr;
+    state->items = nullptr;
+}
+
+bool _private::mpscQueuePush(MpscQueueState* state, const void* item)
+{
+    ASSERT(state->sequences);
+
+    // Each cell's sequence tells if it's free for the producer at 'pos' (seq == pos) or still has an item to be 
+    // consumed from the previous round (seq < pos). Positions are free-running and wrap around at 2^32
+    uint32 pos = Atomic::LoadExplicit(&state->enqueuePos, AtomicMemoryOrder::Relaxed);
+    uint32 cellIndex;
+    for (;;) {
+        cellIndex = pos & state->mask;
+        uint32 seq = Atomic::LoadExplicit(&state->sequences[cellIndex], AtomicMemoryOrder::Acquire);
+        int32 diff = int32(seq - pos);
+        if (diff == 0) {
+            if (Atomic::CompareExchangeExplicit_Weak(&state->enqueuePos, &pos, pos + 1, 
+                                                     AtomicMemoryOrder::Relaxed, AtomicMemoryOrder::Relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false;   // Full
+        }
+        else {
+            pos = Atomic::LoadExplicit(&state->enqueuePos, AtomicMemoryOrder::Relaxed);
+        }
+    }
+
+    memcpy(state->items + size_t(cellIndex)*state->itemSize, item, state->itemSize);
+    Atomic::StoreExplicit(&state->sequences[cellIndex], pos + 1, AtomicMemoryOrder::Release);
+    return true;
+}
+
+bool _private::mpscQueuePop(MpscQueueState* state, void* outItem)
+{
+    ASSERT(state->sequences);
+
+    uint32 pos = state->dequeuePos;
+    uint32 cellIndex = pos & state->mask;
+    uint32 seq = Atomic::LoadExplicit(&state->sequences[cellIndex], AtomicMemoryOrder::Acquire);
+    if (int32(seq - (pos + 1)) < 0)
+        return false;   // Empty, or the producer of this cell has not finished yet
+
+    memcpy(outItem, state->items + size_t(cellIndex)*state->itemSize, state->itemSize);
+    Atomic::StoreExplicit(&state->sequences[cellIndex], pos + state->mask + 1, AtomicMemoryOrder::Release);
+    state->dequeuePos = pos + 1;
+    return true;
+}
+
+uint32 _private::mpscQueueCount(const MpscQueueState* state)
+{
+    uint32 enqueuePos = Atomic::LoadExplicit(const_cast<uint32*>(&state->enqueuePos), AtomicMemoryOrder::Relaxed);
+    return enqueuePos - state->dequeuePos;
+}
+
 
@@ -12,6 +12,7 @@
 // - Virtual memory functions
 // - File: Local disk file wrapper
 // - SocketTCP: server/client TCP socket
+// - SocketPoller: Waits on IO readiness of many sockets (epoll on linux/android, poll/WSAPoll on other platforms)
 //
 #include "StringUtil.h"
 
@@ -57,10 +58,12 @@ struct alignas(64) Thread
     int  Stop();
     bool IsRunning();
     void SetPriority(ThreadPriority prio);
+    bool SetAffinity(const uint16* processorIds, uint32 numProcessors);     // processorIds: see SysCpuTopology::Processor::id
 
     static void SwitchContext();
     static uint32 GetCurrentId();
     static void SetCurrentThreadPriority(ThreadPriority prio);
+    static bool SetCurrentThreadAffinity(const uint16* processorIds, uint32 numProcessors);
     static void SetCurrentThreadName(const char* name);
     static void GetCurrentThreadName(char* nameOut, uint32 nameSize);
     static void Sleep(uint32 msecs);
@@ -224,6 +227,54 @@ private:
 };
 
 
+//    ███╗   ███╗██████╗ ███████╗ ██████╗     ██████╗ ██╗   ██╗███████╗██╗   ██╗███████╗
+//    ████╗ ████║██╔══██╗██╔════╝██╔════╝    ██╔═══██╗██║   ██║██╔════╝██║   ██║██╔════╝
+//    ██╔████╔██║██████╔╝███████╗██║         ██║   ██║██║   ██║█████╗  ██║   ██║█████╗  
+//    ██║╚██╔╝██║██╔═══╝ ╚════██║██║         ██║▄▄ ██║██║   ██║██╔══╝  ██║   ██║██╔══╝  
+//    ██║ ╚═╝ ██║██║     ███████║╚██████╗    ╚██████╔╝╚██████╔╝███████╗╚██████╔╝███████╗
+//    ╚═╝     ╚═╝╚═╝     ╚══════╝ ╚═════╝     ╚══▀▀═╝  ╚═════╝ ╚══════╝ ╚═════╝ ╚══════╝
+namespace _private
+{
+    struct MpscQueueState
+    {
+        alignas(CACHE_LINE_SIZE) uint32 enqueuePos;     // Producers
+        alignas(CACHE_LINE_SIZE) uint32 dequeuePos;     // Consumer
+        uint32 mask;
+        uint32 itemSize;
+        uint32* sequences;
+        uint8* items;
+    };
+
+    API void mpscQueueInitialize(MpscQueueState* state, uint32 itemSize, uint32 capacity, MemAllocator* alloc);
+    API void mpscQueueRelease(MpscQueueState* state, MemAllocator* alloc);
+    API bool mpscQueuePush(MpscQueueState* state, const void* item);
+    API bool mpscQueuePop(MpscQueueState* state, void* outItem);
+    API uint32 mpscQueueCount(const MpscQueueState* state);
+}
+
+// Bounded lock-free multi-producer/single-consumer queue. Based on Dmitry Vyukov's bounded MPMC queue:
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//      - Items are copied with memcpy, so only use it with POD types
+//      - Capacity is rounded up to power of two and doesn't grow. Push returns false if the queue is full
+//      - Pop must only be called from a single consumer thread. A push that's still in progress on another thread can 
+//        make Pop return false while later items are already in. So consumers should always drain the queue with
+//        `while (queue.Pop(&item))` after they are woken up
+template <typename _T>
+struct MpscQueue
+{
+    void Initialize(uint32 capacity, MemAllocator* alloc = Mem::GetDefaultAlloc());
+    void Release();
+
+    bool Push(const _T& item);
+    bool Pop(_T* outItem);
+    uint32 Count() const;       // Approximate if there are producers working on the queue
+
+private:
+    _private::MpscQueueState mState {};
+    MemAllocator* mAlloc = nullptr;
+};
+
+
 //    ████████╗██╗███╗   ███╗███████╗██████╗ 
 //    ╚══██╔══╝██║████╗ ████║██╔════╝██╔══██╗
 //       ██║   ██║██╔████╔██║█████╗  ██████╔╝
@@ -398,6 +449,39 @@ private:
     uint8 mData[64];
 };
 
+enum class MappedFileFlags : uint32
+{
+    None         = 0,
+    ReadWrite    = 0x01, // Map with write access, modified pages are written back to the file. Without it, the view is read-only
+    SeqScan      = 0x02, // Access hint: pages are read in order, so the OS reads ahead more aggressively
+    RandomAccess = 0x04, // Access hint: pages are read randomly, so the OS doesn't read ahead
+    Prefetch     = 0x08, // Start reading the whole file into memory in the background right after mapping it
+};
+ENABLE_BITMASK(MappedFileFlags);
+
+// Memory-mapped view of a file. Pages are read in by the OS on first access and come straight from the page cache, 
+// so there is no allocation and copy involved, unlike File::Read. The view is valid until Close
+// For ReadWrite maps, 'size' creates or resizes the file before mapping. Empty files cannot be mapped
+struct MappedFile
+{
+    MappedFile();
+
+    bool Open(const char* filepath, MappedFileFlags flags = MappedFileFlags::None, size_t size = 0);
+    void Close();
+
+    void Prefetch(size_t offset = 0, size_t size = SIZE_MAX);  // Asks the OS to read the range in the background ahead of access
+    bool Flush();                                               // ReadWrite: Writes the modified pages back to the file
+
+    const void* Data() const;
+    void* MutableData() const;      // ReadWrite only
+    size_t GetSize() const;
+    uint64 GetLastModified() const;
+    bool IsOpen() const;
+
+private:
+    uint8 mData[64];
+};
+
 // Async file
 // TODO: (experimental) Currently, not implemented in platforms other than windows
 struct AsyncFile
@@ -485,6 +569,14 @@ using SocketHandle = uint64;
 using SocketHandle = int;
 #endif
 
+inline constexpr uint32 SOCKET_MAX_GATHER_BUFFERS = 16;
+
+struct SocketBuffer
+{
+    const void* data;
+    uint32 size;
+};
+
 struct SocketTCP
 {
     SocketTCP();
@@ -500,6 +592,13 @@ struct SocketTCP
     uint32 Write(const void* src, uint32 size);
     uint32 Read(void* dst, uint32 dstSize);
 
+    // Writes all buffers in order with as few system calls as possible (scatter/gather), without merging them first
+    // Returns the total number of bytes written, or UINT32_MAX if there was an error
+    uint32 WriteGather(const SocketBuffer* buffers, uint32 numBuffers);
+
+    // Disables Nagle's algorithm, so small messages are sent right away instead of waiting to be coalesced
+    bool SetNoDelay(bool enable);
+
     static SocketTCP CreateListener();
     SocketTCP Accept(char* clientUrl = nullptr, uint32 clientUrlSize = 0);
     bool Listen(uint16 port, uint32 maxConnections = UINT32_MAX);
@@ -507,6 +606,7 @@ struct SocketTCP
     static SocketTCP Connect(const char* url);
 
 private:
+    friend struct SocketPoller;
     static bool ParseUrl(const char* url, char* address, size_t addressSize, char* port, size_t portSize, const char** pResource = nullptr);
 
 private:
@@ -515,6 +615,40 @@ private:
     uint16 mLive;
 };
 
+enum class SocketPollFlags : uint32
+{
+    None = 0,
+    Read = 0x1,     // Data is available for reading, or a listener has a pending connection
+    Write = 0x2,    // Socket can be written to without blocking
+    Hangup = 0x4    // Peer has closed the connection or the socket is in error state
+};
+ENABLE_BITMASK(SocketPollFlags);
+
+struct SocketPollEvent
+{
+    uint64 userData;
+    SocketPollFlags flags;
+};
+
+// Waits on multiple sockets from a single thread, so servers don't need a thread per connection
+// Events are level-triggered: A socket keeps reporting 'Read' until all pending data is received
+struct SocketPoller
+{
+    bool Initialize(uint32 maxSockets, MemAllocator* alloc = Mem::GetDefaultAlloc());
+    void Release();
+
+    bool Add(const SocketTCP& sock, uint64 userData, SocketPollFlags flags = SocketPollFlags::Read);
+    void Remove(const SocketTCP& sock);
+
+    // Returns number of events written to `outEvents`
+    // Returns 0 if timeout is reached, UINT32_MAX if there was an error
+    uint32 Wait(SocketPollEvent* outEvents, uint32 maxEvents, uint32 msecs = UINT32_MAX);
+
+private:
+    void* mData = nullptr;
+    MemAllocator* mAlloc = nullptr;
+};
+
 //    ██╗   ██╗██╗   ██╗██╗██████╗ 
 //    ██║   ██║██║   ██║██║██╔══██╗
 //    ██║   ██║██║   ██║██║██║  ██║
@@ -578,6 +712,26 @@ struct SysInfo
     uint32       cpuCapsNeon : 1;
 };
 
+inline constexpr uint32 SYS_MAX_PROCESSORS = 256;
+
+// Logical processors that are available to the process, grouped by physical core and the last level cache they share
+// Processors are sorted by cacheIndex, coreIndex and then smtIndex
+struct SysCpuTopology
+{
+    struct Processor
+    {
+        uint16 id;              // OS processor number, used for thread affinities
+        uint16 coreIndex;       // Physical core [0, numCores). Processors with the same coreIndex are SMT siblings
+        uint16 cacheIndex;      // Last level cache domain (L3, or CCX on AMD) [0, numCacheDomains)
+        uint16 smtIndex;        // 0 for the first logical processor of the core
+    };
+
+    uint32 numProcessors;
+    uint32 numCores;
+    uint32 numCacheDomains;
+    Processor processors[SYS_MAX_PROCESSORS];
+};
+
 namespace OS
 {
     API void PauseCPU();
@@ -588,6 +742,7 @@ namespace OS
     API void* GetSymbolAddress(OSDLL dll, const char* symbolName);
     API size_t GetPageSize();
     API void GetSysInfo(SysInfo* info);
+    API bool GetCpuTopology(SysCpuTopology* topology);     // Returns false if the platform doesn't support thread affinities
     API bool IsDebuggerPresent();
     API void GenerateCmdLineFromArgcArgv(int argc, const char* argv[], char** outString, uint32* outStringLen, 
                                              MemAllocator* alloc = Mem::GetDefaultAlloc(), const char* prefixCmd = nullptr);
@@ -779,6 +934,9 @@ namespace OS
 // Used internally by system platform source files. Defined in System.cpp
 namespace _private
 {
+    // Platforms fill SysCpuTopology::Processor::id and pass arbitrary (OS specific) keys for the core and cache of each processor
+    void CpuTopologyFinalize(SysCpuTopology* topology, const uint32* coreKeys, const uint32* cacheKeys);
+
     void CountersAddThread(size_t stackSize);
     void CountersRemoveThread(size_t stackSize);
     void CountersAddMutex();
@@ -806,6 +964,42 @@ SysPrimitiveStats GetSystemPrimitiveStats();
 //    ██║██║╚██╗██║██║     ██║██║╚██╗██║██╔══╝  ╚════██║
 //    ██║██║ ╚████║███████╗██║██║ ╚████║███████╗███████║
 //    ╚═╝╚═╝  ╚═══╝╚══════╝╚═╝╚═╝  ╚═══╝╚══════╝╚══════╝
+//----------------------------------------------------------------------------------------------------------------------
+// MpscQueue
+template <typename _T>
+inline void MpscQueue<_T>::Initialize(uint32 capacity, MemAllocator* alloc)
+{
+    ASSERT(alloc);
+    mAlloc = alloc;
+    _private::mpscQueueInitialize(&mState, sizeof(_T), capacity, alloc);
+}
+
+template <typename _T>
+inline void MpscQueue<_T>::Release()
+{
+    if (mAlloc)
+        _private::mpscQueueRelease(&mState, mAlloc);
+    mAlloc = nullptr;
+}
+
+template <typename _T>
+inline bool MpscQueue<_T>::Push(const _T& item)
+{
+    return _private::mpscQueuePush(&mState, &item);
+}
+
+template <typename _T>
+inline bool MpscQueue<_T>::Pop(_T* outItem)
+{
+    return _private::mpscQueuePop(&mState, outItem);
+}
+
+template <typename _T>
+inline uint32 MpscQueue<_T>::Count() const
+{
+    return _private::mpscQueueCount(&mState);
+}
+
 inline Path& Path::SetToCurrentDir()
 {
     OS::GetCurrentDir(mStr, sizeof(mStr));
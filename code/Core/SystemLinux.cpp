@@ -49,13 +49,18 @@ void OS::GetSysInfo(SysInfo* sysInfo)
         constexpr int CPUID_GET_FEATURES = 1;
         int eax, ebx, ecx, edx;
         cpuid(CPUID_GET_FEATURES, 0, &eax, &ebx, &ecx, &edx);
-        sysInfo->cpuCapsSSE = edx & (1 << 25);
-        sysInfo->cpuCapsSSE2 = edx & (1 << 26);
-        sysInfo->cpuCapsSSE3 = (ecx & (1 << 0));
-        sysInfo->cpuCapsSSE41 = (ecx & (1 << 19));
-        sysInfo->cpuCapsSSE42 = (ecx & (1 << 20));
-        sysInfo->cpuCapsAVX = (ecx & (1 << 28));
-        sysInfo->cpuCapsAVX2 = (ebx & (1 << 5));
+        sysInfo->cpuCapsSSE = ((edx >> 25) & 0x1) ? true : false;
+        sysInfo->cpuCapsSSE2 = ((edx >> 26) & 0x1) ? true : false;
+        sysInfo->cpuCapsSSE3 = (ecx & 0x1) ? true : false;
+        sysInfo->cpuCapsSSE41 = ((ecx >> 19) & 0x1) ? true : false;
+        sysInfo->cpuCapsSSE42 = ((ecx >> 20) & 0x1) ? true : false;
+        sysInfo->cpuCapsAVX = ((ecx >> 28) & 0x1) ? true : false;
+
+        // AVX2/AVX512 are in the extended features leaf
+        constexpr int CPUID_GET_EXTENDED_FEATURES = 7;
+        cpuid(CPUID_GET_EXTENDED_FEATURES, 0, &eax, &ebx, &ecx, &edx);
+        sysInfo->cpuCapsAVX2 = ((ebx >> 5) & 0x1) ? true : false;
+        sysInfo->cpuCapsAVX512 = ((ebx >> 16) & 0x1) ? true : false;
     }
 
     sysInfo->pageSize = sysconf(_SC_PAGESIZE);
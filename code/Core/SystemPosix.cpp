@@ -7,11 +7,16 @@
 #include <pthread.h>            // pthread_t and family
 #include <sys/types.h>
 #include <sys/socket.h>         // socket funcs
+#include <sys/uio.h>            // iovec
 #if PLATFORM_ANDROID || PLATFORM_LINUX
     #include <sys/prctl.h>          // prctl
     #include <semaphore.h>
     #include <sys/syscall.h>
     #include <sys/sendfile.h>
+    #include <sys/epoll.h>         // SocketPoller
+    #if PLATFORM_LINUX
+    #include <linux/futex.h>        // Mutex/Semaphore/Signal
+    #endif
 #else
     #include <sched.h>
 #endif
@@ -24,6 +29,7 @@
 #include <fcntl.h>
 #include <netdb.h>              // getaddrinfo, freeaddrinfo
 #include <netinet/in.h>         // sockaddr_in
+#include <netinet/tcp.h>        // TCP_NODELAY
 #include <arpa/inet.h>          // inet_ntop
 #include <poll.h>               // async file poll
 #include <spawn.h>
@@ -33,6 +39,10 @@
 #include <sys/wait.h>
 #endif
 
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#include <sched.h>              // sched_setaffinity
+#endif
+
 #if PLATFORM_APPLE || PLATFORM_LINUX
     #include <uuid/uuid.h>
 #endif
@@ -61,6 +71,41 @@ static inline void timespecAdd(struct timespec* _ts, int32_t _msecs)
     timespecFromNs(_ts, ns + (uint64)(_msecs)*1000000);
 }
 
+#if PLATFORM_LINUX
+// Futex based sync primitives: Uncontended paths (or no waiters) never leave the user-space
+// Waiters spin for a short while before going to sleep in the kernel
+static constexpr uint32 FUTEX_SPIN_COUNT = 64;
+
+// Spinning only burns the time-slice of the thread we are waiting for on single core machines
+static inline uint32 _FutexSpinCount(uint32 spinCount)
+{
+    static const bool singleCore = sysconf(_SC_NPROCESSORS_ONLN) <= 1;
+    return singleCore ? 0 : spinCount;
+}
+
+static inline void _FutexWake(AtomicUint32* addr, uint32 count)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, int(Min<uint32>(count, INT32_MAX)), nullptr, nullptr, 0);
+}
+
+// deadline is absolute CLOCK_MONOTONIC time, nullptr waits forever. Returns false if it's timed out
+// Note that returning true doesn't mean that the value is changed (spurious wakeups/signals), callers should always re-check
+static inline bool _FutexWait(AtomicUint32* addr, uint32 expected, const struct timespec* deadline)
+{
+    long r = syscall(SYS_futex, addr, FUTEX_WAIT_BITSET_PRIVATE, expected, deadline, nullptr, FUTEX_BITSET_MATCH_ANY);
+    return !(r == -1 && errno == ETIMEDOUT);
+}
+
+static inline struct timespec* _FutexDeadline(struct timespec* ts, uint32 msecs)
+{
+    if (msecs == UINT32_MAX)
+        return nullptr;
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    timespecAdd(ts, int32(Min<uint32>(msecs, INT32_MAX)));
+    return ts;
+}
+#endif // PLATFORM_LINUX
+
 //    ████████╗██╗  ██╗██████╗ ███████╗ █████╗ ██████╗ 
 //    ╚══██╔══╝██║  ██║██╔══██╗██╔════╝██╔══██╗██╔══██╗
 //       ██║   ███████║██████╔╝█████╗  ███████║██║  ██║
@@ -273,12 +318,204 @@ void Thread::SetCurrentThreadPriority(ThreadPriority prio)
     _SetThreadPriority(pthread_self(), prio);
 }
 
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+static bool _SetThreadAffinity(pid_t tid, const uint16* processorIds, uint32 numProcessors)
+{
+    ASSERT(processorIds && numProcessors);
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (uint32 i = 0; i < numProcessors; i++) {
+        ASSERT(processorIds[i] < CPU_SETSIZE);
+        CPU_SET(processorIds[i], &cpuSet);
+    }
+
+    return sched_setaffinity(tid, sizeof(cpuSet), &cpuSet) == 0;
+}
+
+bool Thread::SetAffinity(const uint16* processorIds, uint32 numProcessors)
+{
+    ThreadImpl* thrd = reinterpret_cast<ThreadImpl*>(mData);
+    ASSERT(thrd->init);
+    return _SetThreadAffinity(thrd->tId, processorIds, numProcessors);
+}
+
+bool Thread::SetCurrentThreadAffinity(const uint16* processorIds, uint32 numProcessors)
+{
+    return _SetThreadAffinity(0, processorIds, numProcessors);
+}
+
+// Returns defaultValue if the file doesn't exist
+static int _ReadSysfsInt(const char* path, int defaultValue)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+        return defaultValue;
+
+    char text[32];
+    ssize_t len = read(fd, text, sizeof(text) - 1);
+    close(fd);
+    if (len <= 0)
+        return defaultValue;
+    text[len] = '\0';
+    return Str::ToInt(text);
+}
+
+bool OS::GetCpuTopology(SysCpuTopology* topology)
+{
+    // Only processors that we are allowed to run on (taskset, cgroups, etc.)
+    cpu_set_t cpuSet;
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+        return false;
+
+    uint32 coreKeys[SYS_MAX_PROCESSORS];
+    uint32 cacheKeys[SYS_MAX_PROCESSORS];
+    uint32 numProcessors = 0;
+    char path[128];
+
+    for (uint32 cpu = 0; cpu < CPU_SETSIZE && numProcessors < SYS_MAX_PROCESSORS; cpu++) {
+        if (!CPU_ISSET(cpu, &cpuSet))
+            continue;
+
+        Str::PrintFmt(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpu);
+        uint32 packageId = uint32(Max(_ReadSysfsInt(path, 0), 0));
+        Str::PrintFmt(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", cpu);
+        int coreId = _ReadSysfsInt(path, -1);
+
+        // Last level cache: index3 is L3 on most desktop CPUs, fallback to the package if cache ids are not exposed
+        Str::PrintFmt(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index3/id", cpu);
+        int cacheId = _ReadSysfsInt(path, -1);
+
+        topology->processors[numProcessors].id = uint16(cpu);
+        coreKeys[numProcessors] = (packageId << 16) | (coreId >= 0 ? uint32(coreId) : (0x8000 | cpu));
+        cacheKeys[numProcessors] = cacheId >= 0 ? uint32(cacheId) : (0x80000000 | packageId);
+        numProcessors++;
+    }
+
+    if (numProcessors == 0)
+        return false;
+
+    topology->numProcessors = numProcessors;
+    _private::CpuTopologyFinalize(topology, coreKeys, cacheKeys);
+    return true;
+}
+#else
+bool Thread::SetAffinity(const uint16*, uint32)
+{
+    return false;   // Apple platforms only have affinity hints (thread_policy_set), which are not supported on arm64
+}
+
+bool Thread::SetCurrentThreadAffinity(const uint16*, uint32)
+{
+    return false;
+}
+
+bool OS::GetCpuTopology(SysCpuTopology*)
+{
+    return false;
+}
+#endif // PLATFORM_LINUX || PLATFORM_ANDROID
+
 //    ███╗   ███╗██╗   ██╗████████╗███████╗██╗  ██╗
 //    ████╗ ████║██║   ██║╚══██╔══╝██╔════╝╚██╗██╔╝
 //    ██╔████╔██║██║   ██║   ██║   █████╗   ╚███╔╝ 
 //    ██║╚██╔╝██║██║   ██║   ██║   ██╔══╝   ██╔██╗ 
 //    ██║ ╚═╝ ██║╚██████╔╝   ██║   ███████╗██╔╝ ██╗
 //    ╚═╝     ╚═╝ ╚═════╝    ╚═╝   ╚══════╝╚═╝  ╚═╝
+#if PLATFORM_LINUX
+// Recursive futex mutex: https://akkadia.org/drepper/futex.pdf (mutex2)
+struct MutexImpl
+{
+    AtomicUint32 state;     // 0: unlocked, 1: locked, 2: locked and there might be waiters
+    uint32 spinCount;
+    uint32 recursion;
+    AtomicUint64 owner;     // pthread_self() of the owner thread. Only compared to the current thread, so relaxed loads are fine
+};
+static_assert(sizeof(MutexImpl) <= sizeof(Mutex), "Mutex size mismatch");
+
+void Mutex::Initialize(uint32 spinCount)
+{
+    MutexImpl* _m = reinterpret_cast<MutexImpl*>(mData);
+    _m->state = 0;
+    _m->spinCount = spinCount;
+    _m->recursion = 0;
+    _m->owner = 0;
+
+    _private::CountersAddMutex();
+}
+
+void Mutex::Release()
+{
+    [[maybe_unused]] MutexImpl* _m = reinterpret_cast<MutexImpl*>(mData);
+    ASSERT_MSG(_m->state == 0, "Mutex is still locked");
+
+    _private::CountersRemoveMutex();
+}
+
+void Mutex::Enter()
+{
+    MutexImpl* _m = reinterpret_cast<MutexImpl*>(mData);
+    uint64 self = uint64(pthread_self());
+
+    if (Atomic::LoadExplicit(&_m->owner, AtomicMemoryOrder::Relaxed) == self) {
+        ++_m->recursion;
+        return;
+    }
+
+    uint32 expected = 0;
+    if (!Atomic::CompareExchangeExplicit_Strong(&_m->state, &expected, 1, AtomicMemoryOrder::Acquire, AtomicMemoryOrder::Relaxed)) {
+        bool locked = false;
+        for (uint32 i = 0, c = _FutexSpinCount(_m->spinCount); i < c && !locked; i++) {
+            OS::PauseCPU();
+            expected = 0;
+            locked = Atomic::LoadExplicit(&_m->state, AtomicMemoryOrder::Relaxed) == 0 &&
+                     Atomic::CompareExchangeExplicit_Strong(&_m->state, &expected, 1, AtomicMemoryOrder::Acquire, AtomicMemoryOrder::Relaxed);
+        }
+
+        // Mark as contended and sleep, so the owner knows it has to wake us up on Exit
+        if (!locked) {
+            while (Atomic::ExchangeExplicit(&_m->state, 2, AtomicMemoryOrder::Acquire) != 0)
+                _FutexWait(&_m->state, 2, nullptr);
+        }
+    }
+
+    Atomic::StoreExplicit(&_m->owner, self, AtomicMemoryOrder::Relaxed);
+    _m->recursion = 1;
+}
+
+void Mutex::Exit()
+{
+    MutexImpl* _m = reinterpret_cast<MutexImpl*>(mData);
+    ASSERT_MSG(Atomic::LoadExplicit(&_m->owner, AtomicMemoryOrder::Relaxed) == uint64(pthread_self()), "Mutex is not owned by this thread");
+
+    if (--_m->recursion)
+        return;
+
+    Atomic::StoreExplicit(&_m->owner, 0, AtomicMemoryOrder::Relaxed);
+    if (Atomic::ExchangeExplicit(&_m->state, 0, AtomicMemoryOrder::Release) == 2)
+        _FutexWake(&_m->state, 1);
+}
+
+bool Mutex::TryEnter()
+{
+    MutexImpl* _m = reinterpret_cast<MutexImpl*>(mData);
+    uint64 self = uint64(pthread_self());
+
+    if (Atomic::LoadExplicit(&_m->owner, AtomicMemoryOrder::Relaxed) == self) {
+        ++_m->recursion;
+        return true;
+    }
+
+    uint32 expected = 0;
+    if (Atomic::CompareExchangeExplicit_Strong(&_m->state, &expected, 1, AtomicMemoryOrder::Acquire, AtomicMemoryOrder::Relaxed)) {
+        Atomic::StoreExplicit(&_m->owner, self, AtomicMemoryOrder::Relaxed);
+        _m->recursion = 1;
+        return true;
+    }
+
+    return false;
+}
+#else
 struct MutexImpl
 {
     pthread_mutex_t handle;
@@ -330,6 +567,7 @@ bool Mutex::TryEnter()
 
     return pthread_mutex_trylock(&_m->handle) == 0;
 }
+#endif // else: PLATFORM_LINUX
 
 //    ██████╗ ███████╗ █████╗ ██████╗ ██╗    ██╗██████╗ ██╗████████╗███████╗    ███╗   ███╗██╗   ██╗████████╗███████╗██╗  ██╗
 //    ██╔══██╗██╔════╝██╔══██╗██╔══██╗██║    ██║██╔══██╗██║╚══██╔══╝██╔════╝    ████╗ ████║██║   ██║╚══██╔══╝██╔════╝╚██╗██╔╝
@@ -397,7 +635,74 @@ void ReadWriteMutex::ExitWrite()
 //    ╚════██║██╔══╝  ██║╚██╔╝██║██╔══██║██╔═══╝ ██╔══██║██║   ██║██╔══██╗██╔══╝  
 //    ███████║███████╗██║ ╚═╝ ██║██║  ██║██║     ██║  ██║╚██████╔╝██║  ██║███████╗
 //    ╚══════╝╚══════╝╚═╝     ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═╝╚══════╝
-#if !PLATFORM_APPLE
+#if PLATFORM_LINUX
+struct SemaphoreImpl
+{
+    AtomicUint32 count;
+    AtomicUint32 numWaiters;    // Number of threads that are (or about to be) sleeping in the kernel
+};
+static_assert(sizeof(SemaphoreImpl) <= sizeof(Semaphore), "Sempahore size mismatch");
+
+static inline bool _SemaphoreTryDecrement(SemaphoreImpl* sem)
+{
+    uint32 count = Atomic::LoadExplicit(&sem->count, AtomicMemoryOrder::Relaxed);
+    while (count) {
+        if (Atomic::CompareExchangeExplicit_Weak(&sem->count, &count, count - 1, AtomicMemoryOrder::Acquire, AtomicMemoryOrder::Relaxed))
+            return true;
+    }
+    return false;
+}
+
+void Semaphore::Initialize()
+{
+    SemaphoreImpl* sem = reinterpret_cast<SemaphoreImpl*>(mData);
+    sem->count = 0;
+    sem->numWaiters = 0;
+
+    _private::CountersAddSemaphore();
+}
+
+void Semaphore::Release()
+{
+    _private::CountersRemoveSemaphore();
+}
+
+void Semaphore::Post(uint32 count)
+{
+    SemaphoreImpl* sem = reinterpret_cast<SemaphoreImpl*>(mData);
+
+    // Waiters increment numWaiters before checking the count, so with seq_cst either we see them or they see the new count
+    Atomic::FetchAddExplicit(&sem->count, count, AtomicMemoryOrder::Seqcst);
+    if (Atomic::LoadExplicit(&sem->numWaiters, AtomicMemoryOrder::Seqcst))
+        _FutexWake(&sem->count, count);
+}
+
+bool Semaphore::Wait(uint32 msecs)
+{
+    SemaphoreImpl* sem = reinterpret_cast<SemaphoreImpl*>(mData);
+
+    for (uint32 i = 0, c = _FutexSpinCount(FUTEX_SPIN_COUNT); i < c; i++) {
+        if (_SemaphoreTryDecrement(sem))
+            return true;
+        OS::PauseCPU();
+    }
+
+    struct timespec ts;
+    const struct timespec* deadline = _FutexDeadline(&ts, msecs);
+
+    bool r = true;
+    Atomic::FetchAddExplicit(&sem->numWaiters, 1, AtomicMemoryOrder::Seqcst);
+    while (!_SemaphoreTryDecrement(sem)) {
+        if (!_FutexWait(&sem->count, 0, deadline)) {
+            r = _SemaphoreTryDecrement(sem);
+            break;
+        }
+    }
+    Atomic::FetchSubExplicit(&sem->numWaiters, 1, AtomicMemoryOrder::Relaxed);
+
+    return r;
+}
+#elif !PLATFORM_APPLE
 struct SemaphoreImpl
 {
     sem_t sem;
@@ -463,6 +768,113 @@ bool Semaphore::Wait(uint32 msecs)
 //    ███████║██║╚██████╔╝██║ ╚████║██║  ██║███████╗
 //    ╚══════╝╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝  ╚═╝╚══════╝
 
+#if PLATFORM_LINUX
+struct SignalImpl
+{
+    AtomicUint32 value;         // int
+    AtomicUint32 seq;           // Incremented on each Raise. Waiters sleep on this one, so value changes don't race with sleeping
+    AtomicUint32 numWaiters;
+};
+static_assert(sizeof(SignalImpl) <= sizeof(Signal), "Signal size mismatch");
+
+// Waits while condFn(value, reference) is true, then sets the value to reference
+static bool _SignalWait(SignalImpl* sig, bool(*condFn)(int value, int reference), int reference, uint32 msecs)
+{
+    auto TryConsume = [sig, condFn, reference]()->bool
+    {
+        uint32 value = Atomic::LoadExplicit(&sig->value, AtomicMemoryOrder::Acquire);
+        while (!condFn(int(value), reference)) {
+            if (Atomic::CompareExchangeExplicit_Weak(&sig->value, &value, uint32(reference), AtomicMemoryOrder::Acquire, AtomicMemoryOrder::Acquire))
+                return true;
+        }
+        return false;
+    };
+
+    for (uint32 i = 0, c = _FutexSpinCount(FUTEX_SPIN_COUNT); i < c; i++) {
+        if (TryConsume())
+            return true;
+        OS::PauseCPU();
+    }
+
+    struct timespec ts;
+    const struct timespec* deadline = _FutexDeadline(&ts, msecs);
+
+    bool r = true;
+    Atomic::FetchAddExplicit(&sig->numWaiters, 1, AtomicMemoryOrder::Seqcst);
+    while (true) {
+        uint32 seq = Atomic::LoadExplicit(&sig->seq, AtomicMemoryOrder::Seqcst);
+        if (TryConsume())
+            break;
+        if (!_FutexWait(&sig->seq, seq, deadline)) {
+            r = TryConsume();
+            break;
+        }
+    }
+    Atomic::FetchSubExplicit(&sig->numWaiters, 1, AtomicMemoryOrder::Relaxed);
+
+    return r;
+}
+
+static inline void _SignalWake(SignalImpl* sig, uint32 count)
+{
+    Atomic::FetchAddExplicit(&sig->seq, 1, AtomicMemoryOrder::Seqcst);
+    if (Atomic::LoadExplicit(&sig->numWaiters, AtomicMemoryOrder::Seqcst))
+        _FutexWake(&sig->seq, count);
+}
+
+void Signal::Initialize()
+{
+    SignalImpl* sig = reinterpret_cast<SignalImpl*>(mData);
+    sig->value = 0;
+    sig->seq = 0;
+    sig->numWaiters = 0;
+
+    _private::CountersAddSignal();
+}
+
+void Signal::Release()
+{
+    _private::CountersRemoveSignal();
+}
+
+void Signal::Raise()
+{
+    _SignalWake(reinterpret_cast<SignalImpl*>(mData), 1);
+}
+
+void Signal::RaiseAll()
+{
+    _SignalWake(reinterpret_cast<SignalImpl*>(mData), UINT32_MAX);
+}
+
+bool Signal::Wait(uint32 msecs)
+{
+    return _SignalWait(reinterpret_cast<SignalImpl*>(mData), [](int value, int)->bool { return value == 0; }, 0, msecs);
+}
+
+bool Signal::WaitOnCondition(bool(*condFn)(int value, int reference), int reference, uint32 msecs)
+{
+    return _SignalWait(reinterpret_cast<SignalImpl*>(mData), condFn, reference, msecs);
+}
+
+void Signal::Decrement(uint32 count)
+{
+    SignalImpl* sig = reinterpret_cast<SignalImpl*>(mData);
+    Atomic::FetchSubExplicit(&sig->value, count, AtomicMemoryOrder::Seqcst);
+}
+
+void Signal::Increment(uint32 count)
+{
+    SignalImpl* sig = reinterpret_cast<SignalImpl*>(mData);
+    Atomic::FetchAddExplicit(&sig->value, count, AtomicMemoryOrder::Seqcst);
+}
+
+void Signal::Set(int value)
+{
+    SignalImpl* sig = reinterpret_cast<SignalImpl*>(mData);
+    Atomic::StoreExplicit(&sig->value, uint32(value), AtomicMemoryOrder::Seqcst);
+}
+#else
 // https://github.com/mattiasgustavsson/libs/blob/master/thread.h
 struct SignalImpl 
 {
@@ -615,6 +1027,8 @@ void Signal::Set(int value)
     sig->value = value;
     pthread_mutex_unlock(&sig->mutex);
 }
+#endif // else: PLATFORM_LINUX
+
 
 //    ████████╗██╗███╗   ███╗███████╗██████╗ 
 //    ╚══██╔══╝██║████╗ ████║██╔════╝██╔══██╗
@@ -1089,6 +1503,144 @@ bool File::IsOpen() const
     return f->id != -1;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// MappedFile
+struct MappedFilePosix
+{
+    void*       data;
+    uint64      size;
+    uint64      lastModifiedTime;
+    MappedFileFlags flags;
+};
+static_assert(sizeof(MappedFilePosix) <= sizeof(MappedFile));
+
+MappedFile::MappedFile()
+{
+    MappedFilePosix* m = (MappedFilePosix*)mData;
+    m->data = nullptr;
+    m->size = 0;
+    m->lastModifiedTime = 0;
+    m->flags = MappedFileFlags::None;
+}
+
+bool MappedFile::Open(const char* filepath, MappedFileFlags flags, size_t size)
+{
+    MappedFilePosix* m = (MappedFilePosix*)mData;
+    ASSERT_MSG(!m->data, "MappedFile is already open");
+
+    bool readWrite = (flags & MappedFileFlags::ReadWrite) == MappedFileFlags::ReadWrite;
+    ASSERT_MSG(readWrite || size == 0, "Size can only be set for ReadWrite maps");
+
+    int fileId = readWrite ? 
+        open(filepath, O_RDWR | O_CREAT | __O_LARGEFILE, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH) :
+        open(filepath, O_RDONLY | __O_LARGEFILE);
+    if (fileId == -1)
+        return false;
+
+    struct stat _stat;
+    if (fstat(fileId, &_stat) != 0) {
+        close(fileId);
+        return false;
+    }
+
+    uint64 fileSize = uint64(_stat.st_size);
+    if (readWrite && size && size != fileSize) {
+        if (ftruncate(fileId, off_t(size)) != 0) {
+            close(fileId);
+            return false;
+        }
+        fileSize = size;
+    }
+
+    if (fileSize == 0) {
+        close(fileId);
+        return false;
+    }
+
+    void* data = mmap(nullptr, size_t(fileSize), readWrite ? (PROT_READ|PROT_WRITE) : PROT_READ, MAP_SHARED, fileId, 0);
+    close(fileId);  // Mapping keeps its own reference to the file
+    if (data == MAP_FAILED)
+        return false;
+
+    if ((flags & MappedFileFlags::SeqScan) == MappedFileFlags::SeqScan)
+        madvise(data, size_t(fileSize), MADV_SEQUENTIAL);
+    else if ((flags & MappedFileFlags::RandomAccess) == MappedFileFlags::RandomAccess)
+        madvise(data, size_t(fileSize), MADV_RANDOM);
+
+    m->data = data;
+    m->size = fileSize;
+    m->lastModifiedTime = uint64(_stat.st_mtime);
+    m->flags = flags;
+
+    if ((flags & MappedFileFlags::Prefetch) == MappedFileFlags::Prefetch)
+        Prefetch();
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    MappedFilePosix* m = (MappedFilePosix*)mData;
+    if (m->data) {
+        munmap(m->data, size_t(m->size));
+        m->data = nullptr;
+        m->size = 0;
+    }
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size)
+{
+    MappedFilePosix* m = (MappedFilePosix*)mData;
+    ASSERT(m->data);
+    if (offset >= m->size)
+        return;
+
+    // madvise needs page aligned addresses
+    size = Min<size_t>(size, m->size - offset);
+    size_t pageSize = OS::GetPageSize();
+    size_t start = offset & ~(pageSize - 1);
+    madvise((uint8*)m->data + start, offset + size - start, MADV_WILLNEED);
+}
+
+bool MappedFile::Flush()
+{
+    MappedFilePosix* m = (MappedFilePosix*)mData;
+    ASSERT(m->data);
+    ASSERT_MSG((m->flags & MappedFileFlags::ReadWrite) == MappedFileFlags::ReadWrite, "Only ReadWrite maps can be flushed");
+    return msync(m->data, size_t(m->size), MS_SYNC) == 0;
+}
+
+const void* MappedFile::Data() const
+{
+    const MappedFilePosix* m = (const MappedFilePosix*)mData;
+    return m->data;
+}
+
+void* MappedFile::MutableData() const
+{
+    const MappedFilePosix* m = (const MappedFilePosix*)mData;
+    ASSERT_MSG((m->flags & MappedFileFlags::ReadWrite) == MappedFileFlags::ReadWrite, "Only ReadWrite maps can be modified");
+    return m->data;
+}
+
+size_t MappedFile::GetSize() const
+{
+    const MappedFilePosix* m = (const MappedFilePosix*)mData;
+    return size_t(m->size);
+}
+
+uint64 MappedFile::GetLastModified() const
+{
+    const MappedFilePosix* m = (const MappedFilePosix*)mData;
+    return m->lastModifiedTime;
+}
+
+bool MappedFile::IsOpen() const
+{
+    const MappedFilePosix* m = (const MappedFilePosix*)mData;
+    return m->data != nullptr;
+}
+
 //    ███████╗ ██████╗  ██████╗██╗  ██╗███████╗████████╗
 //    ██╔════╝██╔═══██╗██╔════╝██║ ██╔╝██╔════╝╚══██╔══╝
 //    ███████╗██║   ██║██║     █████╔╝ █████╗     ██║   
@@ -1184,6 +1736,14 @@ bool SocketTCP::Listen(uint16 port, uint32 maxConnections)
     return success;
 }
 
+bool SocketTCP::SetNoDelay(bool enable)
+{
+    ASSERT(IsValid());
+
+    int value = enable ? 1 : 0;
+    return setsockopt(mSock, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value)) == 0;
+}
+
 SocketTCP SocketTCP::Accept(char* clientUrl, uint32 clientUrlSize)
 {
     ASSERT(IsValid());
@@ -1285,6 +1845,62 @@ uint32 SocketTCP::Write(const void* src, uint32 size)
     return totalBytesSent;
 }
 
+uint32 SocketTCP::WriteGather(const SocketBuffer* buffers, uint32 numBuffers)
+{
+    ASSERT(IsValid());
+    ASSERT(mLive);
+    ASSERT(numBuffers <= SOCKET_MAX_GATHER_BUFFERS);
+
+    iovec iovs[SOCKET_MAX_GATHER_BUFFERS];
+    uint32 numIovs = 0;
+    uint32 totalSize = 0;
+    for (uint32 i = 0; i < numBuffers; i++) {
+        if (buffers[i].size) {
+            iovs[numIovs++] = iovec { .iov_base = const_cast<void*>(buffers[i].data), .iov_len = buffers[i].size };
+            totalSize += buffers[i].size;
+        }
+    }
+
+    uint32 totalBytesSent = 0;
+    iovec* iov = iovs;
+    while (totalBytesSent < totalSize) {
+        msghdr msg {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = numIovs;
+
+        ssize_t bytesSent = sendmsg(mSock, &msg, 0);
+        if (bytesSent == 0) {
+            break;
+        }
+        else if (bytesSent == -1) {
+            mErrCode = _private::socketTranslatePlatformErrorCode();
+            if (mErrCode == SocketErrorCode::SocketShutdown ||
+                mErrCode == SocketErrorCode::NotConnected)
+            {
+                LOG_DEBUG("SocketTCP: socket connection closed forcefully by the peer");
+                mLive = false;
+            }
+            return UINT32_MAX;
+        }
+
+        totalBytesSent += static_cast<uint32>(bytesSent);
+
+        // Skip the buffers that are fully sent and adjust the partially sent one
+        size_t remaining = size_t(bytesSent);
+        while (numIovs && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            ++iov;
+            --numIovs;
+        }
+        if (numIovs) {
+            iov->iov_base = (uint8*)iov->iov_base + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+
+    return totalBytesSent;
+}
+
 uint32 SocketTCP::Read(void* dst, uint32 dstSize)
 {
     ASSERT(IsValid());
@@ -1310,6 +1926,194 @@ bool SocketTCP::IsValid() const
     return mSock != SOCKET_INVALID;
 }
 
+#if PLATFORM_ANDROID || PLATFORM_LINUX
+struct SocketPollerData
+{
+    int epollFd;
+    uint32 maxEvents;
+    epoll_event* events;
+};
+
+bool SocketPoller::Initialize(uint32 maxSockets, MemAllocator* alloc)
+{
+    ASSERT(maxSockets);
+    ASSERT_MSG(!mData, "SocketPoller is already initialized");
+
+    MemSingleShotMalloc<SocketPollerData> mallocator;
+    mallocator.AddMemberArray<epoll_event>(offsetof(SocketPollerData, events), maxSockets);
+    SocketPollerData* data = mallocator.Calloc(alloc);
+
+    data->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (data->epollFd == -1) {
+        LOG_ERROR("SocketPoller: epoll_create1 failed (errno: %d)", errno);
+        MemSingleShotMalloc<SocketPollerData>::Free(data, alloc);
+        return false;
+    }
+    data->maxEvents = maxSockets;
+
+    mData = data;
+    mAlloc = alloc;
+    return true;
+}
+
+void SocketPoller::Release()
+{
+    if (mData) {
+        SocketPollerData* data = (SocketPollerData*)mData;
+        close(data->epollFd);
+        MemSingleShotMalloc<SocketPollerData>::Free(data, mAlloc);
+        mData = nullptr;
+    }
+}
+
+bool SocketPoller::Add(const SocketTCP& sock, uint64 userData, SocketPollFlags flags)
+{
+    ASSERT(mData);
+    ASSERT(sock.IsValid());
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    epoll_event ev {};
+    ev.events = (IsBitsSet(flags, SocketPollFlags::Read) ? uint32(EPOLLIN) : 0) |
+                (IsBitsSet(flags, SocketPollFlags::Write) ? uint32(EPOLLOUT) : 0) | uint32(EPOLLRDHUP);
+    ev.data.u64 = userData;
+    if (epoll_ctl(data->epollFd, EPOLL_CTL_ADD, sock.mSock, &ev) == -1) {
+        LOG_ERROR("SocketPoller: Adding socket failed (errno: %d)", errno);
+        return false;
+    }
+    return true;
+}
+
+void SocketPoller::Remove(const SocketTCP& sock)
+{
+    ASSERT(mData);
+    ASSERT(sock.IsValid());
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    epoll_ctl(data->epollFd, EPOLL_CTL_DEL, sock.mSock, nullptr);
+}
+
+uint32 SocketPoller::Wait(SocketPollEvent* outEvents, uint32 maxEvents, uint32 msecs)
+{
+    ASSERT(mData);
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    maxEvents = Min(maxEvents, data->maxEvents);
+    int timeout = msecs == UINT32_MAX ? -1 : int(Min<uint32>(msecs, INT32_MAX));
+    int numEvents = epoll_wait(data->epollFd, data->events, int(maxEvents), timeout);
+    if (numEvents == -1) 
+        return errno == EINTR ? 0 : UINT32_MAX;
+
+    for (int i = 0; i < numEvents; i++) {
+        const epoll_event& ev = data->events[i];
+        SocketPollFlags flags = SocketPollFlags::None;
+        if (ev.events & EPOLLIN)
+            flags |= SocketPollFlags::Read;
+        if (ev.events & EPOLLOUT)
+            flags |= SocketPollFlags::Write;
+        if (ev.events & (EPOLLHUP|EPOLLRDHUP|EPOLLERR))
+            flags |= SocketPollFlags::Hangup;
+        outEvents[i] = SocketPollEvent { .userData = ev.data.u64, .flags = flags };
+    }
+    return uint32(numEvents);
+}
+#else   // PLATFORM_ANDROID || PLATFORM_LINUX
+struct SocketPollerData
+{
+    uint32 numFds;
+    uint32 maxFds;
+    pollfd* fds;
+    uint64* userDatas;
+};
+
+bool SocketPoller::Initialize(uint32 maxSockets, MemAllocator* alloc)
+{
+    ASSERT(maxSockets);
+    ASSERT_MSG(!mData, "SocketPoller is already initialized");
+
+    MemSingleShotMalloc<SocketPollerData> mallocator;
+    mallocator.AddMemberArray<pollfd>(offsetof(SocketPollerData, fds), maxSockets);
+    mallocator.AddMemberArray<uint64>(offsetof(SocketPollerData, userDatas), maxSockets);
+    SocketPollerData* data = mallocator.Calloc(alloc);
+    data->maxFds = maxSockets;
+
+    mData = data;
+    mAlloc = alloc;
+    return true;
+}
+
+void SocketPoller::Release()
+{
+    if (mData) {
+        MemSingleShotMalloc<SocketPollerData>::Free((SocketPollerData*)mData, mAlloc);
+        mData = nullptr;
+    }
+}
+
+bool SocketPoller::Add(const SocketTCP& sock, uint64 userData, SocketPollFlags flags)
+{
+    ASSERT(mData);
+    ASSERT(sock.IsValid());
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    if (data->numFds == data->maxFds) {
+        LOG_ERROR("SocketPoller: Too many sockets (max = %u)", data->maxFds);
+        return false;
+    }
+
+    uint32 index = data->numFds++;
+    data->fds[index] = pollfd {
+        .fd = sock.mSock,
+        .events = short((IsBitsSet(flags, SocketPollFlags::Read) ? POLLIN : 0) |
+                        (IsBitsSet(flags, SocketPollFlags::Write) ? POLLOUT : 0))
+    };
+    data->userDatas[index] = userData;
+    return true;
+}
+
+void SocketPoller::Remove(const SocketTCP& sock)
+{
+    ASSERT(mData);
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    for (uint32 i = 0; i < data->numFds; i++) {
+        if (data->fds[i].fd == sock.mSock) {
+            uint32 lastIndex = --data->numFds;
+            data->fds[i] = data->fds[lastIndex];
+            data->userDatas[i] = data->userDatas[lastIndex];
+            break;
+        }
+    }
+}
+
+uint32 SocketPoller::Wait(SocketPollEvent* outEvents, uint32 maxEvents, uint32 msecs)
+{
+    ASSERT(mData);
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    int timeout = msecs == UINT32_MAX ? -1 : int(Min<uint32>(msecs, INT32_MAX));
+    int r = poll(data->fds, data->numFds, timeout);
+    if (r == -1) 
+        return errno == EINTR ? 0 : UINT32_MAX;
+
+    uint32 numEvents = 0;
+    for (uint32 i = 0; i < data->numFds && numEvents < maxEvents; i++) {
+        short revents = data->fds[i].revents;
+        if (revents == 0)
+            continue;
+
+        SocketPollFlags flags = SocketPollFlags::None;
+        if (revents & POLLIN)
+            flags |= SocketPollFlags::Read;
+        if (revents & POLLOUT)
+            flags |= SocketPollFlags::Write;
+        if (revents & (POLLHUP|POLLERR|POLLNVAL))
+            flags |= SocketPollFlags::Hangup;
+        outEvents[numEvents++] = SocketPollEvent { .userData = data->userDatas[i], .flags = flags };
+    }
+    return numEvents;
+}
+#endif  // else: PLATFORM_ANDROID || PLATFORM_LINUX
+
 //   █████╗ ███████╗██╗   ██╗███╗   ██╗ ██████╗
 //  ██╔══██╗██╔════╝╚██╗ ██╔╝████╗  ██║██╔════╝
 //  ███████║███████╗ ╚████╔╝ ██╔██╗ ██║██║
@@ -328,6 +328,34 @@ void Thread::SetCurrentThreadPriority(ThreadPriority prio)
     ASSERT(r);
 }
 
+static bool _SetThreadAffinity(HANDLE hThread, const uint16* processorIds, uint32 numProcessors)
+{
+    ASSERT(processorIds && numProcessors);
+
+    // Thread affinity can only be set within a single processor group (64 logical processors each)
+    // So we use the group of the first processor and ignore the ones from other groups
+    GROUP_AFFINITY affinity {};
+    affinity.Group = WORD(processorIds[0] / 64);
+    for (uint32 i = 0; i < numProcessors; i++) {
+        if (processorIds[i] / 64 == affinity.Group)
+            affinity.Mask |= KAFFINITY(1) << (processorIds[i] % 64);
+    }
+
+    return SetThreadGroupAffinity(hThread, &affinity, nullptr) != 0;
+}
+
+bool Thread::SetAffinity(const uint16* processorIds, uint32 numProcessors)
+{
+    ThreadImpl* thrd = reinterpret_cast<ThreadImpl*>(mData);
+    ASSERT(thrd->handle);
+    return _SetThreadAffinity(thrd->handle, processorIds, numProcessors);
+}
+
+bool Thread::SetCurrentThreadAffinity(const uint16* processorIds, uint32 numProcessors)
+{
+    return _SetThreadAffinity(GetCurrentThread(), processorIds, numProcessors);
+}
+
 void Thread::SetCurrentThreadName(const char* name)
 {
     wchar_t namew[32];
@@ -945,6 +973,70 @@ void OS::GetSysInfo(SysInfo* info)
     extData.Free();
 }
 
+bool OS::GetCpuTopology(SysCpuTopology* topology)
+{
+    DWORD returnLen = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &returnLen);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+        return false;
+
+    uint8* buffer = (uint8*)Mem::Alloc(returnLen);
+    if (!GetLogicalProcessorInformationEx(RelationAll, (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)buffer, &returnLen)) {
+        Mem::Free(buffer);
+        return false;
+    }
+
+    // Keys are indexed by the global processor id (group*64 + bit)
+    uint32 coreKeyById[SYS_MAX_PROCESSORS];
+    uint32 cacheKeyById[SYS_MAX_PROCESSORS];
+    memset(coreKeyById, 0xff, sizeof(coreKeyById));
+    memset(cacheKeyById, 0xff, sizeof(cacheKeyById));
+
+    auto ForEachProcessorInMask = [](const GROUP_AFFINITY& groupMask, auto func) {
+        for (uint32 bit = 0; bit < 64; bit++) {
+            uint32 id = uint32(groupMask.Group)*64 + bit;
+            if ((groupMask.Mask & (KAFFINITY(1) << bit)) && id < SYS_MAX_PROCESSORS)
+                func(id);
+        }
+    };
+
+    uint32 numCoreEntries = 0;
+    uint32 numCacheEntries = 0;
+    for (DWORD offset = 0; offset < returnLen;) {
+        const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* ptr = (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)(buffer + offset);
+        if (ptr->Relationship == RelationProcessorCore) {
+            uint32 key = numCoreEntries++;
+            for (WORD g = 0; g < ptr->Processor.GroupCount; g++)
+                ForEachProcessorInMask(ptr->Processor.GroupMask[g], [&](uint32 id) { coreKeyById[id] = key; });
+        }
+        else if (ptr->Relationship == RelationCache && ptr->Cache.Level == 3) {
+            uint32 key = numCacheEntries++;
+            ForEachProcessorInMask(ptr->Cache.GroupMask, [&](uint32 id) { cacheKeyById[id] = key; });
+        }
+        offset += ptr->Size;
+    }
+    Mem::Free(buffer);
+
+    uint32 coreKeys[SYS_MAX_PROCESSORS];
+    uint32 cacheKeys[SYS_MAX_PROCESSORS];
+    uint32 numProcessors = 0;
+    for (uint32 id = 0; id < SYS_MAX_PROCESSORS; id++) {
+        if (coreKeyById[id] == UINT32_MAX)
+            continue;
+        topology->processors[numProcessors].id = uint16(id);
+        coreKeys[numProcessors] = coreKeyById[id];
+        cacheKeys[numProcessors] = cacheKeyById[id] != UINT32_MAX ? cacheKeyById[id] : 0x80000000;   // No L3: single domain
+        numProcessors++;
+    }
+
+    if (numProcessors == 0)
+        return false;
+
+    topology->numProcessors = numProcessors;
+    _private::CpuTopologyFinalize(topology, coreKeys, cacheKeys);
+    return true;
+}
+
 #if PLATFORM_PC
 OSProcess::OSProcess() :
     mProcess(INVALID_HANDLE_VALUE),
@@ -1861,6 +1953,174 @@ bool File::IsOpen() const
     return f->handle != INVALID_HANDLE_VALUE;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// MappedFile
+struct MappedFileWin
+{
+    HANDLE      file;
+    HANDLE      mapping;
+    void*       data;
+    uint64      size;
+    uint64      lastModifiedTime;
+    MappedFileFlags flags;
+};
+static_assert(sizeof(MappedFileWin) <= sizeof(MappedFile));
+
+MappedFile::MappedFile()
+{
+    MappedFileWin* m = (MappedFileWin*)mData;
+    m->file = INVALID_HANDLE_VALUE;
+    m->mapping = nullptr;
+    m->data = nullptr;
+    m->size = 0;
+    m->lastModifiedTime = 0;
+    m->flags = MappedFileFlags::None;
+}
+
+bool MappedFile::Open(const char* filepath, MappedFileFlags flags, size_t size)
+{
+    MappedFileWin* m = (MappedFileWin*)mData;
+    ASSERT_MSG(!m->data, "MappedFile is already open");
+
+    bool readWrite = (flags & MappedFileFlags::ReadWrite) == MappedFileFlags::ReadWrite;
+    ASSERT_MSG(readWrite || size == 0, "Size can only be set for ReadWrite maps");
+
+    uint32 attrs = FILE_ATTRIBUTE_NORMAL;
+    if ((flags & MappedFileFlags::SeqScan) == MappedFileFlags::SeqScan)             attrs |= FILE_FLAG_SEQUENTIAL_SCAN;
+    if ((flags & MappedFileFlags::RandomAccess) == MappedFileFlags::RandomAccess)   attrs |= FILE_FLAG_RANDOM_ACCESS;
+
+    HANDLE hfile = readWrite ?
+        CreateFileA(filepath, GENERIC_READ|GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, attrs, NULL) :
+        CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, attrs, NULL);
+    if (hfile == INVALID_HANDLE_VALUE)
+        return false;
+
+    uint64 fileSize;
+    uint64 lastModifiedTime;
+    if (!_GetFileInfo(hfile, &fileSize, &lastModifiedTime)) {
+        CloseHandle(hfile);
+        return false;
+    }
+
+    // Mapping with a bigger size than the file grows it, but doesn't truncate it. So resize explicitly
+    if (readWrite && size && size != fileSize) {
+        LARGE_INTEGER largeSize;
+        largeSize.QuadPart = LONGLONG(size);
+        if (!SetFilePointerEx(hfile, largeSize, NULL, FILE_BEGIN) || !SetEndOfFile(hfile)) {
+            CloseHandle(hfile);
+            return false;
+        }
+        fileSize = size;
+    }
+
+    if (fileSize == 0) {
+        CloseHandle(hfile);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(hfile, NULL, readWrite ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(hfile);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, readWrite ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(hfile);
+        return false;
+    }
+
+    // File handle is only kept for Flush, the mapping keeps its own reference to the file
+    if (!readWrite) {
+        CloseHandle(hfile);
+        hfile = INVALID_HANDLE_VALUE;
+    }
+
+    m->file = hfile;
+    m->mapping = mapping;
+    m->data = data;
+    m->size = fileSize;
+    m->lastModifiedTime = lastModifiedTime;
+    m->flags = flags;
+
+    if ((flags & MappedFileFlags::Prefetch) == MappedFileFlags::Prefetch)
+        Prefetch();
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    MappedFileWin* m = (MappedFileWin*)mData;
+    if (m->data) {
+        UnmapViewOfFile(m->data);
+        CloseHandle(m->mapping);
+        if (m->file != INVALID_HANDLE_VALUE)
+            CloseHandle(m->file);
+        m->file = INVALID_HANDLE_VALUE;
+        m->data = nullptr;
+        m->mapping = nullptr;
+        m->size = 0;
+    }
+}
+
+void MappedFile::Prefetch([[maybe_unused]] size_t offset, [[maybe_unused]] size_t size)
+{
+    MappedFileWin* m = (MappedFileWin*)mData;
+    ASSERT(m->data);
+
+    #if _WIN32_WINNT >= 0x0602
+    if (offset >= m->size)
+        return;
+
+    WIN32_MEMORY_RANGE_ENTRY range {
+        .VirtualAddress = (uint8*)m->data + offset,
+        .NumberOfBytes = Min<size_t>(size, m->size - offset)
+    };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    #endif
+}
+
+bool MappedFile::Flush()
+{
+    MappedFileWin* m = (MappedFileWin*)mData;
+    ASSERT(m->data);
+    ASSERT_MSG((m->flags & MappedFileFlags::ReadWrite) == MappedFileFlags::ReadWrite, "Only ReadWrite maps can be flushed");
+    return FlushViewOfFile(m->data, 0) && FlushFileBuffers(m->file);
+}
+
+const void* MappedFile::Data() const
+{
+    const MappedFileWin* m = (const MappedFileWin*)mData;
+    return m->data;
+}
+
+void* MappedFile::MutableData() const
+{
+    const MappedFileWin* m = (const MappedFileWin*)mData;
+    ASSERT_MSG((m->flags & MappedFileFlags::ReadWrite) == MappedFileFlags::ReadWrite, "Only ReadWrite maps can be modified");
+    return m->data;
+}
+
+size_t MappedFile::GetSize() const
+{
+    const MappedFileWin* m = (const MappedFileWin*)mData;
+    return size_t(m->size);
+}
+
+uint64 MappedFile::GetLastModified() const
+{
+    const MappedFileWin* m = (const MappedFileWin*)mData;
+    return m->lastModifiedTime;
+}
+
+bool MappedFile::IsOpen() const
+{
+    const MappedFileWin* m = (const MappedFileWin*)mData;
+    return m->data != nullptr;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // AsyncFile
 struct alignas(4096) AsyncFileWin
@@ -2230,6 +2490,14 @@ bool SocketTCP::Listen(uint16 port, uint32 maxConnections)
     return success;
 }
 
+bool SocketTCP::SetNoDelay(bool enable)
+{
+    ASSERT(IsValid());
+
+    BOOL value = enable ? TRUE : FALSE;
+    return setsockopt(mSock, IPPROTO_TCP, TCP_NODELAY, (const char*)&value, sizeof(value)) == 0;
+}
+
 SocketTCP SocketTCP::Accept(char* clientUrl, uint32 clientUrlSize)
 {
     ASSERT(IsValid());
@@ -2333,6 +2601,58 @@ uint32 SocketTCP::Write(const void* src, uint32 size)
     return totalBytesSent;
 }
 
+uint32 SocketTCP::WriteGather(const SocketBuffer* buffers, uint32 numBuffers)
+{
+    ASSERT(IsValid());
+    ASSERT(mLive);
+    ASSERT(numBuffers <= SOCKET_MAX_GATHER_BUFFERS);
+
+    WSABUF wsaBufs[SOCKET_MAX_GATHER_BUFFERS];
+    uint32 numWsaBufs = 0;
+    uint32 totalSize = 0;
+    for (uint32 i = 0; i < numBuffers; i++) {
+        if (buffers[i].size) {
+            wsaBufs[numWsaBufs++] = WSABUF { .len = buffers[i].size, .buf = (CHAR*)const_cast<void*>(buffers[i].data) };
+            totalSize += buffers[i].size;
+        }
+    }
+
+    uint32 totalBytesSent = 0;
+    WSABUF* wsaBuf = wsaBufs;
+    while (totalBytesSent < totalSize) {
+        DWORD bytesSent = 0;
+        if (WSASend(mSock, wsaBuf, numWsaBufs, &bytesSent, 0, nullptr, nullptr) == SOCKET_ERROR) {
+            mErrCode = _private::socketTranslatePlatformErrorCode();
+            if (mErrCode == SocketErrorCode::SocketShutdown ||
+                mErrCode == SocketErrorCode::NotConnected)
+            {
+                LOG_DEBUG("SocketTCP: socket connection closed forcefully by the peer");
+                mLive = false;
+            }
+            return UINT32_MAX;
+        }
+        else if (bytesSent == 0) {
+            break;
+        }
+
+        totalBytesSent += bytesSent;
+
+        // Skip the buffers that are fully sent and adjust the partially sent one
+        ULONG remaining = bytesSent;
+        while (numWsaBufs && remaining >= wsaBuf->len) {
+            remaining -= wsaBuf->len;
+            ++wsaBuf;
+            --numWsaBufs;
+        }
+        if (numWsaBufs) {
+            wsaBuf->buf += remaining;
+            wsaBuf->len -= remaining;
+        }
+    }
+
+    return totalBytesSent;
+}
+
 uint32 SocketTCP::Read(void* dst, uint32 dstSize)
 {
     ASSERT(IsValid());
@@ -2358,4 +2678,108 @@ bool SocketTCP::IsValid() const
     return mSock != SOCKET_INVALID;
 }
 
+struct SocketPollerData
+{
+    uint32 numFds;
+    uint32 maxFds;
+    WSAPOLLFD* fds;
+    uint64* userDatas;
+};
+
+bool SocketPoller::Initialize(uint32 maxSockets, MemAllocator* alloc)
+{
+    ASSERT(maxSockets);
+    ASSERT_MSG(!mData, "SocketPoller is already initialized");
+
+    _private::socketInitializeWin32();
+
+    MemSingleShotMalloc<SocketPollerData> mallocator;
+    mallocator.AddMemberArray<WSAPOLLFD>(offsetof(SocketPollerData, fds), maxSockets);
+    mallocator.AddMemberArray<uint64>(offsetof(SocketPollerData, userDatas), maxSockets);
+    SocketPollerData* data = mallocator.Calloc(alloc);
+    data->maxFds = maxSockets;
+
+    mData = data;
+    mAlloc = alloc;
+    return true;
+}
+
+void SocketPoller::Release()
+{
+    if (mData) {
+        MemSingleShotMalloc<SocketPollerData>::Free((SocketPollerData*)mData, mAlloc);
+        mData = nullptr;
+    }
+}
+
+bool SocketPoller::Add(const SocketTCP& sock, uint64 userData, SocketPollFlags flags)
+{
+    ASSERT(mData);
+    ASSERT(sock.IsValid());
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    if (data->numFds == data->maxFds) {
+        LOG_ERROR("SocketPoller: Too many sockets (max = %u)", data->maxFds);
+        return false;
+    }
+
+    uint32 index = data->numFds++;
+    data->fds[index] = WSAPOLLFD {
+        .fd = SOCKET(sock.mSock),
+        .events = SHORT((IsBitsSet(flags, SocketPollFlags::Read) ? POLLRDNORM : 0) |
+                        (IsBitsSet(flags, SocketPollFlags::Write) ? POLLWRNORM : 0))
+    };
+    data->userDatas[index] = userData;
+    return true;
+}
+
+void SocketPoller::Remove(const SocketTCP& sock)
+{
+    ASSERT(mData);
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    for (uint32 i = 0; i < data->numFds; i++) {
+        if (data->fds[i].fd == SOCKET(sock.mSock)) {
+            uint32 lastIndex = --data->numFds;
+            data->fds[i] = data->fds[lastIndex];
+            data->userDatas[i] = data->userDatas[lastIndex];
+            break;
+        }
+    }
+}
+
+uint32 SocketPoller::Wait(SocketPollEvent* outEvents, uint32 maxEvents, uint32 msecs)
+{
+    ASSERT(mData);
+    SocketPollerData* data = (SocketPollerData*)mData;
+
+    // WSAPoll fails on empty sets, so just act like a timeout
+    if (data->numFds == 0) {
+        Thread::Sleep(msecs == UINT32_MAX ? 1 : msecs);
+        return 0;
+    }
+
+    int timeout = msecs == UINT32_MAX ? -1 : int(Min<uint32>(msecs, INT32_MAX));
+    int r = WSAPoll(data->fds, data->numFds, timeout);
+    if (r == SOCKET_ERROR) 
+        return UINT32_MAX;
+
+    uint32 numEvents = 0;
+    for (uint32 i = 0; i < data->numFds && numEvents < maxEvents; i++) {
+        SHORT revents = data->fds[i].revents;
+        if (revents == 0)
+            continue;
+
+        SocketPollFlags flags = SocketPollFlags::None;
+        if (revents & POLLRDNORM)
+            flags |= SocketPollFlags::Read;
+        if (revents & POLLWRNORM)
+            flags |= SocketPollFlags::Write;
+        if (revents & (POLLHUP|POLLERR|POLLNVAL))
+            flags |= SocketPollFlags::Hangup;
+        outEvents[numEvents++] = SocketPollEvent { .userData = data->userDatas[i], .flags = flags };
+    }
+    return numEvents;
+}
+
 #endif // PLATFORM_WINDOWS
@@ -95,4 +95,380 @@ Tracy::CpuProfilerScope::~CpuProfilerScope()
 }
 
 
-#endif  // TRACY_ENABLE
+#elif CONFIG_ENABLE_PROFILER
+
+#include "Atomic.h"
+#include "System.h"
+#include "Allocators.h"
+#include "Arrays.h"
+#include "Hash.h"
+#include "Log.h"
+
+static constexpr uint32 PROFILER_MAX_THREADS = 64;
+static constexpr uint32 PROFILER_MAX_ZONES_PER_THREAD = 32*1024;    // Must be power of two
+static constexpr uint32 PROFILER_MAX_FRAMES = 256;                  // Must be power of two
+static constexpr uint32 PROFILER_JSON_PID = 1;
+
+static_assert((PROFILER_MAX_ZONES_PER_THREAD & (PROFILER_MAX_ZONES_PER_THREAD - 1)) == 0);
+static_assert((PROFILER_MAX_FRAMES & (PROFILER_MAX_FRAMES - 1)) == 0);
+
+struct ProfilerZoneRecord
+{
+    const ProfilerSourceLocation* sourceLoc;
+    uint64 startTick;
+    uint64 endTick;
+};
+
+// Single producer (owner thread) ring-buffer. Readers copy the records and then drop the ones that might have been 
+// overwritten in the meantime by checking writeIndex again, so the owner thread never waits for anything
+struct ProfilerThreadBuffer
+{
+    AtomicUint64 writeIndex;
+    AtomicUint32 registered;
+    uint32 threadId;
+    char threadName[32];
+    ProfilerZoneRecord* records;
+};
+
+struct ProfilerThreadContext
+{
+    ProfilerThreadBuffer* buffer;
+    uint32 generation;
+};
+
+struct ProfilerContext
+{
+    MemAllocator* alloc = Mem::GetDefaultAlloc();
+    bool enabled;
+    uint32 generation = 1;      // Increments on each Release, so the threads know that their cached buffers are not valid anymore
+    ProfilerZoneEnterCallback zoneEnterCallback;
+    ProfilerZoneExitCallback zoneExitCallback;
+
+    AtomicUint32 numThreads;
+    ProfilerThreadBuffer threads[PROFILER_MAX_THREADS];
+
+    AtomicUint64 numFrames;
+    uint64 frameTicks[PROFILER_MAX_FRAMES];     // Ticks at the end of each frame (see MarkFrame)
+
+    // Copies of the source locations for PROFILE_ZONE_ALLOC macros. Those are on the stack and names can be dynamic
+    SpinLockMutex allocSourceLocsLock;
+    HashTable<ProfilerSourceLocation*> allocSourceLocs;
+};
+
+static ProfilerContext gProfiler;
+
+namespace Profiler
+{
+    NO_INLINE static ProfilerThreadContext& _GetThreadContext()
+    {
+        static thread_local ProfilerThreadContext threadCtx;
+        return threadCtx;
+    }
+
+    static ProfilerThreadBuffer* _GetThreadBuffer()
+    {
+        ProfilerThreadContext& threadCtx = _GetThreadContext();
+        if (threadCtx.buffer && threadCtx.generation == gProfiler.generation)
+            return threadCtx.buffer;
+
+        uint32 index = Atomic::FetchAdd(&gProfiler.numThreads, 1);
+        if (index >= PROFILER_MAX_THREADS) {
+            // Too many threads. Zones of this thread are dropped
+            Atomic::FetchSub(&gProfiler.numThreads, 1);
+            return nullptr;
+        }
+
+        ProfilerThreadBuffer* buffer = &gProfiler.threads[index];
+        buffer->records = Mem::AllocTyped<ProfilerZoneRecord>(PROFILER_MAX_ZONES_PER_THREAD, gProfiler.alloc);
+        buffer->threadId = Thread::GetCurrentId();
+        Thread::GetCurrentThreadName(buffer->threadName, sizeof(buffer->threadName));
+        Atomic::StoreExplicit(&buffer->writeIndex, 0, AtomicMemoryOrder::Relaxed);
+        Atomic::StoreExplicit(&buffer->registered, 1, AtomicMemoryOrder::Release);
+
+        threadCtx.buffer = buffer;
+        threadCtx.generation = gProfiler.generation;
+        return buffer;
+    }
+
+    static void _RecordZone(const ProfilerSourceLocation* sourceLoc, uint64 startTick, uint64 endTick)
+    {
+        ProfilerThreadBuffer* buffer = _GetThreadBuffer();
+        if (!buffer)
+            return;
+
+        // Only the owner thread writes, so there is no need for RMW operations here
+        uint64 index = Atomic::LoadExplicit(&buffer->writeIndex, AtomicMemoryOrder::Relaxed);
+        buffer->records[index & (PROFILER_MAX_ZONES_PER_THREAD - 1)] = {
+            .sourceLoc = sourceLoc,
+            .startTick = startTick,
+            .endTick = endTick
+        };
+        Atomic::StoreExplicit(&buffer->writeIndex, index + 1, AtomicMemoryOrder::Release);
+    }
+
+    static const ProfilerSourceLocation* _AllocSourceLocation(const ProfilerSourceLocation& sourceLoc)
+    {
+        uint32 nameLen = Str::Len(sourceLoc.name);
+        uint32 hash = HashMurmur32Incremental()
+            .AddAny(sourceLoc.name, nameLen)
+            .Add<uintptr_t>(reinterpret_cast<uintptr_t>(sourceLoc.file))
+            .Add<uint32>(sourceLoc.line)
+            .Hash();
+
+        SpinLockMutexScope lock(gProfiler.allocSourceLocsLock);
+        if (ProfilerSourceLocation* existing = gProfiler.allocSourceLocs.FindAndFetch(hash, nullptr))
+            return existing;
+
+        // Source location and the name are in the same allocation. function/file are always static strings
+        ProfilerSourceLocation* loc = (ProfilerSourceLocation*)Mem::Alloc(sizeof(ProfilerSourceLocation) + nameLen + 1, gProfiler.alloc);
+        char* name = (char*)(loc + 1);
+        memcpy(name, sourceLoc.name, nameLen + 1);
+        *loc = sourceLoc;
+        loc->name = name;
+
+        gProfiler.allocSourceLocs.Add(hash, loc);
+        return loc;
+    }
+
+    // Copies the recorded zones of a thread and returns the number of valid records in 'outRecords'
+    static uint32 _CopyThreadZones(ProfilerThreadBuffer* buffer, ProfilerZoneRecord* outRecords)
+    {
+        uint64 writeIndex = Atomic::LoadExplicit(&buffer->writeIndex, AtomicMemoryOrder::Acquire);
+        uint64 firstIndex = writeIndex > PROFILER_MAX_ZONES_PER_THREAD ? (writeIndex - PROFILER_MAX_ZONES_PER_THREAD) : 0;
+        for (uint64 i = firstIndex; i < writeIndex; i++)
+            outRecords[i - firstIndex] = buffer->records[i & (PROFILER_MAX_ZONES_PER_THREAD - 1)];
+
+        // The owner thread may have moved on and overwritten the oldest records while we were copying them
+        Atomic::ThreadFence(AtomicMemoryOrder::Acquire);
+        uint64 newWriteIndex = Atomic::LoadExplicit(&buffer->writeIndex, AtomicMemoryOrder::Relaxed);
+        uint64 validIndex = newWriteIndex >= PROFILER_MAX_ZONES_PER_THREAD ? (newWriteIndex - PROFILER_MAX_ZONES_PER_THREAD + 1) : 0;
+        uint32 count = uint32(writeIndex - firstIndex);
+        if (validIndex > firstIndex) {
+            uint32 numDropped = uint32(Min<uint64>(validIndex - firstIndex, count));
+            memmove(outRecords, outRecords + numDropped, (count - numDropped)*sizeof(ProfilerZoneRecord));
+            count -= numDropped;
+        }
+
+        return count;
+    }
+
+    static void _WriteJsonString(Array<char>& out, const char* str)
+    {
+        out.Push('"');
+        for (const char* c = str; *c; c++) {
+            if (*c == '"' || *c == '\\') {
+                out.Push('\\');
+                out.Push(*c);
+            }
+            else if (uint8(*c) >= 32) {
+                out.Push(*c);
+            }
+        }
+        out.Push('"');
+    }
+} // Profiler
+
+void Profiler::SetEnabled(bool enable)
+{
+    gProfiler.enabled = enable;
+}
+
+bool Profiler::IsEnabled()
+{
+    return gProfiler.enabled;
+}
+
+void Profiler::Release()
+{
+    gProfiler.enabled = false;
+
+    uint32 numThreads = Min(Atomic::Load(&gProfiler.numThreads), PROFILER_MAX_THREADS);
+    for (uint32 i = 0; i < numThreads; i++) {
+        ProfilerThreadBuffer& buffer = gProfiler.threads[i];
+        Mem::Free(buffer.records, gProfiler.alloc);
+        buffer.records = nullptr;
+        Atomic::StoreExplicit(&buffer.registered, 0, AtomicMemoryOrder::Relaxed);
+    }
+    Atomic::StoreExplicit(&gProfiler.numThreads, 0, AtomicMemoryOrder::Release);
+    ++gProfiler.generation;
+
+    if (gProfiler.allocSourceLocs.mHashTable) {
+        const ProfilerSourceLocation* const* locs = gProfiler.allocSourceLocs.Values();
+        for (uint32 i = 0; i < gProfiler.allocSourceLocs.Capacity(); i++) {
+            if (gProfiler.allocSourceLocs.Keys()[i])
+                Mem::Free(const_cast<ProfilerSourceLocation*>(locs[i]), gProfiler.alloc);
+        }
+        gProfiler.allocSourceLocs.Free();
+    }
+}
+
+void Profiler::SetZoneCallbacks(ProfilerZoneEnterCallback zoneEnterCallback, ProfilerZoneExitCallback zoneExitCallback)
+{
+    gProfiler.zoneEnterCallback = zoneEnterCallback;
+    gProfiler.zoneExitCallback = zoneExitCallback;
+}
+
+void Profiler::SuspendZone(ProfilerZone* zone)
+{
+    ASSERT(zone->sourceLoc);
+    Profiler::_RecordZone(zone->sourceLoc, zone->startTick, Timer::GetTicks());
+}
+
+void Profiler::ResumeZone(ProfilerZone* zone)
+{
+    ASSERT(zone->sourceLoc);
+    zone->startTick = Timer::GetTicks();
+}
+
+uint64 Profiler::MarkFrame()
+{
+    uint64 tick = Timer::GetTicks();
+    uint64 frameIndex = Atomic::LoadExplicit(&gProfiler.numFrames, AtomicMemoryOrder::Relaxed);
+    uint64 frameTicks = frameIndex ? Timer::Diff(tick, gProfiler.frameTicks[(frameIndex - 1) & (PROFILER_MAX_FRAMES - 1)]) : 0;
+
+    gProfiler.frameTicks[frameIndex & (PROFILER_MAX_FRAMES - 1)] = tick;
+    Atomic::StoreExplicit(&gProfiler.numFrames, frameIndex + 1, AtomicMemoryOrder::Release);
+    return frameTicks;
+}
+
+bool Profiler::DumpChromeTrace(const char* filepath, uint32 numFrames)
+{
+    ASSERT(filepath);
+
+    uint64 totalFrames = Atomic::LoadExplicit(&gProfiler.numFrames, AtomicMemoryOrder::Acquire);
+    if (totalFrames == 0) {
+        LOG_WARNING("Profiler: No frames are recorded yet");
+        return false;
+    }
+
+    // Keep one frame as margin, because MarkFrame can overwrite the oldest one if we are not on the main thread
+    numFrames = Clamp<uint32>(numFrames, 1, PROFILER_MAX_FRAMES - 1);
+    uint64 startTick = 0;
+    uint64 firstFrame = 0;
+    if (totalFrames > numFrames) {
+        firstFrame = totalFrames - numFrames;
+        startTick = gProfiler.frameTicks[(firstFrame - 1) & (PROFILER_MAX_FRAMES - 1)];
+    }
+
+    MemTempAllocator tempAlloc;
+    ProfilerZoneRecord* records = tempAlloc.MallocTyped<ProfilerZoneRecord>(PROFILER_MAX_ZONES_PER_THREAD);
+    Array<char> out(&tempAlloc);
+    char line[512];
+    uint32 lineLen;
+    uint32 numZones = 0;
+
+    // All timestamps are relative to the first tick, chrome trace expects microseconds
+    uint64 baseTick = UINT64_MAX;
+    uint32 numThreads = Min(Atomic::LoadExplicit(&gProfiler.numThreads, AtomicMemoryOrder::Acquire), PROFILER_MAX_THREADS);
+    Array<uint32> threadRecordCounts(&tempAlloc);
+    Array<ProfilerZoneRecord*> threadRecords(&tempAlloc);
+    for (uint32 i = 0; i < numThreads; i++) {
+        ProfilerThreadBuffer* buffer = &gProfiler.threads[i];
+        if (!Atomic::LoadExplicit(&buffer->registered, AtomicMemoryOrder::Acquire)) {
+            threadRecordCounts.Push(0);
+            threadRecords.Push(nullptr);
+            continue;
+        }
+
+        uint32 count = Profiler::_CopyThreadZones(buffer, records);
+        ProfilerZoneRecord* threadZones = tempAlloc.MallocTyped<ProfilerZoneRecord>(Max(count, 1u));
+        uint32 numThreadZones = 0;
+        for (uint32 k = 0; k < count; k++) {
+            if (records[k].endTick >= startTick) {
+                threadZones[numThreadZones++] = records[k];
+                baseTick = Min(baseTick, records[k].startTick);
+            }
+        }
+
+        threadRecordCounts.Push(numThreadZones);
+        threadRecords.Push(threadZones);
+    }
+
+    if (baseTick == UINT64_MAX)
+        baseTick = startTick;
+
+    out.Extend("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", 33);
+    bool first = true;
+    auto BeginEvent = [&first, &out]() { if (!first) out.Extend(",\n", 2); first = false; };
+
+    for (uint32 i = 0; i < numThreads; i++) {
+        if (!threadRecordCounts[i])
+            continue;
+
+        const ProfilerThreadBuffer& buffer = gProfiler.threads[i];
+        BeginEvent();
+        lineLen = Str::PrintFmt(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":", 
+                                PROFILER_JSON_PID, buffer.threadId);
+        out.Extend(line, lineLen);
+        Profiler::_WriteJsonString(out, buffer.threadName[0] ? buffer.threadName : "Thread");
+        out.Extend("}}", 2);
+
+        for (uint32 k = 0; k < threadRecordCounts[i]; k++) {
+            const ProfilerZoneRecord& rec = threadRecords[i][k];
+            BeginEvent();
+            out.Extend("{\"name\":", 8);
+            Profiler::_WriteJsonString(out, rec.sourceLoc->name ? rec.sourceLoc->name : rec.sourceLoc->function);
+            lineLen = Str::PrintFmt(line, sizeof(line), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%u,\"tid\":%u,\"args\":{\"file\":",
+                                    Timer::ToUS(Timer::Diff(rec.startTick, baseTick)), Timer::ToUS(Timer::Diff(rec.endTick, rec.startTick)),
+                                    PROFILER_JSON_PID, buffer.threadId);
+            out.Extend(line, lineLen);
+            Profiler::_WriteJsonString(out, rec.sourceLoc->file);
+            lineLen = Str::PrintFmt(line, sizeof(line), ",\"line\":%u}}", rec.sourceLoc->line);
+            out.Extend(line, lineLen);
+            ++numZones;
+        }
+    }
+
+    // Frame boundaries as global instant events
+    for (uint64 frame = firstFrame; frame < totalFrames; frame++) {
+        uint64 tick = gProfiler.frameTicks[frame & (PROFILER_MAX_FRAMES - 1)];
+        if (tick < baseTick)
+            continue;
+        BeginEvent();
+        lineLen = Str::PrintFmt(line, sizeof(line), "{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":%u,\"tid\":0}",
+                                frame, Timer::ToUS(Timer::Diff(tick, baseTick)), PROFILER_JSON_PID);
+        out.Extend(line, lineLen);
+    }
+    out.Extend("\n]}\n", 4);
+
+    bool r = false;
+    File file;
+    if (file.Open(filepath, FileOpenFlags::Write)) {
+        r = file.Write(out.Ptr(), out.Count()) == out.Count();
+        file.Close();
+    }
+
+    if (!r) {
+        LOG_ERROR("Profiler: Writing chrome trace to '%s' failed", filepath);
+        return false;
+    }
+
+    LOG_INFO("Profiler: %u zones from the last %u frames written to '%s'", numZones, uint32(totalFrames - firstFrame), filepath);
+    return true;
+}
+
+Profiler::CpuProfilerScope::CpuProfilerScope(const ProfilerSourceLocation* sourceLoc, bool isActive, bool isAlloc)
+{
+    mZone = {};
+    if (!isActive || !gProfiler.enabled)
+        return;
+
+    mZone.sourceLoc = isAlloc ? Profiler::_AllocSourceLocation(*sourceLoc) : sourceLoc;
+    mZone.startTick = Timer::GetTicks();
+
+    if (gProfiler.zoneEnterCallback)
+        gProfiler.zoneEnterCallback(&mZone);
+}
+
+Profiler::CpuProfilerScope::~CpuProfilerScope()
+{
+    if (!mZone.sourceLoc)
+        return;
+
+    if (gProfiler.zoneExitCallback)
+        gProfiler.zoneExitCallback(&mZone);
+
+    Profiler::_RecordZone(mZone.sourceLoc, mZone.startTick, Timer::GetTicks());
+}
+
+#endif  // CONFIG_ENABLE_PROFILER
@@ -83,6 +83,76 @@
         #define PROFILE_ZONE_COLOR(name, color) PROFILE_ZONE_COLOR_OPT(name, color, true)
         #define PROFILE_ZONE_ALLOC_COLOR(name, color) PROFILE_ZONE_ALLOC_COLOR_OPT(name, color, true)
     #endif // else: TRACY_HAS_CALLBACK
+#elif CONFIG_ENABLE_PROFILER
+    // Built-in CPU profiler, used when Tracy is not available (headless servers, remote perf reports, etc.)
+    // Each thread records finished zones into it's own lock-free ring-buffer. Recording is disabled by default (see Profiler::SetEnabled)
+    // Use Profiler::DumpChromeTrace to write the last N frames into a json file that can be opened by chrome://tracing or ui.perfetto.dev
+    struct ProfilerSourceLocation
+    {
+        const char* name;
+        const char* function;
+        const char* file;
+        uint32 line;
+        uint32 color;
+    };
+
+    // Zone that is currently open. Lives on the stack of the caller, so Jobs can keep the pointers while fibers are suspended
+    struct ProfilerZone
+    {
+        const ProfilerSourceLocation* sourceLoc;
+        uint64 startTick;
+    };
+
+    using ProfilerZoneEnterCallback = void(*)(ProfilerZone* zone);
+    using ProfilerZoneExitCallback = void(*)(ProfilerZone* zone);
+
+    namespace Profiler
+    {
+        API void SetEnabled(bool enable);
+        API bool IsEnabled();
+        API void Release();
+
+        API void SetZoneCallbacks(ProfilerZoneEnterCallback zoneEnterCallback, ProfilerZoneExitCallback zoneExitCallback);
+
+        // Fibers: Suspend records the part of the zone that has run on the current thread, Resume restarts the zone on the new thread
+        API void SuspendZone(ProfilerZone* zone);
+        API void ResumeZone(ProfilerZone* zone);
+
+        // Call once per frame. Returns the duration of the frame that just ended in ticks (0 for the first frame)
+        API uint64 MarkFrame();
+
+        API bool DumpChromeTrace(const char* filepath, uint32 numFrames);
+
+        struct CpuProfilerScope
+        {
+            ProfilerZone mZone;
+
+            CpuProfilerScope() = delete;
+
+            explicit CpuProfilerScope(const ProfilerSourceLocation* sourceLoc, bool isActive, bool isAlloc);
+            ~CpuProfilerScope();
+        };
+    }
+
+    #define PROFILE_ZONE_OPT(name, active) \
+        static constexpr ProfilerSourceLocation CONCAT(__profiler_source_location,__LINE__) = { name, __func__,  __FILE__, (uint32)__LINE__, 0 }; \
+        Profiler::CpuProfilerScope CONCAT(__cpu_profiler,__LINE__)(&CONCAT(__profiler_source_location,__LINE__), active, false)
+    #define PROFILE_ZONE_ALLOC_OPT(name, active) \
+        ProfilerSourceLocation CONCAT(__profiler_source_location,__LINE__) = { name, __func__,  __FILE__, (uint32)__LINE__, 0 }; \
+        Profiler::CpuProfilerScope CONCAT(__cpu_profiler,__LINE__)(&CONCAT(__profiler_source_location,__LINE__), active, true)
+    #define PROFILE_ZONE_COLOR_OPT(name, color, active) \
+        static constexpr ProfilerSourceLocation CONCAT(__profiler_source_location,__LINE__) = { name, __func__,  __FILE__, (uint32)__LINE__, color }; \
+        Profiler::CpuProfilerScope CONCAT(__cpu_profiler,__LINE__)(&CONCAT(__profiler_source_location,__LINE__), active, false)
+    #define PROFILE_ZONE_ALLOC_COLOR_OPT(name, color, active) \
+        ProfilerSourceLocation CONCAT(__profiler_source_location,__LINE__) = { name, __func__,  __FILE__, (uint32)__LINE__, color }; \
+        Profiler::CpuProfilerScope CONCAT(__cpu_profiler,__LINE__)(&CONCAT(__profiler_source_location,__LINE__), active, true)
+
+    #define PROFILE_ZONE(name) PROFILE_ZONE_OPT(name, true)
+    #define PROFILE_ZONE_ALLOC(name) PROFILE_ZONE_ALLOC_OPT(name, true)
+    #define PROFILE_ZONE_COLOR(name, color) PROFILE_ZONE_COLOR_OPT(name, color, true)
+    #define PROFILE_ZONE_ALLOC_COLOR(name, color) PROFILE_ZONE_ALLOC_COLOR_OPT(name, color, true)
+
+    #define TracyCRealloc(oldPtr, ptr, size)
 #else
     #define PROFILE_ZONE_OPT(name, active)
     #define PROFILE_ZONE_ALLOC_OPT(name, active)
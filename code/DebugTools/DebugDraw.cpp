@@ -7,11 +7,15 @@
 
 #include "../Core/Log.h"
 #include "../Core/MathAll.h"
+#include "../Core/Allocators.h"
+#include "../Core/System.h"
 
 #include "../Common/Camera.h"
 
 #include "../Graphics/TextBuilder.h"
 
+#include "../Tool/Console.h"
+
 static constexpr uint32 DEBUGDRAW_MAX_VERTICES = 32*1000;
 static constexpr uint32 DEBUGDRAW_MAX_TEXT_CHARACTERS = 1000;
 
@@ -256,6 +260,46 @@ namespace DebugDraw
         return Span<DebugDrawVertex>(&gDebugDraw.vertices[gDebugDraw.vertexIndex], gDebugDraw.vertices.Count() - gDebugDraw.vertexIndex);
 
     }
+
+    // Lays out a long UTF-8 paragraph with the debug font and reports the throughput
+    // Usage: text-bench [NumIterations]
+    static bool _TextBenchmarkCommand(int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)
+    {
+        static const char* sampleText = 
+            "The quick brown fox jumps over the lazy dog. Kerning: AVA To Ty Wa. "
+            "Na\xc3\xafve caf\xc3\xa9 fa\xc3\xa7" "ade, \xc3\x9c" "bergr\xc3\xb6\xc3\x9f" "e \xe2\x80\x94 \xe2\x82\xac" "12.50\n";
+        const uint32 sampleLen = Str::Len(sampleText);
+        const uint32 numRepeats = 512;
+        uint32 numIterations = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 16;
+
+        AssetObjPtrScope<FontData> font(gDebugDraw.textFont);
+        if (font.IsNull()) {
+            Str::Copy(outResponse, responseSize, "Debug font is not loaded");
+            return false;
+        }
+
+        MemTempAllocator tempAlloc;
+        uint32 textLen = sampleLen*numRepeats;
+        char* text = tempAlloc.MallocTyped<char>(textLen + 1);
+        for (uint32 i = 0; i < numRepeats; i++)
+            memcpy(text + i*sampleLen, sampleText, sampleLen);
+        text[textLen] = 0;
+
+        uint32 numVertices = 0;
+        TimerStopWatch stopwatch;
+        for (uint32 i = 0; i < numIterations; i++) {
+            TextBuilder::CalculateTextSize(*font, 1.0f, text, textLen, TextType::Utf8);
+            TextGeometry geo = TextBuilder::CreateText(*font, FLOAT2_ZERO, 1.0f, text, textLen, COLOR4U_WHITE, TextType::Utf8);
+            numVertices += geo.numVertices;
+            TextBuilder::Destroy(geo);
+        }
+        double elapsedMS = stopwatch.ElapsedMS();
+
+        Str::PrintFmt(outResponse, responseSize, "Text layout: %u bytes x %u iterations, %u glyphs: %.2f ms/iter, %.1f MB/s", 
+                      textLen, numIterations, numVertices/(4*numIterations), elapsedMS/double(numIterations), 
+                      double(textLen)*double(numIterations)/(elapsedMS*0.001*double(SIZE_MB)));
+        return true;
+    }
 } // DebugDraw
 
 void DebugDraw::BeginDraw(GfxCommandBuffer cmd, const Camera& cam, uint16 viewWidth, uint16 viewHeight)
@@ -554,6 +598,12 @@ bool DebugDraw::Initialize()
     }
 
 
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "text-bench",
+        .help = "Benchmarks text layout of a long UTF-8 paragraph with the debug font. Args: [NumIterations]",
+        .callback = _TextBenchmarkCommand
+    });
+
     LOG_INFO("(init) DebugDraw initialized");
     return true;
 }
@@ -795,19 +845,23 @@ bool DebugDraw::DrawText3D(Float3 p, float scale, const char* text, uint32 textL
 {
     ASSERT(gDebugDraw.isDrawing);
 
-    MemTempAllocator tempAlloc;
     AssetObjPtrScope<FontData> font(gDebugDraw.textFont);
     Float2 pos = MathUtil::ProjectPointToScreenPixels(p, gDebugDraw.worldToClipMat, 
                                                       RectFloat(0, 0, float(gDebugDraw.viewExtents.x), float(gDebugDraw.viewExtents.y)));
     if (pos.x >=0 && pos.y >= 0) {
-        Float2 textSize = TextBuilder::CalculateTextSize(*font, scale, text, textLen);
-        pos = Float2(pos.x - textSize.x*0.5f, pos.y);
-        TextGeometry textGeo = TextBuilder::CreateText(*font, pos, scale, text, textLen, color, TextType::Ascii, &tempAlloc);
+        // Labels are usually the same every frame and only move on screen, so layouts are cached and just get offset here
+        TextLayout layout = TextBuilder::GetCachedLayout(*font, scale, text, textLen, color, TextType::Ascii);
+        const TextGeometry& textGeo = layout.geo;
+        pos = Float2(pos.x - layout.size.x*0.5f, pos.y);
         ASSERT_MSG((gDebugDraw.textVertices.Count() + textGeo.numVertices)/4 <=  DEBUGDRAW_MAX_TEXT_CHARACTERS, 
                    "Too many debug text characters. Increase DEBUGDRAW_MAX_TEXT_CHARACTERS");
 
-        gDebugDraw.textVertices.PushBatch(textGeo.vertices, textGeo.numVertices);
-        gDebugDraw.textIndices.PushBatch(textGeo.indices, textGeo.numIndices);
+        if (textGeo.numVertices) {
+            uint32 baseVertex = gDebugDraw.textVertices.Count();
+            TextVertex* vertices = gDebugDraw.textVertices.PushBatch(textGeo.vertices, textGeo.numVertices);
+            uint32* indices = gDebugDraw.textIndices.PushBatch(textGeo.indices, textGeo.numIndices);
+            TextBuilder::OffsetText(vertices, textGeo.numVertices, indices, textGeo.numIndices, pos, baseVertex);
+        }
 
         return true;
     }
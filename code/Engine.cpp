@@ -15,6 +15,7 @@
 #include "Common/VirtualFS.h"
 
 #include "Graphics/GfxBackend.h"
+#include "Graphics/TextBuilder.h"
 
 #include "DebugTools/DebugDraw.h"
 #include "DebugTools/DebugHud.h"
@@ -30,9 +31,47 @@
 static constexpr float  ENGINE_REMOTE_RECONNECT_INTERVAL = 5.0f;
 static constexpr uint32 ENGINE_REMOTE_CONNECT_RETRIES = 3;
 static constexpr size_t ENGINE_MAX_MEMORY_SIZE = 2*SIZE_GB;
+static constexpr uint32 ENGINE_PROFILER_DUMP_FRAMES = 8;       // Default number of frames for "profile-dump" command
+static constexpr uint32 ENGINE_PROFILER_HITCH_FRAMES = 4;      // Number of frames (including the hitch) that are dumped on hitches
+static constexpr float  ENGINE_PROFILER_HITCH_COOLDOWN = 5.0f; // Seconds to wait before dumping another hitch
+static constexpr uint32 ENGINE_JOBS_TELEMETRY_FRAMES = 60;     // Frames that are aggregated in the "Jobs" DebugHud stats
+static constexpr uint32 ENGINE_JOBS_TELEMETRY_DUMP_FRAMES = 256;   // Default number of frames for "jobs-telemetry-dump" command
 
 using EngineInitializeResourcesPair = Pair<EngineInitializeResourcesCallback, void*>;
 
+// Sub-systems that are brought up by Engine::Initialize. See Engine::Initialize for the dependencies between them
+enum class EngineInitStepId : uint32
+{
+    Jobs = 0,
+    Mounts,
+    SysInfo,
+    Console,
+    Remote,
+    Graphics,
+    AssetManager,
+    ImGui,
+    DebugDraw,
+    DebugHud,
+    Renderer,
+    _Count
+};
+
+struct EngineInitStep
+{
+    const char* name;
+    bool (*initFn)();
+    uint32 dependsOn;           // Bits of EngineInitStepId that should be finished before this step starts
+    bool runOnMainThread;       // Window/graphics and init-resources registration are kept on the main thread. The rest run as jobs
+    bool enabled;
+
+    JobsHandle job;
+    bool started;
+    bool result;
+    uint32 threadId;
+    uint64 startTick;
+    uint64 endTick;
+};
+
 struct EngineShortcutKeys
 {
     InputKeycode keys[2];
@@ -71,9 +110,11 @@ struct EngineVMAllocTrackItem
 struct EngineContext
 {
     SpinLockMutex vmAllocsMtx;
+    SpinLockMutex proxyAllocsMtx;
     MemProxyAllocator alloc;
     MemProxyAllocator jobsAlloc;
     MemBumpAllocatorVM mainAlloc;   // Virtual memory bump allocator that is used for initializing all sub-systems
+    MemThreadSafeAllocator mainAllocSafe;   // Sub-systems are initialized in parallel, so proxy allocators go through this
 
     SysInfo sysInfo = {};
 
@@ -86,6 +127,7 @@ struct EngineContext
     AtomicUint64 frameIndex;
     uint64 rawFrameStartTime;
     uint64 rawFrameTime;
+    double lastHitchDumpTime;
 
     bool initialized;
     bool resourcesInitialized;
@@ -100,6 +142,9 @@ struct EngineContext
     Array<EngineVMAllocTrackItem> vmAllocs;
 
     EngineDebugMemStats debugMemStats;
+
+    uint64 initStartTick;
+    EngineInitStep initSteps[uint32(EngineInitStepId::_Count)];
 };
 
 static EngineContext gEng;
@@ -239,6 +284,20 @@ namespace Engine
             ImGui::Text("Total: %_$llu/%_$llu", sum1, sum2);
         }
 
+        if (ImGui::CollapsingHeader("Fiber Stacks", 0)) {
+            static constexpr const char* STACK_SIZE_NAMES[uint32(JobsStackSize::_Count)] = { "Small", "Medium", "Large" };
+            JobsBudgetStats stats = Jobs::GetBudgetStats();
+            for (uint32 i = 0; i < uint32(JobsStackSize::_Count); i++) {
+                const JobsFiberStackStats& s = stats.stacks[i];
+                float progress = float(double(s.highWater)/double(s.stackSize));
+                ImGui::Text("%s (%_$llu): ", STACK_SIZE_NAMES[i], s.stackSize);
+                ImGui::SameLine();
+                ImGui::ProgressBar(progress, ImVec2(-1, 0), String32::Format("HighWater: %_$llu", s.highWater).CStr());
+                ImGui::Text("  Stacks: %u (InUse: %u, Peak: %u), Touched: %_$llu, Committed: %_$llu/%_$llu", 
+                            s.numStacks, s.numInUse, s.maxInUse, s.touchedBytes, s.committedBytes, s.reservedBytes);
+            }
+        }
+
         if (ImGui::CollapsingHeader("Proxies", ImGuiTreeNodeFlags_DefaultOpen)) {
             if (!SettingsJunkyard::Get().engine.trackAllocations) 
                 ImGui::TextColored(ImVec4(1, 1, 0, 1), "Tracking proxy allocations is disabled (-EngineTrackAllocations=1)");
@@ -373,44 +432,96 @@ namespace Engine
         }
 
     }
-} // Engine
 
-bool Engine::IsMainThread()
-{
-    return Thread::GetCurrentId() == gEng.mainThreadId;
-}
-
-bool Engine::Initialize()
-{
-    PROFILE_ZONE("Engine.Init");
+    static void _DrawTextCacheStatsCallback(void*)
+    {
+        TextLayoutCacheStats stats = TextBuilder::GetLayoutCacheStats();
+        uint64 numRequests = stats.numHits + stats.numMisses;
+        uint32 numFrameRequests = stats.numHitsLastFrame + stats.numMissesLastFrame;
+
+        ImGui::TextUnformatted(String64::Format("Layouts: %u/%u (%_$llu)", stats.numItems, TEXT_LAYOUT_CACHE_MAX_ITEMS, uint64(stats.memoryUsed)).CStr());
+        ImGui::Text("Hit rate (frame): %.1f%% (%u/%u)", numFrameRequests ? 100.0f*float(stats.numHitsLastFrame)/float(numFrameRequests) : 0, 
+                    stats.numHitsLastFrame, numFrameRequests);
+        ImGui::Text("Hit rate (total): %.1f%% (%llu/%llu)", numRequests ? 100.0*double(stats.numHits)/double(numRequests) : 0, 
+                    stats.numHits, numRequests);
+        ImGui::Text("Evictions: %llu", stats.numEvictions);
+    }
 
-    Thread::SetCurrentThreadName("Main");
-    gEng.mainThreadId = Thread::GetCurrentId();
+    static void _DrawJobsTelemetryCallback(void*)
+    {
+        static constexpr const char* TYPE_NAMES[uint32(JobsType::_Count)] = { "ShortTask", "LongTask" };
+
+        MemTempAllocator tempAlloc;
+        uint32 numShortTaskWorkers = Jobs::GetWorkerThreadsCount(JobsType::ShortTask);
+        uint32 numWorkers = numShortTaskWorkers + Jobs::GetWorkerThreadsCount(JobsType::LongTask);
+        JobsTelemetryWorker* workers = tempAlloc.MallocTyped<JobsTelemetryWorker>(numWorkers);
+        JobsTelemetryFrame frame;
+        if (!Jobs::GetTelemetry(ENGINE_JOBS_TELEMETRY_FRAMES, &frame, workers))
+            return;
 
-    // Mounts for essential engine assets
-    // These assets should always be included in the app package
-    Vfs::MountLocal("code/Shaders", "shaders", true);
-    Vfs::MountLocal("data/fonts", "fonts", false);
+        ImGui::Text("Last %u frames (%.1f ms)", frame.numFrames, frame.durationMS);
+        if (ImGui::CollapsingHeader("Workers", ImGuiTreeNodeFlags_DefaultOpen)) {
+            for (uint32 i = 0; i < numWorkers; i++) {
+                const JobsTelemetryWorker& w = workers[i];
+                float busy = Clamp(w.busyMS/frame.durationMS, 0.0f, 1.0f);
+                float spin = Clamp(w.spinMS/frame.durationMS, 0.0f, 1.0f);
+                bool isShortTask = i < numShortTaskWorkers;
+                ImGui::Text("%s_%u: ", isShortTask ? "ShortTask" : "LongTask", isShortTask ? i + 1 : i - numShortTaskWorkers + 1);
+                ImGui::SameLine();
+                ImGui::ProgressBar(busy, ImVec2(-1, 0), 
+                                   String64::Format("Busy %.0f%%, Spin %.1f%%, Runs: %u, Yields: %u", 
+                                                    busy*100.0f, spin*100.0f, w.numRuns, w.numYields).CStr());
+            }
+        }
 
-    // Setup allocators
-    // TODO: make main allocator commit all memory upfront in RELEASE builds (?)
-    gEng.mainAlloc.Initialize(ENGINE_MAX_MEMORY_SIZE, SIZE_MB, SettingsJunkyard::Get().engine.debugAllocations);
-    Engine::RegisterVMAllocator(&gEng.mainAlloc, "Engine");
+        if (ImGui::CollapsingHeader("Queues", ImGuiTreeNodeFlags_DefaultOpen)) {
+            for (uint32 t = 0; t < uint32(JobsType::_Count); t++) {
+                ImGui::Text("%s: Dispatches: %u, Dropped: %u, Max depth (High/Normal/Low/Background): %u/%u/%u/%u", 
+                            TYPE_NAMES[t], frame.numDispatches[t], frame.numDropped[t],
+                            frame.maxQueueDepth[t][uint32(JobsPriority::High)], frame.maxQueueDepth[t][uint32(JobsPriority::Normal)],
+                            frame.maxQueueDepth[t][uint32(JobsPriority::Low)], frame.maxQueueDepth[t][uint32(JobsPriority::Background)]);
+
+                float histogram[JOBS_TELEMETRY_LATENCY_BUCKETS];
+                for (uint32 b = 0; b < JOBS_TELEMETRY_LATENCY_BUCKETS; b++)
+                    histogram[b] = float(frame.latencyHistogram[t][b]);
+                ImGui::PlotHistogram(String32::Format("##Latency%u", t).CStr(), histogram, JOBS_TELEMETRY_LATENCY_BUCKETS, 0, 
+                                     "Start latency (1us .. 16ms)", 0, M_FLOAT32_MAX, ImVec2(-1, 50.0f));
+            }
 
-    Engine::HelperInitializeProxyAllocator(&gEng.alloc, "Engine");
-    Engine::HelperInitializeProxyAllocator(&gEng.jobsAlloc, "Jobs");
-    Engine::RegisterProxyAllocator(&gEng.alloc);
-    Engine::RegisterProxyAllocator(&gEng.jobsAlloc);
+            ImGui::Text("Max fibers in use (Small/Medium/Large): %u/%u/%u", frame.maxFibersInUse[uint32(JobsStackSize::Small)],
+                        frame.maxFibersInUse[uint32(JobsStackSize::Medium)], frame.maxFibersInUse[uint32(JobsStackSize::Large)]);
+        }
+    }
 
-    // Note: We don't set any allocators for ProxyAllocs array because it will likely get populated before engine initialization
-    gEng.shortcuts.SetAllocator(&gEng.alloc);
-    gEng.initResourcesCallbacks.SetAllocator(&gEng.alloc);
+    static bool _InitJobs()
+    {
+        JobsInitParams jobsInitParams {                   
+            .alloc = &gEng.jobsAlloc, 
+            .numShortTaskThreads = SettingsJunkyard::Get().engine.jobsNumShortTaskThreads,
+            .numLongTaskThreads = SettingsJunkyard::Get().engine.jobsNumLongTaskThreads,
+            .debugAllocations = SettingsJunkyard::Get().engine.debugAllocations,
+            .pinThreads = SettingsJunkyard::Get().engine.jobsPinThreads,
+            .pinAvoidSmtSiblings = SettingsJunkyard::Get().engine.jobsPinAvoidSmtSiblings,
+            .pinReserveMainThreadCore = SettingsJunkyard::Get().engine.jobsPinReserveMainThreadCore
+        };
+        Jobs::Initialize(jobsInitParams);
+        return true;
+    }
 
-    if (SettingsJunkyard::Get().engine.debugAllocations)
-        MemTempAllocator::EnableDebugMode(true);
+    static bool _InitMounts()
+    {
+        // Mounts for essential engine assets
+        // These assets should always be included in the app package
+        Vfs::MountLocal("code/Shaders", "shaders", true);
+        Vfs::MountLocal("data/fonts", "fonts", false);
+        return true;
+    }
 
-    {   // Cpu/Memory info
+    static bool _InitSysInfo()
+    {
+        // Cpu/Memory info
         OS::GetSysInfo(&gEng.sysInfo);
+        Str::SelectSimdKernels(gEng.sysInfo);
 
         char cpuCaps[128] = {0};
         if (gEng.sysInfo.cpuCapsSSE)
@@ -436,23 +547,102 @@ bool Engine::Initialize()
         LOG_INFO("(init) CPU: %s", gEng.sysInfo.cpuModel);
         LOG_INFO("(init) CPU Cores: %u", gEng.sysInfo.coreCount); 
         LOG_INFO("(init) CPU Caps: %s", cpuCaps);
+        LOG_INFO("(init) String kernels: %s", Str::GetSimdLevelName(Str::GetSimdLevel()));
         LOG_INFO("(init) CPU L1 Cache: %u x %_$$$u (%u-way)", gEng.sysInfo.L1Cache.count, gEng.sysInfo.L1Cache.size, gEng.sysInfo.L1Cache.kway);
         LOG_INFO("(init) CPU L2 Cache: %u x %_$$$u (%u-way)", gEng.sysInfo.L2Cache.count, gEng.sysInfo.L2Cache.size, gEng.sysInfo.L2Cache.kway);
         LOG_INFO("(init) CPU L3 Cache: %u x %_$$$u (%u-way)", gEng.sysInfo.L3Cache.count, gEng.sysInfo.L3Cache.size, gEng.sysInfo.L3Cache.kway);
         LOG_INFO("(init) System RAM: %_$$$llu", gEng.sysInfo.physicalMemorySize);
+        return true;
     }
 
-    Console::Initialize(&gEng.alloc);
+    static bool _InitConsole()
+    {
+        if (!Console::Initialize(&gEng.alloc))
+            return false;
 
-    JobsInitParams jobsInitParams {                   
-        .alloc = &gEng.jobsAlloc, 
-        .numShortTaskThreads = SettingsJunkyard::Get().engine.jobsNumShortTaskThreads,
-        .numLongTaskThreads = SettingsJunkyard::Get().engine.jobsNumLongTaskThreads,
-        .debugAllocations = SettingsJunkyard::Get().engine.debugAllocations 
-    };
-    Jobs::Initialize(jobsInitParams);
+        auto GetVMemStats = [](int, const char**, char* outResponse, uint32 responseSize, void*)->bool {
+            MemVirtualStats stats = Mem::VirtualGetStats();
+            Str::PrintFmt(outResponse, responseSize, "Reserverd: %_$$$llu, Commited: %_$$$llu", stats.reservedBytes, stats.commitedBytes);
+            return true;
+        };
 
-    if (SettingsJunkyard::Get().engine.connectToServer) {
+        ConCommandDesc cmdVmem {
+            .name = "vmem",
+            .help = "Get VMem stats",
+            .callback = GetVMemStats
+        };
+        Console::RegisterCommand(cmdVmem);
+
+        auto GetJobsStats = [](int, const char**, char* outResponse, uint32 responseSize, void*)->bool {
+            JobsBudgetStats stats = Jobs::GetBudgetStats();
+            uint32 len = 0;
+            for (uint32 i = 0; i < uint32(JobsStackSize::_Count); i++) {
+                const JobsFiberStackStats& s = stats.stacks[i];
+                uint32 n = Str::PrintFmt(outResponse + len, responseSize - len, 
+                                         "%sStack %_$$$llu: HighWater=%_$$$llu, Stacks=%u (Peak: %u), Touched=%_$$$llu, Committed=%_$$$llu",
+                                         i ? ". " : "", s.stackSize, s.highWater, s.numStacks, s.maxInUse, s.touchedBytes, s.committedBytes);
+                len = Min(len + n, responseSize - 1);
+            }
+            return true;
+        };
+
+        ConCommandDesc cmdJobsStats {
+            .name = "jobs-stats",
+            .help = "Get Jobs fiber stack stats (high-water marks and memory)",
+            .callback = GetJobsStats
+        };
+        Console::RegisterCommand(cmdJobsStats);
+
+        auto JobsTelemetryDump = [](int argc, const char** argv, char* outResponse, uint32 responseSize, void*)->bool {
+            uint32 numFrames = argc > 1 ? Str::ToUint(argv[1]) : ENGINE_JOBS_TELEMETRY_DUMP_FRAMES;
+            const char* filepath = argc > 2 ? argv[2] : "jobs-telemetry.json";
+            if (!Jobs::DumpTelemetryJson(filepath, numFrames)) {
+                Str::PrintFmt(outResponse, responseSize, "Writing jobs telemetry to '%s' failed", filepath);
+                return false;
+            }
+
+            Str::PrintFmt(outResponse, responseSize, "Jobs telemetry written to '%s'", filepath);
+            return true;
+        };
+
+        ConCommandDesc cmdJobsTelemetryDump {
+            .name = "jobs-telemetry-dump",
+            .help = "Writes per-frame job system telemetry (workers, queues, latencies) to json. jobs-telemetry-dump [NumFrames] [Filepath]",
+            .callback = JobsTelemetryDump
+        };
+        Console::RegisterCommand(cmdJobsTelemetryDump);
+
+        #if CONFIG_ENABLE_PROFILER
+        auto ProfileDump = [](int argc, const char** argv, char* outResponse, uint32 responseSize, void*)->bool {
+            if (!Profiler::IsEnabled()) {
+                Str::Copy(outResponse, responseSize, "Profiler is not enabled (-EngineProfilerEnable=1)");
+                return false;
+            }
+
+            uint32 numFrames = argc > 1 ? Str::ToUint(argv[1]) : ENGINE_PROFILER_DUMP_FRAMES;
+            const char* filepath = argc > 2 ? argv[2] : "profile.json";
+            if (!Profiler::DumpChromeTrace(filepath, numFrames)) {
+                Str::PrintFmt(outResponse, responseSize, "Writing profile to '%s' failed", filepath);
+                return false;
+            }
+
+            Str::PrintFmt(outResponse, responseSize, "Profile written to '%s'", filepath);
+            return true;
+        };
+
+        ConCommandDesc cmdProfileDump {
+            .name = "profile-dump",
+            .help = "Writes the last N frames of the built-in profiler to a chrome trace json. profile-dump [NumFrames] [Filepath]",
+            .callback = ProfileDump
+        };
+        Console::RegisterCommand(cmdProfileDump);
+        #endif
+
+        return true;
+    }
+
+    static bool _InitRemote()
+    {
         if (!Remote::Connect(SettingsJunkyard::Get().engine.remoteServicesUrl.CStr(), _RemoteDisconnected)) {
             return false;
         }
@@ -463,12 +653,13 @@ bool Engine::Initialize()
             Console::ExecuteRemote("exec scripts\\Android\\android-close-logcats.bat com.junkyard.example && scripts\\Android\\android-logcat.bat");
             Console::ExecuteRemote("exec-once {ScrCpy}");
         }
+
+        return true;
     }
 
-    // Graphics
-    const SettingsGraphics& gfxSettings = SettingsJunkyard::Get().graphics;
-    if (gfxSettings.enable) {
-        if (!gfxSettings.headless) {
+    static bool _InitGraphics()
+    {
+        if (SettingsJunkyard::Get().graphics.IsWindowEnabled()) {
             AppDisplayInfo dinfo = App::GetDisplayInfo();
             LOG_INFO("(init) Logical Window Size: %ux%u", App::GetWindowWidth(), App::GetWindowHeight());
             LOG_INFO("(init) Framebuffer Size: %ux%u", App::GetFramebufferWidth(), App::GetFramebufferHeight());
@@ -479,65 +670,232 @@ bool Engine::Initialize()
             LOG_ERROR("Initializing Graphics failed");
             return false;
         }
+        return true;
     }
 
-    // Asset manager
-    if (!Asset::Initialize()) {
-        LOG_ERROR("Initializing AssetManager failed");
-        return false;
-    }
+    static bool _InitAssetManager()
+    {
+        if (!Asset::Initialize()) {
+            LOG_ERROR("Initializing AssetManager failed");
+            return false;
+        }
 
-    // Initialization time resources
-    gEng.initResourcesGroup = Asset::CreateGroup();
+        // Initialization time resources
+        gEng.initResourcesGroup = Asset::CreateGroup();
+        return true;
+    }
 
-    if (gfxSettings.IsGraphicsEnabled()) {
-        if (gfxSettings.enableImGui && !ImGui::Initialize()) {
+    static bool _InitImGui()
+    {
+        if (!ImGui::Initialize()) {
             LOG_ERROR("Initializing ImGui failed");
             return false;
         }
+        return true;
+    }
 
+    static bool _InitDebugDraw()
+    {
         if (!DebugDraw::Initialize()) {
             LOG_ERROR("Initializing DebugDraw failed");
             return false;
         }
+        return true;
     }
 
-    if (ImGui::IsEnabled()) {
-        DebugHud::Initialize();
-        DebugHud::RegisterMemoryStats("Engine", _DrawMemStatsCallback);
+    static bool _InitDebugHud()
+    {
+        if (ImGui::IsEnabled()) {
+            DebugHud::Initialize();
+            DebugHud::RegisterMemoryStats("Engine", _DrawMemStatsCallback);
+            DebugHud::RegisterMemoryStats("TextCache", _DrawTextCacheStatsCallback);
+            DebugHud::RegisterMemoryStats("Jobs", _DrawJobsTelemetryCallback);
+        }
+        return true;
     }
 
-    App::RegisterEventsCallback(_OnEvent);
+    static bool _InitRenderer()
+    {
+        if (!R::Initialize()) {
+            LOG_ERROR("Initializing Renderer failed");
+            return false;
+        }
+        return true;
+    }
 
-    // Console commands
+    static constexpr uint32 _InitStepBit(EngineInitStepId id)
     {
-        auto GetVMemStats = [](int, const char**, char* outResponse, uint32 responseSize, void*)->bool {
-            MemVirtualStats stats = Mem::VirtualGetStats();
-            Str::PrintFmt(outResponse, responseSize, "Reserverd: %_$$$llu, Commited: %_$$$llu", stats.reservedBytes, stats.commitedBytes);
-            return true;
-        };
+        return 1u << uint32(id);
+    }
 
-        ConCommandDesc cmdVmem {
-            .name = "vmem",
-            .help = "Get VMem stats",
-            .callback = GetVMemStats
-        };
-        Console::RegisterCommand(cmdVmem);
+    static void _RunInitStep(EngineInitStep* step)
+    {
+        step->threadId = Thread::GetCurrentId();
+        step->startTick = Timer::GetTicks();
+        step->result = step->initFn();
+        step->endTick = Timer::GetTicks();
     }
 
-    // Renderer(s)
-    if (gfxSettings.IsGraphicsEnabled()) {
-        if (!R::Initialize()) {
-            LOG_ERROR("Initializing Renderer failed");
-            return false;
+    // Runs the steps as soon as their dependencies are finished. Main thread steps are run in place and the rest are dispatched as jobs
+    // On failure, no more steps are started and we only wait for the jobs that are already running
+    static bool _RunInitSteps(EngineInitStep* steps, uint32 numSteps)
+    {
+        ASSERT(numSteps <= 32);
+
+        uint32 finishedMask = 0;
+        uint32 allMask = numSteps == 32 ? UINT32_MAX : ((1u << numSteps) - 1);
+        for (uint32 i = 0; i < numSteps; i++) {
+            if (!steps[i].enabled)
+                finishedMask |= 1u << i;    // Disabled steps don't hold back their dependents
+        }
+
+        bool failed = false;
+        while (finishedMask != allMask && !failed) {
+            bool progress = false;
+
+            for (uint32 i = 0; i < numSteps && !failed; i++) {
+                EngineInitStep& step = steps[i];
+                if (step.started || (finishedMask & (1u << i)) || (step.dependsOn & finishedMask) != step.dependsOn)
+                    continue;
+
+                step.started = true;
+                progress = true;
+                if (step.runOnMainThread) {
+                    _RunInitStep(&step);
+                    finishedMask |= 1u << i;
+                    failed = !step.result;
+                }
+                else {
+                    step.job = Jobs::Dispatch(JobsType::LongTask, [](uint32, void* userData) { _RunInitStep((EngineInitStep*)userData); }, 
+                                              &step, 1, JobsPriority::High, JobsStackSize::Large);
+                }
+            }
+
+            for (uint32 i = 0; i < numSteps; i++) {
+                EngineInitStep& step = steps[i];
+                if (step.job && !Jobs::IsRunning(step.job)) {
+                    Jobs::Delete(step.job);
+                    step.job = nullptr;
+                    finishedMask |= 1u << i;
+                    failed |= !step.result;
+                    progress = true;
+                }
+            }
+
+            if (!progress)
+                Thread::SwitchContext();
+        }
+
+        for (uint32 i = 0; i < numSteps; i++) {
+            if (steps[i].job) {
+                Jobs::WaitForCompletionAndDelete(steps[i].job);
+                steps[i].job = nullptr;
+            }
+        }
+
+        return !failed;
+    }
+
+    static void _LogInitTimeline(const EngineInitStep* steps, uint32 numSteps, uint64 startTick, uint64 endTick)
+    {
+        double sumMS = 0;
+        LOG_INFO("(init) Startup timeline (ms):");
+        for (uint32 i = 0; i < numSteps; i++) {
+            const EngineInitStep& step = steps[i];
+            if (!step.started)
+                continue;
+
+            double durationMS = Timer::ToMS(Timer::Diff(step.endTick, step.startTick));
+            sumMS += durationMS;
+            LOG_INFO("(init) \t%-14s %8.1f .. %8.1f (%.1f)%s", step.name, 
+                     Timer::ToMS(Timer::Diff(step.startTick, startTick)), Timer::ToMS(Timer::Diff(step.endTick, startTick)), durationMS,
+                     step.threadId == gEng.mainThreadId ? "" : " [Job]");
         }
+        LOG_INFO("(init) \tTotal: %.1f, Steps: %.1f", Timer::ToMS(Timer::Diff(endTick, startTick)), sumMS);
     }
+} // Engine
+
+bool Engine::IsMainThread()
+{
+    return Thread::GetCurrentId() == gEng.mainThreadId;
+}
+
+bool Engine::Initialize()
+{
+    PROFILE_ZONE("Engine.Init");
+
+    gEng.initStartTick = Timer::GetTicks();
+    Thread::SetCurrentThreadName("Main");
+    gEng.mainThreadId = Thread::GetCurrentId();
+
+    // Setup allocators
+    // TODO: make main allocator commit all memory upfront in RELEASE builds (?)
+    gEng.mainAlloc.Initialize(ENGINE_MAX_MEMORY_SIZE, SIZE_MB, SettingsJunkyard::Get().engine.debugAllocations);
+    gEng.mainAllocSafe.SetAllocator(&gEng.mainAlloc);
+    Engine::RegisterVMAllocator(&gEng.mainAlloc, "Engine");
+
+    Engine::HelperInitializeProxyAllocator(&gEng.alloc, "Engine");
+    Engine::HelperInitializeProxyAllocator(&gEng.jobsAlloc, "Jobs");
+    Engine::RegisterProxyAllocator(&gEng.alloc);
+    Engine::RegisterProxyAllocator(&gEng.jobsAlloc);
+
+    // Note: We don't set any allocators for ProxyAllocs array because it will likely get populated before engine initialization
+    gEng.shortcuts.SetAllocator(&gEng.alloc);
+    gEng.initResourcesCallbacks.SetAllocator(&gEng.alloc);
+
+    if (SettingsJunkyard::Get().engine.debugAllocations)
+        MemTempAllocator::EnableDebugMode(true);
+
+    #if CONFIG_ENABLE_PROFILER
+    Profiler::SetEnabled(SettingsJunkyard::Get().engine.profilerEnable);
+    #endif
+
+    // Sub-systems are initialized as a dependency graph. Once Jobs is up, independent steps overlap with each other
+    // For example, GfxBackend device creation on the main thread runs alongside Console, SysInfo and the server connection
+    const SettingsGraphics& gfxSettings = SettingsJunkyard::Get().graphics;
+    auto Step = [](EngineInitStepId id, const char* name, bool(*initFn)(), uint32 dependsOn, bool runOnMainThread, bool enabled = true)
+    {
+        gEng.initSteps[uint32(id)] = EngineInitStep {
+            .name = name,
+            .initFn = initFn,
+            .dependsOn = dependsOn,
+            .runOnMainThread = runOnMainThread,
+            .enabled = enabled
+        };
+    };
+
+    using Id = EngineInitStepId;
+    constexpr uint32 JOBS = _InitStepBit(Id::Jobs);
+    constexpr uint32 MOUNTS = _InitStepBit(Id::Mounts);
+    constexpr uint32 CONSOLE = _InitStepBit(Id::Console);
+    constexpr uint32 GRAPHICS = _InitStepBit(Id::Graphics);
+    constexpr uint32 ASSETS = _InitStepBit(Id::AssetManager);
+
+    Step(Id::Jobs,          "Jobs",         _InitJobs,          0,                                                  true);
+    Step(Id::Mounts,        "Mounts",       _InitMounts,        JOBS,                                               false);
+    Step(Id::SysInfo,       "SysInfo",      _InitSysInfo,       JOBS,                                               false);
+    Step(Id::Console,       "Console",      _InitConsole,       JOBS|MOUNTS,                                        false);
+    Step(Id::Remote,        "Remote",       _InitRemote,        CONSOLE,                                            false, SettingsJunkyard::Get().engine.connectToServer);
+    Step(Id::Graphics,      "Graphics",     _InitGraphics,      MOUNTS,                                             true,  gfxSettings.enable);
+    Step(Id::AssetManager,  "AssetManager", _InitAssetManager,  MOUNTS|CONSOLE|GRAPHICS|_InitStepBit(Id::Remote),   false);
+    Step(Id::ImGui,         "ImGui",        _InitImGui,         GRAPHICS|ASSETS,                                    true,  gfxSettings.IsGraphicsEnabled() && gfxSettings.enableImGui);
+    Step(Id::DebugDraw,     "DebugDraw",    _InitDebugDraw,     GRAPHICS|ASSETS|CONSOLE,                            true,  gfxSettings.IsGraphicsEnabled());
+    Step(Id::DebugHud,      "DebugHud",     _InitDebugHud,      _InitStepBit(Id::ImGui),                            true,  gfxSettings.IsGraphicsEnabled());
+    Step(Id::Renderer,      "Renderer",     _InitRenderer,      GRAPHICS|ASSETS,                                    true,  gfxSettings.IsGraphicsEnabled());
+
+    if (!_RunInitSteps(gEng.initSteps, uint32(EngineInitStepId::_Count)))
+        return false;
+
+    App::RegisterEventsCallback(_OnEvent);
+
+    uint64 initEndTick = Timer::GetTicks();
+    _LogInitTimeline(gEng.initSteps, uint32(EngineInitStepId::_Count), gEng.initStartTick, initEndTick);
 
     LOG_INFO("(init) Engine v%u.%u.%u initialized (%.1f ms)", 
              GetVersionMajor(JUNKYARD_VERSION),
              GetVersionMinor(JUNKYARD_VERSION),
              GetVersionPatch(JUNKYARD_VERSION),
-             Timer::ToMS(Timer::GetTicks()));
+             Timer::ToMS(initEndTick));
     gEng.initialized = true;
 
     return true;
@@ -573,6 +931,7 @@ void Engine::Release()
             ImGui::Release();
         }
         DebugDraw::Release();
+        TextBuilder::ReleaseLayoutCache();
     } 
 
     if (gEng.initResourcesGroup.mHandle.IsValid()) {
@@ -596,6 +955,10 @@ void Engine::Release()
     Jobs::Release();
     Console::Release();
 
+    #if CONFIG_ENABLE_PROFILER
+    Profiler::Release();
+    #endif
+
     gEng.shortcuts.Free();
     gEng.proxyAllocs.Free();
     gEng.vmAllocs.Free();
@@ -666,13 +1029,30 @@ void Engine::EndFrame()
     gEng.rawFrameTime = Timer::Diff(Timer::GetTicks(), gEng.rawFrameStartTime);
 
     // Graphics
-    if (SettingsJunkyard::Get().graphics.IsGraphicsEnabled())
+    if (SettingsJunkyard::Get().graphics.IsGraphicsEnabled()) {
         GfxBackend::End();
+        TextBuilder::UpdateLayoutCache();
+    }
 
     MemTempAllocator::Reset();
+    Jobs::EndTelemetryFrame();
 
     TracyCFrameMark;
 
+    #if CONFIG_ENABLE_PROFILER
+    uint64 profileFrameTime = Profiler::MarkFrame();
+    uint32 hitchThreshold = SettingsJunkyard::Get().engine.profilerHitchThreshold;
+    if (hitchThreshold && Profiler::IsEnabled() && Timer::ToMS(profileFrameTime) >= double(hitchThreshold) &&
+        (gEng.lastHitchDumpTime == 0 || (gEng.elapsedTime - gEng.lastHitchDumpTime) >= ENGINE_PROFILER_HITCH_COOLDOWN))
+    {
+        char filepath[64];
+        Str::PrintFmt(filepath, sizeof(filepath), "hitch-%llu.json", Engine::GetFrameIndex());
+        LOG_WARNING("Frame hitch detected (%.1f ms), dumping profile: %s", Timer::ToMS(profileFrameTime), filepath);
+        Profiler::DumpChromeTrace(filepath, ENGINE_PROFILER_HITCH_FRAMES);
+        gEng.lastHitchDumpTime = gEng.elapsedTime;
+    }
+    #endif
+
     Atomic::FetchAddExplicit(&gEng.frameIndex, 1, AtomicMemoryOrder::Relaxed);
 }
 
@@ -797,6 +1177,7 @@ const AssetGroup& Engine::RegisterInitializeResources(EngineInitializeResourcesC
 
 void Engine::RegisterProxyAllocator(MemProxyAllocator* alloc)
 {
+    SpinLockMutexScope lock(gEng.proxyAllocsMtx);
     [[maybe_unused]] uint32 index = gEng.proxyAllocs.FindIf([alloc](const MemProxyAllocator* a) { return alloc == a; });
     ASSERT(index == -1);
     gEng.proxyAllocs.Push(alloc);
@@ -809,7 +1190,7 @@ void Engine::HelperInitializeProxyAllocator(MemProxyAllocator* alloc, const char
 
     if (!baseAlloc) {
         ASSERT(gEng.mainAlloc.IsInitialized());
-        alloc->Initialize(name, &gEng.mainAlloc, proxyAllocFlags);
+        alloc->Initialize(name, &gEng.mainAllocSafe, proxyAllocFlags);
     }
     else {
         alloc->Initialize(name, baseAlloc, proxyAllocFlags);
@@ -40,6 +40,62 @@ namespace GeometryUtils
         ASSERT(numVertexBuffers);
         return numVertexBuffers;
     }
+
+    // Attribute writers for the built-in shapes. They handle both full-precision and quantized layouts
+    static void WritePosition(uint8* ptr, uint32 stride, uint32 index, GfxFormat fmt, Float3 pos, Float3 scale)
+    {
+        if (fmt == GfxFormat::R16G16B16A16_SNORM) {
+            int16* q = &PtrToElement<int16>(ptr, stride, index);
+            q[0] = Geometry::QuantizeSnorm16(pos.x/scale.x);
+            q[1] = Geometry::QuantizeSnorm16(pos.y/scale.y);
+            q[2] = Geometry::QuantizeSnorm16(pos.z/scale.z);
+            q[3] = INT16_MAX;
+        }
+        else {
+            ASSERT(fmt == GfxFormat::R32G32B32_SFLOAT);
+            PtrToElement<Float3>(ptr, stride, index) = pos;
+        }
+    }
+
+    static void WriteNormal(uint8* ptr, uint32 stride, uint32 index, GfxFormat fmt, Float3 normal)
+    {
+        if (fmt == GfxFormat::R16G16_SNORM) {
+            Geometry::EncodeOctahedral(normal, &PtrToElement<int16>(ptr, stride, index));
+        }
+        else if (fmt == GfxFormat::R16G16B16A16_SNORM) {
+            int16* q = &PtrToElement<int16>(ptr, stride, index);
+            q[0] = Geometry::QuantizeSnorm16(normal.x);
+            q[1] = Geometry::QuantizeSnorm16(normal.y);
+            q[2] = Geometry::QuantizeSnorm16(normal.z);
+            q[3] = 0;
+        }
+        else {
+            ASSERT(fmt == GfxFormat::R32G32B32_SFLOAT);
+            PtrToElement<Float3>(ptr, stride, index) = normal;
+        }
+    }
+
+    static void WriteTexcoord(uint8* ptr, uint32 stride, uint32 index, GfxFormat fmt, Float2 uv)
+    {
+        if (fmt == GfxFormat::R16G16_SFLOAT) {
+            uint16* h = &PtrToElement<uint16>(ptr, stride, index);
+            h[0] = Geometry::QuantizeHalf(uv.x);
+            h[1] = Geometry::QuantizeHalf(uv.y);
+        }
+        else {
+            ASSERT(fmt == GfxFormat::R32G32_SFLOAT);
+            PtrToElement<Float2>(ptr, stride, index) = uv;
+        }
+    }
+
+    static Float3 GetPositionScale(const GeometryVertexLayout& layout, Float3 extents)
+    {
+        const GfxVertexInputAttributeDesc* attr = layout.FindAttribute("POSITION", 0);
+        if (attr && attr->format == GfxFormat::R16G16B16A16_SNORM)
+            return Float3(Max(extents.x, M_FLOAT32_EPSILON), Max(extents.y, M_FLOAT32_EPSILON), Max(extents.z, M_FLOAT32_EPSILON));
+        else
+            return Float3(1.0f, 1.0f, 1.0f);
+    }
 };
 
 bool GeometryVertexLayout::HasTangents() const
@@ -114,23 +170,73 @@ uint32 Geometry::GetVertexStride(GfxFormat fmt)
     case GfxFormat::R16G16_UNORM:
     case GfxFormat::R16G16_SNORM:
     case GfxFormat::R16G16_UINT:
+    case GfxFormat::R16G16_SFLOAT:
         return sizeof(uint16)*2;
     case GfxFormat::R16G16B16A16_SNORM:
     case GfxFormat::R16G16B16A16_UNORM:
     case GfxFormat::R16G16B16A16_SINT:
     case GfxFormat::R16G16B16A16_UINT:
+    case GfxFormat::R16G16B16A16_SFLOAT:
         return sizeof(uint16)*4;
     default:
         return 0;
     }
 }
 
+int16 Geometry::QuantizeSnorm16(float v)
+{
+    v = Clamp(v, -1.0f, 1.0f)*32767.0f;
+    return int16(v + (v >= 0 ? 0.5f : -0.5f));
+}
+
+uint16 Geometry::QuantizeHalf(float v)
+{
+    union { float f; uint32 ui; } u = { v };
+    uint32 ui = u.ui;
+
+    int s = (ui >> 16) & 0x8000;
+    int em = ui & 0x7fffffff;
+
+    int h = (em - (112 << 23) + (1 << 12)) >> 13;   // bias exponent and round to nearest
+    h = (em < (113 << 23)) ? 0 : h;                 // underflow: flush to zero
+    h = (em >= (143 << 23)) ? 0x7c00 : h;           // overflow: infinity
+    h = (em > (255 << 23)) ? 0x7e00 : h;            // NaN
+
+    return uint16(s | h);
+}
+
+void Geometry::EncodeOctahedral(Float3 n, int16 outEncoded[2])
+{
+    float l1 = M::Abs(n.x) + M::Abs(n.y) + M::Abs(n.z);
+    if (l1 < M_FLOAT32_EPSILON) {
+        // Degenerate normals (zero area triangles, broken source data)
+        outEncoded[0] = 0;
+        outEncoded[1] = 0;
+        return;
+    }
+
+    n = Float3::Mul(n, 1.0f / l1);
+    float x = n.x;
+    float y = n.y;
+    if (n.z < 0) {
+        x = (1.0f - M::Abs(n.y))*M::Sign(n.x);
+        y = (1.0f - M::Abs(n.x))*M::Sign(n.y);
+    }
+    outEncoded[0] = QuantizeSnorm16(x);
+    outEncoded[1] = QuantizeSnorm16(y);
+}
+
 void Geometry::CreateAxisAlignedBox(Float3 extents, const GeometryVertexLayout& layout, GeometryData& outBox, MemAllocator* alloc)
 {
     ASSERT(alloc);
     memset(&outBox, 0x0, sizeof(outBox));
 
-    auto MakeFace = [](uint8* positions, uint8* normals, uint8* uvs, uint32* indices, 
+    GfxFormat posFmt = layout.FindAttribute("POSITION", 0)->format;
+    GfxFormat normalFmt = layout.FindAttribute("NORMAL", 0)->format;
+    GfxFormat uvFmt = layout.FindAttribute("TEXCOORD", 0)->format;
+    Float3 posScale = GeometryUtils::GetPositionScale(layout, extents);
+
+    auto MakeFace = [posFmt, normalFmt, uvFmt, posScale](uint8* positions, uint8* normals, uint8* uvs, uint32* indices, 
         uint32 startVertex, uint32 positionStride, uint32 normalsStride, uint32 uvStride,
         const Float3& a, const Float3& b, const Float3& c, const Float3& d, Float3 normal)
     {
@@ -139,20 +245,20 @@ void Geometry::CreateAxisAlignedBox(Float3 extents, const GeometryVertexLayout&
         uvs += uvStride*startVertex;
 
         // 4 Vertices per face
-        GeometryUtils::PtrToElement<Float3>(positions, positionStride, 0) = a;
-        GeometryUtils::PtrToElement<Float3>(positions, positionStride, 1) = b;
-        GeometryUtils::PtrToElement<Float3>(positions, positionStride, 2) = c;
-        GeometryUtils::PtrToElement<Float3>(positions, positionStride, 3) = d;
+        GeometryUtils::WritePosition(positions, positionStride, 0, posFmt, a, posScale);
+        GeometryUtils::WritePosition(positions, positionStride, 1, posFmt, b, posScale);
+        GeometryUtils::WritePosition(positions, positionStride, 2, posFmt, c, posScale);
+        GeometryUtils::WritePosition(positions, positionStride, 3, posFmt, d, posScale);
 
-        GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 0) = Float2(0, 0);
-        GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 1) = Float2(1, 0);
-        GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 2) = Float2(1, 1);
-        GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 3) = Float2(0, 1);
+        GeometryUtils::WriteTexcoord(uvs, uvStride, 0, uvFmt, Float2(0, 0));
+        GeometryUtils::WriteTexcoord(uvs, uvStride, 1, uvFmt, Float2(1, 0));
+        GeometryUtils::WriteTexcoord(uvs, uvStride, 2, uvFmt, Float2(1, 1));
+        GeometryUtils::WriteTexcoord(uvs, uvStride, 3, uvFmt, Float2(0, 1));
 
-        GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 0) = normal;
-        GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 1) = normal;
-        GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 2) = normal;
-        GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 3) = normal;
+        GeometryUtils::WriteNormal(normals, normalsStride, 0, normalFmt, normal);
+        GeometryUtils::WriteNormal(normals, normalsStride, 1, normalFmt, normal);
+        GeometryUtils::WriteNormal(normals, normalsStride, 2, normalFmt, normal);
+        GeometryUtils::WriteNormal(normals, normalsStride, 3, normalFmt, normal);
 
         // 2 triangles (CCW)
         indices[0] = startVertex;
@@ -231,6 +337,8 @@ void Geometry::CreateAxisAlignedBox(Float3 extents, const GeometryVertexLayout&
     outBox.numVertices = numVertices;
     outBox.numIndices = numIndices; 
     outBox.numVertexBuffers = numVertexBuffers;
+    outBox.positionOffset = FLOAT3_ZERO;
+    outBox.positionScale = posScale;
 }
 
 void Geometry::CreatePlane(Float2 extents, const GeometryVertexLayout& layout, GeometryData& outPlane, MemAllocator* alloc)
@@ -249,20 +357,25 @@ void Geometry::CreatePlane(Float2 extents, const GeometryVertexLayout& layout, G
     ASSERT(normals);
     uint32* indices = (uint32*)outPlane.cpuBuffers.indexBuffer;
 
-    GeometryUtils::PtrToElement<Float3>(positions, positionStride, 0) = Float3(-extents.x, -extents.y, 0);
-    GeometryUtils::PtrToElement<Float3>(positions, positionStride, 1) = Float3(extents.x, -extents.y, 0);
-    GeometryUtils::PtrToElement<Float3>(positions, positionStride, 2) = Float3(extents.x, extents.y, 0);
-    GeometryUtils::PtrToElement<Float3>(positions, positionStride, 3) = Float3(-extents.x, extents.y, 0);
+    GfxFormat posFmt = layout.FindAttribute("POSITION", 0)->format;
+    GfxFormat normalFmt = layout.FindAttribute("NORMAL", 0)->format;
+    GfxFormat uvFmt = layout.FindAttribute("TEXCOORD", 0)->format;
+    Float3 posScale = GeometryUtils::GetPositionScale(layout, Float3(extents.x, extents.y, 0));
+
+    GeometryUtils::WritePosition(positions, positionStride, 0, posFmt, Float3(-extents.x, -extents.y, 0), posScale);
+    GeometryUtils::WritePosition(positions, positionStride, 1, posFmt, Float3(extents.x, -extents.y, 0), posScale);
+    GeometryUtils::WritePosition(positions, positionStride, 2, posFmt, Float3(extents.x, extents.y, 0), posScale);
+    GeometryUtils::WritePosition(positions, positionStride, 3, posFmt, Float3(-extents.x, extents.y, 0), posScale);
 
-    GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 0) = Float2(0, 0);
-    GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 1) = Float2(1, 0);
-    GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 2) = Float2(1, 1);
-    GeometryUtils::PtrToElement<Float2>(uvs, uvStride, 3) = Float2(0, 1);
+    GeometryUtils::WriteTexcoord(uvs, uvStride, 0, uvFmt, Float2(0, 0));
+    GeometryUtils::WriteTexcoord(uvs, uvStride, 1, uvFmt, Float2(1, 0));
+    GeometryUtils::WriteTexcoord(uvs, uvStride, 2, uvFmt, Float2(1, 1));
+    GeometryUtils::WriteTexcoord(uvs, uvStride, 3, uvFmt, Float2(0, 1));
 
-    GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 0) = FLOAT3_UNITZ;
-    GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 1) = FLOAT3_UNITZ;
-    GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 2) = FLOAT3_UNITZ;
-    GeometryUtils::PtrToElement<Float3>(normals, normalsStride, 3) = FLOAT3_UNITZ;
+    GeometryUtils::WriteNormal(normals, normalsStride, 0, normalFmt, FLOAT3_UNITZ);
+    GeometryUtils::WriteNormal(normals, normalsStride, 1, normalFmt, FLOAT3_UNITZ);
+    GeometryUtils::WriteNormal(normals, normalsStride, 2, normalFmt, FLOAT3_UNITZ);
+    GeometryUtils::WriteNormal(normals, normalsStride, 3, normalFmt, FLOAT3_UNITZ);
 
     // 2 triangles (CCW)
     indices[0] = 0;
@@ -277,6 +390,8 @@ void Geometry::CreatePlane(Float2 extents, const GeometryVertexLayout& layout, G
     outPlane.numVertices = 4;
     outPlane.numIndices = 6;
     outPlane.numVertexBuffers = numVertexBuffers;
+    outPlane.positionOffset = FLOAT3_ZERO;
+    outPlane.positionScale = posScale;
 }
 
 void Geometry::Destroy(GeometryData& geo)
@@ -23,6 +23,8 @@ struct GeometryData
     uint32 numVertexBuffers;
     GfxBufferHandle vertexBuffers[GEOMETRY_MAX_VERTEX_BUFFERS_PER_SHADER];
     GfxBufferHandle indexBuffer;
+    Float3 positionOffset;      // Dequantization of R16G16B16A16_SNORM positions (same as ModelMesh). Otherwise offset=0, scale=1
+    Float3 positionScale;
     bool firstUpdate;
 };
 
@@ -47,6 +49,12 @@ namespace Geometry
 {
     uint32 GetVertexStride(GfxFormat fmt);
 
+    // Vertex attribute quantization for 16bit formats
+    // EncodeOctahedral: Normal is projected on the octahedron and unfolded to [-1, 1] square. Zero length normals encode to (0, 0)
+    int16 QuantizeSnorm16(float v);
+    uint16 QuantizeHalf(float v);
+    void EncodeOctahedral(Float3 n, int16 outEncoded[2]);
+
     void CreateAxisAlignedBox(Float3 extents, const GeometryVertexLayout& layout, GeometryData& outBox, MemAllocator* alloc = Mem::GetDefaultAlloc());
     void CreatePlane(Float2 extents, const GeometryVertexLayout& layout, GeometryData& outPlane, MemAllocator* alloc = Mem::GetDefaultAlloc());
 
@@ -77,7 +77,14 @@ static constexpr uint32 GFXBACKEND_BACKBUFFER_COUNT = 3;
 static constexpr uint32 GFXBACKEND_FRAMES_IN_FLIGHT = 2;
 static constexpr uint32 GFXBACKEND_MAX_ENTRIES_IN_OFFSET_ALLOCATOR = 64*1024;
 static constexpr uint32 GFXBACKEND_MAX_QUEUES = 4;
+static constexpr uint32 GFXBACKEND_MAX_PENDING_SUBMITS = 64;
 static constexpr uint32 GFXBACKEND_MAX_SETS_PER_PIPELINE = 4;
+static constexpr uint32 GFXBACKEND_NULL_DESCRIPTOR_SIZE = 64;
+#if PLATFORM_APPLE || PLATFORM_ANDROID
+static constexpr uint32 GFXBACKEND_NULL_NUM_ARENAS = uint32(GfxMemoryArena::TiledGPU) + 1;
+#else
+static constexpr uint32 GFXBACKEND_NULL_NUM_ARENAS = uint32(GfxMemoryArena::DynamicBufferGPU) + 1;
+#endif
 #ifdef TRACY_ENABLE
 static constexpr uint32 GFXBACKEND_PROFILE_CONTEXT_QUERY_COUNT = 64*1024;
 #endif
@@ -348,7 +355,6 @@ private:
     bool InitializeCommandBufferContext(GfxBackendCommandBufferContext& ctx, uint32 queueFamilyIndex);
     void ReleaseCommandBufferContext(GfxBackendCommandBufferContext& ctx);
 
-    SpinLockMutex mRequestMutex;
     Semaphore mRequestsSemaphore;
     Thread mThread;
 
@@ -361,7 +367,7 @@ private:
     GfxBackendQueue* mQueues;
     uint32 mNumQueues;
 
-    Array<GfxBackendQueueSubmitRequest*> mSubmitRequests;
+    MpscQueue<GfxBackendQueueSubmitRequest*> mSubmitRequests;
     bool mQuit;
 };
 
@@ -697,6 +703,35 @@ struct GfxBackendVk
 
 static GfxBackendVk gBackendVk;
 
+// State of the null backend (SettingsGraphics::nullBackend). See the NULL section below
+struct GfxBackendNull
+{
+    struct FrameStats
+    {
+        AtomicUint32 numCmdBuffers;
+        AtomicUint32 numDraws;
+        AtomicUint32 numDispatches;
+        AtomicUint32 numCopies;
+        AtomicUint32 numDescriptorWrites;
+    };
+
+    bool enabled;
+    uint32 maxFrames;
+    FrameStats frameStats;
+    FrameStats totalStats;
+
+    AtomicUint64 arenaSizes[GFXBACKEND_NULL_NUM_ARENAS];
+    AtomicUint64 arenaPeakSizes[GFXBACKEND_NULL_NUM_ARENAS];
+
+    uint64 lastFrameTick;
+    uint64 totalFrameTicks;
+    uint64 minFrameTicks;
+    uint64 maxFrameTicks;
+    uint32 numTimedFrames;
+};
+
+static GfxBackendNull gBackendNull;
+
 namespace GfxBackend
 {
     // Used for debugging only
@@ -752,6 +787,29 @@ namespace GfxBackend
             fmt == GfxFormat::S8_UINT;
     }
 
+    static uint32 _GetBufferOffsetAlignment(const GfxBufferDesc& desc)
+    {
+        uint32 offsetAlignment = CONFIG_MACHINE_ALIGNMENT;
+
+        if (IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::Uniform)) {
+            ASSERT(gBackendVk.gpu.props.limits.minUniformBufferOffsetAlignment <= UINT32_MAX);
+            offsetAlignment = (uint32)gBackendVk.gpu.props.limits.minUniformBufferOffsetAlignment;
+            ASSERT_MSG(desc.perFrameUpdates, "Uniform buffer is not created with a ring-buffer. Enable 'perFrameUpdates' flag");
+        }
+        else if (IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::Storage)) {
+            ASSERT(gBackendVk.gpu.props.limits.minStorageBufferOffsetAlignment <= UINT32_MAX);
+            offsetAlignment = (uint32)gBackendVk.gpu.props.limits.minStorageBufferOffsetAlignment;
+        }
+        else if (IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::ResourceDescriptorBuffer) ||
+                 IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::SamplerDescriptorBuffer))
+        {
+            ASSERT(gBackendVk.gpu.descriptorBufferProps.descriptorBufferOffsetAlignment <= UINT32_MAX);
+            offsetAlignment = (uint32)gBackendVk.gpu.descriptorBufferProps.descriptorBufferOffsetAlignment;
+        }
+
+        return offsetAlignment;
+    }
+
     INLINE uint32 _FindBindingIndexByHash(const GfxBackendPipelineLayout* layout, uint32 nameHash)
     {
         for (uint32 k = 0; k < layout->numBindings; k++) {
@@ -2123,8 +2181,367 @@ namespace GfxBackend
     }
 } // GfxBackend
 
+//  ███╗   ██╗██╗   ██╗██╗     ██╗     
+//  ████╗  ██║██║   ██║██║     ██║     
+//  ██╔██╗ ██║██║   ██║██║     ██║     
+//  ██║╚██╗██║██║   ██║██║     ██║     
+//  ██║ ╚████║╚██████╔╝███████╗███████╗
+//  ╚═╝  ╚═══╝ ╚═════╝ ╚══════╝╚══════╝
+// Null backend: Enabled with SettingsGraphics::nullBackend (cmdline="-GraphicsNull=1")
+// Nothing is created on the GPU and Vulkan is not even loaded. Objects still go into the same pools as the Vulkan 
+// backend, only with empty Vk handles. So handles, descriptions and pipeline layout meta data work as usual. 
+// CPU staging buffers get real memory so they can be mapped and written to, and memory usage is tracked per arena.
+// Recorded commands are dropped and only counted. Used for benchmarking the CPU side of the frame without a GPU
+namespace GfxBackend
+{
+    static const char* _NullGetArenaName(uint32 arenaIdx)
+    {
+        static const char* kArenaNames[] = {
+            "PersistentGPU",
+            "PersistentAddressGPU",
+            "PersistentCPU",
+            "TransientCPU",
+            "DynamicImageGPU",
+            "DynamicBufferGPU",
+        #if PLATFORM_APPLE || PLATFORM_ANDROID
+            "TiledGPU"
+        #endif
+        };
+        static_assert(CountOf(kArenaNames) == GFXBACKEND_NULL_NUM_ARENAS);
+
+        return kArenaNames[arenaIdx];
+    }
+
+    // There is no driver to query the memory requirements from, so this is a rough estimate for the budgets:
+    // 4 bytes per texel for each sample and the full mip chain adds another third
+    static uint64 _NullEstimateImageSize(const GfxImageDesc& desc)
+    {
+        uint64 size = uint64(desc.width)*uint64(desc.height)*uint64(desc.depth)*uint64(desc.numArrayLayers)*
+                      uint64(desc.multisampleFlags)*4;
+        if (desc.numMips > 1)
+            size += size/3;
+        return size;
+    }
+
+    static void _NullAddMemory(GfxMemoryArena arena, uint64 size)
+    {
+        uint32 arenaIdx = uint32(arena);
+        ASSERT(arenaIdx < GFXBACKEND_NULL_NUM_ARENAS);
+        
+        uint64 newSize = Atomic::FetchAdd(&gBackendNull.arenaSizes[arenaIdx], size) + size;
+        unsigned long long peakSize = Atomic::Load(&gBackendNull.arenaPeakSizes[arenaIdx]);
+        while (newSize > peakSize && !Atomic::CompareExchange_Weak(&gBackendNull.arenaPeakSizes[arenaIdx], &peakSize, newSize)) {}
+    }
+
+    static void _NullRemoveMemory(GfxMemoryArena arena, uint64 size)
+    {
+        ASSERT(uint32(arena) < GFXBACKEND_NULL_NUM_ARENAS);
+        [[maybe_unused]] uint64 prevSize = Atomic::FetchSub(&gBackendNull.arenaSizes[uint32(arena)], size);
+        ASSERT(prevSize >= size);
+    }
+
+    static bool _NullInitialize(const SettingsJunkyard& settings)
+    {
+        gBackendNull.enabled = true;
+        gBackendNull.maxFrames = settings.graphics.nullBackendFrameCount;
+        gBackendNull.minFrameTicks = UINT64_MAX;
+
+        Engine::HelperInitializeProxyAllocator(&gBackendVk.parentAlloc, "GfxBackend");
+        gBackendVk.runtimeAllocBase.Initialize(&gBackendVk.parentAlloc, 16*SIZE_MB, settings.engine.debugAllocations);
+        Engine::HelperInitializeProxyAllocator(&gBackendVk.runtimeAlloc, "GfxBackend.Runtime", &gBackendVk.runtimeAllocBase);
+        Engine::RegisterProxyAllocator(&gBackendVk.parentAlloc);
+        Engine::RegisterProxyAllocator(&gBackendVk.runtimeAlloc);
+
+        // Plausible device properties, because some of the code and helpers (GfxHelperUniformBuffer and others) 
+        // read the limits directly. It also reports itself as a discrete GPU, so resources go through staging buffers
+        VkPhysicalDeviceProperties& props = gBackendVk.gpu.props;
+        props.deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+        props.apiVersion = VK_API_VERSION_1_3;
+        Str::Copy(props.deviceName, sizeof(props.deviceName), "Null");
+        props.limits.minUniformBufferOffsetAlignment = 256;
+        props.limits.minStorageBufferOffsetAlignment = 64;
+        props.limits.nonCoherentAtomSize = 64;
+        props.limits.maxPushConstantsSize = 256;
+
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT& descProps = gBackendVk.gpu.descriptorBufferProps;
+        descProps.descriptorBufferOffsetAlignment = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+        descProps.samplerDescriptorSize = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+        descProps.combinedImageSamplerDescriptorSize = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+        descProps.sampledImageDescriptorSize = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+        descProps.storageImageDescriptorSize = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+        descProps.uniformBufferDescriptorSize = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+        descProps.storageBufferDescriptorSize = GFXBACKEND_NULL_DESCRIPTOR_SIZE;
+
+        gBackendVk.images.SetAllocator(&gBackendVk.runtimeAlloc);
+        gBackendVk.pipelineLayouts.SetAllocator(&gBackendVk.runtimeAlloc);
+        gBackendVk.pipelines.SetAllocator(&gBackendVk.runtimeAlloc);
+        gBackendVk.samplers.SetAllocator(&gBackendVk.runtimeAlloc);
+        gBackendVk.buffers.SetAllocator(&gBackendVk.runtimeAlloc);
+        gBackendVk.objectPoolsMutex.Initialize();
+
+        gBackendVk.garbage.SetAllocator(&gBackendVk.runtimeAlloc);
+        gBackendVk.garbageMtx.Initialize();
+
+        gBackendVk.frameSyncSignal.Initialize();
+        gBackendVk.externalFrameSyncSignal.Initialize();
+        gBackendVk.externalFrameSyncSignal.Increment();
+
+        gBackendVk.shaderToPipelineTableMtx.Initialize();
+        gBackendVk.shaderToPipelineTable.SetAllocator(&gBackendVk.runtimeAlloc);
+
+        // There is no surface, so swapchain only carries the format and the framebuffer size for the getters
+        gBackendVk.swapchain.format.format = settings.graphics.surfaceSRGB ? VK_FORMAT_B8G8R8A8_SRGB : VK_FORMAT_B8G8R8A8_UNORM;
+        gBackendVk.swapchain.extent = { App::GetFramebufferWidth(), App::GetFramebufferHeight() };
+
+        LOG_INFO("(init) Gfx: Null backend. No GPU work will be executed (Swapchain: %ux%u)", 
+                 gBackendVk.swapchain.extent.width, gBackendVk.swapchain.extent.height);
+        return true;
+    }
+
+    static void _NullLogStats()
+    {
+        uint32 numFrames = Max(gBackendNull.numTimedFrames, 1u);
+        LOG_INFO("Gfx: Null backend stats for %u frames:", gBackendNull.numTimedFrames);
+        if (gBackendNull.numTimedFrames) {
+            LOG_INFO("\tFrame time: avg = %.2f ms, min = %.2f ms, max = %.2f ms", 
+                     Timer::ToMS(gBackendNull.totalFrameTicks)/double(numFrames),
+                     Timer::ToMS(gBackendNull.minFrameTicks), Timer::ToMS(gBackendNull.maxFrameTicks));
+        }
+
+        const GfxBackendNull::FrameStats& stats = gBackendNull.totalStats;
+        LOG_INFO("\tPer frame: CommandBuffers = %.1f, Draws = %.1f, Dispatches = %.1f, Copies = %.1f, DescriptorWrites = %.1f", 
+                 double(stats.numCmdBuffers)/double(numFrames), double(stats.numDraws)/double(numFrames), 
+                 double(stats.numDispatches)/double(numFrames), double(stats.numCopies)/double(numFrames), 
+                 double(stats.numDescriptorWrites)/double(numFrames));
+
+        for (uint32 i = 0; i < GFXBACKEND_NULL_NUM_ARENAS; i++) {
+            uint64 peakSize = Atomic::Load(&gBackendNull.arenaPeakSizes[i]);
+            if (peakSize) {
+                LOG_INFO("\tArena %s: current = %_$$$llu, peak = %_$$$llu", _NullGetArenaName(i), 
+                         Atomic::Load(&gBackendNull.arenaSizes[i]), peakSize);
+            }
+        }
+    }
+
+    static void _NullRelease()
+    {
+        _NullLogStats();
+
+        // Free the CPU memory of the buffers that are left behind, so the allocators won't complain about it
+        for (GfxBackendBuffer& buffer : gBackendVk.buffers) {
+            if (buffer.mem.mappedData)
+                Mem::FreeAligned(buffer.mem.mappedData, buffer.offsetAlignment, &gBackendVk.parentAlloc);
+        }
+
+        gBackendVk.pipelineLayouts.Free();
+        gBackendVk.images.Free();
+        gBackendVk.samplers.Free();
+        gBackendVk.buffers.Free();
+        gBackendVk.pipelines.Free();
+        gBackendVk.objectPoolsMutex.Release();
+
+        gBackendVk.garbage.Free();
+        gBackendVk.garbageMtx.Release();
+
+        gBackendVk.shaderToPipelineTable.Free();
+        gBackendVk.shaderToPipelineTableMtx.Release();
+
+        gBackendVk.frameSyncSignal.Release();
+        gBackendVk.externalFrameSyncSignal.Release();
+
+        gBackendVk.runtimeAllocBase.Release();
+        gBackendVk.runtimeAlloc.Release();
+        gBackendVk.parentAlloc.Release();
+
+        gBackendNull = {};
+    }
+
+    static void _NullBegin()
+    {
+        // Unlock external systems to use and submit command-buffers
+        gBackendVk.externalFrameSyncSignal.Decrement();
+        gBackendVk.externalFrameSyncSignal.Raise();
+    }
+
+    static void _NullEnd()
+    {
+        gBackendVk.externalFrameSyncSignal.Increment();
+
+        // Same CPU <-> CPU sync as the Vulkan backend. Only external syncs (BeginRenderFrameSync) can hold the frame here
+        if (!gBackendVk.frameSyncSignal.WaitOnCondition([](int value, int ref) { return value > ref; }, 0, 500)) {
+            ASSERT_MSG(Atomic::Load(&gBackendVk.numOpenExternalFrameSyncs) == 0, 
+                       "There are %u BeginRenderFrameSync() calls that are not closed with EndRenderFrameSync()", 
+                       gBackendVk.numOpenExternalFrameSyncs);
+        }
+
+        GfxBackendNull::FrameStats& frame = gBackendNull.frameStats;
+        GfxBackendNull::FrameStats& total = gBackendNull.totalStats;
+        Atomic::FetchAdd(&total.numCmdBuffers, Atomic::Exchange(&frame.numCmdBuffers, 0));
+        Atomic::FetchAdd(&total.numDraws, Atomic::Exchange(&frame.numDraws, 0));
+        Atomic::FetchAdd(&total.numDispatches, Atomic::Exchange(&frame.numDispatches, 0));
+        Atomic::FetchAdd(&total.numCopies, Atomic::Exchange(&frame.numCopies, 0));
+        Atomic::FetchAdd(&total.numDescriptorWrites, Atomic::Exchange(&frame.numDescriptorWrites, 0));
+
+        // Whole frame CPU time, measured from the end of the previous frame 
+        uint64 tick = Timer::GetTicks();
+        if (gBackendNull.lastFrameTick) {
+            uint64 frameTicks = Timer::Diff(tick, gBackendNull.lastFrameTick);
+            gBackendNull.totalFrameTicks += frameTicks;
+            gBackendNull.minFrameTicks = Min(gBackendNull.minFrameTicks, frameTicks);
+            gBackendNull.maxFrameTicks = Max(gBackendNull.maxFrameTicks, frameTicks);
+            ++gBackendNull.numTimedFrames;
+        }
+        gBackendNull.lastFrameTick = tick;
+
+        ++gBackendVk.presentFrame;
+
+        if (gBackendNull.maxFrames && gBackendVk.presentFrame == gBackendNull.maxFrames) {
+            LOG_INFO("Gfx: Null backend reached %u frames. Quitting ...", gBackendNull.maxFrames);
+            App::Quit();
+        }
+    }
+
+    static GfxCommandBuffer _NullBeginCommandBuffer(GfxQueueType queueType)
+    {
+        UNUSED(queueType);
+        Atomic::FetchAdd(&gBackendNull.frameStats.numCmdBuffers, 1);
+
+        GfxCommandBuffer cmdBuffer {
+            .mGeneration = gBackendVk.queueMan.GetGeneration()
+        };
+        cmdBuffer.mIsRecording = true;
+        return cmdBuffer;
+    }
+
+    static void _NullBatchCreateImage(uint32 numImages, const GfxImageDesc* descs, GfxImageHandle* outHandles)
+    {
+        ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
+        for (uint32 i = 0; i < numImages; i++) {
+            const GfxImageDesc& desc = descs[i];
+            ASSERT(desc.numMips <= GFXBACKEND_MAX_MIPS_PER_IMAGE);
+
+            GfxBackendImage image {
+                .desc = desc,
+                .mem = {
+                    .arena = desc.arena
+                }
+            };
+
+            _NullAddMemory(desc.arena, _NullEstimateImageSize(desc));
+            outHandles[i] = gBackendVk.images.Add(image);
+        }
+    }
+
+    static void _NullBatchDestroyImage(uint32 numImages, GfxImageHandle* handles)
+    {
+        ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
+        for (uint32 i = 0; i < numImages; i++) {
+            GfxImageHandle handle = handles[i];
+            if (handle.IsValid()) {
+                const GfxBackendImage& image = gBackendVk.images.Data(handle);
+                _NullRemoveMemory(image.mem.arena, _NullEstimateImageSize(image.desc));
+                gBackendVk.images.Remove(handle);
+                handles[i] = {};
+            }
+        }
+    }
+
+    static void _NullBatchCreateBuffer(uint32 numBuffers, const GfxBufferDesc* descs, GfxBufferHandle* outHandles)
+    {
+        MemTempAllocator tempAlloc;
+        GfxBackendBuffer* buffers = tempAlloc.MallocTyped<GfxBackendBuffer>(numBuffers); 
+
+        for (uint32 i = 0; i < numBuffers; i++) {
+            const GfxBufferDesc& desc = descs[i];
+            ASSERT(desc.sizeBytes);
+
+            uint32 offsetAlignment = _GetBufferOffsetAlignment(desc);
+            size_t allocSize = desc.sizeBytes;
+            if (desc.perFrameUpdates)
+                allocSize = GFXBACKEND_FRAMES_IN_FLIGHT * AlignValue<uint64>(desc.sizeBytes, offsetAlignment);
+
+            buffers[i] = {
+                .desc = desc,
+                .mem = {
+                    .arena = desc.arena
+                },
+                .allocatedSize = allocSize,
+                .offsetAlignment = offsetAlignment
+            };
+
+            // Only the host visible arenas need backing memory, because that's what the callers map and write to
+            if (desc.arena == GfxMemoryArena::PersistentCPU || desc.arena == GfxMemoryArena::TransientCPU) {
+                GfxBackendDeviceMemory& mem = buffers[i].mem;
+                mem.mappedData = Mem::AllocAligned(allocSize, offsetAlignment, &gBackendVk.parentAlloc);
+                mem.isCpuVisible = true;
+                mem.isCoherent = true;
+            }
+
+            _NullAddMemory(desc.arena, allocSize);
+        }
+
+        ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
+        for (uint32 i = 0; i < numBuffers; i++) 
+            outHandles[i] = gBackendVk.buffers.Add(buffers[i]);
+    }
+
+    static void _NullBatchDestroyBuffer(uint32 numBuffers, GfxBufferHandle* handles)
+    {
+        ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
+        for (uint32 i = 0; i < numBuffers; i++) {
+            GfxBufferHandle handle = handles[i];
+            if (handle.IsValid()) {
+                const GfxBackendBuffer& buffer = gBackendVk.buffers.Data(handle);
+                if (buffer.mem.mappedData)
+                    Mem::FreeAligned(buffer.mem.mappedData, buffer.offsetAlignment, &gBackendVk.parentAlloc);
+                _NullRemoveMemory(buffer.mem.arena, buffer.allocatedSize);
+                gBackendVk.buffers.Remove(handle);
+                handles[i] = {};
+            }
+        }
+    }
+
+    // Descriptor offsets and sizes for descriptor buffers. Every descriptor takes GFXBACKEND_NULL_DESCRIPTOR_SIZE
+    static void _NullAssignDescriptorSetLayout(GfxBackendPipelineLayout* layout, uint32 setIdx)
+    {
+        uint32 offset = 0;
+        for (uint32 bindingIdx = 0; bindingIdx < layout->numBindings; bindingIdx++) {
+            GfxBackendPipelineLayout::Binding& binding = layout->bindings[bindingIdx];
+            if (binding.setIndex == setIdx) {
+                binding.offset = offset;
+                offset += GFXBACKEND_NULL_DESCRIPTOR_SIZE*layout->bindingsVk[bindingIdx].descriptorCount;
+            }
+        }
+
+        layout->setSizes[setIdx] = AlignValue(offset, uint32(gBackendVk.gpu.descriptorBufferProps.descriptorBufferOffsetAlignment));
+    }
+
+    static GfxPipelineHandle _NullCreatePipeline(const GfxShader& shader, GfxBackendPipeline::PipelineType type)
+    {
+        GfxBackendPipeline pipeline {
+            .type = type,
+            .shaderHash = shader.paramsHash
+        };
+
+        ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
+        return gBackendVk.pipelines.Add(pipeline);
+    }
+
+    static void _NullFinishTransfer(GfxResourceTransferCallback callback, void* userData)
+    {
+        Atomic::FetchAdd(&gBackendNull.frameStats.numCopies, 1);
+
+        // Nothing to wait for, so the transfer is done right away
+        if (callback)
+            callback(userData);
+    }
+} // GfxBackend
+
 bool GfxBackend::Initialize()
 {
+    if (SettingsJunkyard::Get().graphics.nullBackend)
+        return GfxBackend::_NullInitialize(SettingsJunkyard::Get());
+
     TimerStopWatch stopwatch;
 
     App::RegisterEventsCallback([](const AppEvent& ev, void*) 
@@ -2293,6 +2710,9 @@ void GfxBackend::Begin()
 
     ASSERT_MSG(Engine::IsMainThread(), "Update can only be called in the main thread");
 
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullBegin();
+
     // GPU -> CPU sync
     gBackendVk.queueMan.BeginFrame();
 
@@ -2322,6 +2742,9 @@ void GfxCommandBuffer::ClearImageColor(GfxImageHandle imgHandle, Float4 color)
 {
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     gBackendVk.objectPoolsMutex.EnterRead();
@@ -2348,6 +2771,9 @@ void GfxCommandBuffer::ClearSwapchainColor(Float4 color)
 
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     VkImage imageVk = gBackendVk.swapchain.GetImage();
@@ -2397,6 +2823,9 @@ void GfxCommandBuffer::CopyImageToSwapchain(GfxImageHandle imgHandle)
     ASSERT(!mIsInRenderPass);
     ASSERT(mIsRecording);
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     gBackendVk.objectPoolsMutex.EnterRead();
@@ -2482,6 +2911,9 @@ void GfxBackend::End()
 {
     PROFILE_ZONE_COLOR("Gfx.End", PROFILE_COLOR_GFX1);
 
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullEnd();
+
     // Lock external systems to wait until Begin() call ends
     gBackendVk.externalFrameSyncSignal.Increment();
 
@@ -2549,6 +2981,9 @@ void GfxBackend::End()
 
 void GfxBackend::Release()
 {
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullRelease();
+
     MemAllocator* alloc = &gBackendVk.parentAlloc;
     if (gBackendVk.device)
         vkDeviceWaitIdle(gBackendVk.device);
@@ -2700,6 +3135,9 @@ void GfxBackendVkAllocator::VkInternalFreeFn(void*, size_t, VkInternalAllocation
 
 GfxCommandBuffer GfxBackend::BeginCommandBuffer(GfxQueueType queueType)
 {
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullBeginCommandBuffer(queueType);
+
     gBackendVk.frameSyncSignal.Increment();
 
     uint32 queueIndex = gBackendVk.queueMan.FindQueue(queueType);
@@ -2825,6 +3263,11 @@ GfxCommandBuffer GfxBackend::BeginCommandBuffer(GfxQueueType queueType)
 void GfxBackend::EndCommandBuffer(GfxCommandBuffer& cmdBuffer)
 {
     ASSERT(cmdBuffer.mIsRecording && !cmdBuffer.mIsInRenderPass);
+    if (gBackendNull.enabled) {
+        cmdBuffer.mIsRecording = false;
+        return;
+    }
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(cmdBuffer);
     GfxBackendQueue& queue = gBackendVk.queueMan.GetQueue(cmdBuffer.mQueueIndex);
 
@@ -3025,6 +3468,9 @@ void GfxBackend::BatchCreateImage(uint32 numImages, const GfxImageDesc* descs, G
     ASSERT(descs);
     ASSERT(outHandles);
 
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullBatchCreateImage(numImages, descs, outHandles);
+
     MemTempAllocator tempAlloc;
     GfxBackendImage* images = tempAlloc.MallocTyped<GfxBackendImage>(numImages);
     uint32 numTransientIncrements = 0;
@@ -3138,6 +3584,9 @@ void GfxBackend::BatchDestroyImage(uint32 numImages, GfxImageHandle* handles)
     ASSERT(numImages);
     ASSERT(handles);
 
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullBatchDestroyImage(numImages, handles);
+
     MemTempAllocator tempAlloc;
     Array<GfxBackendGarbage> garbages(&tempAlloc);
     uint32 numTransientDecrements = 0;
@@ -3353,6 +3802,12 @@ GfxPipelineLayoutHandle GfxBackend::CreatePipelineLayout(const GfxShader& shader
 
     // Create the descriptor set layouts 
     for (uint32 setIdx = 0; setIdx < sets.Count(); setIdx++) {
+        if (gBackendNull.enabled) {
+            if (desc.type == GfxPipelineLayoutType::DescriptorBuffer)
+                _NullAssignDescriptorSetLayout(layout, setIdx);
+            continue;
+        }
+
         const DescriptorSetRef& set = sets[setIdx];
         VkDescriptorSetLayoutBinding* setBindings = tempAlloc.MallocTyped<VkDescriptorSetLayoutBinding>(set.count);
         ASSERT(set.startIndex < bindings.Count());
@@ -3412,6 +3867,11 @@ GfxPipelineLayoutHandle GfxBackend::CreatePipelineLayout(const GfxShader& shader
         }
     }
 
+    if (gBackendNull.enabled) {
+        ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
+        return gBackendVk.pipelineLayouts.Add(layout);
+    }
+
     StaticArray<VkDescriptorSetLayout, GFXBACKEND_MAX_SETS_PER_PIPELINE> setLayouts;
     for (uint32 i = 0; i < sets.Count(); i++) 
         setLayouts.Push(layout->sets[i]);
@@ -3452,11 +3912,13 @@ void GfxBackend::DestroyPipelineLayout(GfxPipelineLayoutHandle& handle)
         MutexScope lock(gBackendVk.garbageMtx);
 
         for (uint32 i = 0; i < pipelineLayout->numSets; i++)  {
-            gBackendVk.garbage.Push({
-                .type = GfxBackendGarbage::Type::DescriptorSetLayout,
-                .frameIdx = gBackendVk.presentFrame,
-                .dsetLayout = pipelineLayout->sets[i]
-            });
+            if (pipelineLayout->sets[i]) {
+                gBackendVk.garbage.Push({
+                    .type = GfxBackendGarbage::Type::DescriptorSetLayout,
+                    .frameIdx = gBackendVk.presentFrame,
+                    .dsetLayout = pipelineLayout->sets[i]
+                });
+            }
         }
 
         if (pipelineLayout->handle) {
@@ -3477,6 +3939,9 @@ void GfxBackend::DestroyPipelineLayout(GfxPipelineLayoutHandle& handle)
 
 void GfxBackend::ReloadShaderPipelines(const GfxShader& shader)
 {
+    if (gBackendNull.enabled)
+        return;
+
     GfxBackendShaderToPipelineMapEntry* pipesEntry = nullptr;
     MemTempAllocator tempAlloc;
 
@@ -3646,6 +4111,9 @@ GfxPipelineHandle GfxBackend::CreateGraphicsPipeline(const GfxShader& shader, Gf
     ASSERT_MSG(vsInfo, "Shader '%s' is missing Vertex shader program", shader.name);
     // ASSERT_MSG(psInfo, "Shader '%s' is missing Pixel shader program", shader.name);
 
+    if (gBackendNull.enabled)
+        return _NullCreatePipeline(shader, GfxBackendPipeline::PipelineTypeGraphics);
+
     VkPipelineLayout layoutVk;
     bool isDescriptorBuffer;
     
@@ -3991,6 +4459,9 @@ GfxPipelineHandle GfxBackend::CreateComputePipeline(const GfxShader& shader, Gfx
     }
     ASSERT_MSG(csInfo, "Shader '%s' is missing Compute shader program", shader.name);
 
+    if (gBackendNull.enabled)
+        return _NullCreatePipeline(shader, GfxBackendPipeline::PipelineTypeCompute);
+
     VkPipelineLayout layoutVk;
     {
         ReadWriteMutexReadScope objPoolLock(gBackendVk.objectPoolsMutex);
@@ -4147,7 +4618,7 @@ void GfxCommandBuffer::PushConstants(GfxPipelineLayoutHandle layoutHandle, const
     ReadWriteMutexReadScope objPoolLock(gBackendVk.objectPoolsMutex);
     GfxBackendPipelineLayout& layout = *gBackendVk.pipelineLayouts.Data(layoutHandle);
     VkPipelineLayout layoutVk = layout.handle;
-    ASSERT(layoutVk);
+    ASSERT(layoutVk || gBackendNull.enabled);
    
     VkPushConstantRange* range = nullptr;
     uint32 nameHash = Hash::Fnv32Str(name);
@@ -4161,6 +4632,9 @@ void GfxCommandBuffer::PushConstants(GfxPipelineLayoutHandle layoutHandle, const
     ASSERT_MSG(range, "PushConstants '%s' not found in pipeline layout", name);
     ASSERT_MSG(range->size == dataSize, "PushConstants '%s' data size mismatch", name);
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdPushConstants(cmdVk, layoutVk, range->stageFlags, range->offset, range->size, data);
 }
@@ -4171,6 +4645,11 @@ void GfxCommandBuffer::PushBindings(GfxPipelineLayoutHandle layoutHandle, uint32
     ASSERT(numBindings);
     ASSERT(bindings);
 
+    if (gBackendNull.enabled) {
+        Atomic::FetchAdd(&gBackendNull.frameStats.numDescriptorWrites, numBindings);
+        return;
+    }
+
     ReadWriteMutexReadScope objPoolLock(gBackendVk.objectPoolsMutex);
     GfxBackendPipelineLayout& layout = *gBackendVk.pipelineLayouts.Data(layoutHandle);
     VkPipelineLayout layoutVk = layout.handle;
@@ -4310,6 +4789,10 @@ void GfxCommandBuffer::PushBindings(GfxPipelineLayoutHandle layoutHandle, uint32
 void GfxCommandBuffer::BindPipeline(GfxPipelineHandle pipeHandle)
 {
     ASSERT(mIsRecording);
+
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     ReadWriteMutexReadScope objPoolLock(gBackendVk.objectPoolsMutex);
@@ -4325,6 +4808,11 @@ void GfxCommandBuffer::Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 g
     ASSERT(mIsRecording);
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled) {
+        Atomic::FetchAdd(&gBackendNull.frameStats.numDispatches, 1);
+        return;
+    }
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdDispatch(cmdVk, groupCountX, groupCountY, groupCountZ);
 }
@@ -4342,6 +4830,9 @@ void GfxBackend::BatchCreateBuffer(uint32 numBuffers, const GfxBufferDesc* descs
     ASSERT(descs);
     ASSERT(outHandles);
 
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullBatchCreateBuffer(numBuffers, descs, outHandles);
+
     MemTempAllocator tempAlloc;
     GfxBackendBuffer* buffers = tempAlloc.MallocTyped<GfxBackendBuffer>(numBuffers); 
     uint32 numTransientIncrements = 0;
@@ -4349,25 +4840,9 @@ void GfxBackend::BatchCreateBuffer(uint32 numBuffers, const GfxBufferDesc* descs
         const GfxBufferDesc& desc = descs[i];
         ASSERT(desc.sizeBytes);
 
-        uint32 offsetAlignment = CONFIG_MACHINE_ALIGNMENT;
+        uint32 offsetAlignment = GfxBackend::_GetBufferOffsetAlignment(desc);
         size_t allocSize = desc.sizeBytes;
 
-        if (IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::Uniform)) {
-            ASSERT(gBackendVk.gpu.props.limits.minUniformBufferOffsetAlignment <= UINT32_MAX);
-            offsetAlignment = (uint32)gBackendVk.gpu.props.limits.minUniformBufferOffsetAlignment;
-            ASSERT_MSG(desc.perFrameUpdates, "Uniform buffer is not created with a ring-buffer. Enable 'perFrameUpdates' flag");
-        }
-        else if (IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::Storage)) {
-            ASSERT(gBackendVk.gpu.props.limits.minStorageBufferOffsetAlignment <= UINT32_MAX);
-            offsetAlignment = (uint32)gBackendVk.gpu.props.limits.minStorageBufferOffsetAlignment;
-        }
-        else if (IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::ResourceDescriptorBuffer) ||
-                 IsBitsSet<GfxBufferUsageFlags>(desc.usageFlags, GfxBufferUsageFlags::SamplerDescriptorBuffer))
-        {
-            ASSERT(gBackendVk.gpu.descriptorBufferProps.descriptorBufferOffsetAlignment <= UINT32_MAX);
-            offsetAlignment = (uint32)gBackendVk.gpu.descriptorBufferProps.descriptorBufferOffsetAlignment;
-        }
-
         if (desc.perFrameUpdates) {
             allocSize = GFXBACKEND_FRAMES_IN_FLIGHT * AlignValue<uint64>(desc.sizeBytes, offsetAlignment);
         }
@@ -4440,6 +4915,9 @@ void GfxBackend::BatchDestroyBuffer(uint32 numBuffers, GfxBufferHandle* handles)
     ASSERT(numBuffers);
     ASSERT(handles);
 
+    if (gBackendNull.enabled)
+        return GfxBackend::_NullBatchDestroyBuffer(numBuffers, handles);
+
     MemTempAllocator tempAlloc;
     Array<GfxBackendGarbage> garbages(&tempAlloc);
     uint32 numTransientDecrements = 0;
@@ -4742,6 +5220,7 @@ uint32 GfxBackendDeviceMemoryManager::FindDeviceMemoryType(VkMemoryPropertyFlags
 bool GfxBackendQueueManager::Initialize()
 {
     mRequestsSemaphore.Initialize();
+    mSubmitRequests.Initialize(GFXBACKEND_MAX_PENDING_SUBMITS, &gBackendVk.runtimeAlloc);
 
     // Enumerate queue families
     GfxBackendGpu& gpu = gBackendVk.gpu;
@@ -4855,7 +5334,7 @@ void GfxBackendQueueManager::Release()
     mRequestsSemaphore.Post();
     mThread.Stop();
     mRequestsSemaphore.Release();
-    mSubmitRequests.Free();
+    mSubmitRequests.Release();
 
     for (uint32 i = 0; i < mNumQueues; i++) {
         GfxBackendQueue& queue = mQueues[i];
@@ -5127,6 +5606,9 @@ inline uint32 GfxBackendQueueManager::FindQueue(GfxQueueType type) const
 
 void GfxBackend::SubmitQueue(GfxQueueType queueType, GfxQueueType dependentQueues)
 {
+    if (gBackendNull.enabled)
+        return;
+
     gBackendVk.queueMan.SubmitQueue(queueType, dependentQueues);
 }
 
@@ -5137,14 +5619,9 @@ int GfxBackendQueueManager::SubmitThread(void* userData)
     while (!self->mQuit) {
         self->mRequestsSemaphore.Wait();
 
-        GfxBackendQueueSubmitRequest* req = nullptr;
-        {
-            SpinLockMutexScope lock(self->mRequestMutex);
-            if (!self->mSubmitRequests.IsEmpty()) 
-                req = self->mSubmitRequests.PopFirst();
-        }
-
-        if (req) {
+        // A push that is still in progress on another thread can hide the requests after it, so drain all of them here
+        GfxBackendQueueSubmitRequest* req;
+        while (self->mSubmitRequests.Pop(&req)) {
             if (req->type != GfxQueueType::None)
                 self->SubmitQueueInternal(*req);
 
@@ -5203,10 +5680,9 @@ void GfxBackendQueueManager::SubmitQueue(GfxQueueType queueType, GfxQueueType de
 
     req->semaphore = queue.semaphoreBanks[mFrameIndex].GetSemaphore();
 
-    {
-        SpinLockMutexScope lock(mRequestMutex);
-        mSubmitRequests.Push(req);
-    }
+    // Submit thread is always draining the queue, so it can only be full for a short while
+    while (!mSubmitRequests.Push(req))
+        Thread::SwitchContext();
 
     mRequestsSemaphore.Post();
     Atomic::StoreExplicit(&queue.numPendingCmdBuffers, 0, AtomicMemoryOrder::Release);
@@ -5465,6 +5941,9 @@ void GfxCommandBuffer::BatchFlushBuffer(uint32 numBuffers, const GfxBufferHandle
 {
     ASSERT(mIsRecording);
 
+    if (gBackendNull.enabled)
+        return;
+
     MemTempAllocator tempAlloc;
     Array<VkMappedMemoryRange> memRanges(&tempAlloc);
 
@@ -5519,6 +5998,12 @@ void GfxCommandBuffer::BatchCopyBufferToBuffer(uint32 numParams, const GfxCopyBu
     ASSERT(mIsRecording);
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled) {
+        for (uint32 i = 0; i < numParams; i++)
+            GfxBackend::_NullFinishTransfer(params[i].resourceTransferedCallback, params[i].resourceTransferedUserData);
+        return;
+    }
+
     struct CopyBufferToBufferData
     {
         VkBuffer srcBuffer;
@@ -5689,6 +6174,12 @@ void GfxCommandBuffer::BatchCopyBufferToImage(uint32 numParams, const GfxCopyBuf
 
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled) {
+        for (uint32 i = 0; i < numParams; i++)
+            GfxBackend::_NullFinishTransfer(params[i].resourceTransferedCallback, params[i].resourceTransferedUserData);
+        return;
+    }
+
     struct CopyBufferToImageData
     {
         VkBufferImageCopy imageCopies[GFXBACKEND_MAX_MIPS_PER_IMAGE];
@@ -5899,6 +6390,9 @@ void GfxCommandBuffer::TransitionBuffer(GfxBufferHandle buffHandle, GfxBufferTra
     ASSERT(mIsRecording);
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     gBackendVk.objectPoolsMutex.EnterRead();
@@ -5966,6 +6460,9 @@ void GfxCommandBuffer::TransitionImage(GfxImageHandle imgHandle, GfxImageTransit
     ASSERT(mIsRecording);
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     gBackendVk.objectPoolsMutex.EnterRead();
@@ -6094,6 +6591,11 @@ void GfxCommandBuffer::BeginRenderPass(const GfxBackendRenderPass& pass)
 {
     ASSERT(mIsRecording);
 
+    if (gBackendNull.enabled) {
+        mIsInRenderPass = true;
+        return;
+    }
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     // _TransitionAndMakeAttachment also accesses backend pool data
@@ -6212,6 +6714,11 @@ void GfxCommandBuffer::EndRenderPass()
 {
     ASSERT(mIsRecording);
 
+    if (gBackendNull.enabled) {
+        mIsInRenderPass = false;
+        return;
+    }
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdEndRendering(cmdVk);
 
@@ -6223,6 +6730,11 @@ void GfxCommandBuffer::Draw(uint32 vertexCount, uint32 instanceCount, uint32 fir
     ASSERT(mIsRecording);
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled) {
+        Atomic::FetchAdd(&gBackendNull.frameStats.numDraws, 1);
+        return;
+    }
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdDraw(cmdVk, vertexCount, instanceCount, firstVertex, firstInstance);
 }
@@ -6232,6 +6744,11 @@ void GfxCommandBuffer::DrawIndexed(uint32 indexCount, uint32 instanceCount, uint
     ASSERT(mIsRecording);
     mShouldSubmit = true;
 
+    if (gBackendNull.enabled) {
+        Atomic::FetchAdd(&gBackendNull.frameStats.numDraws, 1);
+        return;
+    }
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdDrawIndexed(cmdVk, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
@@ -6252,6 +6769,9 @@ void GfxCommandBuffer::SetScissors(uint32 firstScissor, uint32 numScissors, cons
     ASSERT(numScissors);
     ASSERT(scissors);
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     MemTempAllocator tmpAlloc;
@@ -6277,6 +6797,9 @@ void GfxCommandBuffer::SetViewports(uint32 firstViewport, uint32 numViewports, c
     ASSERT(numViewports);
     ASSERT(viewports);
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     MemTempAllocator tmpAlloc;
@@ -6301,24 +6824,36 @@ void GfxCommandBuffer::SetViewports(uint32 firstViewport, uint32 numViewports, c
 
 void GfxCommandBuffer::SetCullMode(GfxCullMode cullMode)
 {
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdSetCullMode(cmdVk, (VkCullModeFlags)cullMode);
 }
 
 void GfxCommandBuffer::SetFrontFace(GfxFrontFace frontFace)
 {
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdSetFrontFace(cmdVk, (VkFrontFace)frontFace);
 }
 
 void GfxCommandBuffer::EnableAlphaToCoverage(bool enable)
 {
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdSetAlphaToCoverageEnableEXT(cmdVk, (VkBool32)enable);
 }
 
 void GfxCommandBuffer::EnableColorBlend(uint32 firstAttachment, uint32 numAttachments, const uint32* enableFlags)
 {
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
     vkCmdSetColorBlendEnableEXT(cmdVk, firstAttachment, numAttachments, enableFlags);
 }
@@ -6331,6 +6866,10 @@ void GfxCommandBuffer::BindVertexBuffer(GfxBufferHandle vertexBuffer, uint64 off
 void GfxCommandBuffer::BindVertexBuffers(uint32 firstBinding, uint32 numBindings, const GfxBufferHandle* vertexBuffers, const uint64* offsets)
 {
     ASSERT(mIsRecording);
+
+    if (gBackendNull.enabled)
+        return;
+
     static_assert(sizeof(uint64) == sizeof(VkDeviceSize));
 
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
@@ -6358,6 +6897,10 @@ void GfxCommandBuffer::BindVertexBuffers(uint32 firstBinding, uint32 numBindings
 void GfxCommandBuffer::BindIndexBuffer(GfxBufferHandle indexBuffer, uint64 offset, GfxIndexType indexType)
 {
     ASSERT(mIsRecording);
+
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     gBackendVk.objectPoolsMutex.EnterRead();
@@ -6392,6 +6935,9 @@ void GfxCommandBuffer::BindDescriptorBuffers(uint32 numBindings, const GfxBuffer
 {
     ASSERT(mIsRecording);
 
+    if (gBackendNull.enabled)
+        return;
+
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
 
     gBackendVk.objectPoolsMutex.EnterRead();
@@ -6415,6 +6961,10 @@ void GfxCommandBuffer::SetDescriptorBufferOffsets(GfxPipelineLayoutHandle layout
                                                   const uint32* itemIndices)
 {
     ASSERT(mIsRecording);
+
+    if (gBackendNull.enabled)
+        return;
+
     static_assert(sizeof(uint64) == sizeof(VkDeviceSize));
 
     VkCommandBuffer cmdVk = GfxBackend::_GetCommandBufferHandle(*this);
@@ -6487,8 +7037,8 @@ GfxSamplerHandle GfxBackend::CreateSampler(const GfxSamplerDesc& desc)
         .unnormalizedCoordinates = VK_FALSE, 
     };
 
-    VkSampler samplerVk;
-    if (vkCreateSampler(gBackendVk.device, &samplerInfo, gBackendVk.vkAlloc, &samplerVk) != VK_SUCCESS)
+    VkSampler samplerVk = VK_NULL_HANDLE;
+    if (!gBackendNull.enabled && vkCreateSampler(gBackendVk.device, &samplerInfo, gBackendVk.vkAlloc, &samplerVk) != VK_SUCCESS)
         return {};
 
     GfxBackendSampler sampler {
@@ -6508,6 +7058,9 @@ void GfxBackend::SetupImmutableSamplers(const GfxImmutableSamplersDesc& desc)
     ASSERT(desc.samplers);
     ASSERT(desc.samplerBindings);
 
+    if (gBackendNull.enabled)
+        return;
+
     MemTempAllocator tempAlloc;
     VkDescriptorSetLayoutBinding* bindings = tempAlloc.MallocTyped<VkDescriptorSetLayoutBinding>(desc.numSamplers);
 
@@ -6546,14 +7099,16 @@ void GfxBackend::DestroySampler(GfxSamplerHandle& handle)
         ReadWriteMutexWriteScope objPoolLock(gBackendVk.objectPoolsMutex);
         GfxBackendSampler& sampler = gBackendVk.samplers.Data(handle);
 
-        MutexScope lock(gBackendVk.garbageMtx);
-        GfxBackendGarbage garbage {
-            .type = GfxBackendGarbage::Type::Sampler,
-            .frameIdx = gBackendVk.presentFrame,
-            .sampler = sampler.handle
-        };
+        if (sampler.handle) {
+            MutexScope lock(gBackendVk.garbageMtx);
+            GfxBackendGarbage garbage {
+                .type = GfxBackendGarbage::Type::Sampler,
+                .frameIdx = gBackendVk.presentFrame,
+                .sampler = sampler.handle
+            };
 
-        gBackendVk.garbage.Push(garbage);
+            gBackendVk.garbage.Push(garbage);
+        }
 
         gBackendVk.samplers.Remove(handle);
 
@@ -6864,6 +7419,9 @@ bool GfxBackend::IsIntegratedGPU()
 
 GfxFormat GfxBackend::GetValidDepthStencilFormat()
 {
+    if (gBackendNull.enabled)
+        return GfxFormat::D24_UNORM_S8_UINT;
+
     static VkFormat kAllFormats[] = {
         VK_FORMAT_D32_SFLOAT_S8_UINT,
         VK_FORMAT_D24_UNORM_S8_UINT,
@@ -6899,6 +7457,9 @@ GfxFormat GfxBackend::GetValidDepthStencilFormat()
 
 GfxFormat GfxBackend::GetValidDepthFormat()
 {
+    if (gBackendNull.enabled)
+        return GfxFormat::D32_SFLOAT;
+
     static VkFormat kAllFormats[] = {
         VK_FORMAT_D32_SFLOAT,
         VK_FORMAT_D16_UNORM
@@ -7178,9 +7739,9 @@ void GfxBackendProfilerContext::Calibrate(int64& tCpu, int64& tGpu)
 }
 
 GpuProfilerScope::GpuProfilerScope(GfxCommandBuffer& cmdBuffer, const ___tracy_source_location_data* sourceLoc, 
-                                   int callstackDepth, bool isActive, bool isAlloc) : mCmdBuffer(cmdBuffer), mIsActive(isActive)
+                                   int callstackDepth, bool isActive, bool isAlloc) : mCmdBuffer(cmdBuffer), mIsActive(isActive && !gBackendNull.enabled)
 {
-    if (!isActive)
+    if (!mIsActive)
         return;
 
     ASSERT_MSG(cmdBuffer.mIsRecording, "CommandBuffer should be recording while profiling samples are placed");
@@ -7420,6 +7981,11 @@ void GfxHelperDescriptorBuffer::WriteBindings(uint32 index, uint32 numBindings,
         ASSERT_MSG(layout->bindings[bindingIdx].setIndex == mDescriptorSetIndex, 
                    "Binding '%s' doesn't belong to this descriptor buffer (DescriptorIndex=%u)", binding.name.cstr, mDescriptorSetIndex);
 
+        if (gBackendNull.enabled) {
+            Atomic::FetchAdd(&gBackendNull.frameStats.numDescriptorWrites, 1);
+            continue;
+        }
+
         VkDescriptorGetInfoEXT getDescInfo {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
             .type = bindingVk.descriptorType
@@ -5,9 +5,14 @@
 #include "../Core/StringUtil.h"
 #include "../Core/MathAll.h"
 #include "../Core/Log.h"
+#include "../Core/Hash.h"
+#include "../Core/System.h"
+#include "../Core/Allocators.h"
 
 #include "GfxBackend.h"
 
+#include "../Engine.h"
+
 #define KB_TEXT_SHAPE_IMPLEMENTATION
 #define KB_TEXT_SHAPE_NO_CRT
 #define KB_TEXT_SHAPE_STATIC
@@ -19,33 +24,151 @@ PRAGMA_DIAGNOSTIC_POP()
 
 static constexpr uint32 TEXT_BUILDER_TAB_SIZE = 2;
 
+struct TextLayoutCacheItem
+{
+    const FontData* font;
+    float scale;
+    Color4u color;
+    TextType type;
+    uint32 textLen;
+    uint64 lastUsedFrame;
+    const char* text;           // Copy of the text for resolving hash collisions. Allocated with the geometry
+    size_t size;
+    TextLayout layout;
+};
+
+// Main thread only. Returned layouts point into the cache, so they cannot be shared with other threads anyway
+struct TextLayoutCache
+{
+    HashTable<TextLayoutCacheItem> items;
+    uint64 frameIndex;
+    TextLayoutCacheStats stats;
+    uint32 numHitsFrame;
+    uint32 numMissesFrame;
+};
+
+static TextLayoutCache gTextLayoutCache;
+
 namespace TextBuilder
 {
-    INLINE uint32 _FindCharIndex(const uint16* glyphIds, uint32 numIds, uint16 unicode, uint16 defaultCode = '?')
+    INLINE uint32 _FindCharIndex(const FontData& font, uint32 unicode, uint32 defaultCode = '?')
     {
-        for (uint32 i = 0; i < numIds; i++) {
-            if (glyphIds[i] == unicode)
-                return i;
+        uint32 index = Font::FindGlyph(font, unicode);
+        if (index == UINT32_MAX && defaultCode != 0)
+            index = Font::FindGlyph(font, defaultCode);
+        return index;
+    }
+
+    // Returns the next character code and advances `index`. Returns 0 at the end of the text
+    // Invalid UTF-8 sequences are returned as single bytes
+    INLINE uint32 _NextChar(const char* text, uint32 textLen, TextType type, uint32* index)
+    {
+        uint32 i = *index;
+        if (i >= textLen)
+            return 0;
+
+        uint32 c = uint8(text[i]);
+        if (type == TextType::Ascii || c < 0x80) {
+            *index = i + 1;
+            return c;
         }
 
-        if (defaultCode != 0) {
-            for (uint32 i = 0; i < numIds; i++) {
-                if (glyphIds[i] == defaultCode)
-                    return i;
-            }
+        uint32 numBytes;
+        if ((c & 0xe0) == 0xc0)         { numBytes = 2; c &= 0x1f; }
+        else if ((c & 0xf0) == 0xe0)    { numBytes = 3; c &= 0x0f; }
+        else if ((c & 0xf8) == 0xf0)    { numBytes = 4; c &= 0x07; }
+        else                            { *index = i + 1; return c; }
+
+        if (i + numBytes > textLen) {
+            *index = textLen;
+            return '?';
         }
 
-        return uint32(-1);
+        for (uint32 k = 1; k < numBytes; k++)
+            c = (c << 6) | (uint8(text[i + k]) & 0x3f);
+        *index = i + numBytes;
+        return c;
+    }
+
+    static uint32 _MakeLayoutCacheKey(const FontData& font, float scale, const char* text, uint32 textLen, Color4u color, TextType type)
+    {
+        HashMurmur32Incremental hasher(0x7e47);
+        uint32 hash = hasher.Add<uintptr_t>(uintptr_t(&font))
+                            .Add<float>(scale)
+                            .Add<Color4u>(color)
+                            .Add<TextType>(type)
+                            .AddAny(text, textLen)
+                            .Hash();
+        return hash ? hash : 1;     // 0 is reserved for empty HashTable slots
+    }
+
+    static void _FreeLayoutCacheItem(TextLayoutCacheItem& item)
+    {
+        Mem::Free(item.layout.geo.vertices);
+        gTextLayoutCache.stats.memoryUsed -= item.size;
     }
 
-    INLINE float _GetKerning(const FontKerning* kernings, uint32 numKernings, uint16 firstId, uint16 secondId)
+    static void _EvictLeastRecentlyUsedLayout()
     {
-        for (uint32 i = 0; i < numKernings; i++) {
-            if (kernings[i].secondId == secondId && kernings[i].firstId == firstId) 
-                return kernings[i].xadvance;
+        HashTable<TextLayoutCacheItem>& items = gTextLayoutCache.items;
+        const uint32* keys = items.Keys();
+        uint32 lruIndex = UINT32_MAX;
+        uint64 lruFrame = UINT64_MAX;
+        for (uint32 i = 0; i < items.Capacity(); i++) {
+            if (keys[i] && items.Get(i).lastUsedFrame < lruFrame) {
+                lruFrame = items.Get(i).lastUsedFrame;
+                lruIndex = i;
+            }
         }
 
-        return 0;
+        if (lruIndex != UINT32_MAX) {
+            _FreeLayoutCacheItem(items.GetMutable(lruIndex));
+            items.Remove(lruIndex);
+            ++gTextLayoutCache.stats.numEvictions;
+        }
+    }
+
+    // Builds the layout at origin and copies it into a single, tightly packed allocation along with the text
+    static TextLayoutCacheItem _CreateLayoutCacheItem(const FontData& font, float scale, const char* text, uint32 textLen, 
+                                                      Color4u color, TextType type)
+    {
+        MemTempAllocator tempAlloc;
+        TextGeometry tmpGeo = CreateText(font, FLOAT2_ZERO, scale, text, textLen, color, type, &tempAlloc);
+
+        size_t verticesSize = sizeof(TextVertex)*tmpGeo.numVertices;
+        size_t indicesSize = sizeof(uint32)*tmpGeo.numIndices;
+        size_t size = verticesSize + indicesSize + textLen + 1;
+        uint8* buffer = (uint8*)Mem::Alloc(size);
+        
+        TextLayoutCacheItem item {
+            .font = &font,
+            .scale = scale,
+            .color = color,
+            .type = type,
+            .textLen = textLen,
+            .lastUsedFrame = gTextLayoutCache.frameIndex,
+            .text = (const char*)(buffer + verticesSize + indicesSize),
+            .size = size,
+            .layout = {
+                .geo = {
+                    .numIndices = tmpGeo.numIndices,
+                    .numVertices = tmpGeo.numVertices,
+                    .alloc = nullptr,   // Owned by the cache
+                    .vertices = (TextVertex*)buffer,
+                    .indices = (uint32*)(buffer + verticesSize)
+                },
+                .size = CalculateTextSize(font, scale, text, textLen, type)
+            }
+        };
+
+        if (verticesSize)
+            memcpy(item.layout.geo.vertices, tmpGeo.vertices, verticesSize);
+        if (indicesSize)
+            memcpy(item.layout.geo.indices, tmpGeo.indices, indicesSize);
+        memcpy(buffer + verticesSize + indicesSize, text, textLen);
+        buffer[size - 1] = 0;
+
+        return item;
     }
 
     #if 0
@@ -75,9 +198,6 @@ TextGeometry TextBuilder::CreateText(const FontData& font, Float2 pos, float sca
                                      Color4u color, TextType type, MemAllocator* alloc)
 {
     ASSERT(alloc);
-    UNUSED(type);
-    ASSERT_MSG(type == TextType::Ascii, "Not implemented");
-
     if (textLen == 0) 
         textLen = Str::Len(text);
     if (textLen == 0) {
@@ -91,7 +211,6 @@ TextGeometry TextBuilder::CreateText(const FontData& font, Float2 pos, float sca
         .indices = Mem::AllocTyped<uint32>(textLen*6, alloc)
     };
 
-    const uint16* glyphIds = font.glyphIds.Get();
     float x = 0;
     float y = 0;
     float fontSize = float(font.size) * scale;
@@ -99,33 +218,38 @@ TextGeometry TextBuilder::CreateText(const FontData& font, Float2 pos, float sca
     uint32 numVertices = 0;
     uint32 numIndices = 0;
 
-    for (uint32 i = 0; i < textLen; i++) {
+    uint32 textIndex = 0;
+    uint32 nextCh = _NextChar(text, textLen, type, &textIndex);
+    while (nextCh) {
+        uint32 ch = nextCh;
+        nextCh = _NextChar(text, textLen, type, &textIndex);
+
         // Whitespace
-        if (text[i] == ' ') {
-            uint32 spaceIndex = _FindCharIndex(glyphIds, font.numGlyphs, text[i]);
+        if (ch == ' ') {
+            uint32 spaceIndex = _FindCharIndex(font, ' ', 0);
             ASSERT_MSG(spaceIndex != -1, "Font does not contain space character");
             x += font.glyphs[spaceIndex].xadvance;
             continue;
         }
-        else if (text[i] == '\r')
+        else if (ch == '\r')
             continue;
-        else if (text[i] == '\t') {
-            uint32 spaceIndex = _FindCharIndex(glyphIds, font.numGlyphs, text[i]);
+        else if (ch == '\t') {
+            uint32 spaceIndex = _FindCharIndex(font, ' ', 0);
             ASSERT_MSG(spaceIndex != -1, "Font does not contain space character");
             for (uint32 s = 0; s < TEXT_BUILDER_TAB_SIZE; s++)
                 x += font.glyphs[spaceIndex].xadvance;
             continue;
         }
-        else if (text[i] == '\n') {
+        else if (ch == '\n') {
             y += font.lineHeight;
             x = 0;
             continue;
         }
 
         // Normal characters
-        uint32 charIndex = _FindCharIndex(glyphIds, font.numGlyphs, text[i]);
+        uint32 charIndex = _FindCharIndex(font, ch);
         if (charIndex == -1) {
-            ASSERT_MSG(0, "Character not found: %c", text[i]);
+            ASSERT_MSG(0, "Character not found: 0x%x", ch);
             continue;
         }
 
@@ -160,8 +284,8 @@ TextGeometry TextBuilder::CreateText(const FontData& font, Float2 pos, float sca
             .color = color
         };
 
-        if (i < textLen - 1)
-            x += _GetKerning(font.kernings.Get(), font.numKernings, text[i], text[i + 1]);
+        if (nextCh)
+            x += Font::GetKerning(font, ch, nextCh);
 
         uint32 indicesIndex = numIndices;
         // Winding: CCW
@@ -188,9 +312,6 @@ TextGeometry TextBuilder::CreateText(const FontData& font, Float2 pos, float sca
 
 Float2 TextBuilder::CalculateTextSize(const FontData& font, float scale, const char* text, uint32 textLen, TextType type)
 {
-    UNUSED(type);
-    ASSERT_MSG(type == TextType::Ascii, "Not implemented");
-
     if (textLen == 0) 
         textLen = Str::Len(text);
     if (textLen == 0) {
@@ -198,40 +319,44 @@ Float2 TextBuilder::CalculateTextSize(const FontData& font, float scale, const c
         return {};
     }
 
-    const uint16* glyphIds = font.glyphIds.Get();
     float x = 0;
     float y = 0;
     float fontSize = float(font.size) * scale;
     float yoffset = float(font.descender);
     RectFloat bounds = RECTFLOAT_EMPTY;
 
-    for (uint32 i = 0; i < textLen; i++) {
+    uint32 textIndex = 0;
+    uint32 nextCh = _NextChar(text, textLen, type, &textIndex);
+    while (nextCh) {
+        uint32 ch = nextCh;
+        nextCh = _NextChar(text, textLen, type, &textIndex);
+
         // Whitespace
-        if (text[i] == ' ') {
-            uint32 spaceIndex = _FindCharIndex(glyphIds, font.numGlyphs, text[i]);
+        if (ch == ' ') {
+            uint32 spaceIndex = _FindCharIndex(font, ' ', 0);
             ASSERT_MSG(spaceIndex != -1, "Font does not contain space character");
             x += font.glyphs[spaceIndex].xadvance;
             continue;
         }
-        else if (text[i] == '\r')
+        else if (ch == '\r')
             continue;
-        else if (text[i] == '\t') {
-            uint32 spaceIndex = _FindCharIndex(glyphIds, font.numGlyphs, text[i]);
+        else if (ch == '\t') {
+            uint32 spaceIndex = _FindCharIndex(font, ' ', 0);
             ASSERT_MSG(spaceIndex != -1, "Font does not contain space character");
             for (uint32 s = 0; s < TEXT_BUILDER_TAB_SIZE; s++)
                 x += font.glyphs[spaceIndex].xadvance;
             continue;
         }
-        else if (text[i] == '\n') {
+        else if (ch == '\n') {
             y += font.lineHeight;
             x = 0;
             continue;
         }
 
         // Normal characters
-        uint32 charIndex = _FindCharIndex(glyphIds, font.numGlyphs, text[i]);
+        uint32 charIndex = _FindCharIndex(font, ch);
         if (charIndex == -1) {
-            ASSERT_MSG(0, "Character not found: %c", text[i]);
+            ASSERT_MSG(0, "Character not found: 0x%x", ch);
             continue;
         }
 
@@ -242,8 +367,8 @@ Float2 TextBuilder::CalculateTextSize(const FontData& font, float scale, const c
         RectFloat::AddPoint(bounds, vmin);
         RectFloat::AddPoint(bounds, vmax);
 
-        if (i < textLen - 1)
-            x += _GetKerning(font.kernings.Get(), font.numKernings, text[i], text[i + 1]);
+        if (nextCh)
+            x += Font::GetKerning(font, ch, nextCh);
 
         x += glyph.xadvance;
     }
@@ -260,6 +385,107 @@ void TextBuilder::Destroy(TextGeometry& geo)
     }
 }
 
+TextLayout TextBuilder::GetCachedLayout(const FontData& font, float scale, const char* text, uint32 textLen, Color4u color, TextType type)
+{
+    if (textLen == 0) 
+        textLen = Str::Len(text);
+    if (textLen == 0)
+        return {};
+
+    ASSERT_MSG(Engine::IsMainThread(), "Layout cache can only be used in the main thread");
+    uint32 key = _MakeLayoutCacheKey(font, scale, text, textLen, color, type);
+
+    HashTable<TextLayoutCacheItem>& items = gTextLayoutCache.items;
+    if (items.Capacity() == 0)
+        items.Reserve(TEXT_LAYOUT_CACHE_MAX_ITEMS*2);
+
+    uint32 index = items.Find(key);
+    if (index != UINT32_MAX) {
+        TextLayoutCacheItem& item = items.GetMutable(index);
+        if (item.font == &font && item.scale == scale && item.color.n == color.n && item.type == type && 
+            item.textLen == textLen && memcmp(item.text, text, textLen) == 0)
+        {
+            item.lastUsedFrame = gTextLayoutCache.frameIndex;
+            ++gTextLayoutCache.numHitsFrame;
+            ++gTextLayoutCache.stats.numHits;
+            return item.layout;
+        }
+
+        // Hash collision: replace the old item
+        _FreeLayoutCacheItem(item);
+        items.Remove(index);
+        ++gTextLayoutCache.stats.numEvictions;
+    }
+
+    ++gTextLayoutCache.numMissesFrame;
+    ++gTextLayoutCache.stats.numMisses;
+
+    if (items.Count() >= TEXT_LAYOUT_CACHE_MAX_ITEMS)
+        _EvictLeastRecentlyUsedLayout();
+
+    TextLayoutCacheItem item = _CreateLayoutCacheItem(font, scale, text, textLen, color, type);
+    gTextLayoutCache.stats.memoryUsed += item.size;
+    items.Add(key, item);
+    return item.layout;
+}
+
+void TextBuilder::OffsetText(TextVertex* vertices, uint32 numVertices, uint32* indices, uint32 numIndices, Float2 pos, uint32 baseVertex)
+{
+    for (uint32 i = 0; i < numVertices; i++)
+        vertices[i].pos = vertices[i].pos + pos;
+
+    if (baseVertex) {
+        for (uint32 i = 0; i < numIndices; i++)
+            indices[i] += baseVertex;
+    }
+}
+
+void TextBuilder::UpdateLayoutCache()
+{
+    ASSERT_MSG(Engine::IsMainThread(), "Layout cache can only be used in the main thread");
+    HashTable<TextLayoutCacheItem>& items = gTextLayoutCache.items;
+    uint64 frameIndex = gTextLayoutCache.frameIndex;
+
+    if (items.Count()) {
+        const uint32* keys = items.Keys();
+        for (uint32 i = 0; i < items.Capacity(); i++) {
+            if (keys[i] && (frameIndex - items.Get(i).lastUsedFrame) > TEXT_LAYOUT_CACHE_MAX_IDLE_FRAMES) {
+                _FreeLayoutCacheItem(items.GetMutable(i));
+                items.Remove(i);
+                ++gTextLayoutCache.stats.numEvictions;
+            }
+        }
+    }
+
+    gTextLayoutCache.stats.numItems = items.Count();
+    gTextLayoutCache.stats.numHitsLastFrame = gTextLayoutCache.numHitsFrame;
+    gTextLayoutCache.stats.numMissesLastFrame = gTextLayoutCache.numMissesFrame;
+    gTextLayoutCache.numHitsFrame = 0;
+    gTextLayoutCache.numMissesFrame = 0;
+    ++gTextLayoutCache.frameIndex;
+}
+
+void TextBuilder::ReleaseLayoutCache()
+{
+    ASSERT_MSG(Engine::IsMainThread(), "Layout cache can only be used in the main thread");
+    HashTable<TextLayoutCacheItem>& items = gTextLayoutCache.items;
+    if (items.Count()) {
+        const uint32* keys = items.Keys();
+        for (uint32 i = 0; i < items.Capacity(); i++) {
+            if (keys[i])
+                _FreeLayoutCacheItem(items.GetMutable(i));
+        }
+    }
+    items.Free();
+    gTextLayoutCache.stats = {};
+}
+
+TextLayoutCacheStats TextBuilder::GetLayoutCacheStats()
+{
+    ASSERT_MSG(Engine::IsMainThread(), "Layout cache can only be used in the main thread");
+    return gTextLayoutCache.stats;
+}
+
 TextDrawGraphicsObjects TextBuilder::HelperCreateGraphicsObjects(const GfxShader& textDrawShader, TextEffect effect,
                                                                  GfxFormat colorAttachmentFmt, GfxFormat depthStencilAttachmentFmt)
 {
@@ -6,6 +6,9 @@
 
 struct FontData;    // Font.h
 
+inline constexpr uint32 TEXT_LAYOUT_CACHE_MAX_ITEMS = 1024;
+inline constexpr uint32 TEXT_LAYOUT_CACHE_MAX_IDLE_FRAMES = 60;
+
 struct TextVertex
 {
     Float2 pos;
@@ -37,6 +40,24 @@ enum class TextEffect : int
 };
 
 
+// Geometry is built at origin (pos=0), use TextBuilder::OffsetText on a copy of it to place it
+struct TextLayout
+{
+    TextGeometry geo;
+    Float2 size;
+};
+
+struct TextLayoutCacheStats
+{
+    uint32 numItems;
+    uint32 numHitsLastFrame;
+    uint32 numMissesLastFrame;
+    uint64 numHits;
+    uint64 numMisses;
+    uint64 numEvictions;
+    size_t memoryUsed;
+};
+
 struct TextDrawGraphicsObjects
 {
     GfxPipelineHandle pipeline;
@@ -56,6 +77,18 @@ namespace TextBuilder
 
     void Destroy(TextGeometry& geo);
 
+    // Layout cache: Keyed by (font, text, scale, color, type). Layouts that are not used for TEXT_LAYOUT_CACHE_MAX_IDLE_FRAMES 
+    // get evicted in UpdateLayoutCache, and the least recently used one gets evicted if the cache is full
+    // Returned layout is owned by the cache and stays valid until the next call to the cache
+    // The cache is main thread only (asserted). Other threads should use CreateText and own the geometry
+    TextLayout GetCachedLayout(const FontData& font, float scale, const char* text, uint32 textLen = 0, 
+                               Color4u color = COLOR4U_WHITE, TextType type = TextType::Ascii);
+    // In-place update of a copy of the layout geometry: Offsets vertex positions by `pos` and indices by `baseVertex`
+    void OffsetText(TextVertex* vertices, uint32 numVertices, uint32* indices, uint32 numIndices, Float2 pos, uint32 baseVertex = 0);
+    void UpdateLayoutCache();   // Call once per frame
+    void ReleaseLayoutCache();
+    TextLayoutCacheStats GetLayoutCacheStats();
+
     TextDrawGraphicsObjects HelperCreateGraphicsObjects(const GfxShader& textDrawShader, TextEffect effect,
                                                         GfxFormat colorAttachmentFmt, GfxFormat depthStencilAttachmentFmt);
 } // TextBuilder
\ No newline at end of file
@@ -87,15 +87,17 @@ static const GfxSamplerDesc R_SAMPLER_DESCS[uint32(RSamplerType::_Count)] = {
     #define R_INSERT_IMMUTABLE_SAMPLER_BINDINGS()
 #endif
 
+// Vertex streams are quantized (see ModelLoadParams). Positions are normalized to the mesh bounds and dequantized 
+// with RGeometryChunk::positionOffset/positionScale
 struct RVertexStreamPosition
 {
-    Float3 position;
+    int16 position[4];  // R16G16B16A16_SNORM
 };
 
 struct RVertexStreamLighting
 {
-    Float3 normal;
-    Float2 uv;
+    int16 normal[2];    // R16G16_SNORM, octahedral encoded
+    uint16 uv[2];       // R16G16_SFLOAT
 };
 
 struct GFX_UNIFORM_BUFFER_ALIGNMENT RLightCullShaderFrameData
@@ -141,12 +143,14 @@ struct GFX_UNIFORM_BUFFER_ALIGNMENT RLightShaderObjectData
 {
     Mat4 localToWorldMat;
     Float4 materialTintColor;
+    Float4 positionOffset;
+    Float4 positionScale;
 };
 
 static const GfxVertexInputAttributeDesc R_VERTEX_ATTRIBUTES[] = {
-    {"POSITION", 0, 0, GfxFormat::R32G32B32_SFLOAT, offsetof(RVertexStreamPosition, position)},
-    {"NORMAL", 0, 1, GfxFormat::R32G32B32_SFLOAT, offsetof(RVertexStreamLighting, normal)},
-    {"TEXCOORD", 0, 1, GfxFormat::R32G32_SFLOAT, offsetof(RVertexStreamLighting, uv)}
+    {"POSITION", 0, 0, GfxFormat::R16G16B16A16_SNORM, offsetof(RVertexStreamPosition, position)},
+    {"NORMAL", 0, 1, GfxFormat::R16G16_SNORM, offsetof(RVertexStreamLighting, normal)},
+    {"TEXCOORD", 0, 1, GfxFormat::R16G16_SFLOAT, offsetof(RVertexStreamLighting, uv)}
 };
 
 static const uint32 R_VERTEXBUFFER_STRIDES[] = {
@@ -242,6 +246,12 @@ RFwdContext gFwd;
 
 namespace R
 {
+    // Position-only passes (ZPrepass/ShadowMap) fold the position dequantization into the transform
+    static Mat4 _GetPositionLocalToWorldMat(const RGeometryChunk& chunk)
+    {
+        return Mat4::Mul(chunk.localToWorldMat, Mat4::TransformMat(chunk.positionOffset, QUAT_INDENT, chunk.positionScale));
+    }
+
     static void _CreateFramebufferDependentResources(uint16 width, uint16 height)
     {
         // TODO: This leaks now. cuz it's allocating from the Persistant buffer
@@ -344,7 +354,7 @@ namespace R
                 {
                     .semantic = "POSITION",
                     .binding = 0,
-                    .format = GfxFormat::R32G32B32_SFLOAT,
+                    .format = GfxFormat::R16G16B16A16_SNORM,
                     .offset = offsetof(RVertexStreamPosition, position) 
                 }
             };
@@ -460,13 +470,13 @@ namespace R
                 {
                     .semantic = "POSITION",
                     .binding = 0,
-                    .format = GfxFormat::R32G32B32_SFLOAT,
+                    .format = GfxFormat::R16G16B16A16_SNORM,
                     .offset = offsetof(RVertexStreamPosition, position)
                 },
                 {
                     .semantic = "TEXCOORD",
                     .binding = 1,
-                    .format = GfxFormat::R32G32_SFLOAT,
+                    .format = GfxFormat::R16G16_SFLOAT,
                     .offset = offsetof(RVertexStreamLighting, uv)
                 }
             };
@@ -637,19 +647,19 @@ namespace R
                 {
                     .semantic = "POSITION",
                     .binding = 0,
-                    .format = GfxFormat::R32G32B32_SFLOAT,
+                    .format = GfxFormat::R16G16B16A16_SNORM,
                     .offset = offsetof(RVertexStreamPosition, position)
                 },
                 {
                     .semantic = "NORMAL",
                     .binding = 1,
-                    .format = GfxFormat::R32G32B32_SFLOAT,
+                    .format = GfxFormat::R16G16_SNORM,
                     .offset = offsetof(RVertexStreamLighting, normal)
                 },
                 {
                     .semantic = "TEXCOORD",
                     .binding = 1,
-                    .format = GfxFormat::R32G32_SFLOAT,
+                    .format = GfxFormat::R16G16_SFLOAT,
                     .offset = offsetof(RVertexStreamLighting, uv)
                 }
             };
@@ -1128,7 +1138,9 @@ void R::FwdLight::Update(RView& view, GfxCommandBuffer& cmd)
 
                 RLightShaderObjectData objectData {
                     .localToWorldMat = chunk->localToWorldMat,
-                    .materialTintColor = Color4u::ToFloat4(subChunk.tintColor)
+                    .materialTintColor = Color4u::ToFloat4(subChunk.tintColor),
+                    .positionOffset = Float4(chunk->positionOffset, 0),
+                    .positionScale = Float4(chunk->positionScale, 1.0f)
                 };
 
                 GfxBindingDesc bindings[] = {
@@ -1259,7 +1271,8 @@ void R::FwdLight::Render(RView& view, GfxCommandBuffer& cmd, GfxImageHandle fina
 
             RGeometryChunk* chunk = viewData.chunkList;
             while (chunk) {
-                cmd.PushConstants(gFwd.pZPrepassLayout, "PerObjectData", &chunk->localToWorldMat, sizeof(Mat4));
+                Mat4 localToWorldMat = _GetPositionLocalToWorldMat(*chunk);
+                cmd.PushConstants(gFwd.pZPrepassLayout, "PerObjectData", &localToWorldMat, sizeof(Mat4));
                 cmd.BindVertexBuffers(0, 1, &chunk->posVertexBuffer, &chunk->posVertexBufferOffset);
                 cmd.BindIndexBuffer(chunk->indexBuffer, chunk->indexBufferOffset, GfxIndexType::Uint32);
 
@@ -1336,7 +1349,8 @@ void R::FwdLight::Render(RView& view, GfxCommandBuffer& cmd, GfxImageHandle fina
                     chunk->lightingVertexBufferOffset
                 };
 
-                cmd.PushConstants(gFwd.pZPrepassLayout, "PerObjectData", &chunk->localToWorldMat, sizeof(Mat4));
+                Mat4 localToWorldMat = _GetPositionLocalToWorldMat(*chunk);
+                cmd.PushConstants(gFwd.pZPrepassLayout, "PerObjectData", &localToWorldMat, sizeof(Mat4));
                 cmd.BindVertexBuffers(0, 2, vertexBuffers, vertexBufferOffsets);
                 cmd.BindIndexBuffer(chunk->indexBuffer, chunk->indexBufferOffset, GfxIndexType::Uint32);                
 
@@ -1630,6 +1644,7 @@ RGeometryChunk* RView::NewGeometryChunk()
 
     RGeometryChunk* chunk = Mem::AllocZeroTyped<RGeometryChunk>(1, &gFwd.frameAlloc);
     chunk->localToWorldMat = MAT4_IDENT;
+    chunk->positionScale = Float3(1.0f, 1.0f, 1.0f);
 
     if (viewData.lastChunk)
         viewData.lastChunk->nextChunk = chunk;
@@ -1727,7 +1742,8 @@ void R::ShadowMap::Render(RView& view, GfxCommandBuffer& cmd, GfxImageHandle sha
 
         RGeometryChunk* chunk = viewData.chunkList;
         while (chunk) {
-            cmd.PushConstants(gFwd.pZPrepassLayout, "PerObjectData", &chunk->localToWorldMat, sizeof(Mat4));
+            Mat4 localToWorldMat = _GetPositionLocalToWorldMat(*chunk);
+            cmd.PushConstants(gFwd.pZPrepassLayout, "PerObjectData", &localToWorldMat, sizeof(Mat4));
 
             cmd.BindVertexBuffers(0, 1, &chunk->posVertexBuffer, &chunk->posVertexBufferOffset);
             cmd.BindIndexBuffer(chunk->indexBuffer, chunk->indexBufferOffset, GfxIndexType::Uint32);
@@ -42,6 +42,8 @@ struct RGeometrySubChunk
 struct RGeometryChunk
 {
     Mat4 localToWorldMat;
+    Float3 positionOffset;      // Dequantization of vertex positions (ModelMesh/GeometryData::positionOffset/positionScale)
+    Float3 positionScale;       // Default: offset=0, scale=1
 
     GfxBufferHandle posVertexBuffer;
     uint64 posVertexBufferOffset;
@@ -89,6 +91,8 @@ namespace R
     bool Initialize();
     void Release();
 
+    // Vertex attributes are quantized: POSITION R16G16B16A16_SNORM, NORMAL R16G16_SNORM (octahedral), TEXCOORD R16G16_SFLOAT
+    // Set RGeometryChunk::positionOffset/positionScale from the geometry's dequantization values
     void GetCompatibleLayout(GeometryVertexLayout& outLayout);
 
     RView CreateView(RViewType viewType);
@@ -10,8 +10,8 @@
 
 struct VsInput
 {
-    float3 position : POSITION;
-    float3 normal : NORMAL;
+    float3 position : POSITION;     // Normalized to mesh bounds: PositionOffset + PositionScale*position
+    float2 normal : NORMAL;         // Octahedral encoded
     float2 uv : TEXCOORD0;
 };
 
@@ -58,8 +58,21 @@ cbuffer PerObjectData
 {
     float4x4 LocalToWorldMat;
     float4 MaterialTintColor;
+    float4 PositionOffset;
+    float4 PositionScale;
 };
 
+// Same as Model::DecodeOctahedral
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    if (n.z < 0) {
+        float2 s = float2(n.x >= 0 ? 1.0f : -1.0f, n.y >= 0 ? 1.0f : -1.0f);
+        n.xy = (1.0f - abs(n.yx))*s;
+    }
+    return normalize(n);
+}
+
 [vk::binding(1, 1)]
 Texture2D BaseColorTexture;
 
@@ -67,13 +80,13 @@ Texture2D BaseColorTexture;
 PsInput VsMain(VsInput v)
 {
     PsInput o;
-    float4 posWS = mul(LocalToWorldMat, float4(v.position, 1.0f));
+    float3 posLS = PositionOffset.xyz + PositionScale.xyz*v.position;
+    float4 posWS = mul(LocalToWorldMat, float4(posLS, 1.0f));
     o.position = mul(PerFrameData.worldToClipMat, posWS);
     
     o.uv = v.uv;
     o.posWS = posWS.xyz;
-    o.normalWS = v.normal;
-    o.normalWS = mul((float3x3)LocalToWorldMat, v.normal);
+    o.normalWS = mul((float3x3)LocalToWorldMat, DecodeOctahedral(v.normal));
 
     return o;
 }
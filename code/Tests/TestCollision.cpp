@@ -102,6 +102,8 @@ struct TestCollisionApp final : AppCallbacks
         chunk->posVertexBuffer = geo.vertexBuffers[0];
         chunk->lightingVertexBuffer = geo.vertexBuffers[1];
         chunk->indexBuffer = geo.indexBuffer;
+        chunk->positionOffset = geo.positionOffset;
+        chunk->positionScale = geo.positionScale;
 
         RGeometrySubChunk subchunk {
             .startIndex = 0,
@@ -108,7 +108,9 @@ struct ModelScene
 
     void Load()
     {
-        ModelLoadParams loadParams {};
+        ModelLoadParams loadParams {
+            .numLods = MODEL_MAX_LODS
+        };
         R::GetCompatibleLayout(loadParams.layout);
         mModel = Model::Load(mModelFilepath.CStr(), loadParams, mAssetGroup);
         mAssetGroup.Load();
@@ -237,6 +239,7 @@ struct TestRendererApp final : AppCallbacks
     GfxImageHandle mRenderTargetDepth;
     GfxImageHandle mShadowMapDepth;
     uint32 mSelectedSceneIdx;
+    float mLodPixelError = 1.0f;
     bool mFirstTime = true;
     bool mMinimized = false;
     bool mDrawGrid = false;
@@ -340,6 +343,10 @@ struct TestRendererApp final : AppCallbacks
 
         AABB bounds = AABB_EMPTY;
 
+        // LODs are always selected from the main camera, so shadow casters match the visible geometry
+        Float3 camPos = mCam->Position();
+        float projScale = float(App::GetWindowHeight()) / (2.0f*M::Tan(mCam->Fov()*0.5f));
+
         for (uint32 i = 0; i < model->numNodes; i++) {
             const ModelNode& node = model->nodes[i];
             if (node.meshId == 0)
@@ -359,10 +366,13 @@ struct TestRendererApp final : AppCallbacks
             chunk->indexBuffer = model->indexBuffer;
                     
             const ModelMesh& mesh = model->meshes[IdToIndex(node.meshId)];
+            float lodDistance = Float3::Len(boundsWS.Center() - camPos);
 
             chunk->posVertexBufferOffset = mesh.vertexBufferOffsets[0];
             chunk->lightingVertexBufferOffset = mesh.vertexBufferOffsets[1];
             chunk->indexBufferOffset = mesh.indexBufferOffset;
+            chunk->positionOffset = mesh.positionOffset;
+            chunk->positionScale = mesh.positionScale;
 
             for (uint32 smi = 0; smi < mesh.numSubmeshes; smi++) {
                 const ModelSubmesh& submesh = mesh.submeshes[smi];
@@ -376,9 +386,11 @@ struct TestRendererApp final : AppCallbacks
                         imgHandle = img->handle;
                 }
 
+                ModelSubmeshLod lod = Model::SelectLod(submesh, lodDistance, projScale, mLodPixelError);
+
                 RGeometrySubChunk subChunk {
-                    .startIndex = submesh.startIndex,
-                    .numIndices = submesh.numIndices,
+                    .startIndex = lod.startIndex,
+                    .numIndices = lod.numIndices,
                     .baseColorImg = imgHandle,
                     .hasAlphaMask = mtl->alphaMode == ModelMaterialAlphaMode::Mask
                 };
@@ -523,6 +535,8 @@ struct TestRendererApp final : AppCallbacks
             ImGui::SetNextWindowSize(ImVec2(300, 200), ImGuiCond_FirstUseEver);
             if (ImGui::Begin("Scene")) {
                 scene.UpdateImGui();
+                ImGui::Separator();
+                ImGui::SliderFloat("LOD Pixel Error", &mLodPixelError, 0.1f, 20.0f, "%.1f");
             }
             ImGui::End();
 
@@ -0,0 +1,1194 @@
+#include "Benchmarks.h"
+#include "Console.h"
+
+#include "../Core/StringUtil.h"
+#include "../Core/System.h"
+#include "../Core/Log.h"
+#include "../Core/Allocators.h"
+#include "../Core/Arrays.h"
+#include "../Core/Atomic.h"
+#include "../Core/Hash.h"
+#include "../Core/JsonParser.h"
+#include "../Core/Pools.h"
+#include "../Core/Jobs.h"
+
+#include "../Common/RemoteServices.h"
+#include "../Common/JunkyardSettings.h"
+#include "../Common/VirtualFS.h"
+
+#include "../Assets/Model.h"
+#include "../Renderer/Render.h"
+
+#if PLATFORM_LINUX
+    #include <semaphore.h>
+    #include <pthread.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+// Queue benchmark
+struct QueueBenchmarkResult
+{
+    uint32 numItems;
+    uint32 numProducers;
+    double arrayFifoMS;         // Array Push/PopFirst
+    double ringQueueFifoMS;     // RingQueue PushBack/PopFront
+    double mutexQueueMS;        // Producer threads pushing to Mutex+RingQueue, consumer thread popping
+    double mpscQueueMS;         // Producer threads pushing to MpscQueue, consumer thread popping
+};
+
+struct QueueBenchItem
+{
+    uint64 value;
+    uint32 producerId;
+    uint32 padding;
+};
+
+struct QueueBenchProducer
+{
+    Thread thread;
+    AtomicUint32* start;
+    RingQueue<QueueBenchItem>* ringQueue;
+    Mutex* ringQueueMtx;
+    MpscQueue<QueueBenchItem>* mpscQueue;
+    uint32 id;
+    uint32 numItems;
+};
+
+static int _QueueBenchProducerThread(void* userData)
+{
+    QueueBenchProducer* producer = (QueueBenchProducer*)userData;
+    while (!Atomic::LoadExplicit(producer->start, AtomicMemoryOrder::Acquire))
+        Thread::SwitchContext();
+
+    for (uint32 i = 0; i < producer->numItems; i++) {
+        QueueBenchItem item { .value = i, .producerId = producer->id };
+        if (producer->mpscQueue) {
+            for (uint32 spinCount = 1; !producer->mpscQueue->Push(item); spinCount++) {
+                if (spinCount & 1023)
+                    OS::PauseCPU();
+                else
+                    Thread::SwitchContext();
+            }
+        }
+        else {
+            MutexScope lock(*producer->ringQueueMtx);
+            producer->ringQueue->PushBack(item);
+        }
+    }
+    return 0;
+}
+
+static double _QueueBenchRunProducers(uint32 numItems, uint32 numProducers, RingQueue<QueueBenchItem>* ringQueue, 
+                                      Mutex* ringQueueMtx, MpscQueue<QueueBenchItem>* mpscQueue)
+{
+    MemTempAllocator tempAlloc;
+    QueueBenchProducer* producers = tempAlloc.MallocZeroTyped<QueueBenchProducer>(numProducers);
+    AtomicUint32 start = 0;
+
+    uint32 numItemsPerProducer = numItems / numProducers;
+    for (uint32 i = 0; i < numProducers; i++) {
+        QueueBenchProducer& p = producers[i];
+        p.start = &start;
+        p.ringQueue = ringQueue;
+        p.ringQueueMtx = ringQueueMtx;
+        p.mpscQueue = mpscQueue;
+        p.id = i;
+        p.numItems = numItemsPerProducer;
+        p.thread.Start(ThreadDesc { .entryFn = _QueueBenchProducerThread, .userData = &p, .name = "QueueBenchProducer" });
+    }
+
+    // Consumer is this thread: Checks that every producer's items come in order
+    uint64* lastValues = tempAlloc.MallocZeroTyped<uint64>(numProducers);
+    uint32 numTotalItems = numItemsPerProducer*numProducers;
+    uint32 numConsumed = 0;
+    uint32 spinCount = 1;
+    uint64 startTm = Timer::GetTicks();
+    Atomic::StoreExplicit(&start, 1, AtomicMemoryOrder::Release);
+    while (numConsumed < numTotalItems) {
+        QueueBenchItem item;
+        bool popped;
+        if (mpscQueue) {
+            popped = mpscQueue->Pop(&item);
+        }
+        else {
+            MutexScope lock(*ringQueueMtx);
+            popped = !ringQueue->IsEmpty();
+            if (popped)
+                item = ringQueue->PopFront();
+        }
+
+        if (popped) {
+            ASSERT_MSG(item.value == 0 || item.value == lastValues[item.producerId] + 1, "Queue items are out of order");
+            lastValues[item.producerId] = item.value;
+            ++numConsumed;
+        }
+        else if (spinCount++ & 1023) {
+            OS::PauseCPU();
+        }
+        else {
+            Thread::SwitchContext();
+        }
+    }
+    double elapsedMS = Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+    for (uint32 i = 0; i < numProducers; i++)
+        producers[i].thread.Stop();
+    return elapsedMS;
+}
+
+static QueueBenchmarkResult _RunQueueBenchmark(uint32 numItems, uint32 numProducers)
+{
+    numItems = Max(numItems, 1u);
+    numProducers = Max(numProducers, 1u);
+    QueueBenchmarkResult result { .numItems = numItems, .numProducers = numProducers };
+
+    // Single threaded FIFO: keep a window of items in flight, so Array::PopFirst has something to shift
+    constexpr uint32 QUEUE_BENCH_WINDOW = 1024;
+    {
+        Array<QueueBenchItem> arr;
+        uint64 startTm = Timer::GetTicks();
+        for (uint32 i = 0; i < numItems; i++) {
+            arr.Push(QueueBenchItem { .value = i });
+            if (arr.Count() > QUEUE_BENCH_WINDOW)
+                arr.PopFirst();
+        }
+        result.arrayFifoMS = Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+        arr.Free();
+    }
+
+    {
+        RingQueue<QueueBenchItem> queue;
+        uint64 startTm = Timer::GetTicks();
+        for (uint32 i = 0; i < numItems; i++) {
+            queue.PushBack(QueueBenchItem { .value = i });
+            if (queue.Count() > QUEUE_BENCH_WINDOW)
+                queue.PopFront();
+        }
+        result.ringQueueFifoMS = Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+        queue.Free();
+    }
+
+    // Cross-thread queues
+    {
+        RingQueue<QueueBenchItem> queue;
+        Mutex mtx;
+        mtx.Initialize();
+        result.mutexQueueMS = _QueueBenchRunProducers(numItems, numProducers, &queue, &mtx, nullptr);
+        mtx.Release();
+        queue.Free();
+    }
+
+    {
+        MpscQueue<QueueBenchItem> queue;
+        queue.Initialize(4096);
+        result.mpscQueueMS = _QueueBenchRunProducers(numItems, numProducers, nullptr, nullptr, &queue);
+        queue.Release();
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// HandlePool benchmark
+struct HandlePoolBenchmarkResult
+{
+    uint32 numItems;
+    double addRemoveMS;         // Add all items, remove a random half of them and add them back
+    double denseAddRemoveMS;
+    double denseBatchAddRemoveMS;
+    double iterateMS;           // Iterate over all items after the add/remove churn
+    double denseIterateMS;
+    uint64 checksum;            // Sum of the iterated data, should be the same for both pools
+    uint64 denseChecksum;
+};
+
+DEFINE_HANDLE(HandleBench);
+
+struct HandleBenchItem
+{
+    float position[3];
+    float value;
+    uint32 flags;
+    uint32 padding[3];
+};
+
+static HandlePoolBenchmarkResult _RunHandlePoolBenchmark(uint32 numItems, uint32 numIterations)
+{
+    ASSERT(numItems > 1);
+    numIterations = Max(numIterations, 1u);
+
+    HandlePoolBenchmarkResult result { .numItems = numItems };
+    MemAllocator* alloc = Mem::GetDefaultAlloc();
+    uint32 halfCount = numItems / 2;
+
+    HandleBenchItem* items = Mem::AllocTyped<HandleBenchItem>(numItems, alloc);
+    HandleBench* handles = Mem::AllocTyped<HandleBench>(numItems, alloc);
+    HandleBench* removeHandles = Mem::AllocTyped<HandleBench>(halfCount, alloc);
+    uint32* removeOrder = Mem::AllocTyped<uint32>(numItems, alloc);
+    for (uint32 i = 0; i < numItems; i++) {
+        items[i] = HandleBenchItem { .value = float(i&0xff), .flags = i };
+        removeOrder[i] = i;
+    }
+
+    // Random half of the items are removed in the middle of the churn, so the regular pool ends up with scattered data
+    RandomContext rand = Random::CreateContext(numItems);
+    for (uint32 i = numItems; i-- > 1;)
+        Swap<uint32>(removeOrder[i], removeOrder[uint32(Random::Int(&rand, 0, int(i)))]);
+
+    HandlePool<HandleBench, HandleBenchItem> pool(alloc);
+    DenseHandlePool<HandleBench, HandleBenchItem> densePool(alloc);
+    DenseHandlePool<HandleBench, HandleBenchItem> denseBatchPool(alloc);
+
+    for (uint32 iter = 0; iter < numIterations; iter++) {
+        uint64 startTm = Timer::GetTicks();
+        for (uint32 i = 0; i < numItems; i++)
+            handles[i] = pool.Add(items[i]);
+        for (uint32 i = 0; i < halfCount; i++)
+            pool.Remove(handles[removeOrder[i]]);
+        for (uint32 i = 0; i < halfCount; i++)
+            handles[removeOrder[i]] = pool.Add(items[removeOrder[i]]);
+        result.addRemoveMS += Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        startTm = Timer::GetTicks();
+        for (const HandleBenchItem& item : pool)
+            result.checksum += item.flags;
+        result.iterateMS += Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        startTm = Timer::GetTicks();
+        for (uint32 i = 0; i < numItems; i++)
+            handles[i] = densePool.Add(items[i]);
+        for (uint32 i = 0; i < halfCount; i++)
+            densePool.Remove(handles[removeOrder[i]]);
+        for (uint32 i = 0; i < halfCount; i++)
+            handles[removeOrder[i]] = densePool.Add(items[removeOrder[i]]);
+        result.denseAddRemoveMS += Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        startTm = Timer::GetTicks();
+        for (const HandleBenchItem& item : densePool)
+            result.denseChecksum += item.flags;
+        result.denseIterateMS += Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        // Batched version gathers the handles to remove first, which is how batch removals are usually fed
+        startTm = Timer::GetTicks();
+        denseBatchPool.AddBatch(items, numItems, handles);
+        for (uint32 i = 0; i < halfCount; i++)
+            removeHandles[i] = handles[removeOrder[i]];
+        denseBatchPool.RemoveBatch(removeHandles, halfCount);
+        denseBatchPool.AddBatch(items, halfCount, removeHandles);
+        result.denseBatchAddRemoveMS += Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        ASSERT(pool.Count() == numItems && densePool.Count() == numItems && denseBatchPool.Count() == numItems);
+        pool.Clear();
+        densePool.Clear();
+        denseBatchPool.Clear();
+    }
+
+    ASSERT_MSG(result.checksum == result.denseChecksum, "HandlePool and DenseHandlePool data do not match");
+
+    double invIterations = 1.0 / double(numIterations);
+    result.addRemoveMS *= invIterations;
+    result.denseAddRemoveMS *= invIterations;
+    result.denseBatchAddRemoveMS *= invIterations;
+    result.iterateMS *= invIterations;
+    result.denseIterateMS *= invIterations;
+
+    pool.Free();
+    densePool.Free();
+    denseBatchPool.Free();
+    Mem::Free(removeOrder, alloc);
+    Mem::Free(removeHandles, alloc);
+    Mem::Free(handles, alloc);
+    Mem::Free(items, alloc);
+    return result;
+}
+
+#if PLATFORM_LINUX
+//----------------------------------------------------------------------------------------------------------------------
+// Sync primitives benchmark
+// Compares the futex based Mutex/Semaphore/Signal with plain posix versions (sem_t, pthread mutex/condvar)
+struct SyncBenchmarkResult
+{
+    uint32 numIterations;
+    double semaphorePingPongUS;         // Round-trip between two threads
+    double posixSemaphorePingPongUS;
+    double signalPingPongUS;
+    double posixSignalPingPongUS;
+    double semaphoreThroughputMS;       // One thread posting in batches, multiple threads waiting
+    double posixSemaphoreThroughputMS;
+    double mutexNS;                     // Uncontended Enter/Exit pair
+    double posixMutexNS;
+};
+
+static constexpr uint32 SYNC_BENCH_NUM_CONSUMERS = 4;
+static constexpr uint32 SYNC_BENCH_POST_BATCH = 16;
+
+// Previous implementations, for comparison
+struct SyncBenchPosixSemaphore
+{
+    sem_t sem;
+
+    void Initialize() { sem_init(&sem, 0, 0); }
+    void Release() { sem_destroy(&sem); }
+    void Post(uint32 count = 1) { for (uint32 i = 0; i < count; i++) sem_post(&sem); }
+    void Wait() { sem_wait(&sem); }
+};
+
+struct SyncBenchPosixSignal
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int value;
+
+    void Initialize() { pthread_mutex_init(&mutex, nullptr); pthread_cond_init(&cond, nullptr); value = 0; }
+    void Release() { pthread_cond_destroy(&cond); pthread_mutex_destroy(&mutex); }
+
+    void Post(uint32 = 1)
+    {
+        pthread_mutex_lock(&mutex);
+        value = 1;
+        pthread_mutex_unlock(&mutex);
+        pthread_cond_signal(&cond);
+    }
+
+    void Wait()
+    {
+        pthread_mutex_lock(&mutex);
+        while (value == 0)
+            pthread_cond_wait(&cond, &mutex);
+        value = 0;
+        pthread_mutex_unlock(&mutex);
+    }
+};
+
+struct SyncBenchSignal
+{
+    Signal sig;
+
+    void Initialize() { sig.Initialize(); }
+    void Release() { sig.Release(); }
+    void Post(uint32 = 1) { sig.Set(); sig.Raise(); }
+    void Wait() { sig.Wait(); }
+};
+
+template <typename _Sem>
+static double _SyncBenchPingPong(uint32 numIterations)
+{
+    struct PingPongData
+    {
+        _Sem ping;
+        _Sem pong;
+        uint32 numIterations;
+    };
+
+    PingPongData data;
+    data.ping.Initialize();
+    data.pong.Initialize();
+    data.numIterations = numIterations;
+
+    Thread thrd;
+    thrd.Start(ThreadDesc {
+        .entryFn = [](void* userData)->int {
+            PingPongData* data = (PingPongData*)userData;
+            for (uint32 i = 0; i < data->numIterations; i++) {
+                data->ping.Wait();
+                data->pong.Post();
+            }
+            return 0;
+        },
+        .userData = &data,
+        .name = "SyncBenchPong"
+    });
+
+    uint64 startTm = Timer::GetTicks();
+    for (uint32 i = 0; i < numIterations; i++) {
+        data.ping.Post();
+        data.pong.Wait();
+    }
+    double elapsedUS = Timer::ToUS(Timer::Diff(Timer::GetTicks(), startTm));
+
+    thrd.Stop();
+    data.ping.Release();
+    data.pong.Release();
+    return elapsedUS / double(numIterations);
+}
+
+template <typename _Sem>
+static double _SyncBenchThroughput(uint32 numIterations)
+{
+    struct ThroughputData
+    {
+        _Sem sem;
+        uint32 numWaitsPerConsumer;
+    };
+
+    uint32 numWaitsPerConsumer = AlignValue(numIterations, SYNC_BENCH_POST_BATCH) / SYNC_BENCH_NUM_CONSUMERS;
+    ThroughputData data;
+    data.sem.Initialize();
+    data.numWaitsPerConsumer = numWaitsPerConsumer;
+
+    Thread consumers[SYNC_BENCH_NUM_CONSUMERS];
+    uint64 startTm = Timer::GetTicks();
+    for (uint32 i = 0; i < SYNC_BENCH_NUM_CONSUMERS; i++) {
+        consumers[i].Start(ThreadDesc {
+            .entryFn = [](void* userData)->int {
+                ThroughputData* data = (ThroughputData*)userData;
+                for (uint32 i = 0; i < data->numWaitsPerConsumer; i++)
+                    data->sem.Wait();
+                return 0;
+            },
+            .userData = &data,
+            .name = "SyncBenchConsumer"
+        });
+    }
+
+    uint32 numPosts = numWaitsPerConsumer*SYNC_BENCH_NUM_CONSUMERS;
+    for (uint32 i = 0; i < numPosts; i += SYNC_BENCH_POST_BATCH)
+        data.sem.Post(Min(SYNC_BENCH_POST_BATCH, numPosts - i));
+
+    for (uint32 i = 0; i < SYNC_BENCH_NUM_CONSUMERS; i++)
+        consumers[i].Stop();
+    double elapsedMS = Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+    data.sem.Release();
+    return elapsedMS;
+}
+
+static SyncBenchmarkResult _RunSyncBenchmark(uint32 numIterations)
+{
+    numIterations = Max(numIterations, SYNC_BENCH_POST_BATCH);
+    SyncBenchmarkResult result { .numIterations = numIterations };
+
+    result.semaphorePingPongUS = _SyncBenchPingPong<Semaphore>(numIterations);
+    result.posixSemaphorePingPongUS = _SyncBenchPingPong<SyncBenchPosixSemaphore>(numIterations);
+    result.signalPingPongUS = _SyncBenchPingPong<SyncBenchSignal>(numIterations);
+    result.posixSignalPingPongUS = _SyncBenchPingPong<SyncBenchPosixSignal>(numIterations);
+    result.semaphoreThroughputMS = _SyncBenchThroughput<Semaphore>(numIterations);
+    result.posixSemaphoreThroughputMS = _SyncBenchThroughput<SyncBenchPosixSemaphore>(numIterations);
+
+    // Uncontended mutex: Both recursive, like the previous implementation
+    uint32 numLocks = numIterations*100;
+    {
+        Mutex mtx;
+        mtx.Initialize();
+        uint64 startTm = Timer::GetTicks();
+        for (uint32 i = 0; i < numLocks; i++) {
+            mtx.Enter();
+            mtx.Exit();
+        }
+        result.mutexNS = Timer::ToUS(Timer::Diff(Timer::GetTicks(), startTm))*1000.0 / double(numLocks);
+        mtx.Release();
+    }
+
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_t mtx;
+        pthread_mutex_init(&mtx, &attr);
+        uint64 startTm = Timer::GetTicks();
+        for (uint32 i = 0; i < numLocks; i++) {
+            pthread_mutex_lock(&mtx);
+            pthread_mutex_unlock(&mtx);
+        }
+        result.posixMutexNS = Timer::ToUS(Timer::Diff(Timer::GetTicks(), startTm))*1000.0 / double(numLocks);
+        pthread_mutex_destroy(&mtx);
+        pthread_mutexattr_destroy(&attr);
+    }
+
+    return result;
+}
+#endif // PLATFORM_LINUX
+
+//----------------------------------------------------------------------------------------------------------------------
+// Jobs mutex benchmark
+struct JobsMutexBenchmarkResult
+{
+    uint32 numJobs;
+    uint32 numIterations;
+    double mutexMS;                 // Contended jobs with Mutex (OS), plus the same amount of independent jobs
+    double jobsMutexMS;             // Same with JobsMutex
+    double readWriteMutexMS;        // Contended jobs with ReadWriteMutex (1 writer to 7 readers), plus independent jobs
+    double jobsReadWriteMutexMS;    // Same with JobsReadWriteMutex
+};
+
+struct JobsMutexBenchData
+{
+    Mutex* mutex;
+    JobsMutex* jobsMutex;
+    ReadWriteMutex* rwMutex;
+    JobsReadWriteMutex* jobsRwMutex;
+    uint32 numIterations;
+    uint64 counter;
+    uint64 value;
+    AtomicUint64 readSum;
+    AtomicUint64 independentSum;
+};
+
+// Simulates a bit of work inside and outside of the locks
+static uint64 _JobsMutexBenchWork(uint64 value, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+        value = value*6364136223846793005ull + 1442695040888963407ull;
+    return value;
+}
+
+static double _JobsMutexBenchRun(JobsMutexBenchData* data, uint32 numJobs, JobsCallback contendedFn)
+{
+    auto IndependentJob = [](uint32 groupIndex, void* userData)
+    {
+        JobsMutexBenchData* data = (JobsMutexBenchData*)userData;
+        uint64 value = _JobsMutexBenchWork(groupIndex, data->numIterations*64);
+        Atomic::FetchAddExplicit(&data->independentSum, value & 0xff, AtomicMemoryOrder::Relaxed);
+    };
+
+    data->counter = 0;
+    uint64 startTm = Timer::GetTicks();
+    JobsHandle contended = Jobs::Dispatch(JobsType::ShortTask, contendedFn, data, numJobs);
+    JobsHandle independent = Jobs::Dispatch(JobsType::ShortTask, IndependentJob, data, numJobs);
+    Jobs::WaitForCompletionAndDelete(contended);
+    Jobs::WaitForCompletionAndDelete(independent);
+    return Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+}
+
+static JobsMutexBenchmarkResult _RunJobsMutexBenchmark(uint32 numJobs, uint32 numIterations)
+{
+    ASSERT_MSG(!Jobs::IsRunningOnCurrentThread(), "Benchmark cannot run inside jobs");
+
+    numJobs = Max(numJobs, 1u);
+    numIterations = Max(numIterations, 1u);
+    JobsMutexBenchmarkResult result { .numJobs = numJobs, .numIterations = numIterations };
+    JobsMutexBenchData data { .numIterations = numIterations };
+
+    {
+        Mutex mtx;
+        mtx.Initialize();
+        data.mutex = &mtx;
+        result.mutexMS = _JobsMutexBenchRun(&data, numJobs, [](uint32, void* userData) {
+            JobsMutexBenchData* data = (JobsMutexBenchData*)userData;
+            for (uint32 i = 0; i < data->numIterations; i++) {
+                MutexScope lk(*data->mutex);
+                data->value = _JobsMutexBenchWork(data->value, 16);
+                ++data->counter;
+            }
+        });
+        ASSERT(data.counter == uint64(numJobs)*numIterations);
+        data.mutex = nullptr;
+        mtx.Release();
+    }
+
+    {
+        JobsMutex mtx;
+        mtx.Initialize();
+        data.jobsMutex = &mtx;
+        result.jobsMutexMS = _JobsMutexBenchRun(&data, numJobs, [](uint32, void* userData) {
+            JobsMutexBenchData* data = (JobsMutexBenchData*)userData;
+            for (uint32 i = 0; i < data->numIterations; i++) {
+                JobsMutexScope lk(*data->jobsMutex);
+                data->value = _JobsMutexBenchWork(data->value, 16);
+                ++data->counter;
+            }
+        });
+        ASSERT(data.counter == uint64(numJobs)*numIterations);
+        data.jobsMutex = nullptr;
+        mtx.Release();
+    }
+
+    {
+        ReadWriteMutex mtx;
+        mtx.Initialize();
+        data.rwMutex = &mtx;
+        result.readWriteMutexMS = _JobsMutexBenchRun(&data, numJobs, [](uint32 groupIndex, void* userData) {
+            JobsMutexBenchData* data = (JobsMutexBenchData*)userData;
+            for (uint32 i = 0; i < data->numIterations; i++) {
+                if (((i + groupIndex) & 7) == 0) {
+                    ReadWriteMutexWriteScope lk(*data->rwMutex);
+                    data->value = _JobsMutexBenchWork(data->value, 16);
+                    ++data->counter;
+                }
+                else {
+                    ReadWriteMutexReadScope lk(*data->rwMutex);
+                    Atomic::FetchAddExplicit(&data->readSum, _JobsMutexBenchWork(data->value, 16) & 0xff, AtomicMemoryOrder::Relaxed);
+                }
+            }
+        });
+        data.rwMutex = nullptr;
+        mtx.Release();
+    }
+
+    {
+        JobsReadWriteMutex mtx;
+        mtx.Initialize();
+        data.jobsRwMutex = &mtx;
+        result.jobsReadWriteMutexMS = _JobsMutexBenchRun(&data, numJobs, [](uint32 groupIndex, void* userData) {
+            JobsMutexBenchData* data = (JobsMutexBenchData*)userData;
+            for (uint32 i = 0; i < data->numIterations; i++) {
+                if (((i + groupIndex) & 7) == 0) {
+                    JobsReadWriteMutexWriteScope lk(*data->jobsRwMutex);
+                    data->value = _JobsMutexBenchWork(data->value, 16);
+                    ++data->counter;
+                }
+                else {
+                    JobsReadWriteMutexReadScope lk(*data->jobsRwMutex);
+                    Atomic::FetchAddExplicit(&data->readSum, _JobsMutexBenchWork(data->value, 16) & 0xff, AtomicMemoryOrder::Relaxed);
+                }
+            }
+        });
+        data.jobsRwMutex = nullptr;
+        mtx.Release();
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Vfs read benchmark
+struct VfsReadBenchmarkResult
+{
+    uint32 numFiles;
+    uint32 fileSize;
+    uint32 numWorkers;      // LongTask threads
+    double blockingMS;      // Vfs::ReadFile in jobs
+    double awaitMS;         // Vfs::ReadFileAwait in jobs
+    bool success;
+};
+
+struct VfsReadBenchData
+{
+    Path* paths;
+    bool await;
+    AtomicUint32 sum;
+    AtomicUint32 numFailed;
+};
+
+static double _VfsReadBenchRun(VfsReadBenchData* data, uint32 numFiles)
+{
+    // One job per file, each one hashes the file after it's loaded (a stand-in for parsing)
+    auto ReadJob = [](uint32 groupIndex, void* userData)
+    {
+        VfsReadBenchData* data = (VfsReadBenchData*)userData;
+        const char* path = data->paths[groupIndex].CStr();
+        Blob blob = data->await ? Vfs::ReadFileAwait(path, VfsFlags::None) : Vfs::ReadFile(path, VfsFlags::None);
+        if (blob.IsValid())
+            Atomic::FetchAddExplicit(&data->sum, Hash::Murmur32(blob.Data(), uint32(blob.Size())), AtomicMemoryOrder::Relaxed);
+        else
+            Atomic::FetchAddExplicit(&data->numFailed, 1, AtomicMemoryOrder::Relaxed);
+        blob.Free();
+    };
+
+    uint64 startTm = Timer::GetTicks();
+    Jobs::WaitForCompletionAndDelete(Jobs::Dispatch(JobsType::LongTask, ReadJob, data, numFiles));
+    return Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+}
+
+static VfsReadBenchmarkResult _RunVfsReadBenchmark(const char* dir, uint32 numFiles, uint32 fileSize)
+{
+    ASSERT_MSG(!Jobs::IsRunningOnCurrentThread(), "Benchmark cannot run inside jobs");
+    ASSERT_MSG(Vfs::GetMountType(dir) == VfsMountType::Local, "Benchmark directory '%s' must be on a local mount", dir);
+
+    // Every file is a job in a single dispatch, so stay well below the maximum number of pending jobs
+    numFiles = Clamp(numFiles, 1u, 2048u);
+    fileSize = Max(fileSize, 1u);
+
+    VfsReadBenchmarkResult result {
+        .numFiles = numFiles,
+        .fileSize = fileSize,
+        .numWorkers = Jobs::GetWorkerThreadsCount(JobsType::LongTask)
+    };
+
+    VfsReadBenchData data { .paths = Mem::AllocTyped<Path>(numFiles) };
+
+    // Write the files
+    {
+        MemTempAllocator tempAlloc;
+        uint8* content = tempAlloc.MallocTyped<uint8>(fileSize);
+        uint32 seed = 0x9e3779b9;
+        for (uint32 i = 0; i < fileSize; i++) {
+            seed = seed*1664525u + 1013904223u;
+            content[i] = uint8(seed >> 24);
+        }
+
+        Blob blob(content, fileSize);
+        blob.SetSize(fileSize);
+        for (uint32 i = 0; i < numFiles; i++) {
+            PLACEMENT_NEW(&data.paths[i], Path);
+            data.paths[i].FormatSelf("%s/file_%u.bin", dir, i);
+            if (Vfs::WriteFile(data.paths[i].CStr(), blob, VfsFlags::CreateDirs) != fileSize) {
+                LOG_ERROR("Writing benchmark file '%s' failed", data.paths[i].CStr());
+                numFiles = i;
+                break;
+            }
+        }
+    }
+
+    if (numFiles == result.numFiles) {
+        data.await = false;
+        result.blockingMS = _VfsReadBenchRun(&data, numFiles);
+
+        data.await = true;
+        result.awaitMS = _VfsReadBenchRun(&data, numFiles);
+
+        result.success = Atomic::Load(&data.numFailed) == 0;
+    }
+
+    for (uint32 i = 0; i < numFiles; i++)
+        OS::DeletePath(Vfs::ResolveFilepath(data.paths[i].CStr()).CStr());
+    OS::DeletePath(Vfs::ResolveFilepath(dir).CStr());
+    Mem::Free(data.paths);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Vfs mapped read benchmark
+struct VfsMappedReadBenchmarkResult
+{
+    uint32 numFiles;
+    uint64 fileSize;
+    double copyMS;          // Vfs::ReadFile + reading the data
+    double mappedMS;        // Vfs::ReadFile(Mapped) + reading the data
+    double copyOpenMS;      // Only the Vfs::ReadFile part of copyMS
+    double mappedOpenMS;    // Only the Vfs::ReadFile part of mappedMS
+    bool success;
+};
+
+static uint64 _VfsMappedBenchRun(const Path* paths, uint32 numFiles, VfsFlags flags, double* outOpenMS, bool* outSuccess)
+{
+    // Sums the whole file in words, so every page is touched like a parser would do
+    uint64 sum = 0;
+    uint64 openTicks = 0;
+    for (uint32 i = 0; i < numFiles; i++) {
+        uint64 startTm = Timer::GetTicks();
+        Blob blob = Vfs::ReadFile(paths[i].CStr(), flags);
+        openTicks += Timer::Diff(Timer::GetTicks(), startTm);
+
+        if (!blob.IsValid()) {
+            *outSuccess = false;
+            continue;
+        }
+
+        const uint64* words = (const uint64*)blob.Data();
+        size_t numWords = blob.Size() / sizeof(uint64);
+        for (size_t k = 0; k < numWords; k++)
+            sum += words[k];
+        blob.Free();
+    }
+
+    *outOpenMS = Timer::ToMS(openTicks);
+    return sum;
+}
+
+static VfsMappedReadBenchmarkResult _RunVfsMappedReadBenchmark(const char* dir, uint32 numFiles, uint64 fileSize)
+{
+    ASSERT_MSG(Vfs::GetMountType(dir) == VfsMountType::Local, "Benchmark directory '%s' must be on a local mount", dir);
+
+    numFiles = Clamp(numFiles, 1u, 256u);
+    fileSize = AlignValue<uint64>(Max<uint64>(fileSize, sizeof(uint64)), sizeof(uint64));
+
+    VfsMappedReadBenchmarkResult result {
+        .numFiles = numFiles,
+        .fileSize = fileSize
+    };
+
+    Path* paths = Mem::AllocTyped<Path>(numFiles);
+
+    // Write the files
+    {
+        uint64* content = (uint64*)Mem::Alloc(size_t(fileSize));
+        uint64 seed = 0x9e3779b97f4a7c15ull;
+        for (uint64 i = 0; i < fileSize / sizeof(uint64); i++) {
+            seed = seed*6364136223846793005ull + 1442695040888963407ull;
+            content[i] = seed;
+        }
+
+        Blob blob(content, size_t(fileSize));
+        blob.SetSize(size_t(fileSize));
+        for (uint32 i = 0; i < numFiles; i++) {
+            PLACEMENT_NEW(&paths[i], Path);
+            paths[i].FormatSelf("%s/file_%u.bin", dir, i);
+            if (Vfs::WriteFile(paths[i].CStr(), blob, VfsFlags::CreateDirs) != fileSize) {
+                LOG_ERROR("Writing benchmark file '%s' failed", paths[i].CStr());
+                numFiles = i;
+                break;
+            }
+        }
+        Mem::Free(content);
+    }
+
+    if (numFiles == result.numFiles) {
+        bool success = true;
+
+        uint64 startTm = Timer::GetTicks();
+        uint64 copySum = _VfsMappedBenchRun(paths, numFiles, VfsFlags::None, &result.copyOpenMS, &success);
+        result.copyMS = Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        startTm = Timer::GetTicks();
+        uint64 mappedSum = _VfsMappedBenchRun(paths, numFiles, VfsFlags::Mapped, &result.mappedOpenMS, &success);
+        result.mappedMS = Timer::ToMS(Timer::Diff(Timer::GetTicks(), startTm));
+
+        result.success = success && copySum == mappedSum;
+    }
+
+    for (uint32 i = 0; i < numFiles; i++)
+        OS::DeletePath(Vfs::ResolveFilepath(paths[i].CStr()).CStr());
+    OS::DeletePath(Vfs::ResolveFilepath(dir).CStr());
+    Mem::Free(paths);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Bench::RegisterConsoleCommands()
+{
+    // Benchmark RemoteServices server on the loopback
+    auto RemoteBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numClients = argc > 1 ? Str::ToUint(argv[1]) : 8;
+        uint32 numRequests = argc > 2 ? Str::ToUint(argv[2]) : 10000;
+        uint32 payloadSize = argc > 3 ? Str::ToUint(argv[3]) : 4096;
+        bool compress = argc > 4 ? Str::ToBool(argv[4]) : false;
+
+        if (!SettingsJunkyard::Get().tooling.enableServer) {
+            Str::Copy(outResponse, responseSize, "RemoteServices server is not enabled (-ToolingEnableServer=1)");
+            return false;
+        }
+
+        String<64> url = String<64>::Format("localhost:%u", SettingsJunkyard::Get().tooling.serverPort);
+        RemoteBenchmarkResult result;
+        if (!Remote::RunBenchmark(url.CStr(), Max(numClients, 1u), numRequests, payloadSize, compress, &result)) {
+            Str::PrintFmt(outResponse, responseSize, "Connecting to '%s' failed", url.CStr());
+            return false;
+        }
+
+        float ratio = result.numWireBytes ? float(double(result.numBytes)/double(result.numWireBytes)) : 1.0f;
+        Str::PrintFmt(outResponse, responseSize, "Clients: %u, Requests: %u, Payload: %u bytes, Time: %.1f ms, %.0f req/s, %.2f MB/s, Compression: %.2fx",
+                      result.numClients, result.numRequests, payloadSize, result.durationMS, result.requestsPerSec, result.megabytesPerSec, ratio);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "remote-bench",
+        .help = "benchmark RemoteServices server on the loopback: remote-bench [NumClients] [NumRequestsPerClient] [PayloadSize] [Compress]",
+        .callback = RemoteBenchFn
+    });
+
+    // Benchmark LOG calls from multiple threads, in sync and async modes, with and without writing to sinks
+    auto LogBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numThreads = argc > 1 ? Str::ToUint(argv[1]) : 4;
+        uint32 numCalls = argc > 2 ? Str::ToUint(argv[2]) : 10000;
+
+        bool wasAsync = Log::IsAsync();
+        LogBenchmarkResult results[4];
+        for (uint32 i = 0; i < CountOf(results); i++) {
+            bool async = i >= 2;
+            bool withSinks = (i & 0x1) != 0;
+            if (async && !Log::IsAsync())
+                Log::InitializeAsync();
+            else if (!async && Log::IsAsync())
+                Log::ReleaseAsync();
+            results[i] = Log::RunBenchmark(numThreads, numCalls, withSinks);
+        }
+
+        if (wasAsync && !Log::IsAsync())
+            Log::InitializeAsync();
+        else if (!wasAsync && Log::IsAsync())
+            Log::ReleaseAsync();
+
+        Str::PrintFmt(outResponse, responseSize, 
+                      "Threads: %u, Calls: %u\n"
+                      "Sync (no sinks): %.0f calls/s (%.1f ms)\n"
+                      "Sync: %.0f calls/s (%.1f ms)\n"
+                      "Async (no sinks): %.0f calls/s (%.1f ms, drained in %.1f ms)\n"
+                      "Async: %.0f calls/s (%.1f ms, drained in %.1f ms)",
+                      results[0].numThreads, results[0].numCalls,
+                      results[0].callsPerSec, results[0].producerMS,
+                      results[1].callsPerSec, results[1].producerMS,
+                      results[2].callsPerSec, results[2].producerMS, results[2].totalMS,
+                      results[3].callsPerSec, results[3].producerMS, results[3].totalMS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "log-bench",
+        .help = "benchmark LOG calls in sync/async modes, with and without sinks: log-bench [NumThreads] [NumCallsPerThread]",
+        .callback = LogBenchFn
+    });
+
+    // Measures JSON parse throughput and key lookups on the given files (defaults to the repo's glTF and font data)
+    auto JsonBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        static const char* defaultFiles[] = {
+            "data/models/HighPolyBox/HighPolyBox.gltf",
+            "data/fonts/arial.jfnt"
+        };
+
+        uint32 numIterations = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 1000;
+        const char** files = argc > 2 ? &argv[2] : defaultFiles;
+        uint32 numFiles = argc > 2 ? uint32(argc - 2) : CountOf(defaultFiles);
+
+        char* response = outResponse;
+        uint32 remaining = responseSize;
+        for (uint32 i = 0; i < numFiles && remaining > 1; i++) {
+            MemTempAllocator tempAlloc;
+            Blob blob = Vfs::ReadFile(files[i], VfsFlags::None, &tempAlloc);
+            uint32 len;
+            if (blob.IsValid()) {
+                JsonBenchmarkResult r = Json::RunBenchmark((const char*)blob.Data(), uint32(blob.Size()), numIterations);
+                if (r.parseFailed) {
+                    len = Str::PrintFmt(response, remaining, "%s: Parsing failed (line: %u, col: %u)\n", 
+                                        files[i], r.errorLoc.line, r.errorLoc.col);
+                }
+                else {
+                    len = Str::PrintFmt(response, remaining, 
+                                        "%s (%u bytes, %u tokens): Parse %.1f MB/s, Arena parse %.1f MB/s, Lookups: %.0f/s (seek), %.0f/s (index)\n",
+                                        files[i], uint32(blob.Size()), r.numTokens, r.parseMBPerSec, r.arenaParseMBPerSec, 
+                                        r.seekLookupsPerSec, r.indexLookupsPerSec);
+                }
+            }
+            else {
+                len = Str::PrintFmt(response, remaining, "%s: Reading file failed\n", files[i]);
+            }
+            len = Min(len, remaining - 1);
+            response += len;
+            remaining -= len;
+        }
+
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "json-bench",
+        .help = "benchmark JSON parsing and key lookups: json-bench [NumIterations] [File1] [File2] ...",
+        .callback = JsonBenchFn
+    });
+
+    auto PoolBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numItems = argc > 1 ? Max(Str::ToUint(argv[1]), 2u) : 100000;
+        uint32 numIterations = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 10;
+
+        HandlePoolBenchmarkResult r = _RunHandlePoolBenchmark(numItems, numIterations);
+        Str::PrintFmt(outResponse, responseSize, 
+                      "%u items: Add/Remove %.2f ms, Dense %.2f ms, Dense batch %.2f ms. Iterate %.3f ms, Dense %.3f ms",
+                      r.numItems, r.addRemoveMS, r.denseAddRemoveMS, r.denseBatchAddRemoveMS, r.iterateMS, r.denseIterateMS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "pool-bench",
+        .help = "benchmark HandlePool vs DenseHandlePool churn and iteration: pool-bench [NumItems] [NumIterations]",
+        .callback = PoolBenchFn
+    });
+
+    auto QueueBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numItems = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 1000000;
+        uint32 numProducers = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 4;
+
+        QueueBenchmarkResult r = _RunQueueBenchmark(numItems, numProducers);
+        Str::PrintFmt(outResponse, responseSize, 
+                      "%u items: Array FIFO %.2f ms, RingQueue FIFO %.2f ms. %u producers: Mutex+RingQueue %.2f ms, MpscQueue %.2f ms",
+                      r.numItems, r.arrayFifoMS, r.ringQueueFifoMS, r.numProducers, r.mutexQueueMS, r.mpscQueueMS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "queue-bench",
+        .help = "benchmark FIFO containers and cross-thread queues: queue-bench [NumItems] [NumProducers]",
+        .callback = QueueBenchFn
+    });
+
+    // Contended locks inside jobs: OS mutexes block the worker threads, Jobs mutexes park the fibers
+    auto JobsMutexBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numJobs = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 64;
+        uint32 numIterations = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 10000;
+
+        JobsMutexBenchmarkResult r = _RunJobsMutexBenchmark(numJobs, numIterations);
+        Str::PrintFmt(outResponse, responseSize, 
+                      "%u jobs x %u locks: Mutex %.2f ms, JobsMutex %.2f ms. ReadWriteMutex %.2f ms, JobsReadWriteMutex %.2f ms",
+                      r.numJobs, r.numIterations, r.mutexMS, r.jobsMutexMS, r.readWriteMutexMS, r.jobsReadWriteMutexMS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "jobs-mutex-bench",
+        .help = "benchmark contended OS mutexes vs fiber-aware Jobs mutexes inside jobs: jobs-mutex-bench [NumJobs] [NumLocksPerJob]",
+        .callback = JobsMutexBenchFn
+    });
+
+    // Same cache-sensitive jobs, with and without pinning workers to cores
+    auto JobsPinBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numJobs = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 256;
+        uint32 numPasses = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 16;
+
+        JobsPinningBenchmarkResult r = Jobs::RunPinningBenchmark(numJobs, numPasses);
+        if (r.supported) {
+            Str::PrintFmt(outResponse, responseSize, "%u jobs x %u passes over %u KB: Unpinned %.2f ms, Pinned %.2f ms",
+                          r.numJobs, r.numPasses, r.bufferSize/SIZE_KB, r.unpinnedMS, r.pinnedMS);
+        }
+        else {
+            Str::PrintFmt(outResponse, responseSize, "%u jobs x %u passes over %u KB: Unpinned %.2f ms (Pinning is not supported)",
+                          r.numJobs, r.numPasses, r.bufferSize/SIZE_KB, r.unpinnedMS);
+        }
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "jobs-pin-bench",
+        .help = "benchmark cache-sensitive jobs with and without thread pinning: jobs-pin-bench [NumJobs] [NumPassesPerJob]",
+        .callback = JobsPinBenchFn
+    });
+
+    // Cancelled parent with queued children: None of the children should run and the waits should return
+    auto JobsCancelTestFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numIterations = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 100;
+        uint32 numChildren = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 64;
+
+        uint32 numFailed = Jobs::RunCancelSelfTest(numIterations, numChildren);
+        Str::PrintFmt(outResponse, responseSize, "%u iterations x %u children: %u failed", numIterations, numChildren, numFailed);
+        LOG_INFO("%s", outResponse);
+        return numFailed == 0;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "jobs-cancel-test",
+        .help = "cancel parent jobs with queued children and check that none of them run: jobs-cancel-test [NumIterations] [NumChildren]",
+        .callback = JobsCancelTestFn
+    });
+
+    // Many small files read from jobs, blocking the workers vs suspending the jobs while the reads are in flight
+    auto VfsReadBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numFiles = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 1000;
+        uint32 fileSize = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 4096;
+        const char* dir = argc > 3 ? argv[3] : "/cache/vfs-bench";
+
+        if (Vfs::GetMountType(dir) != VfsMountType::Local) {
+            Str::PrintFmt(outResponse, responseSize, "Directory '%s' is not on a local mount", dir);
+            return false;
+        }
+
+        VfsReadBenchmarkResult r = _RunVfsReadBenchmark(dir, numFiles, fileSize);
+        if (!r.success) {
+            Str::Copy(outResponse, responseSize, "Reading benchmark files failed");
+            return false;
+        }
+
+        Str::PrintFmt(outResponse, responseSize, "%u files x %u bytes, %u LongTask threads: ReadFile %.2f ms, ReadFileAwait %.2f ms",
+                      r.numFiles, r.fileSize, r.numWorkers, r.blockingMS, r.awaitMS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "vfs-read-bench",
+        .help = "benchmark loading small files in jobs with blocking vs suspending reads: vfs-read-bench [NumFiles] [FileSize] [LocalMountDir]",
+        .callback = VfsReadBenchFn
+    });
+
+    auto VfsMappedBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numFiles = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 8;
+        uint64 fileSize = uint64(argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 64)*SIZE_MB;
+        const char* dir = argc > 3 ? argv[3] : "/cache/vfs-mapped-bench";
+
+        if (Vfs::GetMountType(dir) != VfsMountType::Local) {
+            Str::PrintFmt(outResponse, responseSize, "Directory '%s' is not on a local mount", dir);
+            return false;
+        }
+
+        VfsMappedReadBenchmarkResult r = _RunVfsMappedReadBenchmark(dir, numFiles, fileSize);
+        if (!r.success) {
+            Str::Copy(outResponse, responseSize, "Reading benchmark files failed");
+            return false;
+        }
+
+        Str::PrintFmt(outResponse, responseSize, "%u files x %llu MB: Copy %.2f ms (ReadFile %.2f ms), Mapped %.2f ms (ReadFile %.2f ms)",
+                      r.numFiles, r.fileSize/SIZE_MB, r.copyMS, r.copyOpenMS, r.mappedMS, r.mappedOpenMS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "vfs-mapped-bench",
+        .help = "benchmark reading large files with a copy vs memory mapping: vfs-mapped-bench [NumFiles] [FileSizeMB] [LocalMountDir]",
+        .callback = VfsMappedBenchFn
+    });
+
+    // Vertex data size and CPU decode speed of quantized models, with the renderer's vertex layout
+    auto ModelQuantBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        if (argc < 2) {
+            Str::Copy(outResponse, responseSize, "Model filepath is not provided");
+            return false;
+        }
+
+        GeometryVertexLayout layout;
+        R::GetCompatibleLayout(layout);
+
+        ModelQuantizeBenchmarkResult r;
+        if (!Model::RunQuantizeBenchmark(argv[1], layout, &r)) {
+            Str::PrintFmt(outResponse, responseSize, "Loading model '%s' failed", argv[1]);
+            return false;
+        }
+
+        Str::PrintFmt(outResponse, responseSize, 
+                      "%u meshes, %u vertices: Vertex data %llu -> %llu KB (%.1f%%). Quantize %.2f ms, "
+                      "Decode %.2f ms (%.1f ns/vertex). Max error: Position %f, Normal %.3f deg",
+                      r.numMeshes, r.numVertices, r.floatVertexBytes/SIZE_KB, r.quantizedVertexBytes/SIZE_KB,
+                      100.0*double(r.quantizedVertexBytes)/double(Max<uint64>(r.floatVertexBytes, 1)),
+                      r.quantizeMS, r.decodeMS, 1000000.0*r.decodeMS/double(Max(r.numVertices, 1u)),
+                      r.maxPositionError, r.maxNormalErrorDeg);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "model-quant-bench",
+        .help = "benchmark quantized vertex size and decode speed of a gltf model: model-quant-bench <ModelFilepath>",
+        .callback = ModelQuantBenchFn
+    });
+
+    #if PLATFORM_LINUX
+    // Futex based sync primitives vs sem_t and pthread mutex/condvar
+    auto SyncBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numIterations = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 100000;
+
+        SyncBenchmarkResult r = _RunSyncBenchmark(numIterations);
+        Str::PrintFmt(outResponse, responseSize, 
+                      "%u iterations: PingPong Semaphore %.2f us (sem_t %.2f us), Signal %.2f us (condvar %.2f us). "
+                      "Post/Wait Semaphore %.2f ms (sem_t %.2f ms). Mutex %.1f ns (pthread %.1f ns)",
+                      r.numIterations, r.semaphorePingPongUS, r.posixSemaphorePingPongUS, r.signalPingPongUS, r.posixSignalPingPongUS,
+                      r.semaphoreThroughputMS, r.posixSemaphoreThroughputMS, r.mutexNS, r.posixMutexNS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "sync-bench",
+        .help = "benchmark futex sync primitives vs posix versions: sync-bench [NumIterations]",
+        .callback = SyncBenchFn
+    });
+    #endif
+
+    // SIMD string kernels vs the scalar reference versions
+    auto StrSimdBenchFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numStrings = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 4096;
+        uint32 numIterations = argc > 2 ? Max(Str::ToUint(argv[2]), 1u) : 100;
+
+        StrSimdBenchmarkResult r = Str::RunSimdBenchmark(numStrings, numIterations);
+        Str::PrintFmt(outResponse, responseSize,
+                      "%u strings (avg len %u), Scalar vs %s (ns): Len %.1f/%.1f, FindChar %.1f/%.1f, FindCharRev %.1f/%.1f, "
+                      "FindStr %.1f/%.1f, IsEqualNoCase %.1f/%.1f",
+                      r.numStrings, r.avgLen, Str::GetSimdLevelName(r.level), r.scalarLenNS, r.simdLenNS,
+                      r.scalarFindCharNS, r.simdFindCharNS, r.scalarFindCharRevNS, r.simdFindCharRevNS,
+                      r.scalarFindStrNS, r.simdFindStrNS, r.scalarIsEqualNoCaseNS, r.simdIsEqualNoCaseNS);
+        LOG_INFO("%s", outResponse);
+        return true;
+    };
+
+    Console::RegisterCommand(ConCommandDesc {
+        .name = "str-simd-bench",
+        .help = "benchmark SIMD string kernels vs scalar over path-like strings: str-simd-bench [NumStrings] [NumIterations]",
+        .callback = StrSimdBenchFn
+    });
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../Core/Base.h"
+
+// Benchmarks of the engine modules, exposed as console commands (queue-bench, jobs-mutex-bench, vfs-read-bench, ...)
+// Benchmarks that only need the public API of a module are implemented here, so the modules themselves only ship features
+// The ones that need module internals (Json, Log, Str, Remote, Model and Jobs pinning) stay in their modules and are only registered here
+namespace Bench
+{
+    API void RegisterConsoleCommands();
+}
@@ -1,4 +1,5 @@
 #include "Console.h"
+#include "Benchmarks.h"
 
 #include "../Core/StringUtil.h"
 #include "../Core/System.h"
@@ -22,6 +23,7 @@ struct ConCustomVar
 
 struct ConContext
 {
+    SpinLockMutex commandsMtx;      // Commands can be registered from init jobs (see Engine::Initialize)
     Array<ConCommandDesc> commands;
     Array<ConCustomVar> vars;
 };
@@ -30,7 +32,7 @@ static ConContext gConsole;
 
 namespace Console
 {
-    static void _HandlerClientCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, void*, bool error, const char* errorDesc)
+    static void _HandlerClientCallback([[maybe_unused]] uint32 cmd, uint32, const Blob& incomingData, void*, bool error, const char* errorDesc)
     {
         ASSERT(cmd == CONSOLE_REMOTE_CMD);
         if (!error) {
@@ -43,7 +45,7 @@ namespace Console
         }
     }
 
-    static bool _HandlerServerCallback([[maybe_unused]] uint32 cmd, const Blob& incomingData, Blob* outgoingBlob, void*, 
+    static bool _HandlerServerCallback([[maybe_unused]] uint32 cmd, const RemoteRequest&, const Blob& incomingData, Blob* outgoingBlob, void*, 
                                     char outgoingErrorDesc[REMOTE_ERROR_SIZE])
     {
         ASSERT(cmd == CONSOLE_REMOTE_CMD);
@@ -166,17 +168,23 @@ bool Console::Execute(const char* cmd, char* outResponse, uint32 responseSize)
 
     if (argv.Count()) {
         const char* name = argv[0];
-        uint32 index = gConsole.commands.FindIf([name](const ConCommandDesc& desc) { return Str::IsEqualNoCase(name, desc.name); });
+        ConCommandDesc cmdDesc {};
+        uint32 index;
+        {
+            SpinLockMutexScope lock(gConsole.commandsMtx);
+            index = gConsole.commands.FindIf([name](const ConCommandDesc& desc) { return Str::IsEqualNoCase(name, desc.name); });
+            if (index != UINT32_MAX)
+                cmdDesc = gConsole.commands[index];
+        }
+
         if (index != UINT32_MAX) {
-            const ConCommandDesc& cmdDesc = gConsole.commands[index];
             if (argv.Count() < cmdDesc.minArgc) {
                 Str::PrintFmt(outResponse, responseSize, "Command '%s' failed. Invalid number of arguments (expected %u)", 
                             name, cmdDesc.minArgc);
                 return false;
             }
             else {
-                return gConsole.commands[index].callback((int)argv.Count(), (const char**)argv.Ptr(), 
-                                                         outResponse, responseSize, cmdDesc.userData);
+                return cmdDesc.callback((int)argv.Count(), (const char**)argv.Ptr(), outResponse, responseSize, cmdDesc.userData);
             }
         }
         else {
@@ -282,6 +290,52 @@ bool Console::Initialize(MemAllocator* alloc)
         .minArgc = 2
     });
 
+    // SIMD string kernels vs the scalar reference versions
+    auto StrSimdTestFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        uint32 numIterations = argc > 1 ? Max(Str::ToUint(argv[1]), 1u) : 100000;
+
+        uint32 numFailed = Str::RunSimdSelfTest(numIterations);
+        Str::PrintFmt(outResponse, responseSize, "%u iterations, selected kernels: %s. %u mismatches",
+                      numIterations, Str::GetSimdLevelName(Str::GetSimdLevel()), numFailed);
+        LOG_INFO("%s", outResponse);
+        return numFailed == 0;
+    };
+
+    RegisterCommand(ConCommandDesc {
+        .name = "str-simd-test",
+        .help = "fuzz SIMD string kernels against the scalar ones: str-simd-test [NumIterations]",
+        .callback = StrSimdTestFn
+    });
+
+    // Decodes binary log files (see Log::InitializeBinarySink) to text
+    auto LogDecodeFn = [](int argc, const char* argv[], char* outResponse, uint32 responseSize, void*)->bool {
+        if (argc < 2) {
+            Str::Copy(outResponse, responseSize, "Usage: log-decode <BinaryFile> [TextFile]");
+            return false;
+        }
+
+        Path textFilepath(argc > 2 ? argv[2] : argv[1]);
+        if (argc <= 2)
+            textFilepath.Append(".txt");
+        Log::Flush();
+        if (!Log::DecodeBinaryFile(argv[1], textFilepath.CStr())) {
+            Str::PrintFmt(outResponse, responseSize, "Decoding '%s' failed", argv[1]);
+            return false;
+        }
+
+        Str::PrintFmt(outResponse, responseSize, "Decoded '%s' to '%s'", argv[1], textFilepath.CStr());
+        return true;
+    };
+
+    RegisterCommand(ConCommandDesc {
+        .name = "log-decode",
+        .help = "decode binary log file to text: log-decode <BinaryFile> [TextFile]",
+        .callback = LogDecodeFn
+    });
+
+    // Benchmarks of the engine modules (*-bench)
+    Bench::RegisterConsoleCommands();
+
     return true;
 }
 
@@ -293,6 +347,8 @@ void Console::Release()
 
 void Console::RegisterCommand(const ConCommandDesc& desc)
 {
+    SpinLockMutexScope lock(gConsole.commandsMtx);
+
     [[maybe_unused]] uint32 index = gConsole.commands.FindIf([name=desc.name](const ConCommandDesc& desc) { return Str::IsEqual(desc.name, name); });
     ASSERT_MSG(index == UINT32_MAX, "Command '%s' already registered", desc.name);
 
@@ -6,6 +6,8 @@
 
 #include "../Core/Allocators.h"
 #include "../Core/TracyHelper.h"
+#include "../Core/Arrays.h"
+#include "../Core/Jobs.h"
 
 #include "../Core/Log.h"
 
@@ -19,13 +21,125 @@ void MeshOpt::Initialize()
     );
 }
 
-void MeshOpt::Optimize(MeshOptModel* model)
+namespace MeshOpt
 {
-    MemTempAllocator tmpAlloc;
-    gMeshOptAlloc = &tmpAlloc;
+    static void _GenerateLods(const MeshOptModel* model, MeshOptMesh* mesh, const float* positions, MemTempAllocator* tmpAlloc)
+    {
+        Array<uint32> lodIndices(tmpAlloc);
+        float scale = meshopt_simplifyScale(positions, mesh->numVertices, mesh->posStride);
+        uint32 numLods = Min(model->numLods, MESHOPT_MAX_LODS);
+        float lodReduction = model->lodReduction > 0 && model->lodReduction < 1.0f ? model->lodReduction : 0.5f;
+
+        for (uint32 submeshIdx = 0; submeshIdx < mesh->numSubmeshes; submeshIdx++) {
+            MeshOptSubmesh* submesh = &mesh->submeshes[submeshIdx];
+            uint32* srcIndices = tmpAlloc->MallocTyped<uint32>(submesh->numIndices);
+            uint32* dstIndices = tmpAlloc->MallocTyped<uint32>(submesh->numIndices);
+            uint32 numSrcIndices = submesh->numIndices;
+            float error = 0;
+
+            memcpy(srcIndices, mesh->indexBuffer + submesh->startIndex, sizeof(uint32)*numSrcIndices);
+
+            // Each LOD is simplified from the previous one, so the error is accumulated over the chain
+            for (uint32 lodIdx = 0; lodIdx < numLods; lodIdx++) {
+                uint32 targetNumIndices = uint32(float(numSrcIndices)*lodReduction)/3*3;
+                if (targetNumIndices < 3)
+                    break;
+
+                float lodError = 0;
+                uint32 numIndices = uint32(meshopt_simplify(dstIndices, srcIndices, numSrcIndices, positions, mesh->numVertices, 
+                                                            mesh->posStride, targetNumIndices, model->lodTargetError, 0, &lodError));
+
+                // Simplifier cannot make any meaningful progress because of the error limit
+                if (numIndices == 0 || numIndices >= numSrcIndices*95/100)
+                    break;
+
+                meshopt_optimizeVertexCache(dstIndices, dstIndices, numIndices, mesh->numVertices);
+
+                error += lodError;
+                submesh->lods[lodIdx] = {
+                    .startIndex = lodIndices.Count(),
+                    .numIndices = numIndices,
+                    .error = error*scale
+                };
+                submesh->numLods = lodIdx + 1;
+                lodIndices.PushBatch(dstIndices, numIndices);
+
+                Swap(srcIndices, dstIndices);
+                numSrcIndices = numIndices;
+            }
+        }
+
+        if (!lodIndices.IsEmpty()) {
+            mesh->lodIndexBuffer = Mem::AllocCopy<uint32>(lodIndices.Ptr(), lodIndices.Count(), model->alloc);
+            mesh->numLodIndices = lodIndices.Count();
+        }
+    }
+
+    static void _GenerateMeshlets(const MeshOptModel* model, MeshOptMesh* mesh, const float* positions, MemTempAllocator* tmpAlloc)
+    {
+        Array<MeshOptMeshlet> meshlets(tmpAlloc);
+        Array<uint32> meshletVertices(tmpAlloc);
+        Array<uint8> meshletTriangles(tmpAlloc);
+
+        for (uint32 submeshIdx = 0; submeshIdx < mesh->numSubmeshes; submeshIdx++) {
+            MeshOptSubmesh* submesh = &mesh->submeshes[submeshIdx];
+            const uint32* indices = mesh->indexBuffer + submesh->startIndex;
+
+            size_t maxMeshlets = meshopt_buildMeshletsBound(submesh->numIndices, MESHOPT_MESHLET_MAX_VERTICES, MESHOPT_MESHLET_MAX_TRIANGLES);
+            meshopt_Meshlet* srcMeshlets = tmpAlloc->MallocTyped<meshopt_Meshlet>(uint32(maxMeshlets));
+            uint32* srcVertices = tmpAlloc->MallocTyped<uint32>(uint32(maxMeshlets*MESHOPT_MESHLET_MAX_VERTICES));
+            uint8* srcTriangles = tmpAlloc->MallocTyped<uint8>(uint32(maxMeshlets*MESHOPT_MESHLET_MAX_TRIANGLES*3));
+
+            uint32 numMeshlets = uint32(meshopt_buildMeshlets(srcMeshlets, srcVertices, srcTriangles, indices, submesh->numIndices,
+                                                              positions, mesh->numVertices, mesh->posStride,
+                                                              MESHOPT_MESHLET_MAX_VERTICES, MESHOPT_MESHLET_MAX_TRIANGLES, 0));
+            if (numMeshlets == 0)
+                continue;
+
+            submesh->meshletStart = meshlets.Count();
+            submesh->numMeshlets = numMeshlets;
+
+            uint32 baseVertex = meshletVertices.Count();
+            uint32 baseTriangle = meshletTriangles.Count();
+            for (uint32 i = 0; i < numMeshlets; i++) {
+                const meshopt_Meshlet& m = srcMeshlets[i];
+                meshopt_Bounds bounds = meshopt_computeMeshletBounds(&srcVertices[m.vertex_offset], &srcTriangles[m.triangle_offset],
+                                                                     m.triangle_count, positions, mesh->numVertices, mesh->posStride);
+                meshlets.Push(MeshOptMeshlet {
+                    .center = {bounds.center[0], bounds.center[1], bounds.center[2]},
+                    .radius = bounds.radius,
+                    .coneAxis = {bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]},
+                    .coneCutoff = bounds.cone_cutoff,
+                    .vertexOffset = baseVertex + m.vertex_offset,
+                    .triangleOffset = baseTriangle + m.triangle_offset,
+                    .numVertices = m.vertex_count,
+                    .numTriangles = m.triangle_count
+                });
+            }
+
+            // Trim the output arrays. Triangles of each meshlet are padded to 4 bytes 
+            const meshopt_Meshlet& last = srcMeshlets[numMeshlets - 1];
+            meshletVertices.PushBatch(srcVertices, last.vertex_offset + last.vertex_count);
+            meshletTriangles.PushBatch(srcTriangles, last.triangle_offset + ((last.triangle_count*3 + 3) & ~3u));
+        }
+
+        if (!meshlets.IsEmpty()) {
+            mesh->meshlets = Mem::AllocCopy<MeshOptMeshlet>(meshlets.Ptr(), meshlets.Count(), model->alloc);
+            mesh->meshletVertices = Mem::AllocCopy<uint32>(meshletVertices.Ptr(), meshletVertices.Count(), model->alloc);
+            mesh->meshletTriangles = Mem::AllocCopy<uint8>(meshletTriangles.Ptr(), meshletTriangles.Count(), model->alloc);
+            mesh->numMeshlets = meshlets.Count();
+            mesh->numMeshletVertices = meshletVertices.Count();
+            mesh->numMeshletTriangles = meshletTriangles.Count();
+        }
+    }
+
+    static void _OptimizeMesh(const MeshOptModel* model, MeshOptMesh* mesh)
+    {
+        PROFILE_ZONE("MeshOpt.OptimizeMesh");
+
+        MemTempAllocator tmpAlloc;
+        gMeshOptAlloc = &tmpAlloc;
 
-    for (uint32 i = 0; i < model->numMeshes; i++) {
-        MeshOptMesh* mesh = model->meshes[i];
         uint32* meshIndices = mesh->indexBuffer;
 
         meshopt_Stream* streams = tmpAlloc.MallocTyped<meshopt_Stream>(mesh->numVertexBuffers);
@@ -85,9 +199,45 @@ void MeshOpt::Optimize(MeshOptModel* model)
         for (uint32 k = 0; k < mesh->numVertexBuffers; k++)
             meshopt_remapVertexBuffer(mesh->vertexBuffers[k], vertices[k], mesh->numVertices, mesh->vertexStrides[k], remap);
         meshopt_remapIndexBuffer(meshIndices, indices, mesh->numIndices, remap);
+
+        // LODs and meshlets are generated from the final (optimized) vertex and index buffers
+        const float* positions = (const float*)((uint8*)mesh->vertexBuffers[mesh->posBufferIndex] + mesh->posOffset);
+        if (model->numLods)
+            _GenerateLods(model, mesh, positions, &tmpAlloc);
+
+        if (model->generateMeshlets)
+            _GenerateMeshlets(model, mesh, positions, &tmpAlloc);
+
+        gMeshOptAlloc = nullptr;
     }
+} // MeshOpt
 
-    gMeshOptAlloc = nullptr;
+void MeshOpt::Optimize(MeshOptModel* model)
+{
+    PROFILE_ZONE("MeshOpt.Optimize");
+    ASSERT_MSG(!(model->numLods || model->generateMeshlets) || model->alloc, "Output allocator must be provided for LODs/Meshlets");
+    ASSERT_MSG(!model->alloc || model->alloc->GetType() != MemAllocatorType::Temp, "Temp allocators cannot be used across worker threads");
+
+    if (model->numMeshes == 0)
+        return;
+
+    auto OptimizeMeshJob = [](uint32 groupIndex, void* userData)
+    {
+        MeshOptModel* model = reinterpret_cast<MeshOptModel*>(userData);
+        _OptimizeMesh(model, model->meshes[groupIndex]);
+    };
+
+    // Inside a job (asset bake), the caller holds the thread-bound arena that the outputs are allocated from, and waiting 
+    // on the children can resume it on another worker. So optimize the meshes one by one on the caller's fiber instead
+    if (model->numMeshes == 1 || Jobs::IsRunningOnCurrentThread()) {
+        for (uint32 i = 0; i < model->numMeshes; i++)
+            OptimizeMeshJob(i, model);
+    }
+    else {
+        JobsHandle handle = Jobs::Dispatch(JobsType::LongTask, OptimizeMeshJob, model, model->numMeshes, 
+                                           JobsPriority::Normal, JobsStackSize::Large);
+        Jobs::WaitForCompletionAndDelete(handle);
+    }
 }
 
 #endif // CONFIG_TOOLMODE
@@ -3,10 +3,39 @@
 #include "../Core/Base.h"
 
 #if CONFIG_TOOLMODE
+inline constexpr uint32 MESHOPT_MAX_LODS = 4;
+inline constexpr uint32 MESHOPT_MESHLET_MAX_VERTICES = 64;
+inline constexpr uint32 MESHOPT_MESHLET_MAX_TRIANGLES = 124;
+
+struct MeshOptLod
+{
+    uint32 startIndex;      // Index into MeshOptMesh::lodIndexBuffer
+    uint32 numIndices;
+    float error;            // Absolute simplification error (in mesh space units), accumulated over the chain
+};
+
+struct MeshOptMeshlet
+{
+    float center[3];        // Bounding sphere
+    float radius;
+    float coneAxis[3];      // Backface culling cone
+    float coneCutoff;
+    uint32 vertexOffset;    // Index into MeshOptMesh::meshletVertices
+    uint32 triangleOffset;  // Index into MeshOptMesh::meshletTriangles
+    uint32 numVertices;
+    uint32 numTriangles;
+};
+
 struct MeshOptSubmesh
 {
     uint32 startIndex;
     uint32 numIndices;
+
+    // Outputs
+    uint32 numLods;
+    MeshOptLod lods[MESHOPT_MAX_LODS];
+    uint32 meshletStart;    // Index into MeshOptMesh::meshlets
+    uint32 numMeshlets;
 };
 
 struct MeshOptMesh
@@ -24,6 +53,16 @@ struct MeshOptMesh
     uint32 numVertices;
     uint32 numIndices;
     uint32 numSubmeshes;
+
+    // Outputs: Allocated from MeshOptModel::alloc
+    uint32* lodIndexBuffer;         // LOD indices of all submeshes, Referencing the same vertices as `indexBuffer` 
+    MeshOptMeshlet* meshlets;
+    uint32* meshletVertices;        // Indices to the mesh vertices
+    uint8* meshletTriangles;        // Three local indices (meshletVertices) per triangle
+    uint32 numLodIndices;
+    uint32 numMeshlets;
+    uint32 numMeshletVertices;
+    uint32 numMeshletTriangles;     // Size of meshletTriangles array (in bytes)
 };
 
 struct MeshOptModel
@@ -31,13 +70,19 @@ struct MeshOptModel
     MeshOptMesh** meshes;
     uint32 numMeshes;
     bool showOverdrawAnalysis;
+    bool generateMeshlets;
+    uint32 numLods;                 // Number of simplified LODs generated per submesh. Max: MESHOPT_MAX_LODS
+    float lodReduction = 0.5f;      // Ratio of the index count of each LOD to the previous one
+    float lodTargetError = 0.02f;   // Maximum simplification error per LOD, relative to mesh extents
+    MemAllocator* alloc;            // Allocator for the outputs. Meshes are processed in parallel, so it must be thread-safe
 };
 
 namespace MeshOpt
 {
+    // Meshes are processed in parallel with LongTask jobs. Called from inside a job (asset bake for example), the meshes
+    // are processed serially on the calling job instead, so it never continues on a different thread
     API void Optimize(MeshOptModel* model);
     API void Initialize();
 }
 
 #endif // CONFIG_TOOLMODE
-
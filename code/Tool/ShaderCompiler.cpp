@@ -7,9 +7,51 @@
 
 #include "../Core/Log.h"
 #include "../Core/TracyHelper.h"
+#include "../Core/Hash.h"
+#include "../Core/Jobs.h"
+#include "../Core/Atomic.h"
+#include "../Core/Blobs.h"
+
+#include "../Common/VirtualFS.h"
 
 #include "../Graphics/GfxBackendTypes.h"
 
+static inline constexpr uint32 SHADERCOMPILER_CACHE_FILE_ID = MakeFourCC('S', 'C', 'C', 'H');
+static inline constexpr uint32 SHADERCOMPILER_CACHE_VERSION = 2;
+static inline constexpr const char* SHADERCOMPILER_CACHE_DIR = "/cache/shaders";
+
+struct ShaderCompilerCacheInclude
+{
+    Path path;
+    uint64 size;
+    uint64 lastModified;
+    uint32 contentHash;
+};
+
+struct ShaderCompilerCacheItem
+{
+    HashResult128 key;
+    GfxShader* shader;      // Relocatable shader blob (see `Compile`)
+    uint32 shaderSize;
+    uint32 numIncludes;
+    ShaderCompilerCacheInclude* includes;
+};
+
+struct ShaderCompilerContext
+{
+    SpinLockMutex cacheMutex;
+    HashTable<ShaderCompilerCacheItem> cache;
+
+    AtomicUint32 numCacheHits;
+    AtomicUint32 numDiskCacheHits;
+    AtomicUint32 numCacheMisses;
+    AtomicUint32 numFailed;
+    AtomicUint64 compileTime;
+    AtomicUint64 cacheTime;
+};
+
+static ShaderCompilerContext gShaderCompiler;
+
 namespace ShaderCompiler
 {
 
@@ -85,10 +127,10 @@ static GfxFormat shaderTranslateVertexInputFormat([[maybe_unused]] uint32 rows,
     return GfxFormat::Undefined;
 }
 
-Pair<GfxShader*, uint32> Compile(const Span<uint8>& sourceCode, const char* filepath, const ShaderCompileDesc& desc, 
-                                 char* errorDiag, uint32 errorDiagSize, 
-                                 Path** outIncludes, uint32* outNumIncludes,
-                                 MemAllocator* alloc)
+static Pair<GfxShader*, uint32> _CompileWithSlang(const Span<uint8>& sourceCode, const char* filepath, const ShaderCompileDesc& desc, 
+                                                  char* errorDiag, uint32 errorDiagSize, 
+                                                  Path** outIncludes, uint32* outNumIncludes,
+                                                  MemAllocator* alloc)
 {
     if (gSlangSession == nullptr) {
         gSlangSession = spCreateSession();
@@ -133,6 +175,7 @@ Pair<GfxShader*, uint32> Compile(const Span<uint8>& sourceCode, const char* file
             Str::Copy(errorDiag, errorDiagSize, diag);
         else 
             LOG_ERROR(diag);
+        spDestroyCompileRequest(req);
         return {};
     }
 
@@ -261,19 +304,18 @@ Pair<GfxShader*, uint32> Compile(const Span<uint8>& sourceCode, const char* file
 
     spDestroyCompileRequest(req);
 
-    if (!includes.IsEmpty()) {
-        if (outNumIncludes) {
-            ASSERT(outIncludes);
-            if (tmpAlloc.OwnsId()) {
-                *outIncludes = Mem::AllocCopy<Path>(includes.Ptr(), includes.Count(), alloc);
-                *outNumIncludes = includes.Count();
-            }
-            else {
-                includes.Detach(outIncludes, outNumIncludes);
-            }
+    if (outNumIncludes) {
+        ASSERT(outIncludes);
+        if (includes.IsEmpty()) {
+            *outIncludes = nullptr;
+            *outNumIncludes = 0;
+        }
+        else if (tmpAlloc.OwnsId()) {
+            *outIncludes = Mem::AllocCopy<Path>(includes.Ptr(), includes.Count(), alloc);
+            *outNumIncludes = includes.Count();
         }
         else {
-            *outNumIncludes = 0;
+            includes.Detach(outIncludes, outNumIncludes);
         }
     }
 
@@ -283,6 +325,409 @@ Pair<GfxShader*, uint32> Compile(const Span<uint8>& sourceCode, const char* file
         return Pair<GfxShader*, uint32>(shader, shaderBufferSize);
 }
 
+static HashResult128 _MakeCacheKey(const Span<uint8>& sourceCode, const char* filepath, const ShaderCompileDesc& desc)
+{
+    // ShaderCompileDesc doesn't have any holes, so we can hash it directly (see ShaderCompiler.h)
+    uint32 filepathLen = Str::Len(filepath);
+    size_t keyDataSize = sizeof(desc) + filepathLen + sourceCode.Count();
+
+    MemTempAllocator tmpAlloc;
+    uint8* keyData = tmpAlloc.MallocTyped<uint8>(uint32(keyDataSize));
+    memcpy(keyData, &desc, sizeof(desc));
+    memcpy(keyData + sizeof(desc), filepath, filepathLen);
+    memcpy(keyData + sizeof(desc) + filepathLen, sourceCode.Ptr(), sourceCode.Count());
+
+    return Hash::Murmur128(keyData, keyDataSize, SHADERCOMPILER_CACHE_VERSION);
+}
+
+static bool _HashFileContents(const char* filepath, uint32* outHash)
+{
+    File f;
+    if (!f.Open(filepath, FileOpenFlags::Read | FileOpenFlags::SeqScan))
+        return false;
+
+    MemTempAllocator tmpAlloc;
+    size_t size = f.GetSize();
+    uint8* data = size ? tmpAlloc.MallocTyped<uint8>(uint32(size)) : nullptr;
+    bool r = f.Read((void*)data, size) == size;
+    f.Close();
+
+    *outHash = r ? Hash::Murmur32(data, uint32(size)) : 0;
+    return r;
+}
+
+static bool _StampInclude(ShaderCompilerCacheInclude* include)
+{
+    PathInfo info = OS::GetPathInfo(include->path.CStr());
+    if (info.type != PathType::File)
+        return false;
+    include->size = info.size;
+    include->lastModified = info.lastModified;
+    return true;
+}
+
+// Includes with the same size and modified time are trusted without reading them. Otherwise the contents are hashed,
+// and if they still match (fresh clone/pull or touched files), the new size/time are written back to `includes`
+// Returns false if any of the includes has changed. `outStampsChanged` is set if any of the stamps were updated
+static bool _ValidateCacheIncludes(ShaderCompilerCacheInclude* includes, uint32 numIncludes, bool* outStampsChanged)
+{
+    *outStampsChanged = false;
+    for (uint32 i = 0; i < numIncludes; i++) {
+        PathInfo info = OS::GetPathInfo(includes[i].path.CStr());
+        if (info.type != PathType::File)
+            return false;
+        if (info.size == includes[i].size && info.lastModified == includes[i].lastModified)
+            continue;
+
+        uint32 contentHash;
+        if (!_HashFileContents(includes[i].path.CStr(), &contentHash) || contentHash != includes[i].contentHash)
+            return false;
+        includes[i].size = info.size;
+        includes[i].lastModified = info.lastModified;
+        *outStampsChanged = true;
+    }
+    return true;
+}
+
+static Path _MakeCacheFilepath(const HashResult128& key)
+{
+    return Path(String<64>::Format("%s/%llx%llx.bin", SHADERCOMPILER_CACHE_DIR, key.h1, key.h2).CStr());
+}
+
+// Copies the item data to the output. Item should be locked or not yet shared
+static Pair<GfxShader*, uint32> _CopyCacheItem(const ShaderCompilerCacheItem& item, Path** outIncludes, uint32* outNumIncludes, 
+                                               MemAllocator* alloc)
+{
+    if (outNumIncludes) {
+        ASSERT(outIncludes);
+        *outNumIncludes = item.numIncludes;
+        *outIncludes = item.numIncludes ? Mem::AllocTyped<Path>(item.numIncludes, alloc) : nullptr;
+        for (uint32 i = 0; i < item.numIncludes; i++)
+            (*outIncludes)[i] = item.includes[i].path;
+    }
+
+    return Pair<GfxShader*, uint32>(Mem::AllocCopyRawBytes<GfxShader>(item.shader, item.shaderSize, alloc), item.shaderSize);
+}
+
+static void _FreeCacheItem(ShaderCompilerCacheItem* item)
+{
+    Mem::Free(item->shader);
+    Mem::Free(item->includes);
+    memset(item, 0x0, sizeof(*item));
+}
+
+static void _InsertCacheItem(uint32 hashKey, const ShaderCompilerCacheItem& item)
+{
+    SpinLockMutexScope lock(gShaderCompiler.cacheMutex);
+    uint32 index = gShaderCompiler.cache.Find(hashKey);
+    if (index == UINT32_MAX) {
+        gShaderCompiler.cache.Add(hashKey, item);
+    }
+    else {
+        _FreeCacheItem(&gShaderCompiler.cache.GetMutable(index));
+        gShaderCompiler.cache.Set(index, item);
+    }
+}
+
+static bool _LoadCacheItemFromDisk(const HashResult128& key, ShaderCompilerCacheItem* outItem)
+{
+    if (Vfs::GetMountType(SHADERCOMPILER_CACHE_DIR) != VfsMountType::Local)
+        return false;
+
+    Path cacheFilepath = _MakeCacheFilepath(key);
+    if (!Vfs::FileExists(cacheFilepath.CStr()))
+        return false;
+
+    MemTempAllocator tmpAlloc;
+    Blob blob = Vfs::ReadFile(cacheFilepath.CStr(), VfsFlags::None, &tmpAlloc);
+    if (!blob.IsValid())
+        return false;
+
+    uint32 fileId = 0;
+    uint32 version = 0;
+    HashResult128 fileKey {};
+    blob.Read<uint32>(&fileId);
+    blob.Read<uint32>(&version);
+    blob.Read<HashResult128>(&fileKey);
+    if (fileId != SHADERCOMPILER_CACHE_FILE_ID || version != SHADERCOMPILER_CACHE_VERSION || fileKey != key)
+        return false;
+
+    ShaderCompilerCacheItem item { .key = key };
+    blob.Read<uint32>(&item.numIncludes);
+    blob.Read<uint32>(&item.shaderSize);
+    if (item.shaderSize == 0 || item.shaderSize > blob.Size() - blob.ReadOffset())
+        return false;
+
+    if (item.numIncludes) {
+        item.includes = Mem::AllocZeroTyped<ShaderCompilerCacheInclude>(item.numIncludes);
+        for (uint32 i = 0; i < item.numIncludes; i++) {
+            char includePath[PATH_CHARS_MAX];
+            blob.ReadStringBinary(includePath, sizeof(includePath));
+            item.includes[i].path = includePath;
+            blob.Read<uint64>(&item.includes[i].size);
+            blob.Read<uint64>(&item.includes[i].lastModified);
+            blob.Read<uint32>(&item.includes[i].contentHash);
+        }
+    }
+
+    item.shader = (GfxShader*)Mem::Alloc(item.shaderSize);
+    if (blob.Read(item.shader, item.shaderSize) != item.shaderSize) {
+        _FreeCacheItem(&item);
+        return false;
+    }
+
+    *outItem = item;
+    return true;
+}
+
+static void _SaveCacheItemToDisk(const ShaderCompilerCacheItem& item)
+{
+    if (Vfs::GetMountType(SHADERCOMPILER_CACHE_DIR) != VfsMountType::Local)
+        return;
+
+    MemTempAllocator tmpAlloc;
+    Blob blob(&tmpAlloc);
+    blob.SetGrowPolicy(Blob::GrowPolicy::Linear);
+    blob.Reserve(64 + item.shaderSize + item.numIncludes*sizeof(ShaderCompilerCacheInclude));
+    blob.Write<uint32>(SHADERCOMPILER_CACHE_FILE_ID);
+    blob.Write<uint32>(SHADERCOMPILER_CACHE_VERSION);
+    blob.Write<HashResult128>(item.key);
+    blob.Write<uint32>(item.numIncludes);
+    blob.Write<uint32>(item.shaderSize);
+    for (uint32 i = 0; i < item.numIncludes; i++) {
+        blob.WriteStringBinary(item.includes[i].path.CStr(), item.includes[i].path.Length());
+        blob.Write<uint64>(item.includes[i].size);
+        blob.Write<uint64>(item.includes[i].lastModified);
+        blob.Write<uint32>(item.includes[i].contentHash);
+    }
+    blob.Write(item.shader, item.shaderSize);
+
+    Path cacheFilepath = _MakeCacheFilepath(item.key);
+    if (Vfs::WriteFile(cacheFilepath.CStr(), blob, VfsFlags::CreateDirs) != blob.Size())
+        LOG_WARNING("Writing shader cache file failed: %s", cacheFilepath.CStr());
+}
+
+static bool _FetchFromCache(const HashResult128& key, Path** outIncludes, uint32* outNumIncludes, MemAllocator* alloc,
+                            Pair<GfxShader*, uint32>* outShader)
+{
+    uint32 hashKey = Hash::Int64To32(key.h1 ^ key.h2);
+
+    // Copy the data out of the cache while locked. Validation of the includes is done outside the lock, 
+    // because it reads the include files from disk
+    // Note: `alloc` can be the caller's temp allocator, so we cannot push another temp allocator here 
+    ShaderCompilerCacheInclude* includes = nullptr;
+    uint32 numIncludes = 0;
+    bool found = false;
+    {
+        SpinLockMutexScope lock(gShaderCompiler.cacheMutex);
+        uint32 index = gShaderCompiler.cache.Find(hashKey);
+        if (index != UINT32_MAX) {
+            const ShaderCompilerCacheItem& item = gShaderCompiler.cache.Get(index);
+            if (item.key == key) {
+                *outShader = _CopyCacheItem(item, outIncludes, outNumIncludes, alloc);
+                numIncludes = item.numIncludes;
+                includes = numIncludes ? Mem::AllocCopy<ShaderCompilerCacheInclude>(item.includes, numIncludes) : nullptr;
+                found = true;
+            }
+        }
+    }
+
+    if (found) {
+        bool stampsChanged;
+        bool valid = _ValidateCacheIncludes(includes, numIncludes, &stampsChanged);
+        if (valid && stampsChanged) {
+            // Write back the new stamps, so the next hits don't need to hash the includes again
+            SpinLockMutexScope lock(gShaderCompiler.cacheMutex);
+            uint32 index = gShaderCompiler.cache.Find(hashKey);
+            if (index != UINT32_MAX) {
+                ShaderCompilerCacheItem& item = gShaderCompiler.cache.GetMutable(index);
+                if (item.key == key && item.numIncludes == numIncludes)
+                    memcpy(item.includes, includes, sizeof(ShaderCompilerCacheInclude)*numIncludes);
+            }
+        }
+        Mem::Free(includes);
+        if (valid)
+            return true;
+
+        // Stale: one of the includes has changed
+        Mem::Free(outShader->first, alloc);
+        if (outNumIncludes)
+            Mem::Free(*outIncludes, alloc);
+        *outShader = {};
+        return false;
+    }
+
+    // Try disk cache
+    ShaderCompilerCacheItem item;
+    if (!_LoadCacheItemFromDisk(key, &item))
+        return false;
+
+    bool stampsChanged;
+    if (!_ValidateCacheIncludes(item.includes, item.numIncludes, &stampsChanged)) {
+        _FreeCacheItem(&item);
+        return false;
+    }
+    if (stampsChanged)
+        _SaveCacheItemToDisk(item);
+
+    *outShader = _CopyCacheItem(item, outIncludes, outNumIncludes, alloc);
+    Atomic::FetchAdd(&gShaderCompiler.numDiskCacheHits, 1);
+
+    _InsertCacheItem(hashKey, item);
+    return true;
+}
+
+static void _AddToCache(const HashResult128& key, const GfxShader* shader, uint32 shaderSize, const Path* includes, uint32 numIncludes)
+{
+    ShaderCompilerCacheItem item {
+        .key = key,
+        .shader = Mem::AllocCopyRawBytes<GfxShader>(shader, shaderSize),
+        .shaderSize = shaderSize,
+        .numIncludes = numIncludes,
+        .includes = numIncludes ? Mem::AllocZeroTyped<ShaderCompilerCacheInclude>(numIncludes) : nullptr
+    };
+
+    for (uint32 i = 0; i < numIncludes; i++) {
+        item.includes[i].path = includes[i];
+        if (!_StampInclude(&item.includes[i]) || !_HashFileContents(includes[i].CStr(), &item.includes[i].contentHash)) {
+            // Cannot validate this include later, so don't cache the result at all
+            _FreeCacheItem(&item);
+            return;
+        }
+    }
+
+    _SaveCacheItemToDisk(item);
+
+    uint32 hashKey = Hash::Int64To32(key.h1 ^ key.h2);
+    _InsertCacheItem(hashKey, item);
+}
+
+Pair<GfxShader*, uint32> Compile(const Span<uint8>& sourceCode, const char* filepath, const ShaderCompileDesc& desc, 
+                                 char* errorDiag, uint32 errorDiagSize, 
+                                 Path** outIncludes, uint32* outNumIncludes,
+                                 MemAllocator* alloc)
+{
+    PROFILE_ZONE("ShaderCompiler.Compile");
+
+    // Intermediates are only dumped by the compiler itself, so always compile in that case
+    bool useCache = !desc.dumpIntermediates;
+    HashResult128 key {};
+
+    if (useCache) {
+        TimerStopWatch cacheStopWatch;
+        key = _MakeCacheKey(sourceCode, filepath, desc);
+
+        Pair<GfxShader*, uint32> shader;
+        bool hit = _FetchFromCache(key, outIncludes, outNumIncludes, alloc, &shader);
+        Atomic::FetchAdd(&gShaderCompiler.cacheTime, cacheStopWatch.Elapsed());
+        if (hit) {
+            Atomic::FetchAdd(&gShaderCompiler.numCacheHits, 1);
+            return shader;
+        }
+        Atomic::FetchAdd(&gShaderCompiler.numCacheMisses, 1);
+    }
+
+    TimerStopWatch compileStopWatch;
+    Path* includes = nullptr;
+    uint32 numIncludes = 0;
+    Pair<GfxShader*, uint32> shader = _CompileWithSlang(sourceCode, filepath, desc, errorDiag, errorDiagSize, 
+                                                        &includes, &numIncludes, alloc);
+    Atomic::FetchAdd(&gShaderCompiler.compileTime, compileStopWatch.Elapsed());
+
+    if (!shader.first) {
+        Atomic::FetchAdd(&gShaderCompiler.numFailed, 1);
+        return shader;
+    }
+
+    if (useCache)
+        _AddToCache(key, shader.first, shader.second, includes, numIncludes);
+
+    if (outNumIncludes) {
+        ASSERT(outIncludes);
+        *outIncludes = includes;
+        *outNumIncludes = numIncludes;
+    }
+    else {
+        Mem::Free(includes, alloc);
+    }
+
+    return shader;
+}
+
+uint32 CompilePermutations(const Span<uint8>& sourceCode, const char* filepath, const Span<ShaderCompileDesc>& descs,
+                           Pair<GfxShader*, uint32>* outShaders, MemAllocator* alloc)
+{
+    ASSERT(outShaders);
+    ASSERT_MSG(alloc->GetType() != MemAllocatorType::Temp, "Temp allocators cannot be used across worker threads");
+
+    struct CompileJobData
+    {
+        const Span<uint8>* sourceCode;
+        const char* filepath;
+        const ShaderCompileDesc* descs;
+        Pair<GfxShader*, uint32>* outShaders;
+        MemAllocator* alloc;
+        AtomicUint32 numCompiled;
+    };
+
+    if (descs.Count() == 0)
+        return 0;
+
+    CompileJobData data {
+        .sourceCode = &sourceCode,
+        .filepath = filepath,
+        .descs = descs.Ptr(),
+        .outShaders = outShaders,
+        .alloc = alloc
+    };
+
+    auto CompileJobCallback = [](uint32 groupIndex, void* userData)
+    {
+        CompileJobData* data = reinterpret_cast<CompileJobData*>(userData);
+        Pair<GfxShader*, uint32> shader = Compile(*data->sourceCode, data->filepath, data->descs[groupIndex], nullptr, 0, 
+                                                  nullptr, nullptr, data->alloc);
+        data->outShaders[groupIndex] = shader;
+        if (shader.first)
+            Atomic::FetchAdd(&data->numCompiled, 1);
+    };
+
+    // Inside a job (asset bake for example), the caller may hold thread-bound allocators and waiting on the children
+    // can resume it on another worker. So compile the permutations one by one on the caller's fiber instead
+    if (descs.Count() == 1 || Jobs::IsRunningOnCurrentThread()) {
+        for (uint32 i = 0; i < descs.Count(); i++)
+            CompileJobCallback(i, &data);
+    }
+    else {
+        JobsHandle handle = Jobs::Dispatch(JobsType::LongTask, CompileJobCallback, &data, descs.Count(), 
+                                           JobsPriority::Normal, JobsStackSize::Large);
+        Jobs::WaitForCompletionAndDelete(handle);
+    }
+
+    return Atomic::Load(&data.numCompiled);
+}
+
+ShaderCompilerStats GetStats()
+{
+    return ShaderCompilerStats {
+        .numCacheHits = Atomic::Load(&gShaderCompiler.numCacheHits),
+        .numDiskCacheHits = Atomic::Load(&gShaderCompiler.numDiskCacheHits),
+        .numCacheMisses = Atomic::Load(&gShaderCompiler.numCacheMisses),
+        .numFailed = Atomic::Load(&gShaderCompiler.numFailed),
+        .compileTimeMS = Timer::ToMS(Atomic::Load(&gShaderCompiler.compileTime)),
+        .cacheTimeMS = Timer::ToMS(Atomic::Load(&gShaderCompiler.cacheTime))
+    };
+}
+
+void ReleaseCache()
+{
+    SpinLockMutexScope lock(gShaderCompiler.cacheMutex);
+    for (uint32 i = 0; i < gShaderCompiler.cache.Capacity(); i++) {
+        if (gShaderCompiler.cache.Keys()[i]) 
+            _FreeCacheItem(&gShaderCompiler.cache.GetMutable(i));
+    }
+    gShaderCompiler.cache.Free();
+}
+
 void ReleaseLiveSessions()
 {
     SpinLockMutexScope lk(gLiveSessionMutex);
@@ -22,6 +22,16 @@ struct ShaderCompileDesc
     uint8 _padding[2];      // Structure should have no holes because we are hashing it for asset-manager
 };
 
+struct ShaderCompilerStats
+{
+    uint32 numCacheHits;        // Includes disk cache hits
+    uint32 numDiskCacheHits;
+    uint32 numCacheMisses;
+    uint32 numFailed;
+    double compileTimeMS;       // Total time spent in the compiler for cache misses
+    double cacheTimeMS;         // Total time spent on cache lookups and include validation
+};
+
 #if CONFIG_TOOLMODE
 
 struct GfxShader;
@@ -29,12 +39,28 @@ struct MemAllocator;
 
 namespace ShaderCompiler
 {
+    // Compiled shaders are cached by the hash of source code + filepath + ShaderCompileDesc (defines/flags)
+    // Cached entries also keep the size/modified time and content hash of all included files and are recompiled if any of
+    // them changes. Includes are only hashed again if their size or modified time differ
+    // Cache lives in memory and is also persisted to "/cache/shaders" if the cache mount is local. 
+    // Since it's content based, it survives timestamp changes (fresh clones/pulls)
     // Note: `alloc` should not be tmpAlloc
     API Pair<GfxShader*, uint32> Compile(const Span<uint8>& sourceCode, const char* filepath, const ShaderCompileDesc& desc, 
                                          char* errorDiag, uint32 errorDiagSize, 
                                          Path** outIncludes = nullptr, uint32* outNumIncludes = nullptr, 
                                          MemAllocator* alloc = Mem::GetDefaultAlloc());
+
+    // Compiles all permutations (ShaderCompileDesc variants) of a single shader source in parallel with LongTask jobs
+    // `outShaders` should have the same number of elements as `descs`. Failed ones are returned as {nullptr, 0} and logged
+    // Returns the number of permutations that compiled successfully
+    // Called from inside a job, the permutations are compiled serially on the calling job, so it never changes threads
+    // Note: `alloc` is used by worker threads, so it should be thread-safe (cannot be tmpAlloc)
+    API uint32 CompilePermutations(const Span<uint8>& sourceCode, const char* filepath, const Span<ShaderCompileDesc>& descs,
+                                   Pair<GfxShader*, uint32>* outShaders, MemAllocator* alloc = Mem::GetDefaultAlloc());
+
+    API ShaderCompilerStats GetStats();
     API void ReleaseLiveSessions();
+    API void ReleaseCache();
 }
 
 #endif
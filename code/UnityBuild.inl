@@ -45,6 +45,7 @@
 #include "Tool/ImageEncoder.cpp"
 #include "Tool/MeshOptimizer.cpp"
 #include "Tool/Console.cpp"
+#include "Tool/Benchmarks.cpp"
 
 // Graphics/ImGui
 #include "External/imgui/imgui.cpp"